@@ -171,6 +171,7 @@ void show_usage()
     fprintf(stderr, "Usage: benchncnn [loop count] [num threads] [powersave] [gpu device] [cooling down] [(key=value)...]\n");
     fprintf(stderr, "  param=model.param\n");
     fprintf(stderr, "  shape=[227,227,3],...\n");
+    fprintf(stderr, "  schedule=static|dynamic\n");
 }
 
 static std::vector<ncnn::Mat> parse_shape_list(char* s)
@@ -244,6 +245,7 @@ int main(int argc, char** argv)
     int cooling_down = 1;
     char* model = 0;
     std::vector<ncnn::Mat> inputs;
+    int schedule = 0;
 
     for (int i = 1; i < argc; i++)
     {
@@ -302,6 +304,8 @@ int main(int argc, char** argv)
             model = value;
         if (strcmp(key, "shape") == 0)
             inputs = parse_shape_list(value);
+        if (strcmp(key, "schedule") == 0)
+            schedule = strcmp(value, "dynamic") == 0 ? 1 : 0;
     }
 
     if (model && inputs.empty())
@@ -341,6 +345,7 @@ int main(int argc, char** argv)
 
     ncnn::set_omp_dynamic(0);
     ncnn::set_omp_num_threads(num_threads);
+    ncnn::set_omp_schedule(schedule);
 
     // default option
     ncnn::Option opt;
@@ -369,6 +374,7 @@ int main(int argc, char** argv)
     fprintf(stderr, "powersave = %d\n", ncnn::get_cpu_powersave());
     fprintf(stderr, "gpu_device = %d\n", gpu_device);
     fprintf(stderr, "cooling_down = %d\n", (int)g_enable_cooling_down);
+    fprintf(stderr, "schedule = %s\n", ncnn::get_omp_schedule() == 1 ? "dynamic" : "static");
 
     if (model != 0)
     {
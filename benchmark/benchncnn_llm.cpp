@@ -10,9 +10,11 @@
 #include "cpu.h"
 #include "datareader.h"
 #include "gpu.h"
+#include "kvcache.h"
 #include "layer.h"
 #include "layer_type.h"
 #include "net.h"
+#include "speculative.h"
 
 #include "benchncnn_llm_param_data.h"
 
@@ -39,6 +41,7 @@ public:
 static int g_warmup_loop_count = 8;
 static int g_loop_count = 4;
 static bool g_enable_cooling_down = true;
+static int g_draft_count = 4;
 
 static ncnn::UnlockedPoolAllocator g_blob_pool_allocator;
 static ncnn::PoolAllocator g_workspace_pool_allocator;
@@ -49,12 +52,6 @@ static ncnn::VkAllocator* g_blob_vkallocator = 0;
 static ncnn::VkAllocator* g_staging_vkallocator = 0;
 #endif // NCNN_VULKAN
 
-struct CacheIndexes
-{
-    std::vector<int> input_indexes;
-    std::vector<int> output_indexes;
-};
-
 struct ModelConfig
 {
     const char* name;
@@ -106,23 +103,6 @@ static const ModelConfig model = {"youtu_llm_2b", youtu_llm_2b_decoder_ncnn_para
 
 } // namespace youtu_llm
 
-static void resolve_cache_indexes(const ncnn::Net& net, CacheIndexes& cache_indexes)
-{
-    const std::vector<ncnn::Layer*>& layers = net.layers();
-    for (size_t i = 0; i < layers.size(); i++)
-    {
-        const ncnn::Layer* op = layers[i];
-
-        if (op->typeindex == ncnn::LayerType::SDPA && op->tops.size() == 3)
-        {
-            cache_indexes.input_indexes.push_back(op->bottoms[op->bottoms.size() - 2]);
-            cache_indexes.input_indexes.push_back(op->bottoms[op->bottoms.size() - 1]);
-            cache_indexes.output_indexes.push_back(op->tops[op->tops.size() - 2]);
-            cache_indexes.output_indexes.push_back(op->tops[op->tops.size() - 1]);
-        }
-    }
-}
-
 static void make_attention_mask(int cur_seqlen, int past_seqlen, ncnn::Mat& attention_mask)
 {
     const int dst_seqlen = past_seqlen + cur_seqlen;
@@ -149,7 +129,7 @@ static void make_rope_cache(int half_dim, int seqlen, ncnn::Mat& cos_cache, ncnn
     sin_cache.fill(0.f);
 }
 
-static int run_decoder_once(ncnn::Net& decoder, ncnn::Net& proj_out, const CacheIndexes& cache_indexes, int hidden_size, int rope_half_dim, int cur_seqlen, int past_seqlen, const std::vector<ncnn::Mat>& cache, std::vector<ncnn::Mat>& out_cache)
+static int run_decoder_once(ncnn::Net& decoder, ncnn::Net& proj_out, ncnn::KVCache& kv_cache, int hidden_size, int rope_half_dim, int cur_seqlen, int past_seqlen)
 {
     ncnn::Mat token_embeds(hidden_size, cur_seqlen);
     token_embeds.fill(0.01f);
@@ -161,23 +141,16 @@ static int run_decoder_once(ncnn::Net& decoder, ncnn::Net& proj_out, const Cache
     ncnn::Mat sin_cache;
     make_rope_cache(rope_half_dim, cur_seqlen, cos_cache, sin_cache);
 
+    // rewind to the benchmarked context, the new tokens are appended in place
+    kv_cache.truncate(past_seqlen);
+
     ncnn::Extractor ex = decoder.create_extractor();
+    ex.set_kv_cache(&kv_cache);
     ex.input("in0", token_embeds);
     ex.input("in1", attention_mask);
     ex.input("in2", cos_cache);
     ex.input("in3", sin_cache);
 
-    for (size_t i = 0; i < cache.size(); i++)
-    {
-        ex.input(cache_indexes.input_indexes[i], cache[i]);
-    }
-
-    out_cache.resize(cache_indexes.output_indexes.size());
-    for (size_t i = 0; i < cache_indexes.output_indexes.size(); i++)
-    {
-        ex.extract(cache_indexes.output_indexes[i], out_cache[i], 1);
-    }
-
     ncnn::Mat hidden;
     int ret = ex.extract("out0", hidden);
     if (ret != 0)
@@ -196,13 +169,11 @@ static int run_decoder_once(ncnn::Net& decoder, ncnn::Net& proj_out, const Cache
     return ex2.extract("out0", logits);
 }
 
-static void benchmark_case(const char* name, ncnn::Net& decoder, ncnn::Net& proj_out, const CacheIndexes& cache_indexes, int hidden_size, int rope_half_dim, int cur_seqlen, int past_seqlen, const std::vector<ncnn::Mat>& cache, double rate_scale)
+static void benchmark_case(const char* name, ncnn::Net& decoder, ncnn::Net& proj_out, ncnn::KVCache& kv_cache, int hidden_size, int rope_half_dim, int cur_seqlen, int past_seqlen, double rate_scale)
 {
-    std::vector<ncnn::Mat> out_cache;
-
     for (int i = 0; i < g_warmup_loop_count; i++)
     {
-        run_decoder_once(decoder, proj_out, cache_indexes, hidden_size, rope_half_dim, cur_seqlen, past_seqlen, cache, out_cache);
+        run_decoder_once(decoder, proj_out, kv_cache, hidden_size, rope_half_dim, cur_seqlen, past_seqlen);
     }
 
     double time_min = DBL_MAX;
@@ -212,7 +183,7 @@ static void benchmark_case(const char* name, ncnn::Net& decoder, ncnn::Net& proj
     for (int i = 0; i < g_loop_count; i++)
     {
         double start = ncnn::get_current_time();
-        run_decoder_once(decoder, proj_out, cache_indexes, hidden_size, rope_half_dim, cur_seqlen, past_seqlen, cache, out_cache);
+        run_decoder_once(decoder, proj_out, kv_cache, hidden_size, rope_half_dim, cur_seqlen, past_seqlen);
         double end = ncnn::get_current_time();
 
         double time = end - start;
@@ -227,6 +198,69 @@ static void benchmark_case(const char* name, ncnn::Net& decoder, ncnn::Net& proj
     fprintf(stderr, "%30s  min = %7.2f  max = %7.2f  avg = %7.2f  tps = %7.2f\n", name, time_min, time_max, time_avg, tokens_per_second);
 }
 
+// the decoder and proj_out nets with their kv cache as a token decoder for speculative decoding
+// the zero weights give all-zero logits, so every draft token is accepted
+class LLMTokenDecoder : public ncnn::TokenDecoder
+{
+public:
+    LLMTokenDecoder(ncnn::Net& _decoder, ncnn::Net& _proj_out, int _hidden_size, int _rope_half_dim)
+        : decoder(_decoder), proj_out(_proj_out), hidden_size(_hidden_size), rope_half_dim(_rope_half_dim)
+    {
+        kv_cache.reserve(512);
+    }
+
+    virtual int forward(const std::vector<int>& tokens, ncnn::Mat& logits)
+    {
+        const int cur_seqlen = (int)tokens.size();
+        const int past_seqlen = kv_cache.seqlen();
+
+        ncnn::Mat token_embeds(hidden_size, cur_seqlen);
+        token_embeds.fill(0.01f);
+
+        ncnn::Mat attention_mask;
+        make_attention_mask(cur_seqlen, past_seqlen, attention_mask);
+
+        ncnn::Mat cos_cache;
+        ncnn::Mat sin_cache;
+        make_rope_cache(rope_half_dim, cur_seqlen, cos_cache, sin_cache);
+
+        ncnn::Extractor ex = decoder.create_extractor();
+        ex.set_kv_cache(&kv_cache);
+        ex.input("in0", token_embeds);
+        ex.input("in1", attention_mask);
+        ex.input("in2", cos_cache);
+        ex.input("in3", sin_cache);
+
+        ncnn::Mat hidden;
+        int ret = ex.extract("out0", hidden);
+        if (ret != 0)
+            return ret;
+
+        // logits of every position for verifying the draft tokens
+        ncnn::Extractor ex2 = proj_out.create_extractor();
+        ex2.input("in0", hidden);
+
+        return ex2.extract("out0", logits);
+    }
+
+    virtual int seqlen() const
+    {
+        return kv_cache.seqlen();
+    }
+
+    virtual void truncate(int seqlen)
+    {
+        kv_cache.truncate(seqlen);
+    }
+
+private:
+    ncnn::Net& decoder;
+    ncnn::Net& proj_out;
+    ncnn::KVCache kv_cache;
+    int hidden_size;
+    int rope_half_dim;
+};
+
 static int load_net(ncnn::Net& net, const char* param_data, const ncnn::Option& opt)
 {
     net.opt = opt;
@@ -269,34 +303,122 @@ static int benchmark_model(const ModelConfig& config, const ncnn::Option& opt)
     if (ret != 0)
         return ret;
 
-    CacheIndexes cache_indexes;
-    resolve_cache_indexes(decoder, cache_indexes);
+    ncnn::KVCache kv_cache;
+    kv_cache.reserve(512);
 
     if (g_enable_cooling_down)
     {
         ncnn::sleep(10 * 1000);
     }
 
-    std::vector<ncnn::Mat> empty_cache;
-    std::vector<ncnn::Mat> past_cache;
-    run_decoder_once(decoder, proj_out, cache_indexes, config.hidden_size, config.rope_half_dim, 256, 0, empty_cache, past_cache);
+    run_decoder_once(decoder, proj_out, kv_cache, config.hidden_size, config.rope_half_dim, 256, 0);
 
     char prefill_name[256];
     snprintf(prefill_name, 256, "%s_256_prefill", config.name);
 
-    benchmark_case(prefill_name, decoder, proj_out, cache_indexes, config.hidden_size, config.rope_half_dim, 256, 0, empty_cache, 256.0);
+    benchmark_case(prefill_name, decoder, proj_out, kv_cache, config.hidden_size, config.rope_half_dim, 256, 0, 256.0);
 
     char decode_name[256];
     snprintf(decode_name, 256, "%s_256_decode", config.name);
 
-    benchmark_case(decode_name, decoder, proj_out, cache_indexes, config.hidden_size, config.rope_half_dim, 1, 256, past_cache, 1.0);
+    benchmark_case(decode_name, decoder, proj_out, kv_cache, config.hidden_size, config.rope_half_dim, 1, 256, 1.0);
+
+    return 0;
+}
+
+static int benchmark_speculative(const ModelConfig& config, const ModelConfig& draft_config, const ncnn::Option& opt)
+{
+    g_blob_pool_allocator.clear();
+    g_workspace_pool_allocator.clear();
+
+#if NCNN_VULKAN
+    if (opt.use_vulkan_compute)
+    {
+        g_blob_vkallocator->clear();
+        g_staging_vkallocator->clear();
+    }
+#endif // NCNN_VULKAN
+
+    ncnn::Net decoder;
+    int ret = load_net(decoder, config.decoder_param_data, opt);
+    if (ret != 0)
+        return ret;
+
+    ncnn::Net proj_out;
+    ret = load_net(proj_out, config.proj_out_param_data, opt);
+    if (ret != 0)
+        return ret;
+
+    ncnn::Net draft_decoder;
+    ret = load_net(draft_decoder, draft_config.decoder_param_data, opt);
+    if (ret != 0)
+        return ret;
+
+    ncnn::Net draft_proj_out;
+    ret = load_net(draft_proj_out, draft_config.proj_out_param_data, opt);
+    if (ret != 0)
+        return ret;
+
+    LLMTokenDecoder target(decoder, proj_out, config.hidden_size, config.rope_half_dim);
+    LLMTokenDecoder draft(draft_decoder, draft_proj_out, draft_config.hidden_size, draft_config.rope_half_dim);
+
+    ncnn::SpeculativeDecoder speculative(&target, &draft);
+    speculative.set_draft_count(g_draft_count);
+
+    if (g_enable_cooling_down)
+    {
+        ncnn::sleep(10 * 1000);
+    }
+
+    std::vector<int> prompt(257, 0);
+    ret = speculative.prefill(prompt);
+    if (ret != 0)
+        return ret;
+
+    std::vector<int> tokens;
+    for (int i = 0; i < g_warmup_loop_count; i++)
+    {
+        speculative.step(tokens);
+    }
+
+    double time_min = DBL_MAX;
+    double time_max = -DBL_MAX;
+    double time_avg = 0;
+
+    const int accepted_count0 = speculative.accepted_count();
+    const int proposed_count0 = speculative.proposed_count();
+
+    tokens.clear();
+    for (int i = 0; i < g_loop_count; i++)
+    {
+        double start = ncnn::get_current_time();
+        speculative.step(tokens);
+        double end = ncnn::get_current_time();
+
+        double time = end - start;
+        time_min = std::min(time_min, time);
+        time_max = std::max(time_max, time);
+        time_avg += time;
+    }
+
+    const double tokens_per_second = tokens.size() * 1000.0 / time_avg;
+
+    time_avg /= g_loop_count;
+
+    const int accepted_count = speculative.accepted_count() - accepted_count0;
+    const int proposed_count = speculative.proposed_count() - proposed_count0;
+
+    char name[256];
+    snprintf(name, 256, "%s_spec%d_decode", config.name, g_draft_count);
+
+    fprintf(stderr, "%30s  min = %7.2f  max = %7.2f  avg = %7.2f  tps = %7.2f  accepted = %d/%d  draft = %s\n", name, time_min, time_max, time_avg, tokens_per_second, accepted_count, proposed_count, draft_config.name);
 
     return 0;
 }
 
 static void show_usage()
 {
-    fprintf(stderr, "Usage: benchncnn_llm [loop count] [num threads] [powersave] [gpu device] [cooling down]\n");
+    fprintf(stderr, "Usage: benchncnn_llm [loop count] [num threads] [powersave] [gpu device] [cooling down] [draft count]\n");
 }
 
 int main(int argc, char** argv)
@@ -306,6 +428,7 @@ int main(int argc, char** argv)
     int powersave = 2;
     int gpu_device = -1;
     int cooling_down = 1;
+    int draft_count = 4;
 
     for (int i = 1; i < argc; i++)
     {
@@ -342,11 +465,16 @@ int main(int argc, char** argv)
     {
         cooling_down = atoi(argv[5]);
     }
+    if (argc >= 7)
+    {
+        draft_count = atoi(argv[6]);
+    }
 
     const bool use_vulkan_compute = gpu_device != -1;
 
     g_enable_cooling_down = cooling_down != 0;
     g_loop_count = loop_count;
+    g_draft_count = draft_count;
 
     g_blob_pool_allocator.set_size_compare_ratio(0.f);
     g_workspace_pool_allocator.set_size_compare_ratio(0.f);
@@ -396,6 +524,7 @@ int main(int argc, char** argv)
     fprintf(stderr, "powersave = %d\n", ncnn::get_cpu_powersave());
     fprintf(stderr, "gpu_device = %d\n", gpu_device);
     fprintf(stderr, "cooling_down = %d\n", (int)g_enable_cooling_down);
+    fprintf(stderr, "draft_count = %d\n", g_draft_count);
 
     const ModelConfig* models[] = {
         &hunyuan::model,
@@ -412,6 +541,21 @@ int main(int argc, char** argv)
         benchmark_model(*models[i], opt);
     }
 
+    if (g_draft_count > 0)
+    {
+        // the larger decoders verifying the drafts of the smallest one
+        const ModelConfig* targets[] = {
+            &llama32::model,
+            &tinyllama::model,
+            &youtu_llm::model,
+        };
+
+        for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++)
+        {
+            benchmark_speculative(*targets[i], qwen25::model, opt);
+        }
+    }
+
 #if NCNN_VULKAN
     delete g_blob_vkallocator;
     delete g_staging_vkallocator;
@@ -346,6 +346,307 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+struct ArenaBlock
+{
+    // aligned size
+    size_t size;
+    // event clock of malloc and free, free_time is -1 if still alive
+    int malloc_time;
+    int free_time;
+    // offset in arena, -1 if not planned
+    long offset;
+};
+
+struct ArenaBlockSizeGreater
+{
+    const std::vector<ArenaBlock>* blocks;
+
+    bool operator()(int i, int j) const
+    {
+        const ArenaBlock& a = (*blocks)[i];
+        const ArenaBlock& b = (*blocks)[j];
+        return a.size > b.size || (a.size == b.size && a.malloc_time < b.malloc_time);
+    }
+};
+
+class ArenaAllocatorPrivate
+{
+public:
+    Mutex lock;
+
+    // 0 = pass through, 1 = record, 2 = replay
+    int state;
+
+    std::vector<ArenaBlock> blocks;
+    size_t planned_size;
+
+    // record
+    int clock;
+    std::list<std::pair<void*, int> > recording;
+
+    // replay
+    unsigned char* arena;
+    size_t arena_size;
+    int replay_index;
+    int unplanned_count;
+    std::list<std::pair<void*, size_t> > payouts;
+};
+
+ArenaAllocator::ArenaAllocator()
+    : Allocator(), d(new ArenaAllocatorPrivate)
+{
+    d->state = 0;
+    d->planned_size = 0;
+    d->clock = 0;
+    d->arena = 0;
+    d->arena_size = 0;
+    d->replay_index = 0;
+    d->unplanned_count = 0;
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    if (!d->payouts.empty() || !d->recording.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! arena allocator destroyed too early");
+    }
+
+    ncnn::fastFree(d->arena);
+
+    delete d;
+}
+
+ArenaAllocator::ArenaAllocator(const ArenaAllocator&)
+    : d(0)
+{
+}
+
+ArenaAllocator& ArenaAllocator::operator=(const ArenaAllocator&)
+{
+    return *this;
+}
+
+void ArenaAllocator::begin_record()
+{
+    MutexLockGuard guard(d->lock);
+
+    d->state = 1;
+    d->blocks.clear();
+    d->planned_size = 0;
+    d->clock = 0;
+}
+
+int ArenaAllocator::end_record()
+{
+    MutexLockGuard guard(d->lock);
+
+    if (d->state != 1)
+        return -1;
+
+    if (!d->payouts.empty())
+    {
+        NCNN_LOGE("arena allocator end_record while arena memory in use");
+        return -1;
+    }
+
+    // allocations outliving the inference are not planned
+    d->recording.clear();
+
+    // greedy by size, place the largest block first at the lowest offset
+    // that does not overlap any placed block alive at the same time
+    std::vector<int> order;
+    for (int i = 0; i < (int)d->blocks.size(); i++)
+    {
+        if (d->blocks[i].free_time != -1)
+            order.push_back(i);
+    }
+
+    ArenaBlockSizeGreater comp;
+    comp.blocks = &d->blocks;
+    std::partial_sort(order.begin(), order.end(), order.end(), comp);
+
+    size_t arena_size = 0;
+    size_t planned_size = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        ArenaBlock& b = d->blocks[order[i]];
+
+        size_t offset = 0;
+        for (bool moved = true; moved;)
+        {
+            moved = false;
+            for (size_t j = 0; j < i; j++)
+            {
+                const ArenaBlock& p = d->blocks[order[j]];
+
+                // not alive at the same time
+                if (p.free_time < b.malloc_time || b.free_time < p.malloc_time)
+                    continue;
+
+                if ((size_t)p.offset < offset + b.size && offset < (size_t)p.offset + p.size)
+                {
+                    offset = (size_t)p.offset + p.size;
+                    moved = true;
+                }
+            }
+        }
+
+        b.offset = (long)offset;
+        arena_size = std::max(arena_size, offset + b.size);
+        planned_size += b.size;
+    }
+
+    if (arena_size > d->arena_size)
+    {
+        ncnn::fastFree(d->arena);
+        d->arena = (unsigned char*)ncnn::fastMalloc(arena_size);
+        if (!d->arena)
+        {
+            d->arena_size = 0;
+            d->state = 0;
+            return -100;
+        }
+
+        d->arena_size = arena_size;
+    }
+
+    d->planned_size = planned_size;
+    d->state = 2;
+    d->replay_index = 0;
+    d->unplanned_count = 0;
+
+    return 0;
+}
+
+int ArenaAllocator::begin_replay()
+{
+    MutexLockGuard guard(d->lock);
+
+    if (d->state != 2)
+        return -1;
+
+    if (!d->payouts.empty())
+        return -1;
+
+    d->replay_index = 0;
+    d->unplanned_count = 0;
+
+    return 0;
+}
+
+size_t ArenaAllocator::arena_size() const
+{
+    return d->arena_size;
+}
+
+size_t ArenaAllocator::planned_size() const
+{
+    return d->planned_size;
+}
+
+int ArenaAllocator::unplanned_count() const
+{
+    return d->unplanned_count;
+}
+
+void* ArenaAllocator::fastMalloc(size_t size)
+{
+    MutexLockGuard guard(d->lock);
+
+    const size_t aligned_size = alignSize(size, NCNN_MALLOC_ALIGN);
+
+    if (d->state == 1)
+    {
+        void* ptr = ncnn::fastMalloc(size);
+        if (!ptr)
+            return 0;
+
+        ArenaBlock b;
+        b.size = aligned_size;
+        b.malloc_time = d->clock++;
+        b.free_time = -1;
+        b.offset = -1;
+        d->blocks.push_back(b);
+
+        d->recording.push_back(std::make_pair(ptr, (int)d->blocks.size() - 1));
+        return ptr;
+    }
+
+    if (d->state == 2 && d->replay_index < (int)d->blocks.size())
+    {
+        const ArenaBlock& b = d->blocks[d->replay_index];
+        d->replay_index++;
+
+        if (b.size != aligned_size)
+        {
+            // diverged from the recorded inference, stop replaying
+            d->replay_index = (int)d->blocks.size();
+        }
+        else if (b.offset != -1)
+        {
+            unsigned char* ptr = d->arena + b.offset;
+
+            // the replay must not hand out memory that is still in use
+            bool overlap = false;
+            std::list<std::pair<void*, size_t> >::iterator it = d->payouts.begin();
+            for (; it != d->payouts.end(); ++it)
+            {
+                const unsigned char* p = (const unsigned char*)it->first;
+                if (p < ptr + b.size && ptr < p + it->second)
+                {
+                    overlap = true;
+                    break;
+                }
+            }
+
+            if (!overlap)
+            {
+                d->payouts.push_back(std::make_pair((void*)ptr, b.size));
+                return ptr;
+            }
+        }
+    }
+
+    if (d->state == 2)
+        d->unplanned_count++;
+
+    return ncnn::fastMalloc(size);
+}
+
+void ArenaAllocator::fastFree(void* ptr)
+{
+    MutexLockGuard guard(d->lock);
+
+    if ((unsigned char*)ptr >= d->arena && (unsigned char*)ptr < d->arena + d->arena_size)
+    {
+        std::list<std::pair<void*, size_t> >::iterator it = d->payouts.begin();
+        for (; it != d->payouts.end(); ++it)
+        {
+            if (it->first == ptr)
+            {
+                d->payouts.erase(it);
+                return;
+            }
+        }
+
+        NCNN_LOGE("FATAL ERROR! arena allocator get wild %p", ptr);
+        return;
+    }
+
+    std::list<std::pair<void*, int> >::iterator it = d->recording.begin();
+    for (; it != d->recording.end(); ++it)
+    {
+        if (it->first == ptr)
+        {
+            d->blocks[it->second].free_time = d->clock++;
+            d->recording.erase(it);
+            break;
+        }
+    }
+
+    ncnn::fastFree(ptr);
+}
+
 #if NCNN_VULKAN
 VkAllocator::VkAllocator(const VulkanDevice* _vkdev)
     : vkdev(_vkdev)
@@ -205,6 +205,50 @@ private:
     UnlockedPoolAllocatorPrivate* const d;
 };
 
+// static memory planner
+// record the blob allocations of one inference, then pack them into offsets of one arena
+// by their lifetimes so that allocations never alive at the same time share memory,
+// replaying the same inference serves every planned allocation from the arena without malloc
+// allocations that diverge from the recorded sequence fall back to malloc
+// allocations still alive after the recorded inference, such as the extracted outputs, are not planned
+class ArenaAllocatorPrivate;
+class NCNN_EXPORT ArenaAllocator : public Allocator
+{
+public:
+    ArenaAllocator();
+    ~ArenaAllocator();
+
+    // drop the plan and start recording allocations
+    void begin_record();
+
+    // stop recording and assign the arena offsets
+    // return 0 if success
+    int end_record();
+
+    // serve the next allocations from the start of the plan
+    // return 0 if success, -1 if memory of the last replay is still in use
+    int begin_replay();
+
+    // bytes of the arena
+    size_t arena_size() const;
+
+    // bytes of all planned allocations, the arena size without sharing
+    size_t planned_size() const;
+
+    // number of allocations served by malloc since begin_replay
+    int unplanned_count() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    ArenaAllocator(const ArenaAllocator&);
+    ArenaAllocator& operator=(const ArenaAllocator&);
+
+private:
+    ArenaAllocatorPrivate* const d;
+};
+
 #if NCNN_VULKAN
 
 class VulkanDevice;
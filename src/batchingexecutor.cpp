@@ -0,0 +1,534 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "batchingexecutor.h"
+
+#include "benchmark.h"
+#include "net.h"
+
+#include <string.h>
+
+#if !NCNN_SIMPLESTL
+#include <functional>
+#endif
+
+namespace ncnn {
+
+struct BatchingRequest
+{
+    std::vector<Mat> inputs;
+    batching_callback_func callback;
+    void* userdata;
+    double submit_time;
+};
+
+class BatchingExecutorPrivate
+{
+public:
+    BatchingExecutorPrivate();
+
+    // the requests can be stacked into one batch
+    static bool batchable(const BatchingRequest& a, const BatchingRequest& b);
+
+    // number of queued requests batchable with the oldest one
+    int queued_batch_size();
+
+    // move the oldest request and the batchable ones out of the queue
+    void take_batch(std::vector<BatchingRequest>& requests);
+
+    // run one extractor pass over requests and invoke their callbacks
+    void process(const std::vector<BatchingRequest>& requests);
+
+    void worker();
+
+    const Net* net;
+    int max_batch_size;
+    float batch_timeout;
+    std::vector<int> input_indexes;
+    std::vector<int> output_indexes;
+
+    Thread* thread;
+    bool stopping;
+    Mutex lock;
+    ConditionVariable condition;
+    std::list<BatchingRequest> queue;
+
+    // statistics
+    mutable Mutex stats_lock;
+    int request_count;
+    int batch_count;
+    int max_achieved_batch_size;
+    double latency_sum;
+    // ring of the most recent request latencies for percentiles
+    std::vector<float> latencies;
+    int latency_pos;
+};
+
+static void* batching_thread(void* args)
+{
+    BatchingExecutorPrivate* d = (BatchingExecutorPrivate*)args;
+    d->worker();
+    return 0;
+}
+
+BatchingExecutorPrivate::BatchingExecutorPrivate()
+{
+    net = 0;
+    max_batch_size = 8;
+    batch_timeout = 2.f;
+    thread = 0;
+    stopping = false;
+
+    request_count = 0;
+    batch_count = 0;
+    max_achieved_batch_size = 0;
+    latency_sum = 0.0;
+    latency_pos = 0;
+}
+
+bool BatchingExecutorPrivate::batchable(const BatchingRequest& a, const BatchingRequest& b)
+{
+    for (size_t i = 0; i < a.inputs.size(); i++)
+    {
+        const Mat& m0 = a.inputs[i];
+        const Mat& m1 = b.inputs[i];
+
+        // already batched inputs run on their own
+        if (m0.n != 1 || m1.n != 1)
+            return false;
+
+        if (m0.dims != m1.dims || m0.w != m1.w || m0.h != m1.h || m0.d != m1.d || m0.c != m1.c || m0.elemsize != m1.elemsize || m0.elempack != m1.elempack)
+            return false;
+    }
+
+    return true;
+}
+
+int BatchingExecutorPrivate::queued_batch_size()
+{
+    std::list<BatchingRequest>::iterator it = queue.begin();
+    const BatchingRequest& front = *it;
+
+    int count = 1;
+    for (++it; it != queue.end() && count < max_batch_size; ++it)
+    {
+        if (batchable(front, *it))
+            count++;
+    }
+
+    return count;
+}
+
+void BatchingExecutorPrivate::take_batch(std::vector<BatchingRequest>& requests)
+{
+    requests.push_back(*queue.begin());
+    queue.pop_front();
+
+    std::list<BatchingRequest>::iterator it = queue.begin();
+    while (it != queue.end() && (int)requests.size() < max_batch_size)
+    {
+        if (batchable(requests[0], *it))
+        {
+            requests.push_back(*it);
+            it = queue.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void BatchingExecutorPrivate::process(const std::vector<BatchingRequest>& requests)
+{
+    const int batch = (int)requests.size();
+
+    std::vector<std::vector<Mat> > outputs(batch);
+    for (int b = 0; b < batch; b++)
+    {
+        outputs[b].resize(output_indexes.size());
+    }
+
+    int ret = 0;
+    {
+        Extractor ex = net->create_extractor();
+
+        for (size_t i = 0; i < input_indexes.size() && ret == 0; i++)
+        {
+            const Mat& m0 = requests[0].inputs[i];
+
+            if (batch == 1)
+            {
+                ret = ex.input(input_indexes[i], m0);
+                continue;
+            }
+
+            // stack the request inputs along n
+            Mat in;
+            if (m0.dims == 1)
+                in.create_batch(m0.w, batch, m0.elemsize, m0.elempack);
+            if (m0.dims == 2)
+                in.create_batch(m0.w, m0.h, batch, m0.elemsize, m0.elempack);
+            if (m0.dims == 3)
+                in.create_batch(m0.w, m0.h, m0.c, batch, m0.elemsize, m0.elempack);
+            if (m0.dims == 4)
+                in.create_batch(m0.w, m0.h, m0.d, m0.c, batch, m0.elemsize, m0.elempack);
+            if (in.empty())
+            {
+                ret = -100;
+                break;
+            }
+
+            for (int b = 0; b < batch; b++)
+            {
+                const Mat& m = requests[b].inputs[i];
+                Mat slot = in.batch(b);
+
+                const size_t size = (size_t)m.w * m.h * m.d * m.elemsize;
+                for (int q = 0; q < m.c; q++)
+                {
+                    memcpy(slot.channel(q), m.channel(q), size);
+                }
+            }
+
+            ret = ex.input(input_indexes[i], in);
+        }
+
+        for (size_t j = 0; j < output_indexes.size() && ret == 0; j++)
+        {
+            Mat out;
+            ret = ex.extract(output_indexes[j], out);
+            if (ret != 0)
+                break;
+
+            if (batch == 1 || out.n != batch)
+            {
+                // not batched, shared by all requests
+                for (int b = 0; b < batch; b++)
+                {
+                    outputs[b][j] = out;
+                }
+                continue;
+            }
+
+            // the batch views do not own the data, give each request its own copy
+            for (int b = 0; b < batch; b++)
+            {
+                outputs[b][j] = out.batch(b).clone();
+                if (outputs[b][j].empty())
+                {
+                    ret = -100;
+                    break;
+                }
+            }
+        }
+    }
+
+    const double end = get_current_time();
+
+    {
+        MutexLockGuard guard(stats_lock);
+
+        batch_count += 1;
+        max_achieved_batch_size = std::max(max_achieved_batch_size, batch);
+
+        for (int b = 0; b < batch; b++)
+        {
+            const float latency = (float)(end - requests[b].submit_time);
+
+            request_count += 1;
+            latency_sum += latency;
+
+            if ((int)latencies.size() < 1024)
+            {
+                latencies.push_back(latency);
+            }
+            else
+            {
+                latencies[latency_pos] = latency;
+                latency_pos = (latency_pos + 1) % 1024;
+            }
+        }
+    }
+
+    for (int b = 0; b < batch; b++)
+    {
+        requests[b].callback(ret, outputs[b], requests[b].userdata);
+    }
+}
+
+void BatchingExecutorPrivate::worker()
+{
+    lock.lock();
+
+    for (;;)
+    {
+        while (queue.empty() && !stopping)
+        {
+            condition.wait(lock);
+        }
+
+        if (queue.empty())
+            break;
+
+        // give the oldest request a chance to pick up more requests to batch with
+        const double deadline = (*queue.begin()).submit_time + batch_timeout;
+        while (!stopping && queued_batch_size() < max_batch_size)
+        {
+            const double remain = deadline - get_current_time();
+            if (remain <= 0)
+                break;
+
+            condition.wait(lock, (unsigned int)(remain * 1000) + 1);
+        }
+
+        std::vector<BatchingRequest> requests;
+        take_batch(requests);
+
+        lock.unlock();
+
+        process(requests);
+
+        lock.lock();
+    }
+
+    lock.unlock();
+}
+
+BatchingExecutor::BatchingExecutor(const Net* net)
+    : d(new BatchingExecutorPrivate)
+{
+    d->net = net;
+}
+
+BatchingExecutor::~BatchingExecutor()
+{
+    stop();
+
+    delete d;
+}
+
+BatchingExecutor::BatchingExecutor(const BatchingExecutor&)
+    : d(0)
+{
+}
+
+BatchingExecutor& BatchingExecutor::operator=(const BatchingExecutor&)
+{
+    return *this;
+}
+
+void BatchingExecutor::set_max_batch_size(int max_batch_size)
+{
+    d->max_batch_size = std::max(max_batch_size, 1);
+}
+
+void BatchingExecutor::set_batch_timeout(float milliseconds)
+{
+    d->batch_timeout = std::max(milliseconds, 0.f);
+}
+
+void BatchingExecutor::set_input_indexes(const std::vector<int>& input_indexes)
+{
+    d->input_indexes = input_indexes;
+}
+
+void BatchingExecutor::set_output_indexes(const std::vector<int>& output_indexes)
+{
+    d->output_indexes = output_indexes;
+}
+
+#if NCNN_STRING
+static int find_blob_indexes(const Net* net, const std::vector<const char*>& names, std::vector<int>& indexes)
+{
+    const std::vector<Blob>& blobs = net->blobs();
+
+    indexes.resize(names.size());
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        indexes[i] = -1;
+        for (size_t j = 0; j < blobs.size(); j++)
+        {
+            if (strcmp(blobs[j].name.c_str(), names[i]) == 0)
+            {
+                indexes[i] = (int)j;
+                break;
+            }
+        }
+
+        if (indexes[i] == -1)
+        {
+            NCNN_LOGE("BatchingExecutor blob %s not found", names[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int BatchingExecutor::set_input_names(const std::vector<const char*>& input_names)
+{
+    return find_blob_indexes(d->net, input_names, d->input_indexes);
+}
+
+int BatchingExecutor::set_output_names(const std::vector<const char*>& output_names)
+{
+    return find_blob_indexes(d->net, output_names, d->output_indexes);
+}
+#endif // NCNN_STRING
+
+int BatchingExecutor::start()
+{
+    if (d->thread)
+        return 0;
+
+    if (d->input_indexes.empty())
+        d->input_indexes = d->net->input_indexes();
+    if (d->output_indexes.empty())
+        d->output_indexes = d->net->output_indexes();
+
+    if (d->input_indexes.empty() || d->output_indexes.empty())
+    {
+        NCNN_LOGE("BatchingExecutor net has no input or output");
+        return -1;
+    }
+
+#if NCNN_THREADS
+    d->stopping = false;
+    d->thread = new Thread(batching_thread, (void*)d);
+#endif // NCNN_THREADS
+
+    return 0;
+}
+
+void BatchingExecutor::stop()
+{
+    if (!d->thread)
+        return;
+
+    d->lock.lock();
+    d->stopping = true;
+    d->condition.signal();
+    d->lock.unlock();
+
+    d->thread->join();
+    delete d->thread;
+    d->thread = 0;
+}
+
+int BatchingExecutor::submit(const std::vector<Mat>& inputs, batching_callback_func callback, void* userdata)
+{
+    if (inputs.size() != d->input_indexes.size())
+    {
+        NCNN_LOGE("BatchingExecutor expect %d inputs but got %d", (int)d->input_indexes.size(), (int)inputs.size());
+        return -1;
+    }
+
+    BatchingRequest request;
+    request.inputs = inputs;
+    request.callback = callback;
+    request.userdata = userdata;
+    request.submit_time = get_current_time();
+
+#if NCNN_THREADS
+    if (!d->thread)
+    {
+        NCNN_LOGE("BatchingExecutor is not started");
+        return -1;
+    }
+
+    d->lock.lock();
+    d->queue.push_back(request);
+    d->condition.signal();
+    d->lock.unlock();
+#else
+    std::vector<BatchingRequest> requests(1, request);
+    d->process(requests);
+#endif // NCNN_THREADS
+
+    return 0;
+}
+
+struct BatchingWaiter
+{
+    Mutex lock;
+    ConditionVariable condition;
+    bool done;
+    int ret;
+    std::vector<Mat>* outputs;
+};
+
+static void batching_waiter_callback(int ret, const std::vector<Mat>& outputs, void* userdata)
+{
+    BatchingWaiter* waiter = (BatchingWaiter*)userdata;
+
+    MutexLockGuard guard(waiter->lock);
+    *waiter->outputs = outputs;
+    waiter->ret = ret;
+    waiter->done = true;
+    waiter->condition.signal();
+}
+
+int BatchingExecutor::run(const std::vector<Mat>& inputs, std::vector<Mat>& outputs)
+{
+    BatchingWaiter waiter;
+    waiter.done = false;
+    waiter.ret = 0;
+    waiter.outputs = &outputs;
+
+    int ret = submit(inputs, batching_waiter_callback, &waiter);
+    if (ret != 0)
+        return ret;
+
+    waiter.lock.lock();
+    while (!waiter.done)
+    {
+        waiter.condition.wait(waiter.lock);
+    }
+    waiter.lock.unlock();
+
+    return waiter.ret;
+}
+
+BatchingStats BatchingExecutor::stats() const
+{
+    MutexLockGuard guard(d->stats_lock);
+
+    BatchingStats s;
+    s.request_count = d->request_count;
+    s.batch_count = d->batch_count;
+    s.avg_batch_size = d->batch_count ? (float)d->request_count / d->batch_count : 0.f;
+    s.max_batch_size = d->max_achieved_batch_size;
+    s.latency_avg = d->request_count ? (float)(d->latency_sum / d->request_count) : 0.f;
+    s.latency_p50 = 0.f;
+    s.latency_p99 = 0.f;
+
+    if (!d->latencies.empty())
+    {
+        std::vector<float> sorted = d->latencies;
+        const int count = (int)sorted.size();
+        const int p50 = (count - 1) * 50 / 100;
+        const int p99 = (count - 1) * 99 / 100;
+
+        std::partial_sort(sorted.begin(), sorted.begin() + p99 + 1, sorted.end(), std::less<float>());
+
+        s.latency_p50 = sorted[p50];
+        s.latency_p99 = sorted[p99];
+    }
+
+    return s;
+}
+
+void BatchingExecutor::reset_stats()
+{
+    MutexLockGuard guard(d->stats_lock);
+
+    d->request_count = 0;
+    d->batch_count = 0;
+    d->max_achieved_batch_size = 0;
+    d->latency_sum = 0.0;
+    d->latencies.clear();
+    d->latency_pos = 0;
+}
+
+} // namespace ncnn
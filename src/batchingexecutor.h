@@ -0,0 +1,99 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_BATCHINGEXECUTOR_H
+#define NCNN_BATCHINGEXECUTOR_H
+
+#include "mat.h"
+#include "platform.h"
+
+namespace ncnn {
+
+class Net;
+
+// request latency and batching statistics since start or the last reset_stats()
+struct BatchingStats
+{
+    // number of finished requests
+    int request_count;
+    // number of extractor passes
+    int batch_count;
+    // achieved batch size
+    float avg_batch_size;
+    int max_batch_size;
+    // latency from submit to result in ms, over the most recent requests
+    float latency_avg;
+    float latency_p50;
+    float latency_p99;
+};
+
+// called on the batching thread when the request is done
+// ret is the extract result, outputs follow the output blob order
+typedef void (*batching_callback_func)(int ret, const std::vector<Mat>& outputs, void* userdata);
+
+// coalesce inference requests from many threads into batched extractor passes
+// requests with the same input shapes that arrive within the batch timeout
+// are stacked into n-batched input mats and run through one extractor,
+// the batched outputs are then split back to each request
+//
+// the net must be loaded before start() and outlive the executor
+class BatchingExecutorPrivate;
+class NCNN_EXPORT BatchingExecutor
+{
+public:
+    // serve requests with net
+    BatchingExecutor(const Net* net);
+    // stop and destroy
+    virtual ~BatchingExecutor();
+
+    // max number of requests in one batch
+    // default is 8
+    void set_max_batch_size(int max_batch_size);
+
+    // how long the oldest queued request waits for more requests to batch with, in ms
+    // default is 2
+    void set_batch_timeout(float milliseconds);
+
+    // blobs fed and extracted for each request
+    // default to the net inputs and outputs
+    void set_input_indexes(const std::vector<int>& input_indexes);
+    void set_output_indexes(const std::vector<int>& output_indexes);
+
+#if NCNN_STRING
+    // set blobs by name
+    // return 0 if success
+    int set_input_names(const std::vector<const char*>& input_names);
+    int set_output_names(const std::vector<const char*>& output_names);
+#endif // NCNN_STRING
+
+    // launch the batching thread
+    // return 0 if success
+    int start();
+
+    // finish the queued requests and join the batching thread
+    void stop();
+
+    // queue a request, callback is invoked with the outputs once its batch is done
+    // without NCNN_THREADS the request runs immediately on the calling thread
+    // return 0 if queued
+    int submit(const std::vector<Mat>& inputs, batching_callback_func callback, void* userdata = 0);
+
+    // queue a request and wait for its outputs
+    // return the extract result
+    int run(const std::vector<Mat>& inputs, std::vector<Mat>& outputs);
+
+    // latency and batch size statistics
+    BatchingStats stats() const;
+    void reset_stats();
+
+private:
+    BatchingExecutor(const BatchingExecutor&);
+    BatchingExecutor& operator=(const BatchingExecutor&);
+
+private:
+    BatchingExecutorPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_BATCHINGEXECUTOR_H
@@ -3029,7 +3029,19 @@ int set_cpu_thread_affinity(const CpuSet& thread_affinity_mask)
 {
     try_initialize_global_cpu_info();
 #if defined __ANDROID__ || defined __linux__ || defined _WIN32
-#ifdef _OPENMP
+#if NCNN_SIMPLEOMP && (defined __ANDROID__ || defined __linux__)
+    int num_threads = thread_affinity_mask.num_enabled();
+
+    set_omp_num_threads(num_threads);
+
+    // any simpleomp worker may serve a team slot, set affinity for all of them
+    int ssaret = set_sched_affinity(thread_affinity_mask);
+    if (ssaret != 0)
+        return -1;
+
+    if (set_simpleomp_worker_affinity(thread_affinity_mask) != 0)
+        return -1;
+#elif defined _OPENMP
     int num_threads = thread_affinity_mask.num_enabled();
 
     // set affinity for each thread
@@ -3201,7 +3213,10 @@ void set_omp_dynamic(int dynamic)
 
 int get_omp_thread_num()
 {
-#ifdef _OPENMP
+#if NCNN_SIMPLEOMP
+    // omp_get_thread_num() is the loop chunk under the dynamic schedule
+    return kmp_get_team_thread_num();
+#elif defined _OPENMP
     return omp_get_thread_num();
 #else
     return 0;
@@ -3210,7 +3225,7 @@ int get_omp_thread_num()
 
 int get_kmp_blocktime()
 {
-#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME))
+#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME) || NCNN_SIMPLEOMP)
     return kmp_get_blocktime();
 #else
     return 0;
@@ -3219,13 +3234,34 @@ int get_kmp_blocktime()
 
 void set_kmp_blocktime(int time_ms)
 {
-#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME))
+#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME) || NCNN_SIMPLEOMP)
     kmp_set_blocktime(time_ms);
 #else
     (void)time_ms;
 #endif
 }
 
+int get_omp_schedule()
+{
+#if NCNN_SIMPLEOMP
+    omp_sched_t kind;
+    int chunk_size;
+    omp_get_schedule(&kind, &chunk_size);
+    return kind == omp_sched_dynamic ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
+void set_omp_schedule(int schedule)
+{
+#if NCNN_SIMPLEOMP
+    omp_set_schedule(schedule == 1 ? omp_sched_dynamic : omp_sched_static, 0);
+#else
+    (void)schedule;
+#endif
+}
+
 static ncnn::ThreadLocalStorage tls_flush_denormals;
 
 int get_flush_denormals()
@@ -163,6 +163,12 @@ NCNN_EXPORT int get_omp_thread_num();
 NCNN_EXPORT int get_kmp_blocktime();
 NCNN_EXPORT void set_kmp_blocktime(int time_ms);
 
+// 0 = static loop schedule
+// 1 = dynamic loop schedule, idle threads take the remaining chunks of the loop
+// only takes effect with simpleomp, the other openmp runtimes keep the static schedule
+NCNN_EXPORT int get_omp_schedule();
+NCNN_EXPORT void set_omp_schedule(int schedule);
+
 // need to flush denormals on Intel Chipset.
 // Other architectures such as ARM can be added as needed.
 // 0 = DAZ OFF, FTZ OFF
@@ -0,0 +1,252 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "kvcache.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+class KVCachePrivate
+{
+public:
+    KVCachePrivate();
+
+    // copy blob into new storage that holds capacity tokens along h
+    int grow_h(const Mat& blob, Mat& view) const;
+
+    // keep the first seqlen columns
+    int truncate_w(const Mat& blob, int seqlen, Mat& out) const;
+
+    int capacity;
+    int block_size;
+    int seqlen;
+
+    std::vector<int> token_axes;
+    std::vector<Mat> keys;
+    std::vector<Mat> values;
+};
+
+KVCachePrivate::KVCachePrivate()
+{
+    capacity = 0;
+    block_size = 256;
+    seqlen = 0;
+}
+
+int KVCachePrivate::grow_h(const Mat& blob, Mat& view) const
+{
+    const int w = blob.w;
+    const int h = blob.h;
+    const int channels = blob.c;
+    const size_t elemsize = blob.elemsize;
+    const int elempack = blob.elempack;
+
+    // always leave room for the next block so that decoding appends in place
+    const int cap = std::max(capacity, (h / block_size + 1) * block_size);
+
+    Mat storage;
+    if (blob.dims == 2)
+        storage.create(w, cap, elemsize, elempack);
+    else
+        storage.create(w, cap, channels, elemsize, elempack);
+    if (storage.empty())
+        return -100;
+
+    for (int q = 0; q < channels; q++)
+    {
+        memcpy(storage.channel(q), blob.channel(q), (size_t)w * h * elemsize);
+    }
+
+    view = storage;
+    view.h = h;
+
+    return 0;
+}
+
+int KVCachePrivate::truncate_w(const Mat& blob, int _seqlen, Mat& out) const
+{
+    const int h = blob.h;
+    const size_t elemsize = blob.elemsize;
+
+    out.create(_seqlen, h, elemsize, blob.elempack);
+    if (out.empty())
+        return -100;
+
+    for (int i = 0; i < h; i++)
+    {
+        memcpy(out.row<unsigned char>(i), blob.row<const unsigned char>(i), _seqlen * elemsize);
+    }
+
+    return 0;
+}
+
+KVCache::KVCache()
+    : d(new KVCachePrivate)
+{
+}
+
+KVCache::~KVCache()
+{
+    clear();
+
+    delete d;
+}
+
+KVCache::KVCache(const KVCache&)
+    : d(0)
+{
+}
+
+KVCache& KVCache::operator=(const KVCache&)
+{
+    return *this;
+}
+
+void KVCache::reserve(int capacity)
+{
+    d->capacity = capacity;
+}
+
+void KVCache::set_block_size(int block_size)
+{
+    d->block_size = std::max(block_size, 1);
+}
+
+int KVCache::seqlen() const
+{
+    return d->seqlen;
+}
+
+int KVCache::capacity() const
+{
+    int cap = d->capacity;
+    for (size_t i = 0; i < d->token_axes.size(); i++)
+    {
+        const Mat& key = d->keys[i];
+        if (d->token_axes[i] == 1 && !key.empty())
+        {
+            // the storage behind the view spans cstep elements per channel
+            cap = std::max(cap, (int)(key.cstep / key.w));
+        }
+    }
+
+    return cap;
+}
+
+void KVCache::truncate(int seqlen)
+{
+    if (seqlen >= d->seqlen)
+        return;
+
+    for (size_t i = 0; i < d->token_axes.size(); i++)
+    {
+        const int axis = d->token_axes[i];
+
+        if (seqlen == 0 && axis != 0)
+        {
+            d->keys[i].release();
+            d->values[i].release();
+            continue;
+        }
+
+        if (axis == 1)
+        {
+            // shrink the view, the rows beyond are overwritten by the next append
+            d->keys[i].h = std::min(d->keys[i].h, seqlen);
+            d->values[i].h = std::min(d->values[i].h, seqlen);
+        }
+        if (axis == 2 && d->keys[i].w > seqlen)
+        {
+            Mat key;
+            Mat value;
+            d->truncate_w(d->keys[i], seqlen, key);
+            d->truncate_w(d->values[i], seqlen, value);
+            d->keys[i] = key;
+            d->values[i] = value;
+        }
+    }
+
+    d->seqlen = seqlen;
+}
+
+void KVCache::clear()
+{
+    d->seqlen = 0;
+    d->token_axes.clear();
+    d->keys.clear();
+    d->values.clear();
+}
+
+void KVCache::bind(const std::vector<int>& token_axes)
+{
+    if (d->token_axes == token_axes)
+        return;
+
+    // a different network, start over
+    d->seqlen = 0;
+    d->token_axes = token_axes;
+    d->keys.clear();
+    d->values.clear();
+    d->keys.resize(token_axes.size());
+    d->values.resize(token_axes.size());
+}
+
+const Mat& KVCache::past_key(int slot) const
+{
+    return d->keys[slot];
+}
+
+const Mat& KVCache::past_value(int slot) const
+{
+    return d->values[slot];
+}
+
+int KVCache::update(int slot, const Mat& key, const Mat& value)
+{
+    const int axis = d->token_axes[slot];
+
+    if (axis == 1)
+    {
+        Mat& past_key = d->keys[slot];
+        Mat& past_value = d->values[slot];
+
+        // appended in place, the layer output is a longer view of our storage
+        if (key.data == past_key.data && key.cstep == past_key.cstep)
+        {
+            past_key = key;
+        }
+        else
+        {
+            int ret = d->grow_h(key, past_key);
+            if (ret != 0)
+                return ret;
+        }
+
+        if (value.data == past_value.data && value.cstep == past_value.cstep)
+        {
+            past_value = value;
+        }
+        else
+        {
+            int ret = d->grow_h(value, past_value);
+            if (ret != 0)
+                return ret;
+        }
+
+        d->seqlen = key.h;
+        return 0;
+    }
+
+    d->keys[slot] = key;
+    d->values[slot] = value;
+
+    if (axis == 2)
+    {
+        d->seqlen = key.w;
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
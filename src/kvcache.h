@@ -0,0 +1,77 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_KVCACHE_H
+#define NCNN_KVCACHE_H
+
+#include "platform.h"
+#include "mat.h"
+
+namespace ncnn {
+
+// past key/value blobs of SDPA and MultiHeadAttention layers with kv_cache enabled
+// attach it to an extractor with Extractor::set_kv_cache()
+// the extractor feeds the cached blobs into the attention layers and keeps their updated cache outputs
+//
+// SDPA caches live in storage with reserved capacity along seqlen,
+// new key/value rows are appended in place instead of copying the whole past on every decoded token
+// the storage grows by block_size tokens when the reserved capacity runs out
+class KVCachePrivate;
+class NCNN_EXPORT KVCache
+{
+public:
+    // empty cache
+    KVCache();
+    // destructor
+    virtual ~KVCache();
+
+    // reserve storage for capacity tokens
+    // applied when the storage is allocated, call it before the first prefill
+    void reserve(int capacity);
+
+    // storage grows by block_size tokens when the capacity is exhausted
+    // default is 256
+    void set_block_size(int block_size);
+
+    // number of cached tokens
+    int seqlen() const;
+
+    // number of tokens the current storage can hold without reallocation
+    int capacity() const;
+
+    // drop the cached tokens beyond seqlen, for rejecting draft tokens or restarting a decode step
+    // the storage is kept and the next step appends from seqlen
+    void truncate(int seqlen);
+
+    // release all cached blobs and storage
+    void clear();
+
+protected:
+    friend class Extractor;
+    friend class ExtractorPrivate;
+
+    // token axis of each attention layer slot
+    // 0 = fixed cache, fed back as is (cross attention)
+    // 1 = cache grows along h (SDPA)
+    // 2 = cache grows along w (MultiHeadAttention self attention)
+    void bind(const std::vector<int>& token_axes);
+
+    // cached past key/value of slot, empty when nothing is cached
+    const Mat& past_key(int slot) const;
+    const Mat& past_value(int slot) const;
+
+    // store the key/value cache outputs of slot
+    // return 0 if success
+    int update(int slot, const Mat& key, const Mat& value);
+
+private:
+    KVCache(const KVCache&);
+    KVCache& operator=(const KVCache&);
+
+private:
+    KVCachePrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_KVCACHE_H
@@ -101,6 +101,107 @@ int Layer::forward_inplace(Mat& /*bottom_top_blob*/, const Option& /*opt*/) cons
     return -1;
 }
 
+int Layer::forward_batch_items(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    int batch = 1;
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        if (bottom_blobs[i].n > 1)
+        {
+            batch = bottom_blobs[i].n;
+            break;
+        }
+    }
+
+    std::vector<Mat> bottom_blobs_b(bottom_blobs.size());
+    std::vector<Mat> top_blobs_b(top_blobs.size());
+    for (int b = 0; b < batch; b++)
+    {
+        for (size_t i = 0; i < bottom_blobs.size(); i++)
+        {
+            bottom_blobs_b[i] = bottom_blobs[i].n > 1 ? bottom_blobs[i].batch(b) : bottom_blobs[i];
+        }
+
+        // the layer allocates into the batch slot of the same shape, no copy needed then
+        for (size_t i = 0; i < top_blobs.size(); i++)
+        {
+            top_blobs_b[i] = b == 0 ? Mat() : top_blobs[i].batch(b);
+        }
+
+        int ret = forward(bottom_blobs_b, top_blobs_b, opt);
+        if (ret != 0)
+            return ret;
+
+        for (size_t i = 0; i < top_blobs.size(); i++)
+        {
+            const Mat& top_blob_b = top_blobs_b[i];
+
+            if (b == 0)
+            {
+                top_blobs[i].create_like_batch(top_blob_b, batch, opt.blob_allocator);
+                if (top_blobs[i].empty())
+                    return -100;
+            }
+
+            Mat top_slot = top_blobs[i].batch(b);
+            if (top_blob_b.data != top_slot.data)
+            {
+                memcpy(top_slot, top_blob_b, top_blob_b.total() * top_blob_b.elemsize);
+            }
+        }
+    }
+
+    return 0;
+}
+
+int Layer::forward_batch_items(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int batch = bottom_blob.n;
+
+    for (int b = 0; b < batch; b++)
+    {
+        const Mat bottom_blob_b = bottom_blob.batch(b);
+
+        // the layer allocates into the batch slot of the same shape, no copy needed then
+        Mat top_blob_b = b == 0 ? Mat() : top_blob.batch(b);
+
+        int ret = forward(bottom_blob_b, top_blob_b, opt);
+        if (ret != 0)
+            return ret;
+
+        if (b == 0)
+        {
+            top_blob.create_like_batch(top_blob_b, batch, opt.blob_allocator);
+            if (top_blob.empty())
+                return -100;
+        }
+
+        Mat top_slot = top_blob.batch(b);
+        if (top_blob_b.data != top_slot.data)
+        {
+            memcpy(top_slot, top_blob_b, top_blob_b.total() * top_blob_b.elemsize);
+        }
+    }
+
+    return 0;
+}
+
+int Layer::forward_inplace_batch_items(Mat& bottom_top_blob, const Option& opt) const
+{
+    const int batch = bottom_top_blob.n;
+
+    for (int b = 0; b < batch; b++)
+    {
+        Mat bottom_top_blob_b = bottom_top_blob.batch(b);
+
+        int ret = forward_inplace(bottom_top_blob_b, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 int Layer::upload_model(VkTransfer& /*cmd*/, const Option& /*opt*/)
 {
@@ -100,6 +100,15 @@ public:
     virtual int forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt) const;
     virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
 
+protected:
+    // forward the batched input (n > 1) one batch item at a time
+    // for layers with support_batch on the inputs they cannot handle as a whole batch
+    // the batch items are written straight into the batched top blob where possible
+    // return 0 if success
+    int forward_batch_items(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+    int forward_batch_items(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+    int forward_inplace_batch_items(Mat& bottom_top_blob, const Option& opt) const;
+
 #if NCNN_VULKAN
 public:
     // upload weight blob from host to device
@@ -3,7 +3,7 @@
 
 #include "argmax.h"
 
-#include <functional>
+#include "topk_select.h"
 
 namespace ncnn {
 
@@ -16,53 +16,156 @@ int ArgMax::load_param(const ParamDict& pd)
 {
     out_max_val = pd.get(0, 0);
     topk = pd.get(1, 1);
+    axis = pd.get(2, -233);
 
     return 0;
 }
 
 int ArgMax::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
-    int size = bottom_blob.total();
+    if (axis == -233)
+    {
+        // flatten without the channel gaps and the row alignment tail
+        Mat bottom_blob_flattened = bottom_blob.reshape(bottom_blob.w * bottom_blob.h * bottom_blob.d * bottom_blob.c, opt.workspace_allocator);
+        if (bottom_blob_flattened.empty())
+            return -100;
 
-    if (out_max_val)
-        top_blob.create(topk, 2, 4u, opt.blob_allocator);
-    else
-        top_blob.create(topk, 1, 4u, opt.blob_allocator);
-    if (top_blob.empty())
-        return -100;
+        int size = bottom_blob_flattened.w;
+
+        if (out_max_val)
+            top_blob.create(topk, 2, 4u, opt.blob_allocator);
+        else
+            top_blob.create(topk, 1, 4u, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const float* ptr = bottom_blob_flattened;
 
-    const float* ptr = bottom_blob;
+        // select topk with index
+        // optional value
+        std::vector<int> indices(topk);
+        const int k = topk_select(ptr, 0, size, topk, indices.data());
 
-    // partial sort topk with index
-    // optional value
-    std::vector<std::pair<float, int> > vec;
-    vec.resize(size);
-    for (int i = 0; i < size; i++)
+        float* outptr = top_blob;
+
+        if (out_max_val)
+        {
+            float* valptr = outptr + topk;
+            for (int i = 0; i < k; i++)
+            {
+                outptr[i] = ptr[indices[i]];
+                valptr[i] = indices[i];
+            }
+        }
+        else
+        {
+            for (int i = 0; i < k; i++)
+            {
+                outptr[i] = indices[i];
+            }
+        }
+
+        return 0;
+    }
+
+    // select along one axis, the axis extent becomes k, or 2k with the values followed by the indices
+    const int dims = bottom_blob.dims;
+    const int positive_axis = axis < 0 ? dims + axis : axis;
+    if (positive_axis < 0 || positive_axis >= dims)
+        return -100;
+
+    // shape in axis order, outermost first
+    int shape[4];
+    if (dims == 1)
+    {
+        shape[0] = bottom_blob.w;
+    }
+    if (dims == 2)
+    {
+        shape[0] = bottom_blob.h;
+        shape[1] = bottom_blob.w;
+    }
+    if (dims == 3)
     {
-        vec[i] = std::make_pair(ptr[i], i);
+        shape[0] = bottom_blob.c;
+        shape[1] = bottom_blob.h;
+        shape[2] = bottom_blob.w;
     }
+    if (dims == 4)
+    {
+        shape[0] = bottom_blob.c;
+        shape[1] = bottom_blob.d;
+        shape[2] = bottom_blob.h;
+        shape[3] = bottom_blob.w;
+    }
+
+    int outer = 1;
+    int inner = 1;
+    for (int i = 0; i < positive_axis; i++)
+        outer *= shape[i];
+    for (int i = positive_axis + 1; i < dims; i++)
+        inner *= shape[i];
+
+    const int len = shape[positive_axis];
+    const int k = std::min(topk, len);
+    const int outlen = out_max_val ? k * 2 : k;
+
+    Mat bottom_blob_flattened = bottom_blob.reshape(outer * len * inner, opt.workspace_allocator);
+    if (bottom_blob_flattened.empty())
+        return -100;
 
-    std::partial_sort(vec.begin(), vec.begin() + topk, vec.end(),
-                      std::greater<std::pair<float, int> >());
+    Mat top_blob_flattened(outer * outlen * inner, 4u, opt.blob_allocator);
+    if (top_blob_flattened.empty())
+        return -100;
 
-    float* outptr = top_blob;
-    if (out_max_val)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int oi = 0; oi < outer * inner; oi++)
     {
-        float* valptr = outptr + topk;
-        for (int i = 0; i < topk; i++)
+        const int o = oi / inner;
+        const int i = oi % inner;
+
+        const float* ptr = (const float*)bottom_blob_flattened + o * len * inner + i;
+        float* outptr = (float*)top_blob_flattened + o * outlen * inner + i;
+
+        std::vector<float> row(len);
+        for (int j = 0; j < len; j++)
         {
-            outptr[i] = vec[i].first;
-            valptr[i] = vec[i].second;
+            row[j] = ptr[j * inner];
         }
-    }
-    else
-    {
-        for (int i = 0; i < topk; i++)
+
+        std::vector<int> indices(k);
+        topk_select(row.data(), 0, len, k, indices.data());
+
+        if (out_max_val)
+        {
+            for (int j = 0; j < k; j++)
+            {
+                outptr[j * inner] = row[indices[j]];
+                outptr[(k + j) * inner] = indices[j];
+            }
+        }
+        else
         {
-            outptr[i] = vec[i].second;
+            for (int j = 0; j < k; j++)
+            {
+                outptr[j * inner] = indices[j];
+            }
         }
     }
 
+    shape[positive_axis] = outlen;
+
+    if (dims == 1)
+        top_blob = top_blob_flattened.reshape(shape[0], opt.blob_allocator);
+    if (dims == 2)
+        top_blob = top_blob_flattened.reshape(shape[1], shape[0], opt.blob_allocator);
+    if (dims == 3)
+        top_blob = top_blob_flattened.reshape(shape[2], shape[1], shape[0], opt.blob_allocator);
+    if (dims == 4)
+        top_blob = top_blob_flattened.reshape(shape[3], shape[2], shape[1], shape[0], opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
     return 0;
 }
 
@@ -20,6 +20,9 @@ public:
 public:
     int out_max_val;
     int topk;
+
+    // -233 selects over the whole blob
+    int axis;
 };
 
 } // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_ARGMAX_ARM_H
+#define LAYER_ARGMAX_ARM_H
+
+#include "argmax.h"
+
+namespace ncnn {
+
+class ArgMax_arm : public ArgMax
+{
+public:
+    ArgMax_arm();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_ARGMAX_ARM_H
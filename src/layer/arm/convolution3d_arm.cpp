@@ -0,0 +1,286 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolution3d_arm.h"
+
+#include "layer_type.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+Convolution3D_arm::Convolution3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+
+    convolution = 0;
+}
+
+int Convolution3D_arm::create_pipeline(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h;
+    const int num_input = weight_data_size / maxk / kernel_d / num_output;
+
+    // the depth padding is resolved in forward
+    int pad_left_2d = 0;
+    int pad_right_2d = 0;
+    int pad_top_2d = 0;
+    int pad_bottom_2d = 0;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0)
+    {
+        pad_left_2d = pad_left;
+        pad_right_2d = pad_right;
+        pad_top_2d = pad_top;
+        pad_bottom_2d = pad_bottom;
+    }
+    else if ((pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233 && pad_front == -233 && pad_behind == -233)
+             || (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234 && pad_front == -234 && pad_behind == -234))
+    {
+        pad_left_2d = pad_left;
+        pad_right_2d = pad_right;
+        pad_top_2d = pad_top;
+        pad_bottom_2d = pad_bottom;
+    }
+
+    convolution = ncnn::create_layer_cpu(ncnn::LayerType::Convolution);
+
+    ncnn::ParamDict pd;
+    pd.set(0, num_output);
+    pd.set(1, kernel_w);
+    pd.set(11, kernel_h);
+    pd.set(2, dilation_w);
+    pd.set(12, dilation_h);
+    pd.set(3, stride_w);
+    pd.set(13, stride_h);
+    pd.set(4, pad_left_2d);
+    pd.set(15, pad_right_2d);
+    pd.set(14, pad_top_2d);
+    pd.set(16, pad_bottom_2d);
+    pd.set(18, pad_value);
+    pd.set(5, bias_term);
+    pd.set(6, weight_data_size);
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    convolution->load_param(pd);
+
+    // maxk-kd-inch-outch to maxk-inch-kd-outch
+    // the stacked input channel k * inch + q keeps the packed channels of one depth slice together
+    Mat weight_data_2d(weight_data_size);
+    {
+        const float* kptr = weight_data;
+        float* ptr = weight_data_2d;
+
+        for (int p = 0; p < num_output; p++)
+        {
+            for (int k = 0; k < kernel_d; k++)
+            {
+                for (int q = 0; q < num_input; q++)
+                {
+                    const float* k0 = kptr + ((p * num_input + q) * kernel_d + k) * maxk;
+
+                    for (int i = 0; i < maxk; i++)
+                    {
+                        ptr[i] = k0[i];
+                    }
+
+                    ptr += maxk;
+                }
+            }
+        }
+    }
+
+    ncnn::Mat weights[2];
+    weights[0] = weight_data_2d;
+    weights[1] = bias_data;
+
+    convolution->load_model(ModelBinFromMatArray(weights));
+
+    convolution->create_pipeline(opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Convolution3D_arm::destroy_pipeline(const Option& opt)
+{
+    if (convolution)
+    {
+        convolution->destroy_pipeline(opt);
+        delete convolution;
+        convolution = 0;
+    }
+
+    return 0;
+}
+
+int Convolution3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    // resolve depth padding the same way as make_padding
+    int pad_front_d = 0;
+    int pad_behind_d = 0;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0)
+    {
+        pad_front_d = pad_front;
+        pad_behind_d = pad_behind;
+    }
+    else if ((pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233 && pad_front == -233 && pad_behind == -233)
+             || (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234 && pad_front == -234 && pad_behind == -234))
+    {
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        int dpad = kernel_extent_d + (d - 1) / stride_d * stride_d - d;
+        if (wpad > 0 || hpad > 0 || dpad > 0)
+        {
+            pad_front_d = dpad / 2;
+            pad_behind_d = dpad - dpad / 2;
+        }
+    }
+
+    const int d_bordered = d + pad_front_d + pad_behind_d;
+    const int outd = (d_bordered - kernel_extent_d) / stride_d + 1;
+
+    // the stacked input uses the elempack the 2d convolution expects
+    int elempack_2d = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        const int num_input_2d = channels * elempack * kernel_d;
+#if NCNN_ARM82
+        if (support_fp16_storage && opt.use_fp16_storage && opt.use_fp16_arithmetic && bottom_blob.elembits() == 16)
+            elempack_2d = num_input_2d % 8 == 0 ? 8 : num_input_2d % 4 == 0 ? 4 : 1;
+        else
+#endif
+            elempack_2d = num_input_2d % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+
+    Mat pad_slice;
+    if (pad_front_d > 0 || pad_behind_d > 0)
+    {
+        pad_slice.create(w * h * elempack, elemsize / elempack, opt.workspace_allocator);
+        if (pad_slice.empty())
+            return -100;
+
+#if NCNN_ARM82
+        if (support_fp16_storage && opt.use_fp16_storage && bottom_blob.elembits() == 16)
+            pad_slice.fill(float32_to_float16(pad_value));
+        else
+#endif
+#if NCNN_BF16
+        if (opt.use_bf16_storage && bottom_blob.elembits() == 16)
+            pad_slice.fill(float32_to_bfloat16(pad_value));
+        else
+#endif
+            pad_slice.fill(pad_value);
+    }
+
+    // depth-major layout, channel z * channels + q is the padded depth slice z of channel q
+    Mat bottom_blob_bordered(w, h, d_bordered * channels, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const size_t slice_size = (size_t)w * h * elemsize;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        for (int z = 0; z < d_bordered; z++)
+        {
+            const int zi = z - pad_front_d;
+
+            unsigned char* outptr = bottom_blob_bordered.channel(z * channels + q);
+
+            if (zi >= 0 && zi < d)
+            {
+                memcpy(outptr, bottom_blob.channel(q).depth(zi), slice_size);
+            }
+            else
+            {
+                memcpy(outptr, pad_slice, slice_size);
+            }
+        }
+    }
+
+    for (int z = 0; z < outd; z++)
+    {
+        // the depth slices under the kernel stacked along channels
+        Mat bottom_blob_stacked;
+        if (dilation_d == 1)
+        {
+            bottom_blob_stacked = bottom_blob_bordered.channel_range(z * stride_d * channels, kernel_d * channels);
+        }
+        else
+        {
+            bottom_blob_stacked.create(w, h, kernel_d * channels, elemsize, elempack, opt.workspace_allocator);
+            if (bottom_blob_stacked.empty())
+                return -100;
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < channels; q++)
+            {
+                for (int k = 0; k < kernel_d; k++)
+                {
+                    memcpy(bottom_blob_stacked.channel(k * channels + q), bottom_blob_bordered.channel((z * stride_d + k * dilation_d) * channels + q), slice_size);
+                }
+            }
+        }
+
+        Mat bottom_blob_stacked_packed = bottom_blob_stacked;
+        if (elempack_2d != elempack)
+        {
+            convert_packing(bottom_blob_stacked, bottom_blob_stacked_packed, elempack_2d, opt_b);
+            if (bottom_blob_stacked_packed.empty())
+                return -100;
+        }
+
+        Mat top_blob_2d;
+        int ret = convolution->forward(bottom_blob_stacked_packed, top_blob_2d, opt_b);
+        if (ret != 0)
+            return ret;
+
+        if (z == 0)
+        {
+            top_blob.create(top_blob_2d.w, top_blob_2d.h, outd, top_blob_2d.c, top_blob_2d.elemsize, top_blob_2d.elempack, opt.blob_allocator);
+            if (top_blob.empty())
+                return -100;
+        }
+
+        const size_t out_slice_size = (size_t)top_blob.w * top_blob.h * top_blob.elemsize;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < top_blob.c; p++)
+        {
+            memcpy(top_blob.channel(p).depth(z), top_blob_2d.channel(p), out_slice_size);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -73,6 +73,8 @@ Convolution_arm::Convolution_arm()
     support_bf16_storage = true;
 #endif
 
+    support_batch = true;
+
     activation = 0;
     nT = 0;
     convolution_dilation1 = 0;
@@ -117,7 +119,10 @@ static void convolution_transform_kernel_packed_neon(const Mat& weight_data, Mat
 int Convolution_arm::create_pipeline(const Option& opt)
 {
     if (dynamic_weight)
+    {
+        support_batch = false;
         return 0;
+    }
 
     activation = create_activation_layer(activation_type, activation_params, opt);
     nT = opt.num_threads;
@@ -321,8 +326,57 @@ int Convolution_arm::destroy_pipeline(const Option& opt)
     return 0;
 }
 
+int Convolution_arm::save_pipeline(std::vector<Mat>& weights) const
+{
+    // the dilation fallback owns an inner convolution pipeline
+    if (dynamic_weight || convolution_dilation1)
+        return -1;
+
+    weights.resize(8);
+    weights[0] = weight_data_tm;
+    weights[1] = weight_3x3s2_data;
+    weights[2] = weight_sgemm_data;
+    weights[3] = weight_winograd23_data;
+    weights[4] = weight_winograd43_data;
+    weights[5] = weight_winograd63_data;
+    weights[6] = bias_data_fp16;
+#if NCNN_INT8
+    weights[7] = scale_in_data;
+#endif
+
+    return 0;
+}
+
+int Convolution_arm::load_pipeline(const std::vector<Mat>& weights, const Option& opt)
+{
+    if (dynamic_weight || weights.size() != 8)
+        return -1;
+
+    activation = create_activation_layer(activation_type, activation_params, opt);
+    nT = opt.num_threads;
+
+    weight_data_tm = weights[0];
+    weight_3x3s2_data = weights[1];
+    weight_sgemm_data = weights[2];
+    weight_winograd23_data = weights[3];
+    weight_winograd43_data = weights[4];
+    weight_winograd63_data = weights[5];
+    bias_data_fp16 = weights[6];
+#if NCNN_INT8
+    scale_in_data = weights[7];
+#endif
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
 int Convolution_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (bottom_blob.n > 1)
+        return forward_batch(bottom_blob, top_blob, opt);
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
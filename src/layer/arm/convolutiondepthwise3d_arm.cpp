@@ -0,0 +1,362 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolutiondepthwise3d_arm.h"
+
+#include "layer_type.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+static void accumulate_slice(const float* ptr, float* outptr, int size)
+{
+    int i = 0;
+#if __ARM_NEON
+    for (; i + 3 < size; i += 4)
+    {
+        vst1q_f32(outptr, vaddq_f32(vld1q_f32(outptr), vld1q_f32(ptr)));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __ARM_NEON
+    for (; i < size; i++)
+    {
+        *outptr += *ptr;
+        ptr++;
+        outptr++;
+    }
+}
+
+ConvolutionDepthWise3D_arm::ConvolutionDepthWise3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+
+    activation = 0;
+}
+
+int ConvolutionDepthWise3D_arm::create_pipeline(const Option& opt)
+{
+    // the depth slices are accumulated in fp32
+    Option opt_fp32 = opt;
+    opt_fp32.use_fp16_storage = false;
+    opt_fp32.use_fp16_packed = false;
+    opt_fp32.use_fp16_arithmetic = false;
+    opt_fp32.use_bf16_storage = false;
+
+    activation = create_activation_layer(activation_type, activation_params, opt_fp32);
+
+    // the depth padding is resolved in forward
+    int pad_left_2d = 0;
+    int pad_right_2d = 0;
+    int pad_top_2d = 0;
+    int pad_bottom_2d = 0;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0)
+    {
+        pad_left_2d = pad_left;
+        pad_right_2d = pad_right;
+        pad_top_2d = pad_top;
+        pad_bottom_2d = pad_bottom;
+    }
+    else if ((pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233 && pad_front == -233 && pad_behind == -233)
+             || (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234 && pad_front == -234 && pad_behind == -234))
+    {
+        pad_left_2d = pad_left;
+        pad_right_2d = pad_right;
+        pad_top_2d = pad_top;
+        pad_bottom_2d = pad_bottom;
+    }
+
+    const int maxk = kernel_w * kernel_h;
+    const int weight_data_size_2d = weight_data_size / kernel_d;
+
+    depth_ops.resize(kernel_d);
+
+    for (int k = 0; k < kernel_d; k++)
+    {
+        // maxk-kd-inch_g-outch to maxk-inch_g-outch at depth k
+        Mat weight_data_2d(weight_data_size_2d);
+        {
+            const float* kptr = weight_data;
+            float* ptr = weight_data_2d;
+
+            for (int i = 0; i < weight_data_size_2d / maxk; i++)
+            {
+                const float* k0 = kptr + (i * kernel_d + k) * maxk;
+
+                for (int j = 0; j < maxk; j++)
+                {
+                    ptr[j] = k0[j];
+                }
+
+                ptr += maxk;
+            }
+        }
+
+        ncnn::Layer* op = ncnn::create_layer_cpu(ncnn::LayerType::ConvolutionDepthWise);
+
+        // bias and activation are applied after accumulation
+        ncnn::ParamDict pd;
+        pd.set(0, num_output);
+        pd.set(1, kernel_w);
+        pd.set(11, kernel_h);
+        pd.set(2, dilation_w);
+        pd.set(12, dilation_h);
+        pd.set(3, stride_w);
+        pd.set(13, stride_h);
+        pd.set(4, pad_left_2d);
+        pd.set(15, pad_right_2d);
+        pd.set(14, pad_top_2d);
+        pd.set(16, pad_bottom_2d);
+        pd.set(18, pad_value);
+        pd.set(5, 0);
+        pd.set(6, weight_data_size_2d);
+        pd.set(7, group);
+
+        op->load_param(pd);
+
+        ncnn::Mat weights[1];
+        weights[0] = weight_data_2d;
+
+        op->load_model(ModelBinFromMatArray(weights));
+
+        op->create_pipeline(opt_fp32);
+
+        depth_ops[k] = op;
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int ConvolutionDepthWise3D_arm::destroy_pipeline(const Option& opt)
+{
+    Option opt_fp32 = opt;
+    opt_fp32.use_fp16_storage = false;
+    opt_fp32.use_fp16_packed = false;
+    opt_fp32.use_fp16_arithmetic = false;
+    opt_fp32.use_bf16_storage = false;
+
+    if (activation)
+    {
+        activation->destroy_pipeline(opt_fp32);
+        delete activation;
+        activation = 0;
+    }
+
+    for (int i = 0; i < (int)depth_ops.size(); i++)
+    {
+        depth_ops[i]->destroy_pipeline(opt_fp32);
+        delete depth_ops[i];
+    }
+    depth_ops.clear();
+
+    return 0;
+}
+
+int ConvolutionDepthWise3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    opt_b.use_fp16_storage = false;
+    opt_b.use_fp16_packed = false;
+    opt_b.use_fp16_arithmetic = false;
+    opt_b.use_bf16_storage = false;
+
+    bool use_fp16 = false;
+    bool use_bf16 = false;
+    Mat bottom_blob_fp32 = bottom_blob;
+#if NCNN_ARM82
+    if (support_fp16_storage && opt.use_fp16_storage && bottom_blob.elembits() == 16)
+    {
+        use_fp16 = true;
+
+        cast_float16_to_float32(bottom_blob, bottom_blob_fp32, opt_b);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+    else
+#endif
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_blob.elembits() == 16)
+    {
+        use_bf16 = true;
+
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_b);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+#endif
+
+    // fp16 may come in pack8
+    if (bottom_blob_fp32.elempack == 8)
+    {
+        Mat bottom_blob_fp32_pack4;
+        convert_packing(bottom_blob_fp32, bottom_blob_fp32_pack4, 4, opt_b);
+        if (bottom_blob_fp32_pack4.empty())
+            return -100;
+
+        bottom_blob_fp32 = bottom_blob_fp32_pack4;
+    }
+
+    const int w = bottom_blob_fp32.w;
+    const int h = bottom_blob_fp32.h;
+    const int d = bottom_blob_fp32.d;
+    const int channels = bottom_blob_fp32.c;
+    const size_t elemsize = bottom_blob_fp32.elemsize;
+    const int elempack = bottom_blob_fp32.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    // resolve depth padding the same way as make_padding
+    int pad_front_d = 0;
+    int pad_behind_d = 0;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0)
+    {
+        pad_front_d = pad_front;
+        pad_behind_d = pad_behind;
+    }
+    else if ((pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233 && pad_front == -233 && pad_behind == -233)
+             || (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234 && pad_front == -234 && pad_behind == -234))
+    {
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        int dpad = kernel_extent_d + (d - 1) / stride_d * stride_d - d;
+        if (wpad > 0 || hpad > 0 || dpad > 0)
+        {
+            pad_front_d = dpad / 2;
+            pad_behind_d = dpad - dpad / 2;
+        }
+    }
+
+    const int d_bordered = d + pad_front_d + pad_behind_d;
+    const int outd = (d_bordered - kernel_extent_d) / stride_d + 1;
+
+    // depth-major layout, channel z * channels + q is the padded depth slice z of channel q
+    Mat bottom_blob_bordered(w, h, d_bordered * channels, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        for (int z = 0; z < d_bordered; z++)
+        {
+            const int zi = z - pad_front_d;
+
+            float* outptr = bottom_blob_bordered.channel(z * channels + q);
+
+            if (zi >= 0 && zi < d)
+            {
+                memcpy(outptr, bottom_blob_fp32.channel(q).depth(zi), (size_t)w * h * elemsize);
+            }
+            else
+            {
+                for (int i = 0; i < w * h * elempack; i++)
+                {
+                    outptr[i] = pad_value;
+                }
+            }
+        }
+    }
+
+    Mat top_blob_fp32;
+
+    for (int z = 0; z < outd; z++)
+    {
+        for (int k = 0; k < kernel_d; k++)
+        {
+            const Mat bottom_blob_slice = bottom_blob_bordered.channel_range((z * stride_d + k * dilation_d) * channels, channels);
+
+            Mat top_blob_2d;
+            int ret = depth_ops[k]->forward(bottom_blob_slice, top_blob_2d, opt_b);
+            if (ret != 0)
+                return ret;
+
+            if (z == 0 && k == 0)
+            {
+                const int outw = top_blob_2d.w;
+                const int outh = top_blob_2d.h;
+                const int out_elempack = top_blob_2d.elempack;
+
+                if (use_fp16 || use_bf16)
+                    top_blob_fp32.create(outw, outh, outd, top_blob_2d.c, top_blob_2d.elemsize, out_elempack, opt.workspace_allocator);
+                else
+                    top_blob_fp32.create(outw, outh, outd, top_blob_2d.c, top_blob_2d.elemsize, out_elempack, opt.blob_allocator);
+                if (top_blob_fp32.empty())
+                    return -100;
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int p = 0; p < top_blob_fp32.c; p++)
+                {
+                    float* outptr = top_blob_fp32.channel(p);
+
+                    for (int i = 0; i < outw * outh * outd; i++)
+                    {
+                        for (int j = 0; j < out_elempack; j++)
+                        {
+                            outptr[j] = bias_term ? bias_data[p * out_elempack + j] : 0.f;
+                        }
+                        outptr += out_elempack;
+                    }
+                }
+            }
+
+            const int size = top_blob_fp32.w * top_blob_fp32.h * top_blob_fp32.elempack;
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int p = 0; p < top_blob_fp32.c; p++)
+            {
+                accumulate_slice(top_blob_2d.channel(p), top_blob_fp32.channel(p).depth(z), size);
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_fp32, opt_b);
+    }
+
+    if (use_fp16)
+    {
+        cast_float32_to_float16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    if (use_bf16)
+    {
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    top_blob = top_blob_fp32;
+
+    return 0;
+}
+
+} // namespace ncnn
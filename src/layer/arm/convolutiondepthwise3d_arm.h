@@ -0,0 +1,30 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_CONVOLUTIONDEPTHWISE3D_ARM_H
+#define LAYER_CONVOLUTIONDEPTHWISE3D_ARM_H
+
+#include "convolutiondepthwise3d.h"
+
+namespace ncnn {
+
+class ConvolutionDepthWise3D_arm : public ConvolutionDepthWise3D
+{
+public:
+    ConvolutionDepthWise3D_arm();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* activation;
+
+    // 2d depthwise convolution for each kernel depth
+    std::vector<ncnn::Layer*> depth_ops;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_CONVOLUTIONDEPTHWISE3D_ARM_H
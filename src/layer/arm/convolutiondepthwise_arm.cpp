@@ -51,13 +51,18 @@ ConvolutionDepthWise_arm::ConvolutionDepthWise_arm()
     support_bf16_storage = true;
 #endif
 
+    support_batch = true;
+
     activation = 0;
 }
 
 int ConvolutionDepthWise_arm::create_pipeline(const Option& opt)
 {
     if (dynamic_weight)
+    {
+        support_batch = false;
         return 0;
+    }
 
     activation = create_activation_layer(activation_type, activation_params, opt);
 
@@ -284,6 +289,9 @@ int ConvolutionDepthWise_arm::destroy_pipeline(const Option& opt)
 
 int ConvolutionDepthWise_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (bottom_blob.n > 1)
+        return forward_batch(bottom_blob, top_blob, opt);
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
@@ -0,0 +1,212 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "cumulativesum_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "cpu.h"
+
+namespace ncnn {
+
+CumulativeSum_arm::CumulativeSum_arm()
+{
+}
+
+// inclusive scan of ptr[0, size) starting from carry, returns the last sum
+static float cumulativesum_scan(float* ptr, int size, float carry)
+{
+    int i = 0;
+#if __ARM_NEON
+    // log-step prefix sum inside the register, then add the running carry
+    float32x4_t _zero = vdupq_n_f32(0.f);
+    float32x4_t _carry = vdupq_n_f32(carry);
+    for (; i + 3 < size; i += 4)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        _p = vaddq_f32(_p, vextq_f32(_zero, _p, 3));
+        _p = vaddq_f32(_p, vextq_f32(_zero, _p, 2));
+        _p = vaddq_f32(_p, _carry);
+        vst1q_f32(ptr, _p);
+        _carry = vdupq_n_f32(vgetq_lane_f32(_p, 3));
+        ptr += 4;
+    }
+    carry = vgetq_lane_f32(_carry, 0);
+#endif // __ARM_NEON
+    for (; i < size; i++)
+    {
+        carry += *ptr;
+        *ptr++ = carry;
+    }
+
+    return carry;
+}
+
+// ptr[0, size) += value
+static void cumulativesum_add_scalar(float* ptr, int size, float value)
+{
+    int i = 0;
+#if __ARM_NEON
+    float32x4_t _value = vdupq_n_f32(value);
+    for (; i + 3 < size; i += 4)
+    {
+        vst1q_f32(ptr, vaddq_f32(vld1q_f32(ptr), _value));
+        ptr += 4;
+    }
+#endif // __ARM_NEON
+    for (; i < size; i++)
+    {
+        *ptr++ += value;
+    }
+}
+
+// slice j += slice j - 1 for count slices of size elements, stride apart
+static void cumulativesum_accumulate(float* ptr, int count, int size, size_t stride)
+{
+    for (int j = 1; j < count; j++)
+    {
+        const float* prev = ptr + (j - 1) * stride;
+        float* cur = ptr + j * stride;
+
+        int i = 0;
+#if __ARM_NEON
+        for (; i + 7 < size; i += 8)
+        {
+            vst1q_f32(cur + i, vaddq_f32(vld1q_f32(cur + i), vld1q_f32(prev + i)));
+            vst1q_f32(cur + i + 4, vaddq_f32(vld1q_f32(cur + i + 4), vld1q_f32(prev + i + 4)));
+        }
+        for (; i + 3 < size; i += 4)
+        {
+            vst1q_f32(cur + i, vaddq_f32(vld1q_f32(cur + i), vld1q_f32(prev + i)));
+        }
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            cur[i] += prev[i];
+        }
+    }
+}
+
+// parallel prefix over one long row
+// every part is scanned on its own, then the part totals are carried forward
+static void cumulativesum_scan_parallel(float* ptr, int size, const Option& opt)
+{
+    int nn_part = std::min(opt.num_threads, size / 16384);
+    if (nn_part < 2)
+    {
+        cumulativesum_scan(ptr, size, 0.f);
+        return;
+    }
+
+    const int part_size = (size + nn_part - 1) / nn_part;
+
+    std::vector<float> part_sums(nn_part);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pi = 0; pi < nn_part; pi++)
+    {
+        const int begin = pi * part_size;
+        const int end = std::min(begin + part_size, size);
+
+        part_sums[pi] = cumulativesum_scan(ptr + begin, end - begin, 0.f);
+    }
+
+    for (int pi = 1; pi < nn_part; pi++)
+    {
+        part_sums[pi] += part_sums[pi - 1];
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pi = 1; pi < nn_part; pi++)
+    {
+        const int begin = pi * part_size;
+        const int end = std::min(begin + part_size, size);
+
+        cumulativesum_add_scalar(ptr + begin, end - begin, part_sums[pi - 1]);
+    }
+}
+
+int CumulativeSum_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    const int dims = bottom_top_blob.dims;
+    const int positive_axis = axis < 0 ? dims + axis : axis;
+    if (dims > 1 && (positive_axis < 0 || positive_axis >= dims))
+        return -100;
+
+    const int w = bottom_top_blob.w;
+    const int h = bottom_top_blob.h;
+    const int d = bottom_top_blob.d;
+    const int channels = bottom_top_blob.c;
+
+    if (dims == 1 || (dims == 2 && h == 1 && positive_axis == 1))
+    {
+        cumulativesum_scan_parallel(bottom_top_blob, w, opt);
+
+        return 0;
+    }
+
+    if (positive_axis == dims - 1)
+    {
+        // scan along w, rows are independent
+        const int rows_per_channel = dims == 2 ? h : h * d;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int r = 0; r < rows_per_channel * channels; r++)
+        {
+            const int q = r / rows_per_channel;
+            const int y = r % rows_per_channel;
+
+            float* ptr = (float*)bottom_top_blob.channel(q) + y * w;
+
+            cumulativesum_scan(ptr, w, 0.f);
+        }
+
+        return 0;
+    }
+
+    if (positive_axis == 0)
+    {
+        // accumulate whole slices, split the slice across threads
+        const int count = dims == 2 ? h : channels;
+        const int size = dims == 2 ? w : w * h * d;
+        const size_t stride = dims == 2 ? (size_t)w : bottom_top_blob.cstep;
+
+        const int tile = 256;
+        const int nn_tile = (size + tile - 1) / tile;
+
+        float* ptr = bottom_top_blob;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ti = 0; ti < nn_tile; ti++)
+        {
+            const int i = ti * tile;
+
+            cumulativesum_accumulate(ptr + i, count, std::min(tile, size - i), stride);
+        }
+
+        return 0;
+    }
+
+    // accumulate inside each channel, channels are independent
+    // dims 3 axis 1 runs over rows, dims 4 axis 1 over depth slices and axis 2 over rows in each depth slice
+    const int count = dims == 3 ? h : positive_axis == 1 ? d : h;
+    const int size = dims == 3 ? w : positive_axis == 1 ? w * h : w;
+    const int outer = dims == 4 && positive_axis == 2 ? d : 1;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        for (int z = 0; z < outer; z++)
+        {
+            cumulativesum_accumulate(ptr + z * count * size, count, size, size);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,30 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_DECONVOLUTION3D_ARM_H
+#define LAYER_DECONVOLUTION3D_ARM_H
+
+#include "deconvolution3d.h"
+
+namespace ncnn {
+
+class Deconvolution3D_arm : public Deconvolution3D
+{
+public:
+    Deconvolution3D_arm();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* activation;
+
+    // 2d deconvolution of one input depth slice to the kernel_d output slices stacked along channels
+    Layer* deconvolution;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_DECONVOLUTION3D_ARM_H
@@ -0,0 +1,560 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deformableconv2d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+
+#include "cpu.h"
+#include "layer_type.h"
+
+#include <math.h>
+
+namespace ncnn {
+
+DeformableConv2D_arm::DeformableConv2D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+
+    activation = 0;
+    gemm = 0;
+}
+
+int DeformableConv2D_arm::create_pipeline(const Option& opt)
+{
+    // sampling and accumulation run in fp32
+    Option opt_fp32 = opt;
+    opt_fp32.use_fp16_storage = false;
+    opt_fp32.use_fp16_packed = false;
+    opt_fp32.use_fp16_arithmetic = false;
+    opt_fp32.use_bf16_storage = false;
+
+    activation = create_activation_layer(activation_type, activation_params, opt_fp32);
+
+    const int maxk = kernel_w * kernel_h;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    int elempack = 1;
+    int out_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        elempack = num_input % 4 == 0 ? 4 : 1;
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    if (opt.use_sgemm_convolution)
+    {
+        gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+        ncnn::ParamDict pd;
+        pd.set(2, 0);                   // transA
+        pd.set(3, 0);                   // transB
+        pd.set(4, 1);                   // constantA
+        pd.set(5, 0);                   // constantB
+        pd.set(6, 1);                   // constantC
+        pd.set(7, num_output);          // M = outch
+        pd.set(8, 0);                   // N = size
+        pd.set(9, maxk * num_input);    // K = maxk*inch
+        pd.set(10, bias_term ? 1 : -1); // constant_broadcast_type_C = (M)
+        pd.set(11, 1);                  // output_N1M
+
+        gemm->load_param(pd);
+
+        // maxk-inch-outch to pa-maxk-inch/pa-outch, the im2col row order
+        Mat tmp;
+        {
+            Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+            tmp.create(maxk * num_input, num_output);
+
+            for (int q = 0; q < num_output; q++)
+            {
+                float* g00 = tmp.row(q);
+
+                for (int p = 0; p + (elempack - 1) < num_input; p += elempack)
+                {
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        for (int i = 0; i < elempack; i++)
+                        {
+                            const float* k00 = weight_data_r2.channel(q).row(p + i);
+                            g00[0] = k00[k];
+                            g00++;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (bias_term)
+        {
+            ncnn::Mat weights[2];
+            weights[0] = tmp;
+            weights[1] = bias_data;
+
+            gemm->load_model(ModelBinFromMatArray(weights));
+        }
+        else
+        {
+            ncnn::Mat weights[1];
+            weights[0] = tmp;
+
+            gemm->load_model(ModelBinFromMatArray(weights));
+        }
+
+        gemm->create_pipeline(opt_fp32);
+    }
+    else
+    {
+        // maxk-inch-outch to outch/pb-maxk-inch-pb, the sampled column order
+        weight_data_tm.create(maxk * num_input, num_output / out_elempack, (size_t)4u * out_elempack, out_elempack);
+        if (weight_data_tm.empty())
+            return -100;
+
+        for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+        {
+            float* g00 = weight_data_tm.row(q / out_elempack);
+
+            for (int k = 0; k < maxk; k++)
+            {
+                for (int p = 0; p < num_input; p++)
+                {
+                    for (int i = 0; i < out_elempack; i++)
+                    {
+                        g00[0] = weight_data[((q + i) * num_input + p) * maxk + k];
+                        g00++;
+                    }
+                }
+            }
+        }
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int DeformableConv2D_arm::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+// fp32 copy of an input blob in the requested packing, fp16 and bf16 storage is cast at the boundary
+static int deformableconv2d_cast_fp32(const Mat& src, Mat& dst, int dst_elempack, const Option& opt)
+{
+    Mat src_fp32 = src;
+#if NCNN_ARM82
+    if (opt.use_fp16_storage && src.elembits() == 16)
+    {
+        cast_float16_to_float32(src, src_fp32, opt);
+        if (src_fp32.empty())
+            return -100;
+    }
+    else
+#endif
+#if NCNN_BF16
+    if (opt.use_bf16_storage && src.elembits() == 16)
+    {
+        cast_bfloat16_to_float32(src, src_fp32, opt);
+        if (src_fp32.empty())
+            return -100;
+    }
+#endif
+
+    if (src_fp32.elempack > dst_elempack)
+    {
+        convert_packing(src_fp32, dst, dst_elempack, opt);
+        if (dst.empty())
+            return -100;
+
+        return 0;
+    }
+
+    dst = src_fp32;
+
+    return 0;
+}
+
+int DeformableConv2D_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const bool has_mask = (bottom_blobs.size() == 3);
+    Mat& top_blob = top_blobs[0];
+
+    const bool use_fp16 = support_fp16_storage && opt.use_fp16_storage && bottom_blob.elembits() == 16;
+    const bool use_bf16 = !use_fp16 && opt.use_bf16_storage && bottom_blob.elembits() == 16;
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    opt_b.use_fp16_storage = use_fp16;
+
+    // offset and mask are read per output location
+    Mat offset;
+    int ret = deformableconv2d_cast_fp32(bottom_blobs[1], offset, 1, opt_b);
+    if (ret != 0)
+        return ret;
+
+    Mat mask;
+    if (has_mask)
+    {
+        ret = deformableconv2d_cast_fp32(bottom_blobs[2], mask, 1, opt_b);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (!use_fp16 && !use_bf16)
+        return forward_fp32(bottom_blob, offset, mask, top_blob, opt);
+
+    Mat bottom_blob_fp32;
+    ret = deformableconv2d_cast_fp32(bottom_blob, bottom_blob_fp32, 4, opt_b);
+    if (ret != 0)
+        return ret;
+
+    Mat top_blob_fp32;
+    ret = forward_fp32(bottom_blob_fp32, offset, mask, top_blob_fp32, opt_b);
+    if (ret != 0)
+        return ret;
+
+#if NCNN_ARM82
+    if (use_fp16)
+    {
+        cast_float32_to_float16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+#if NCNN_BF16
+    if (use_bf16)
+    {
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+
+    top_blob = top_blob_fp32;
+
+    return 0;
+}
+
+// bilinear taps of one deformed sampling point, out of bound taps get zero weight at position 0
+static void deformableconv2d_sample_taps(float h_im, float w_im, int h, int w, float mask, int* pos, float* coeffs)
+{
+    pos[0] = pos[1] = pos[2] = pos[3] = 0;
+    coeffs[0] = coeffs[1] = coeffs[2] = coeffs[3] = 0.f;
+
+    if (!(h_im > -1 && w_im > -1 && h_im < h && w_im < w))
+        return;
+
+    const int h_low = (int)floorf(h_im);
+    const int w_low = (int)floorf(w_im);
+    const int h_high = h_low + 1;
+    const int w_high = w_low + 1;
+
+    const float lh = h_im - h_low;
+    const float lw = w_im - w_low;
+    const float hh = 1 - lh;
+    const float hw = 1 - lw;
+
+    if (h_low >= 0 && w_low >= 0)
+    {
+        pos[0] = h_low * w + w_low;
+        coeffs[0] = hh * hw * mask;
+    }
+    if (h_low >= 0 && w_high <= w - 1)
+    {
+        pos[1] = h_low * w + w_high;
+        coeffs[1] = hh * lw * mask;
+    }
+    if (h_high <= h - 1 && w_low >= 0)
+    {
+        pos[2] = h_high * w + w_low;
+        coeffs[2] = lh * hw * mask;
+    }
+    if (h_high <= h - 1 && w_high <= w - 1)
+    {
+        pos[3] = h_high * w + w_high;
+        coeffs[3] = lh * lw * mask;
+    }
+}
+
+int DeformableConv2D_arm::forward_fp32(const Mat& bottom_blob, const Mat& offset, const Mat& mask, Mat& top_blob, const Option& opt) const
+{
+    const bool has_mask = !mask.empty();
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+    const int num_input = channels * elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int outw = (w + pad_left + pad_right - kernel_extent_w) / stride_w + 1;
+    const int outh = (h + pad_top + pad_bottom - kernel_extent_h) / stride_h + 1;
+    const int size = outw * outh;
+    const int maxk = kernel_w * kernel_h;
+
+    // the deformed sampling points are shared by every input channel, resolve them once
+    // sample_taps = maxk-size-(pos1 pos2 pos3 pos4 w1 w2 w3 w4)
+    Mat sample_taps(size * 8, maxk, (size_t)4u, 1, opt.workspace_allocator);
+    if (sample_taps.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int k = 0; k < maxk; k++)
+    {
+        const int u = k / kernel_w;
+        const int v = k % kernel_w;
+
+        const float* offset_h_ptr = offset.channel(k * 2);
+        const float* offset_w_ptr = offset.channel(k * 2 + 1);
+        const float* mask_ptr = has_mask ? (const float*)mask.channel(k) : 0;
+
+        float* taps = sample_taps.row(k);
+
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                const float h_im = i * stride_h - pad_top + u * dilation_h + offset_h_ptr[j];
+                const float w_im = j * stride_w - pad_left + v * dilation_w + offset_w_ptr[j];
+                const float mask_ = has_mask ? mask_ptr[j] : 1.f;
+
+                deformableconv2d_sample_taps(h_im, w_im, h, w, mask_, (int*)taps, taps + 4);
+
+                taps += 8;
+            }
+
+            offset_h_ptr += offset.w;
+            offset_w_ptr += offset.w;
+            if (has_mask)
+                mask_ptr += mask.w;
+        }
+    }
+
+    int out_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    top_blob.create(outw, outh, num_output / out_elempack, (size_t)4u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (gemm)
+    {
+        // im2col = inch/pa-maxk-size-pa
+        Mat bottom_im2col(size, maxk * channels, (size_t)4u * elempack, elempack, opt.workspace_allocator);
+        if (bottom_im2col.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < channels; p++)
+        {
+            const float* img = bottom_blob.channel(p);
+
+            for (int k = 0; k < maxk; k++)
+            {
+                const float* taps = sample_taps.row(k);
+                float* ptr = bottom_im2col.row(p * maxk + k);
+
+#if __ARM_NEON
+                if (elempack == 4)
+                {
+                    for (int i = 0; i < size; i++)
+                    {
+                        const int* pos = (const int*)taps;
+
+                        float32x4_t _val = vmulq_n_f32(vld1q_f32(img + pos[0] * 4), taps[4]);
+                        _val = vmlaq_n_f32(_val, vld1q_f32(img + pos[1] * 4), taps[5]);
+                        _val = vmlaq_n_f32(_val, vld1q_f32(img + pos[2] * 4), taps[6]);
+                        _val = vmlaq_n_f32(_val, vld1q_f32(img + pos[3] * 4), taps[7]);
+                        vst1q_f32(ptr, _val);
+
+                        taps += 8;
+                        ptr += 4;
+                    }
+                }
+#endif // __ARM_NEON
+
+                if (elempack == 1)
+                {
+                    for (int i = 0; i < size; i++)
+                    {
+                        const int* pos = (const int*)taps;
+
+                        ptr[0] = img[pos[0]] * taps[4] + img[pos[1]] * taps[5] + img[pos[2]] * taps[6] + img[pos[3]] * taps[7];
+
+                        taps += 8;
+                        ptr += 1;
+                    }
+                }
+            }
+        }
+
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        opt_b.use_fp16_storage = false;
+        opt_b.use_bf16_storage = false;
+
+        // sgemm
+        {
+            top_blob.w = outw * outh;
+            top_blob.h = 1;
+        }
+        int ret = gemm->forward(bottom_im2col, top_blob, opt_b);
+        {
+            top_blob.w = outw;
+            top_blob.h = outh;
+        }
+        if (ret != 0)
+            return ret;
+
+        if (activation)
+        {
+            activation->forward_inplace(top_blob, opt_b);
+        }
+
+        return 0;
+    }
+
+    const int outch = num_output / out_elempack;
+
+    const int K = maxk * num_input;
+
+    // one sampled column of maxk-inch per thread
+    Mat cols(K, 1, opt.num_threads, (size_t)4u, 1, opt.workspace_allocator);
+    if (cols.empty())
+        return -100;
+
+    const float* bias_data_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < size; i++)
+    {
+        float* col = cols.channel(get_omp_thread_num());
+
+        for (int k = 0; k < maxk; k++)
+        {
+            const float* taps = sample_taps.row(k) + i * 8;
+            const int* pos = (const int*)taps;
+
+            float* colptr = col + k * num_input;
+
+            for (int p = 0; p < channels; p++)
+            {
+                const float* img = bottom_blob.channel(p);
+
+#if __ARM_NEON
+                if (elempack == 4)
+                {
+                    float32x4_t _val = vmulq_n_f32(vld1q_f32(img + pos[0] * 4), taps[4]);
+                    _val = vmlaq_n_f32(_val, vld1q_f32(img + pos[1] * 4), taps[5]);
+                    _val = vmlaq_n_f32(_val, vld1q_f32(img + pos[2] * 4), taps[6]);
+                    _val = vmlaq_n_f32(_val, vld1q_f32(img + pos[3] * 4), taps[7]);
+                    vst1q_f32(colptr, _val);
+                    colptr += 4;
+                }
+#endif // __ARM_NEON
+
+                if (elempack == 1)
+                {
+                    colptr[0] = img[pos[0]] * taps[4] + img[pos[1]] * taps[5] + img[pos[2]] * taps[6] + img[pos[3]] * taps[7];
+                    colptr += 1;
+                }
+            }
+        }
+
+        for (int q = 0; q < outch; q++)
+        {
+            const float* kptr = weight_data_tm.row(q);
+            float* outptr = (float*)top_blob.channel(q) + i * out_elempack;
+
+#if __ARM_NEON
+            if (out_elempack == 4)
+            {
+                float32x4_t _sum = bias_data_ptr ? vld1q_f32(bias_data_ptr + q * 4) : vdupq_n_f32(0.f);
+
+                for (int j = 0; j < K; j++)
+                {
+                    _sum = vmlaq_n_f32(_sum, vld1q_f32(kptr), col[j]);
+                    kptr += 4;
+                }
+
+                _sum = activation_ps(_sum, activation_type, activation_params);
+
+                vst1q_f32(outptr, _sum);
+            }
+#endif // __ARM_NEON
+
+            if (out_elempack == 1)
+            {
+                float sum = bias_data_ptr ? bias_data_ptr[q] : 0.f;
+
+                int j = 0;
+#if __ARM_NEON
+                float32x4_t _sum = vdupq_n_f32(0.f);
+                for (; j + 3 < K; j += 4)
+                {
+                    _sum = vmlaq_f32(_sum, vld1q_f32(kptr + j), vld1q_f32(col + j));
+                }
+#if __aarch64__
+                sum += vaddvq_f32(_sum);
+#else
+                float32x2_t _ss = vadd_f32(vget_low_f32(_sum), vget_high_f32(_sum));
+                _ss = vpadd_f32(_ss, _ss);
+                sum += vget_lane_f32(_ss, 0);
+#endif
+#endif // __ARM_NEON
+                for (; j < K; j++)
+                {
+                    sum += kptr[j] * col[j];
+                }
+
+                outptr[0] = activation_ss(sum, activation_type, activation_params);
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,35 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_DEFORMABLECONV2D_ARM_H
+#define LAYER_DEFORMABLECONV2D_ARM_H
+
+#include "deformableconv2d.h"
+
+namespace ncnn {
+
+class DeformableConv2D_arm : public DeformableConv2D
+{
+public:
+    DeformableConv2D_arm();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    int forward_fp32(const Mat& bottom_blob, const Mat& offset, const Mat& mask, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* activation;
+
+    // outch/pb-maxk-inch-pb for the direct path
+    Mat weight_data_tm;
+
+    Layer* gemm;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_DEFORMABLECONV2D_ARM_H
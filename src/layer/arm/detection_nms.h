@@ -0,0 +1,87 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// greedy nms over score sorted boxes shared by detectionoutput, proposal and yolov3detectionoutput
+// boxes are kept as separate coordinate arrays so that one picked box is tested against many at once
+
+struct BBoxSoA
+{
+    std::vector<float> xmin;
+    std::vector<float> ymin;
+    std::vector<float> xmax;
+    std::vector<float> ymax;
+    std::vector<float> area;
+
+    void resize(int n)
+    {
+        xmin.resize(n);
+        ymin.resize(n);
+        xmax.resize(n);
+        ymax.resize(n);
+        area.resize(n);
+    }
+};
+
+// a box is dropped when its iou with any earlier picked box exceeds nms_threshold
+// the iou test is done as inter > nms_threshold * union since armv7 neon has no division
+// picking stops after max_picked boxes, which is all a caller truncating the result needs
+static void nms_sorted_bboxes_soa(const BBoxSoA& boxes, int n, float nms_threshold, int max_picked, std::vector<int>& picked)
+{
+    picked.clear();
+
+    if (n == 0 || max_picked <= 0)
+        return;
+
+    const float* xmin = &boxes.xmin[0];
+    const float* ymin = &boxes.ymin[0];
+    const float* xmax = &boxes.xmax[0];
+    const float* ymax = &boxes.ymax[0];
+    const float* area = &boxes.area[0];
+
+    // 1.f marks a box suppressed by a picked one
+    std::vector<float> suppressed(n, 0.f);
+    float* sptr = &suppressed[0];
+
+    for (int i = 0; i < n; i++)
+    {
+        if (sptr[i] != 0.f)
+            continue;
+
+        picked.push_back(i);
+        if ((int)picked.size() >= max_picked)
+            break;
+
+        int j = i + 1;
+#if __ARM_NEON
+        {
+            const float32x4_t _axmin = vdupq_n_f32(xmin[i]);
+            const float32x4_t _aymin = vdupq_n_f32(ymin[i]);
+            const float32x4_t _axmax = vdupq_n_f32(xmax[i]);
+            const float32x4_t _aymax = vdupq_n_f32(ymax[i]);
+            const float32x4_t _aarea = vdupq_n_f32(area[i]);
+            const float32x4_t _thresh = vdupq_n_f32(nms_threshold);
+            const float32x4_t _zero = vdupq_n_f32(0.f);
+            const uint32x4_t _one = vreinterpretq_u32_f32(vdupq_n_f32(1.f));
+            for (; j + 3 < n; j += 4)
+            {
+                float32x4_t _w = vsubq_f32(vminq_f32(_axmax, vld1q_f32(xmax + j)), vmaxq_f32(_axmin, vld1q_f32(xmin + j)));
+                float32x4_t _h = vsubq_f32(vminq_f32(_aymax, vld1q_f32(ymax + j)), vmaxq_f32(_aymin, vld1q_f32(ymin + j)));
+                float32x4_t _inter = vmulq_f32(vmaxq_f32(_w, _zero), vmaxq_f32(_h, _zero));
+                float32x4_t _union = vsubq_f32(vaddq_f32(_aarea, vld1q_f32(area + j)), _inter);
+                uint32x4_t _mask = vcgtq_f32(_inter, vmulq_f32(_thresh, _union));
+                uint32x4_t _s = vorrq_u32(vreinterpretq_u32_f32(vld1q_f32(sptr + j)), vandq_u32(_mask, _one));
+                vst1q_f32(sptr + j, vreinterpretq_f32_u32(_s));
+            }
+        }
+#endif // __ARM_NEON
+        for (; j < n; j++)
+        {
+            float w = std::max(std::min(xmax[i], xmax[j]) - std::max(xmin[i], xmin[j]), 0.f);
+            float h = std::max(std::min(ymax[i], ymax[j]) - std::max(ymin[i], ymin[j]), 0.f);
+            float inter = w * h;
+            float union_area = area[i] + area[j] - inter;
+            if (inter > nms_threshold * union_area)
+                sptr[j] = 1.f;
+        }
+    }
+}
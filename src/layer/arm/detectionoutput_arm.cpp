@@ -0,0 +1,281 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "detectionoutput_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+#include "topk_select.h"
+
+namespace ncnn {
+
+#include "detection_nms.h"
+
+DetectionOutput_arm::DetectionOutput_arm()
+{
+}
+
+// decode center size offsets of num_prior priors into separate corner arrays
+static void decode_bboxes(const float* loc, const float* pb, const float* var, const float* variances, int num_prior, BBoxSoA& bboxes, const Option& opt)
+{
+    float* xmin = &bboxes.xmin[0];
+    float* ymin = &bboxes.ymin[0];
+    float* xmax = &bboxes.xmax[0];
+    float* ymax = &bboxes.ymax[0];
+
+    int nn_prior = 0;
+#if __ARM_NEON
+    nn_prior = num_prior / 4;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ii = 0; ii < nn_prior; ii++)
+    {
+        const int i = ii * 4;
+
+        float32x4x4_t _loc = vld4q_f32(loc + i * 4);
+        float32x4x4_t _pb = vld4q_f32(pb + i * 4);
+
+        float32x4x4_t _var;
+        if (var)
+        {
+            _var = vld4q_f32(var + i * 4);
+        }
+        else
+        {
+            _var.val[0] = vdupq_n_f32(variances[0]);
+            _var.val[1] = vdupq_n_f32(variances[1]);
+            _var.val[2] = vdupq_n_f32(variances[2]);
+            _var.val[3] = vdupq_n_f32(variances[3]);
+        }
+
+        const float32x4_t _half = vdupq_n_f32(0.5f);
+
+        float32x4_t _pb_w = vsubq_f32(_pb.val[2], _pb.val[0]);
+        float32x4_t _pb_h = vsubq_f32(_pb.val[3], _pb.val[1]);
+        float32x4_t _pb_cx = vmulq_f32(vaddq_f32(_pb.val[0], _pb.val[2]), _half);
+        float32x4_t _pb_cy = vmulq_f32(vaddq_f32(_pb.val[1], _pb.val[3]), _half);
+
+        float32x4_t _cx = vaddq_f32(vmulq_f32(vmulq_f32(_var.val[0], _loc.val[0]), _pb_w), _pb_cx);
+        float32x4_t _cy = vaddq_f32(vmulq_f32(vmulq_f32(_var.val[1], _loc.val[1]), _pb_h), _pb_cy);
+        float32x4_t _w = vmulq_f32(exp_ps(vmulq_f32(_var.val[2], _loc.val[2])), _pb_w);
+        float32x4_t _h = vmulq_f32(exp_ps(vmulq_f32(_var.val[3], _loc.val[3])), _pb_h);
+
+        vst1q_f32(xmin + i, vsubq_f32(_cx, vmulq_f32(_w, _half)));
+        vst1q_f32(ymin + i, vsubq_f32(_cy, vmulq_f32(_h, _half)));
+        vst1q_f32(xmax + i, vaddq_f32(_cx, vmulq_f32(_w, _half)));
+        vst1q_f32(ymax + i, vaddq_f32(_cy, vmulq_f32(_h, _half)));
+    }
+#endif // __ARM_NEON
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = nn_prior * 4; i < num_prior; i++)
+    {
+        const float* l = loc + i * 4;
+        const float* p = pb + i * 4;
+        const float* v = var ? var + i * 4 : variances;
+
+        // CENTER_SIZE
+        float pb_w = p[2] - p[0];
+        float pb_h = p[3] - p[1];
+        float pb_cx = (p[0] + p[2]) * 0.5f;
+        float pb_cy = (p[1] + p[3]) * 0.5f;
+
+        float bbox_cx = v[0] * l[0] * pb_w + pb_cx;
+        float bbox_cy = v[1] * l[1] * pb_h + pb_cy;
+        float bbox_w = expf(v[2] * l[2]) * pb_w;
+        float bbox_h = expf(v[3] * l[3]) * pb_h;
+
+        xmin[i] = bbox_cx - bbox_w * 0.5f;
+        ymin[i] = bbox_cy - bbox_h * 0.5f;
+        xmax[i] = bbox_cx + bbox_w * 0.5f;
+        ymax[i] = bbox_cy + bbox_h * 0.5f;
+    }
+}
+
+// append j to candidates[i] for every class i in [1, num_class) whose score exceeds the threshold
+static void filter_class_scores(const float* ptr, int num_class, float confidence_threshold, int j, std::vector<std::vector<int> >& candidates)
+{
+    int i = 1;
+#if __ARM_NEON
+    const float32x4_t _thresh = vdupq_n_f32(confidence_threshold);
+    for (; i + 3 < num_class; i += 4)
+    {
+        uint32x4_t _mask = vcgtq_f32(vld1q_f32(ptr + i), _thresh);
+        uint32x2_t _mask2 = vorr_u32(vget_low_u32(_mask), vget_high_u32(_mask));
+        if ((vget_lane_u32(_mask2, 0) | vget_lane_u32(_mask2, 1)) == 0)
+            continue;
+
+        for (int k = 0; k < 4; k++)
+        {
+            if (ptr[i + k] > confidence_threshold)
+                candidates[i + k].push_back(j);
+        }
+    }
+#endif // __ARM_NEON
+    for (; i < num_class; i++)
+    {
+        if (ptr[i] > confidence_threshold)
+            candidates[i].push_back(j);
+    }
+}
+
+int DetectionOutput_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& location = bottom_blobs[0];
+    const Mat& confidence = bottom_blobs[1];
+    const Mat& priorbox = bottom_blobs[2];
+
+    bool mxnet_ssd_style = num_class == -233;
+
+    // mxnet-ssd _contrib_MultiBoxDetection
+    const int num_prior = mxnet_ssd_style ? priorbox.h : priorbox.w / 4;
+
+    int num_class_copy = mxnet_ssd_style ? confidence.h : num_class;
+
+    // apply location with priorbox
+    BBoxSoA bboxes;
+    bboxes.resize(num_prior);
+
+    const float* priorbox_ptr = priorbox.row(0);
+    const float* variance_ptr = mxnet_ssd_style ? 0 : priorbox.row(1);
+
+    decode_bboxes(location, priorbox_ptr, variance_ptr, variances, num_prior, bboxes, opt);
+
+    // prob data layout
+    // caffe-ssd = num_class x num_prior
+    // mxnet-ssd = num_prior x num_class
+    const float* confidence_ptr = confidence;
+
+    // filter by confidence_threshold, start from 1 to ignore background class
+    // priors whose background score is at least 1 - confidence_threshold are skipped up front
+    const double background_threshold = 1.0 - confidence_threshold;
+
+    std::vector<std::vector<int> > all_class_candidates(num_class_copy);
+    if (mxnet_ssd_style)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 1; i < num_class_copy; i++)
+        {
+            const float* ptr = confidence_ptr + i * num_prior;
+            for (int j = 0; j < num_prior; j++)
+            {
+                if (confidence_ptr[j] >= background_threshold)
+                    continue;
+
+                if (ptr[j] > confidence_threshold)
+                    all_class_candidates[i].push_back(j);
+            }
+        }
+    }
+    else
+    {
+        for (int j = 0; j < num_prior; j++)
+        {
+            if (confidence_ptr[(size_t)j * num_class_copy] >= background_threshold)
+                continue;
+
+            filter_class_scores(confidence_ptr + (size_t)j * num_class_copy, num_class_copy, confidence_threshold, j, all_class_candidates);
+        }
+    }
+
+    // sort and nms for each class
+    std::vector<std::vector<int> > all_class_picked(num_class_copy);
+    std::vector<std::vector<float> > all_class_picked_scores(num_class_copy);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 1; i < num_class_copy; i++)
+    {
+        const std::vector<int>& candidates = all_class_candidates[i];
+        const int num_candidates = (int)candidates.size();
+        if (num_candidates == 0)
+            continue;
+
+        std::vector<float> scores(num_candidates);
+        for (int j = 0; j < num_candidates; j++)
+        {
+            const int z = candidates[j];
+            scores[j] = mxnet_ssd_style ? confidence_ptr[i * num_prior + z] : confidence_ptr[(size_t)z * num_class_copy + i];
+        }
+
+        // keep nms_top_k, negative keeps all
+        const int top_k = nms_top_k < 0 ? num_candidates : std::min(nms_top_k, num_candidates);
+        std::vector<int> sorted(top_k);
+        const int num_sorted = topk_select(scores.data(), 0, num_candidates, top_k, sorted.data());
+
+        BBoxSoA class_bboxes;
+        class_bboxes.resize(num_sorted);
+        for (int j = 0; j < num_sorted; j++)
+        {
+            const int z = candidates[sorted[j]];
+            class_bboxes.xmin[j] = bboxes.xmin[z];
+            class_bboxes.ymin[j] = bboxes.ymin[z];
+            class_bboxes.xmax[j] = bboxes.xmax[z];
+            class_bboxes.ymax[j] = bboxes.ymax[z];
+            class_bboxes.area[j] = (bboxes.xmax[z] - bboxes.xmin[z]) * (bboxes.ymax[z] - bboxes.ymin[z]);
+        }
+
+        // apply nms, no class can contribute more than keep_top_k boxes
+        std::vector<int> picked;
+        nms_sorted_bboxes_soa(class_bboxes, num_sorted, nms_threshold, keep_top_k < 0 ? num_sorted : keep_top_k, picked);
+
+        for (size_t j = 0; j < picked.size(); j++)
+        {
+            const int z = sorted[picked[j]];
+            all_class_picked[i].push_back(candidates[z]);
+            all_class_picked_scores[i].push_back(scores[z]);
+        }
+    }
+
+    // gather all class
+    std::vector<int> bbox_labels;
+    std::vector<int> bbox_indices;
+    std::vector<float> bbox_scores;
+
+    for (int i = 1; i < num_class_copy; i++)
+    {
+        const std::vector<int>& class_picked = all_class_picked[i];
+        const std::vector<float>& class_picked_scores = all_class_picked_scores[i];
+
+        bbox_labels.insert(bbox_labels.end(), class_picked.size(), i);
+        bbox_indices.insert(bbox_indices.end(), class_picked.begin(), class_picked.end());
+        bbox_scores.insert(bbox_scores.end(), class_picked_scores.begin(), class_picked_scores.end());
+    }
+
+    // global sort and keep_top_k, negative keeps all
+    const int num_picked = (int)bbox_scores.size();
+    if (num_picked == 0)
+        return 0;
+
+    const int top_k = keep_top_k < 0 ? num_picked : std::min(keep_top_k, num_picked);
+    std::vector<int> sorted(top_k);
+    const int num_detected = topk_select(bbox_scores.data(), 0, num_picked, top_k, sorted.data());
+
+    // fill result
+    if (num_detected == 0)
+        return 0;
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(6, num_detected, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    for (int i = 0; i < num_detected; i++)
+    {
+        const int k = sorted[i];
+        const int z = bbox_indices[k];
+        float* outptr = top_blob.row(i);
+
+        outptr[0] = static_cast<float>(bbox_labels[k]);
+        outptr[1] = bbox_scores[k];
+        outptr[2] = bboxes.xmin[z];
+        outptr[3] = bboxes.ymin[z];
+        outptr[4] = bboxes.xmax[z];
+        outptr[5] = bboxes.ymax[z];
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
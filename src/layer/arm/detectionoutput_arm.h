@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_DETECTIONOUTPUT_ARM_H
+#define LAYER_DETECTIONOUTPUT_ARM_H
+
+#include "detectionoutput.h"
+
+namespace ncnn {
+
+class DetectionOutput_arm : public DetectionOutput
+{
+public:
+    DetectionOutput_arm();
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_DETECTIONOUTPUT_ARM_H
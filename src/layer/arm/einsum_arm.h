@@ -0,0 +1,36 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_EINSUM_ARM_H
+#define LAYER_EINSUM_ARM_H
+
+#include "einsum.h"
+
+namespace ncnn {
+
+class Einsum_arm : public Einsum
+{
+public:
+    Einsum_arm();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+public:
+    // pairwise contraction plan, operand a and b are replaced by the result appended to the operand list
+    std::vector<int> contraction_a;
+    std::vector<int> contraction_b;
+    std::vector<std::string> contraction_batch_tokens;
+    std::vector<std::string> contraction_m_tokens;
+    std::vector<std::string> contraction_n_tokens;
+    std::vector<std::string> contraction_k_tokens;
+
+    // batched gemm indexed by transA * 2 + transB
+    Layer* gemm[4];
+};
+
+} // namespace ncnn
+
+#endif // LAYER_EINSUM_ARM_H
@@ -0,0 +1,294 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "embed_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_usability.h"
+
+#include "cpu.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+// columns gathered per word before interleaving into the packed output
+#define EMBED_CHUNK 256
+
+Embed_arm::Embed_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+
+    weight_data_type = 0;
+}
+
+int Embed_arm::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (weight_quant_bits || int8_scale_term)
+    {
+        // the quantized table is gathered as it is, mapped model data is never touched beyond the looked up words
+        weight_data_type = weight_quant_bits == 4 ? 4 : 3;
+        return 0;
+    }
+#endif // NCNN_INT8
+
+    if (opt.use_fp16_storage)
+    {
+        cast_float32_to_float16(weight_data, weight_data_tm, opt);
+        if (weight_data_tm.empty())
+            return -100;
+
+        weight_data_type = 1;
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        cast_float32_to_bfloat16(weight_data, weight_data_tm, opt);
+        if (weight_data_tm.empty())
+            return -100;
+
+        weight_data_type = 2;
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+#endif // NCNN_BF16
+
+    weight_data_type = 0;
+
+    return 0;
+}
+
+void Embed_arm::embed_row(int word_index, int p0, int n, float* outptr) const
+{
+    if (weight_data_type == 0)
+    {
+        const float* ptr = (const float*)weight_data + (size_t)num_output * word_index + p0;
+
+        memcpy(outptr, ptr, n * sizeof(float));
+    }
+
+    if (weight_data_type == 1)
+    {
+        const unsigned short* ptr = (const unsigned short*)weight_data_tm + (size_t)num_output * word_index + p0;
+
+        int i = 0;
+#if (__ARM_FP & 2)
+        for (; i + 3 < n; i += 4)
+        {
+            vst1q_f32(outptr + i, vcvt_f32_f16((float16x4_t)vld1_u16(ptr + i)));
+        }
+#endif // (__ARM_FP & 2)
+        for (; i < n; i++)
+        {
+            outptr[i] = float16_to_float32(ptr[i]);
+        }
+    }
+
+    if (weight_data_type == 2)
+    {
+        const unsigned short* ptr = (const unsigned short*)weight_data_tm + (size_t)num_output * word_index + p0;
+
+        int i = 0;
+#if __ARM_NEON
+        for (; i + 3 < n; i += 4)
+        {
+            vst1q_f32(outptr + i, bfloat2float(vld1_u16(ptr + i)));
+        }
+#endif // __ARM_NEON
+        for (; i < n; i++)
+        {
+            outptr[i] = bfloat16_to_float32(ptr[i]);
+        }
+    }
+
+#if NCNN_INT8
+    if (weight_data_type == 3)
+    {
+        const signed char* ptr = (const signed char*)weight_data + (size_t)num_output * word_index + p0;
+        const float scale = weight_quant_bits ? weight_quant_scales[word_index] : 1.f / weight_data_int8_scale;
+
+        int i = 0;
+#if __ARM_NEON
+        for (; i + 7 < n; i += 8)
+        {
+            int16x8_t _w = vmovl_s8(vld1_s8(ptr + i));
+            vst1q_f32(outptr + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(_w))), scale));
+            vst1q_f32(outptr + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(_w))), scale));
+        }
+#endif // __ARM_NEON
+        for (; i < n; i++)
+        {
+            outptr[i] = ptr[i] * scale;
+        }
+    }
+
+    if (weight_data_type == 4)
+    {
+        const int num_groups = (num_output + weight_quant_group_size - 1) / weight_quant_group_size;
+
+        const unsigned char* ptr = weight_data.row<const unsigned char>(word_index);
+        const float* scales = (const float*)weight_quant_scales + num_groups * word_index;
+        const float* zeros = (const float*)weight_quant_zeros + num_groups * word_index;
+
+        // p0 and the group boundaries are multiples of 8, so every run starts on a byte
+        int i = 0;
+        while (i < n)
+        {
+            const int p = p0 + i;
+            const int g = p / weight_quant_group_size;
+            const int nn = std::min(n - i, (g + 1) * weight_quant_group_size - p);
+
+            const unsigned char* w = ptr + p / 2;
+            const float scale = scales[g];
+            const float zero = zeros[g];
+            float* out = outptr + i;
+
+            int k = 0;
+#if __ARM_NEON
+            const float32x4_t _scale = vdupq_n_f32(scale);
+            const float32x4_t _zero = vdupq_n_f32(zero);
+            for (; k + 15 < nn; k += 16)
+            {
+                // the low and high nibbles interleaved back to column order
+                uint8x8_t _p = vld1_u8(w + k / 2);
+                uint8x8x2_t _q = vzip_u8(vand_u8(_p, vdup_n_u8(15)), vshr_n_u8(_p, 4));
+                uint16x8_t _q0 = vmovl_u8(_q.val[0]);
+                uint16x8_t _q1 = vmovl_u8(_q.val[1]);
+                float32x4_t _w0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(_q0)));
+                float32x4_t _w1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(_q0)));
+                float32x4_t _w2 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(_q1)));
+                float32x4_t _w3 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(_q1)));
+                vst1q_f32(out + k, vmulq_f32(vsubq_f32(_w0, _zero), _scale));
+                vst1q_f32(out + k + 4, vmulq_f32(vsubq_f32(_w1, _zero), _scale));
+                vst1q_f32(out + k + 8, vmulq_f32(vsubq_f32(_w2, _zero), _scale));
+                vst1q_f32(out + k + 12, vmulq_f32(vsubq_f32(_w3, _zero), _scale));
+            }
+#endif // __ARM_NEON
+            for (; k < nn; k++)
+            {
+                out[k] = (((w[k / 2] >> ((k % 2) * 4)) & 15) - zero) * scale;
+            }
+
+            i += nn;
+        }
+    }
+#endif // NCNN_INT8
+
+    if (bias_term)
+    {
+        const float* bias_ptr = (const float*)bias_data + p0;
+
+        int i = 0;
+#if __ARM_NEON
+        for (; i + 3 < n; i += 4)
+        {
+            vst1q_f32(outptr + i, vaddq_f32(vld1q_f32(outptr + i), vld1q_f32(bias_ptr + i)));
+        }
+#endif // __ARM_NEON
+        for (; i < n; i++)
+        {
+            outptr[i] += bias_ptr[i];
+        }
+    }
+}
+
+int Embed_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // a packed 1d blob keeps the word order
+    const int words = bottom_blob.w * bottom_blob.elempack;
+    const int* word_ptr = bottom_blob;
+
+    int out_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        out_elempack = words % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    top_blob.create(num_output, words / out_elempack, 4u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (out_elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < words; q++)
+        {
+            const int word_index = std::min(std::max(word_ptr[q], 0), input_dim - 1);
+
+            embed_row(word_index, 0, num_output, top_blob.row(q));
+        }
+
+        return 0;
+    }
+
+#if __ARM_NEON
+    // gather a chunk of the four words in the pack, then interleave them into the output
+    Mat rows(EMBED_CHUNK * 4, 1, opt.num_threads, 4u, opt.workspace_allocator);
+    if (rows.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < top_blob.h; q++)
+    {
+        float* rowsptr = rows.channel(get_omp_thread_num());
+        float* outptr = top_blob.row(q);
+
+        for (int p0 = 0; p0 < num_output; p0 += EMBED_CHUNK)
+        {
+            const int n = std::min(EMBED_CHUNK, num_output - p0);
+
+            for (int l = 0; l < 4; l++)
+            {
+                const int word_index = std::min(std::max(word_ptr[q * 4 + l], 0), input_dim - 1);
+
+                embed_row(word_index, p0, n, rowsptr + l * EMBED_CHUNK);
+            }
+
+            const float* r0 = rowsptr;
+            const float* r1 = rowsptr + EMBED_CHUNK;
+            const float* r2 = rowsptr + EMBED_CHUNK * 2;
+            const float* r3 = rowsptr + EMBED_CHUNK * 3;
+            float* outp = outptr + p0 * 4;
+
+            int i = 0;
+            for (; i + 3 < n; i += 4)
+            {
+                float32x4x4_t _r;
+                _r.val[0] = vld1q_f32(r0 + i);
+                _r.val[1] = vld1q_f32(r1 + i);
+                _r.val[2] = vld1q_f32(r2 + i);
+                _r.val[3] = vld1q_f32(r3 + i);
+                vst4q_f32(outp + i * 4, _r);
+            }
+            for (; i < n; i++)
+            {
+                outp[i * 4] = r0[i];
+                outp[i * 4 + 1] = r1[i];
+                outp[i * 4 + 2] = r2[i];
+                outp[i * 4 + 3] = r3[i];
+            }
+        }
+    }
+#endif // __ARM_NEON
+
+    return 0;
+}
+
+} // namespace ncnn
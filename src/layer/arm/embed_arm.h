@@ -0,0 +1,34 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_EMBED_ARM_H
+#define LAYER_EMBED_ARM_H
+
+#include "embed.h"
+
+namespace ncnn {
+
+class Embed_arm : public Embed
+{
+public:
+    Embed_arm();
+
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+protected:
+    // dequantize columns [p0, p0 + n) of one word row and add bias
+    void embed_row(int word_index, int p0, int n, float* outptr) const;
+
+public:
+    // 0=fp32 1=fp16 2=bf16 3=int8 4=uint4
+    int weight_data_type;
+
+    // the fp16 or bf16 table, the other types read weight_data directly
+    Mat weight_data_tm;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_EMBED_ARM_H
@@ -0,0 +1,74 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// vector arithmetic of one fft lane group, see spectrogram_fft.h
+
+struct fft_op_pack1
+{
+    enum
+    {
+        lanes = 1
+    };
+    typedef float vec;
+
+    static NCNN_FORCEINLINE float set1(float v)
+    {
+        return v;
+    }
+    static NCNN_FORCEINLINE float load(const float* ptr)
+    {
+        return *ptr;
+    }
+    static NCNN_FORCEINLINE void store(float* ptr, float v)
+    {
+        *ptr = v;
+    }
+    static NCNN_FORCEINLINE float add(float x, float y)
+    {
+        return x + y;
+    }
+    static NCNN_FORCEINLINE float sub(float x, float y)
+    {
+        return x - y;
+    }
+    static NCNN_FORCEINLINE float mul(float x, float y)
+    {
+        return x * y;
+    }
+};
+
+#if __ARM_NEON
+struct fft_op_pack4
+{
+    enum
+    {
+        lanes = 4
+    };
+    typedef float32x4_t vec;
+
+    static NCNN_FORCEINLINE float32x4_t set1(float v)
+    {
+        return vdupq_n_f32(v);
+    }
+    static NCNN_FORCEINLINE float32x4_t load(const float* ptr)
+    {
+        return vld1q_f32(ptr);
+    }
+    static NCNN_FORCEINLINE void store(float* ptr, float32x4_t v)
+    {
+        vst1q_f32(ptr, v);
+    }
+    static NCNN_FORCEINLINE float32x4_t add(float32x4_t x, float32x4_t y)
+    {
+        return vaddq_f32(x, y);
+    }
+    static NCNN_FORCEINLINE float32x4_t sub(float32x4_t x, float32x4_t y)
+    {
+        return vsubq_f32(x, y);
+    }
+    static NCNN_FORCEINLINE float32x4_t mul(float32x4_t x, float32x4_t y)
+    {
+        return vmulq_f32(x, y);
+    }
+};
+#endif // __ARM_NEON
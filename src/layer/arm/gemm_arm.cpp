@@ -38,6 +38,8 @@ Gemm_arm::Gemm_arm()
     support_bf16_storage = true;
 #endif
 
+    support_batch = true;
+
     nT = 0;
 }
 
@@ -4742,6 +4744,42 @@ int Gemm_arm::create_pipeline(const Option& opt)
 
 int Gemm_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    int batch = 1;
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        batch = std::max(batch, bottom_blobs[i].n);
+    }
+    if (batch > 1)
+    {
+        // fold the batch into the gemm rows
+        const int M = bottom_blobs[0].h * bottom_blobs[0].elempack;
+        const int rows = M * batch;
+
+        int elempack = 1;
+        int out_elempack = 1;
+#if __ARM_NEON
+        if (opt.use_packing_layout)
+        {
+#if NCNN_ARM82
+            if (cpu_support_arm_asimdhp() && opt.use_fp16_storage && opt.use_fp16_arithmetic && bottom_blobs[0].elembits() == 16)
+            {
+                elempack = rows % 8 == 0 ? 8 : rows % 4 == 0 ? 4 : 1;
+                out_elempack = M % 8 == 0 ? 8 : M % 4 == 0 ? 4 : 1;
+            }
+            else
+#endif
+            {
+                elempack = rows % 4 == 0 ? 4 : 1;
+                out_elempack = M % 4 == 0 ? 4 : 1;
+            }
+        }
+#endif // __ARM_NEON
+        if (output_elempack)
+            out_elempack = output_elempack;
+
+        return forward_batch(bottom_blobs, top_blobs, elempack, out_elempack, opt);
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -0,0 +1,288 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gridsample_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+#include "arm_usability.h"
+#include "cpu.h"
+
+#include <math.h>
+
+namespace ncnn {
+
+#include "gridsample_compute_blob.h"
+#include "gridsample_bilinear_apply_interpolation.h"
+#include "gridsample_bicubic_apply_interpolation.h"
+#include "gridsample_nearest_apply_interpolation.h"
+
+GridSample_arm::GridSample_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+// fp32 copy of an input blob in the requested packing, fp16 and bf16 storage is cast at the boundary
+static int gridsample_cast_fp32(const Mat& src, Mat& dst, int dst_elempack, const Option& opt)
+{
+    Mat src_fp32 = src;
+#if NCNN_ARM82
+    if (opt.use_fp16_storage && src.elembits() == 16)
+    {
+        cast_float16_to_float32(src, src_fp32, opt);
+        if (src_fp32.empty())
+            return -100;
+    }
+    else
+#endif
+#if NCNN_BF16
+    if (opt.use_bf16_storage && src.elembits() == 16)
+    {
+        cast_bfloat16_to_float32(src, src_fp32, opt);
+        if (src_fp32.empty())
+            return -100;
+    }
+#endif
+
+    if (src_fp32.elempack > dst_elempack)
+    {
+        convert_packing(src_fp32, dst, dst_elempack, opt);
+        if (dst.empty())
+            return -100;
+
+        return 0;
+    }
+
+    dst = src_fp32;
+
+    return 0;
+}
+
+// resolve the padding and align_corner template for one compute_blob kernel
+#define GRIDSAMPLE_DISPATCH_COMPUTE_BLOB(func)                                                                 \
+    if (padding_mode == GridSample::Padding_ZEROS)                                                             \
+    {                                                                                                          \
+        if (align_corner == 0)                                                                                 \
+            func<GridSample::Padding_ZEROS, false>(bottom_blob, grid, offset_value_blob, permute_fusion);      \
+        else                                                                                                   \
+            func<GridSample::Padding_ZEROS, true>(bottom_blob, grid, offset_value_blob, permute_fusion);       \
+    }                                                                                                          \
+    else if (padding_mode == GridSample::Padding_BORDER)                                                       \
+    {                                                                                                          \
+        if (align_corner == 0)                                                                                 \
+            func<GridSample::Padding_BORDER, false>(bottom_blob, grid, offset_value_blob, permute_fusion);     \
+        else                                                                                                   \
+            func<GridSample::Padding_BORDER, true>(bottom_blob, grid, offset_value_blob, permute_fusion);      \
+    }                                                                                                          \
+    else if (padding_mode == GridSample::Padding_REFLECTION)                                                   \
+    {                                                                                                          \
+        if (align_corner == 0)                                                                                 \
+            func<GridSample::Padding_REFLECTION, false>(bottom_blob, grid, offset_value_blob, permute_fusion); \
+        else                                                                                                   \
+            func<GridSample::Padding_REFLECTION, true>(bottom_blob, grid, offset_value_blob, permute_fusion);  \
+    }                                                                                                          \
+    else                                                                                                       \
+    {                                                                                                          \
+        NCNN_LOGE("gridsample padding_mode error\n");                                                          \
+        return -100;                                                                                           \
+    }
+
+int GridSample_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& grid = bottom_blobs[1];
+    Mat& top_blob = top_blobs[0];
+
+    const bool use_fp16 = support_fp16_storage && opt.use_fp16_storage && bottom_blob.elembits() == 16;
+    const bool use_bf16 = !use_fp16 && opt.use_bf16_storage && bottom_blob.elembits() == 16;
+
+    if (!use_fp16 && !use_bf16)
+    {
+        Mat grid_p1;
+        int ret = gridsample_cast_fp32(grid, grid_p1, 1, opt);
+        if (ret != 0)
+            return ret;
+
+        return forward_fp32(bottom_blob, grid_p1, top_blob, opt);
+    }
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    opt_b.use_fp16_storage = use_fp16;
+
+    Mat bottom_blob_fp32;
+    int ret = gridsample_cast_fp32(bottom_blob, bottom_blob_fp32, 4, opt_b);
+    if (ret != 0)
+        return ret;
+
+    Mat grid_p1;
+    ret = gridsample_cast_fp32(grid, grid_p1, 1, opt_b);
+    if (ret != 0)
+        return ret;
+
+    Mat top_blob_fp32;
+    ret = forward_fp32(bottom_blob_fp32, grid_p1, top_blob_fp32, opt_b);
+    if (ret != 0)
+        return ret;
+
+#if NCNN_ARM82
+    if (use_fp16)
+    {
+        cast_float32_to_float16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+#if NCNN_BF16
+    if (use_bf16)
+    {
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+
+    top_blob = top_blob_fp32;
+
+    return 0;
+}
+
+int GridSample_arm::forward_fp32(const Mat& bottom_blob, const Mat& grid, Mat& top_blob, const Option& opt) const
+{
+    const int elempack = bottom_blob.elempack;
+    const int channels = bottom_blob.c;
+    const int dims = bottom_blob.dims;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    // per output location sample offsets and weights, shared by every channel
+    Mat offset_value_blob;
+
+    if (dims == 3)
+    {
+        const int outw = permute_fusion == 0 ? grid.h : grid.w;
+        const int outh = permute_fusion == 0 ? grid.c : grid.h;
+
+        top_blob.create(outw, outh, channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        if (sample_type == GridSample::Interpolation_BILINEAR)
+        {
+            offset_value_blob.create(outw, outh, (size_t)4u * 6, 6, opt.workspace_allocator);
+            if (offset_value_blob.empty())
+                return -100;
+
+            GRIDSAMPLE_DISPATCH_COMPUTE_BLOB(gridsample_2d_bilinear_compute_blob)
+
+#if __ARM_NEON
+            if (elempack == 4)
+                gridsample_2d_bilinear_apply_interpolation_p4(bottom_blob, top_blob, offset_value_blob, opt);
+#endif // __ARM_NEON
+            if (elempack == 1)
+                gridsample_2d_bilinear_apply_interpolation_p1(bottom_blob, top_blob, offset_value_blob, opt);
+        }
+
+        if (sample_type == GridSample::Interpolation_NEAREST)
+        {
+            offset_value_blob.create(outw, outh, 1, (size_t)4u, 1, opt.workspace_allocator);
+            if (offset_value_blob.empty())
+                return -100;
+
+            GRIDSAMPLE_DISPATCH_COMPUTE_BLOB(gridsample_2d_nearest_compute_blob)
+
+#if __ARM_NEON
+            if (elempack == 4)
+                gridsample_nearest_apply_interpolation_p4(bottom_blob, top_blob, offset_value_blob, opt);
+#endif // __ARM_NEON
+            if (elempack == 1)
+                gridsample_nearest_apply_interpolation_p1(bottom_blob, top_blob, offset_value_blob, opt);
+        }
+
+        if (sample_type == GridSample::Interpolation_BICUBIC)
+        {
+            offset_value_blob.create(outw, outh, (size_t)4u * 18, 18, opt.workspace_allocator);
+            if (offset_value_blob.empty())
+                return -100;
+
+            GRIDSAMPLE_DISPATCH_COMPUTE_BLOB(gridsample_2d_bicubic_compute_blob)
+
+#if __ARM_NEON
+            if (elempack == 4)
+                gridsample_2d_bicubic_apply_interpolation_p4(bottom_blob, top_blob, offset_value_blob, opt);
+#endif // __ARM_NEON
+            if (elempack == 1)
+                gridsample_2d_bicubic_apply_interpolation_p1(bottom_blob, top_blob, offset_value_blob, opt);
+        }
+    }
+
+    if (dims == 4)
+    {
+        const int outw = permute_fusion == 0 ? grid.h : grid.w;
+        const int outh = permute_fusion == 0 ? grid.d : grid.h;
+        const int outd = permute_fusion == 0 ? grid.c : grid.d;
+
+        top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        if (sample_type == GridSample::Interpolation_BILINEAR)
+        {
+            offset_value_blob.create(outw, outh, outd, (size_t)4u * 11, 11, opt.workspace_allocator);
+            if (offset_value_blob.empty())
+                return -100;
+
+            GRIDSAMPLE_DISPATCH_COMPUTE_BLOB(gridsample_3d_bilinear_compute_blob)
+
+#if __ARM_NEON
+            if (elempack == 4)
+                gridsample_3d_bilinear_apply_interpolation_p4(bottom_blob, top_blob, offset_value_blob, opt);
+#endif // __ARM_NEON
+            if (elempack == 1)
+                gridsample_3d_bilinear_apply_interpolation_p1(bottom_blob, top_blob, offset_value_blob, opt);
+        }
+
+        if (sample_type == GridSample::Interpolation_NEAREST)
+        {
+            offset_value_blob.create(outw, outh, outd, 1, (size_t)4u, 1, opt.workspace_allocator);
+            if (offset_value_blob.empty())
+                return -100;
+
+            GRIDSAMPLE_DISPATCH_COMPUTE_BLOB(gridsample_3d_nearest_compute_blob)
+
+#if __ARM_NEON
+            if (elempack == 4)
+                gridsample_nearest_apply_interpolation_p4(bottom_blob, top_blob, offset_value_blob, opt);
+#endif // __ARM_NEON
+            if (elempack == 1)
+                gridsample_nearest_apply_interpolation_p1(bottom_blob, top_blob, offset_value_blob, opt);
+        }
+
+        if (sample_type == GridSample::Interpolation_BICUBIC)
+        {
+            NCNN_LOGE("unsupported bicubic when dims == 4");
+            return -100;
+        }
+    }
+
+    return 0;
+}
+
+#undef GRIDSAMPLE_DISPATCH_COMPUTE_BLOB
+
+} // namespace ncnn
@@ -0,0 +1,116 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+static inline void cubic_interp1d(float& coeffs0, float& coeffs1, float& coeffs2, float& coeffs3, float fx)
+{
+    const float A = -0.75f;
+
+    float fx0 = fx + 1;
+    float fx1 = fx;
+    float fx2 = 1 - fx;
+    // float fx3 = 2 - fx;
+
+    coeffs0 = A * fx0 * fx0 * fx0 - 5 * A * fx0 * fx0 + 8 * A * fx0 - 4 * A;
+    coeffs1 = (A + 2) * fx1 * fx1 * fx1 - (A + 3) * fx1 * fx1 + 1;
+    coeffs2 = (A + 2) * fx2 * fx2 * fx2 - (A + 3) * fx2 * fx2 + 1;
+    coeffs3 = 1.f - coeffs0 - coeffs1 - coeffs2;
+}
+
+#if __ARM_NEON
+static void gridsample_2d_bicubic_apply_interpolation_p4(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int grid_size = outw * outh;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const float* offset_value_ptr = offset_value.channel(0);
+
+        for (int i = 0; i < grid_size; i++)
+        {
+            float x_coeffs[4];
+            float y_coeffs[4];
+            cubic_interp1d(x_coeffs[0], x_coeffs[1], x_coeffs[2], x_coeffs[3], offset_value_ptr[0]);
+            cubic_interp1d(y_coeffs[0], y_coeffs[1], y_coeffs[2], y_coeffs[3], offset_value_ptr[1]);
+
+            const int* offset_ptr = (const int*)offset_value_ptr + 2;
+
+            float32x4_t _v = vdupq_n_f32(0.f);
+            for (int ii = 0; ii < 4; ii++)
+            {
+                float32x4_t _x0 = offset_ptr[0] >= 0 ? vld1q_f32(srcptr + offset_ptr[0]) : vdupq_n_f32(0.f);
+                float32x4_t _x1 = offset_ptr[1] >= 0 ? vld1q_f32(srcptr + offset_ptr[1]) : vdupq_n_f32(0.f);
+                float32x4_t _x2 = offset_ptr[2] >= 0 ? vld1q_f32(srcptr + offset_ptr[2]) : vdupq_n_f32(0.f);
+                float32x4_t _x3 = offset_ptr[3] >= 0 ? vld1q_f32(srcptr + offset_ptr[3]) : vdupq_n_f32(0.f);
+
+                float32x4_t _row = vmulq_n_f32(_x0, x_coeffs[0]);
+                _row = vmlaq_n_f32(_row, _x1, x_coeffs[1]);
+                _row = vmlaq_n_f32(_row, _x2, x_coeffs[2]);
+                _row = vmlaq_n_f32(_row, _x3, x_coeffs[3]);
+
+                _v = vmlaq_n_f32(_v, _row, y_coeffs[ii]);
+
+                offset_ptr += 4;
+            }
+
+            vst1q_f32(dstptr, _v);
+
+            dstptr += 4;
+            offset_value_ptr += 18;
+        }
+    }
+}
+#endif // __ARM_NEON
+
+static void gridsample_2d_bicubic_apply_interpolation_p1(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int grid_size = outw * outh;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const float* offset_value_ptr = offset_value.channel(0);
+
+        for (int x = 0; x < grid_size; x++)
+        {
+            float x_coeffs[4];
+            float y_coeffs[4];
+            cubic_interp1d(x_coeffs[0], x_coeffs[1], x_coeffs[2], x_coeffs[3], offset_value_ptr[0]);
+            cubic_interp1d(y_coeffs[0], y_coeffs[1], y_coeffs[2], y_coeffs[3], offset_value_ptr[1]);
+
+            const int* offset_ptr = (const int*)offset_value_ptr + 2;
+
+            float v = 0.f;
+            for (int ii = 0; ii < 4; ii++)
+            {
+                float x0_val = offset_ptr[0] >= 0 ? *(srcptr + offset_ptr[0]) : 0;
+                float x1_val = offset_ptr[1] >= 0 ? *(srcptr + offset_ptr[1]) : 0;
+                float x2_val = offset_ptr[2] >= 0 ? *(srcptr + offset_ptr[2]) : 0;
+                float x3_val = offset_ptr[3] >= 0 ? *(srcptr + offset_ptr[3]) : 0;
+
+                float row = x_coeffs[0] * x0_val + x_coeffs[1] * x1_val + x_coeffs[2] * x2_val + x_coeffs[3] * x3_val;
+
+                v += y_coeffs[ii] * row;
+
+                offset_ptr += 4;
+            }
+
+            *dstptr = v;
+
+            dstptr++;
+            offset_value_ptr += 18;
+        }
+    }
+}
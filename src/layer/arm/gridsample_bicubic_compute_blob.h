@@ -0,0 +1,86 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+template<GridSample::PaddingMode pd, bool align_corner>
+static void gridsample_2d_bicubic_compute_blob_pack1(const Mat& src, float sample_x, float sample_y, float* offset_value_ptr)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    sample_x = unormalize(src.w, sample_x);
+    sample_y = unormalize(src.h, sample_y);
+
+    int x1 = (int)floorf(sample_x);
+    int y1 = (int)floorf(sample_y);
+    int x0 = x1 - 1;
+    int x2 = x1 + 1;
+    int x3 = x1 + 2;
+
+    offset_value_ptr[0] = sample_x - static_cast<float>(x1);
+    offset_value_ptr[1] = sample_y - static_cast<float>(y1);
+
+    x1 = (int)get_coord(src.w, (float)x1);
+    x0 = (int)get_coord(src.w, (float)x0);
+    x2 = (int)get_coord(src.w, (float)x2);
+    x3 = (int)get_coord(src.w, (float)x3);
+
+    bool x1_in_range = (x1 > -1) & (x1 < src.w);
+    bool x0_in_range = (x0 > -1) & (x0 < src.w);
+    bool x2_in_range = (x2 > -1) & (x2 < src.w);
+    bool x3_in_range = (x3 > -1) & (x3 < src.w);
+
+    int* offset_ptr = (int*)offset_value_ptr + 2;
+
+    for (int i = 0; i < 4; i++)
+    {
+        int gy = (int)get_coord(src.h, (float)(y1 + i - 1));
+        int offset_y = gy * src.w;
+
+        bool y_in_range = (gy > -1) & (gy < src.h);
+
+        offset_ptr[0] = (x0_in_range & y_in_range) ? (offset_y + x0) * src.elempack : -1;
+        offset_ptr[1] = (x1_in_range & y_in_range) ? (offset_y + x1) * src.elempack : -1;
+        offset_ptr[2] = (x2_in_range & y_in_range) ? (offset_y + x2) * src.elempack : -1;
+        offset_ptr[3] = (x3_in_range & y_in_range) ? (offset_y + x3) * src.elempack : -1;
+
+        offset_ptr += 4;
+    }
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+void gridsample_2d_bicubic_compute_blob(const Mat& src, const Mat& grid, Mat& offset_value, int permute_fusion)
+{
+    const int grid_size = grid.w * grid.h;
+
+    float* offset_value_ptr = offset_value.channel(0);
+
+    if (permute_fusion == 0)
+    {
+        for (int y = 0; y < grid.c; y++)
+        {
+            const float* gridptr = grid.channel(y);
+
+            for (int x = 0; x < grid_size; x += 2)
+            {
+                gridsample_2d_bicubic_compute_blob_pack1<pd, align_corner>(src, gridptr[0], gridptr[1], offset_value_ptr);
+
+                gridptr += 2;
+                offset_value_ptr += 18;
+            }
+        }
+    }
+    else
+    {
+        const float* gridptr_x = grid.channel(0);
+        const float* gridptr_y = grid.channel(1);
+
+        for (int x = 0; x < grid_size; x++)
+        {
+            gridsample_2d_bicubic_compute_blob_pack1<pd, align_corner>(src, *gridptr_x, *gridptr_y, offset_value_ptr);
+
+            gridptr_x++;
+            gridptr_y++;
+            offset_value_ptr += 18;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#if __ARM_NEON
+static void gridsample_2d_bilinear_apply_interpolation_p4(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int grid_size = outw * outh;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const float* offset_value_ptr = offset_value.channel(0);
+
+        for (int i = 0; i < grid_size; i++)
+        {
+            const int* offset_ptr = (const int*)offset_value_ptr;
+            const float* value_ptr = offset_value_ptr + 4;
+
+            float32x4_t _v00 = offset_ptr[0] >= 0 ? vld1q_f32(srcptr + offset_ptr[0]) : vdupq_n_f32(0.f);
+            float32x4_t _v01 = offset_ptr[1] >= 0 ? vld1q_f32(srcptr + offset_ptr[1]) : vdupq_n_f32(0.f);
+            float32x4_t _v10 = offset_ptr[2] >= 0 ? vld1q_f32(srcptr + offset_ptr[2]) : vdupq_n_f32(0.f);
+            float32x4_t _v11 = offset_ptr[3] >= 0 ? vld1q_f32(srcptr + offset_ptr[3]) : vdupq_n_f32(0.f);
+
+            float32x4_t _v0 = vmlaq_n_f32(_v00, vsubq_f32(_v01, _v00), value_ptr[0]);
+            float32x4_t _v1 = vmlaq_n_f32(_v10, vsubq_f32(_v11, _v10), value_ptr[0]);
+            float32x4_t _v = vmlaq_n_f32(_v0, vsubq_f32(_v1, _v0), value_ptr[1]);
+
+            vst1q_f32(dstptr, _v);
+
+            dstptr += 4;
+            offset_value_ptr += 6;
+        }
+    }
+}
+
+static void gridsample_3d_bilinear_apply_interpolation_p4(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int outd = dst.d;
+    const int grid_size = outw * outh * outd;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const float* offset_value_ptr = offset_value.channel(0);
+
+        for (int i = 0; i < grid_size; i++)
+        {
+            const int* offset_ptr = (const int*)offset_value_ptr;
+            const float* value_ptr = offset_value_ptr + 8;
+
+            float32x4_t _v000 = offset_ptr[0] >= 0 ? vld1q_f32(srcptr + offset_ptr[0]) : vdupq_n_f32(0.f);
+            float32x4_t _v001 = offset_ptr[1] >= 0 ? vld1q_f32(srcptr + offset_ptr[1]) : vdupq_n_f32(0.f);
+            float32x4_t _v010 = offset_ptr[2] >= 0 ? vld1q_f32(srcptr + offset_ptr[2]) : vdupq_n_f32(0.f);
+            float32x4_t _v011 = offset_ptr[3] >= 0 ? vld1q_f32(srcptr + offset_ptr[3]) : vdupq_n_f32(0.f);
+            float32x4_t _v100 = offset_ptr[4] >= 0 ? vld1q_f32(srcptr + offset_ptr[4]) : vdupq_n_f32(0.f);
+            float32x4_t _v101 = offset_ptr[5] >= 0 ? vld1q_f32(srcptr + offset_ptr[5]) : vdupq_n_f32(0.f);
+            float32x4_t _v110 = offset_ptr[6] >= 0 ? vld1q_f32(srcptr + offset_ptr[6]) : vdupq_n_f32(0.f);
+            float32x4_t _v111 = offset_ptr[7] >= 0 ? vld1q_f32(srcptr + offset_ptr[7]) : vdupq_n_f32(0.f);
+
+            float32x4_t _v00 = vmlaq_n_f32(_v000, vsubq_f32(_v001, _v000), value_ptr[0]);
+            float32x4_t _v01 = vmlaq_n_f32(_v010, vsubq_f32(_v011, _v010), value_ptr[0]);
+            float32x4_t _v10 = vmlaq_n_f32(_v100, vsubq_f32(_v101, _v100), value_ptr[0]);
+            float32x4_t _v11 = vmlaq_n_f32(_v110, vsubq_f32(_v111, _v110), value_ptr[0]);
+
+            float32x4_t _v0 = vmlaq_n_f32(_v00, vsubq_f32(_v01, _v00), value_ptr[1]);
+            float32x4_t _v1 = vmlaq_n_f32(_v10, vsubq_f32(_v11, _v10), value_ptr[1]);
+
+            float32x4_t _v = vmlaq_n_f32(_v0, vsubq_f32(_v1, _v0), value_ptr[2]);
+
+            vst1q_f32(dstptr, _v);
+
+            dstptr += 4;
+            offset_value_ptr += 11;
+        }
+    }
+}
+#endif // __ARM_NEON
+
+static void gridsample_2d_bilinear_apply_interpolation_p1(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int grid_size = outw * outh;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const float* offset_value_ptr = offset_value.channel(0);
+
+        for (int x = 0; x < grid_size; x++)
+        {
+            const int* offset_ptr = (const int*)offset_value_ptr;
+            const float* value_ptr = offset_value_ptr + 4;
+
+            float v00 = offset_ptr[0] >= 0 ? *(srcptr + offset_ptr[0]) : 0;
+            float v01 = offset_ptr[1] >= 0 ? *(srcptr + offset_ptr[1]) : 0;
+            float v10 = offset_ptr[2] >= 0 ? *(srcptr + offset_ptr[2]) : 0;
+            float v11 = offset_ptr[3] >= 0 ? *(srcptr + offset_ptr[3]) : 0;
+
+            float v0 = v00 * (1 - value_ptr[0]) + v01 * value_ptr[0];
+            float v1 = v10 * (1 - value_ptr[0]) + v11 * value_ptr[0];
+
+            *dstptr = v0 * (1 - value_ptr[1]) + v1 * value_ptr[1];
+
+            dstptr++;
+            offset_value_ptr += 6;
+        }
+    }
+}
+
+static void gridsample_3d_bilinear_apply_interpolation_p1(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int outd = dst.d;
+    const int grid_size = outw * outh * outd;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const float* offset_value_ptr = offset_value.channel(0);
+
+        for (int x = 0; x < grid_size; x++)
+        {
+            const int* offset_ptr = (const int*)offset_value_ptr;
+            const float* value_ptr = offset_value_ptr + 8;
+
+            float v000 = offset_ptr[0] >= 0 ? *(srcptr + offset_ptr[0]) : 0;
+            float v001 = offset_ptr[1] >= 0 ? *(srcptr + offset_ptr[1]) : 0;
+            float v010 = offset_ptr[2] >= 0 ? *(srcptr + offset_ptr[2]) : 0;
+            float v011 = offset_ptr[3] >= 0 ? *(srcptr + offset_ptr[3]) : 0;
+            float v100 = offset_ptr[4] >= 0 ? *(srcptr + offset_ptr[4]) : 0;
+            float v101 = offset_ptr[5] >= 0 ? *(srcptr + offset_ptr[5]) : 0;
+            float v110 = offset_ptr[6] >= 0 ? *(srcptr + offset_ptr[6]) : 0;
+            float v111 = offset_ptr[7] >= 0 ? *(srcptr + offset_ptr[7]) : 0;
+
+            float v00 = v000 * (1 - value_ptr[0]) + v001 * value_ptr[0];
+            float v01 = v010 * (1 - value_ptr[0]) + v011 * value_ptr[0];
+            float v10 = v100 * (1 - value_ptr[0]) + v101 * value_ptr[0];
+            float v11 = v110 * (1 - value_ptr[0]) + v111 * value_ptr[0];
+
+            float v0 = v00 * (1 - value_ptr[1]) + v01 * value_ptr[1];
+            float v1 = v10 * (1 - value_ptr[1]) + v11 * value_ptr[1];
+
+            *dstptr = v0 * (1 - value_ptr[2]) + v1 * value_ptr[2];
+
+            dstptr++;
+            offset_value_ptr += 11;
+        }
+    }
+}
@@ -0,0 +1,329 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#if __ARM_NEON
+template<GridSample::PaddingMode pd, bool align_corner>
+static void gridsample_2d_bilinear_compute_blob_pack4(const Mat& src, float32x4_t gx, float32x4_t gy, float* offset_value_ptr)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    const float32x4_t _w = vdupq_n_f32(src.w);
+    const float32x4_t _h = vdupq_n_f32(src.h);
+
+    gx = get_coord(_w, unormalize(_w, gx));
+    gy = get_coord(_h, unormalize(_h, gy));
+
+    float32x4_t x_w = floor_ps(gx);
+    float32x4_t y_n = floor_ps(gy);
+
+    uint32x4_t x0_in_range = grid_sample_in_range(x_w, _w);
+    uint32x4_t x1_in_range = grid_sample_in_range(vaddq_f32(x_w, vdupq_n_f32(1.f)), _w);
+    uint32x4_t y0_in_range = grid_sample_in_range(y_n, _h);
+    uint32x4_t y1_in_range = grid_sample_in_range(vaddq_f32(y_n, vdupq_n_f32(1.f)), _h);
+
+    const int32x4_t _elempack = vdupq_n_s32(src.elempack);
+    const int32x4_t _row = vdupq_n_s32(src.w * src.elempack);
+
+    int32x4_t nw_offset = vmulq_s32(vmlaq_s32(vcvtq_s32_f32(x_w), vcvtq_s32_f32(y_n), vdupq_n_s32(src.w)), _elempack);
+    int32x4_t ne_offset = vaddq_s32(nw_offset, _elempack);
+    int32x4_t sw_offset = vaddq_s32(nw_offset, _row);
+    int32x4_t se_offset = vaddq_s32(sw_offset, _elempack);
+
+    float32x4_t _nw = vreinterpretq_f32_s32(grid_sample_offset(nw_offset, vandq_u32(x0_in_range, y0_in_range)));
+    float32x4_t _ne = vreinterpretq_f32_s32(grid_sample_offset(ne_offset, vandq_u32(x1_in_range, y0_in_range)));
+    float32x4_t _sw = vreinterpretq_f32_s32(grid_sample_offset(sw_offset, vandq_u32(x0_in_range, y1_in_range)));
+    float32x4_t _se = vreinterpretq_f32_s32(grid_sample_offset(se_offset, vandq_u32(x1_in_range, y1_in_range)));
+
+    float32x4x2_t _ab = vzipq_f32(vsubq_f32(gx, x_w), vsubq_f32(gy, y_n));
+
+    // 4 records of nw ne sw se alpha beta
+    transpose4x4_ps(_nw, _ne, _sw, _se);
+
+    vst1q_f32(offset_value_ptr, _nw);
+    vst1_f32(offset_value_ptr + 4, vget_low_f32(_ab.val[0]));
+    vst1q_f32(offset_value_ptr + 6, _ne);
+    vst1_f32(offset_value_ptr + 10, vget_high_f32(_ab.val[0]));
+    vst1q_f32(offset_value_ptr + 12, _sw);
+    vst1_f32(offset_value_ptr + 16, vget_low_f32(_ab.val[1]));
+    vst1q_f32(offset_value_ptr + 18, _se);
+    vst1_f32(offset_value_ptr + 22, vget_high_f32(_ab.val[1]));
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+static void gridsample_3d_bilinear_compute_blob_pack4(const Mat& src, float32x4_t gx, float32x4_t gy, float32x4_t gz, float* offset_value_ptr)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    const float32x4_t _w = vdupq_n_f32(src.w);
+    const float32x4_t _h = vdupq_n_f32(src.h);
+    const float32x4_t _d = vdupq_n_f32(src.d);
+
+    gx = get_coord(_w, unormalize(_w, gx));
+    gy = get_coord(_h, unormalize(_h, gy));
+    gz = get_coord(_d, unormalize(_d, gz));
+
+    float32x4_t x_w = floor_ps(gx);
+    float32x4_t y_n = floor_ps(gy);
+    float32x4_t z_t = floor_ps(gz);
+
+    uint32x4_t x0_in_range = grid_sample_in_range(x_w, _w);
+    uint32x4_t x1_in_range = grid_sample_in_range(vaddq_f32(x_w, vdupq_n_f32(1.f)), _w);
+    uint32x4_t y0_in_range = grid_sample_in_range(y_n, _h);
+    uint32x4_t y1_in_range = grid_sample_in_range(vaddq_f32(y_n, vdupq_n_f32(1.f)), _h);
+    uint32x4_t z0_in_range = grid_sample_in_range(z_t, _d);
+    uint32x4_t z1_in_range = grid_sample_in_range(vaddq_f32(z_t, vdupq_n_f32(1.f)), _d);
+
+    uint32x4_t v00_in_range = vandq_u32(x0_in_range, y0_in_range);
+    uint32x4_t v01_in_range = vandq_u32(x1_in_range, y0_in_range);
+    uint32x4_t v10_in_range = vandq_u32(x0_in_range, y1_in_range);
+    uint32x4_t v11_in_range = vandq_u32(x1_in_range, y1_in_range);
+
+    const int32x4_t _elempack = vdupq_n_s32(src.elempack);
+    const int32x4_t _row = vdupq_n_s32(src.w * src.elempack);
+    const int32x4_t _slice = vdupq_n_s32(src.w * src.h * src.elempack);
+
+    int32x4_t tnw_offset = vmulq_s32(vmlaq_s32(vmlaq_s32(vcvtq_s32_f32(x_w), vcvtq_s32_f32(y_n), vdupq_n_s32(src.w)), vcvtq_s32_f32(z_t), vdupq_n_s32(src.w * src.h)), _elempack);
+    int32x4_t tne_offset = vaddq_s32(tnw_offset, _elempack);
+    int32x4_t tsw_offset = vaddq_s32(tnw_offset, _row);
+    int32x4_t tse_offset = vaddq_s32(tsw_offset, _elempack);
+    int32x4_t bnw_offset = vaddq_s32(tnw_offset, _slice);
+    int32x4_t bne_offset = vaddq_s32(bnw_offset, _elempack);
+    int32x4_t bsw_offset = vaddq_s32(bnw_offset, _row);
+    int32x4_t bse_offset = vaddq_s32(bsw_offset, _elempack);
+
+    int offsets[8][4];
+    vst1q_s32(offsets[0], grid_sample_offset(tnw_offset, vandq_u32(v00_in_range, z0_in_range)));
+    vst1q_s32(offsets[1], grid_sample_offset(tne_offset, vandq_u32(v01_in_range, z0_in_range)));
+    vst1q_s32(offsets[2], grid_sample_offset(tsw_offset, vandq_u32(v10_in_range, z0_in_range)));
+    vst1q_s32(offsets[3], grid_sample_offset(tse_offset, vandq_u32(v11_in_range, z0_in_range)));
+    vst1q_s32(offsets[4], grid_sample_offset(bnw_offset, vandq_u32(v00_in_range, z1_in_range)));
+    vst1q_s32(offsets[5], grid_sample_offset(bne_offset, vandq_u32(v01_in_range, z1_in_range)));
+    vst1q_s32(offsets[6], grid_sample_offset(bsw_offset, vandq_u32(v10_in_range, z1_in_range)));
+    vst1q_s32(offsets[7], grid_sample_offset(bse_offset, vandq_u32(v11_in_range, z1_in_range)));
+
+    float values[3][4];
+    vst1q_f32(values[0], vsubq_f32(gx, x_w));
+    vst1q_f32(values[1], vsubq_f32(gy, y_n));
+    vst1q_f32(values[2], vsubq_f32(gz, z_t));
+
+    for (int l = 0; l < 4; l++)
+    {
+        int* offset_ptr = (int*)offset_value_ptr;
+        for (int k = 0; k < 8; k++)
+        {
+            offset_ptr[k] = offsets[k][l];
+        }
+
+        offset_value_ptr[8] = values[0][l];
+        offset_value_ptr[9] = values[1][l];
+        offset_value_ptr[10] = values[2][l];
+
+        offset_value_ptr += 11;
+    }
+}
+#endif // __ARM_NEON
+
+template<GridSample::PaddingMode pd, bool align_corner>
+static void gridsample_2d_bilinear_compute_blob_pack1(const Mat& src, float sample_x, float sample_y, float* offset_value_ptr)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    sample_x = get_coord(src.w, unormalize(src.w, sample_x));
+    sample_y = get_coord(src.h, unormalize(src.h, sample_y));
+
+    int x0 = (int)floorf(sample_x);
+    int y0 = (int)floorf(sample_y);
+    int x1 = x0 + 1;
+    int y1 = y0 + 1;
+
+    bool x0_in_bound = (x0 > -1) & (x0 < src.w);
+    bool x1_in_bound = (x1 > -1) & (x1 < src.w);
+    bool y0_in_bound = (y0 > -1) & (y0 < src.h);
+    bool y1_in_bound = (y1 > -1) & (y1 < src.h);
+
+    int* offset_ptr = (int*)offset_value_ptr;
+    float* value_ptr = offset_value_ptr + 4;
+
+    offset_ptr[0] = (x0_in_bound & y0_in_bound) ? (x0 + y0 * src.w) * src.elempack : -1;
+    offset_ptr[1] = (x1_in_bound & y0_in_bound) ? (x1 + y0 * src.w) * src.elempack : -1;
+    offset_ptr[2] = (x0_in_bound & y1_in_bound) ? (x0 + y1 * src.w) * src.elempack : -1;
+    offset_ptr[3] = (x1_in_bound & y1_in_bound) ? (x1 + y1 * src.w) * src.elempack : -1;
+
+    value_ptr[0] = sample_x - x0;
+    value_ptr[1] = sample_y - y0;
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+static void gridsample_3d_bilinear_compute_blob_pack1(const Mat& src, float sample_x, float sample_y, float sample_z, float* offset_value_ptr)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    sample_x = get_coord(src.w, unormalize(src.w, sample_x));
+    sample_y = get_coord(src.h, unormalize(src.h, sample_y));
+    sample_z = get_coord(src.d, unormalize(src.d, sample_z));
+
+    int x0 = (int)floorf(sample_x);
+    int y0 = (int)floorf(sample_y);
+    int z0 = (int)floorf(sample_z);
+    int x1 = x0 + 1;
+    int y1 = y0 + 1;
+    int z1 = z0 + 1;
+
+    bool x0_in_range = (x0 > -1) & (x0 < src.w);
+    bool y0_in_range = (y0 > -1) & (y0 < src.h);
+    bool z0_in_range = (z0 > -1) & (z0 < src.d);
+    bool x1_in_range = (x1 > -1) & (x1 < src.w);
+    bool y1_in_range = (y1 > -1) & (y1 < src.h);
+    bool z1_in_range = (z1 > -1) & (z1 < src.d);
+
+    bool v00_in_range = x0_in_range & y0_in_range;
+    bool v01_in_range = x1_in_range & y0_in_range;
+    bool v10_in_range = x0_in_range & y1_in_range;
+    bool v11_in_range = x1_in_range & y1_in_range;
+
+    int* offset_ptr = (int*)offset_value_ptr;
+    float* value_ptr = offset_value_ptr + 8;
+
+    offset_ptr[0] = (v00_in_range & z0_in_range) ? (x0 + y0 * src.w + z0 * src.w * src.h) * src.elempack : -1;
+    offset_ptr[1] = (v01_in_range & z0_in_range) ? (x1 + y0 * src.w + z0 * src.w * src.h) * src.elempack : -1;
+    offset_ptr[2] = (v10_in_range & z0_in_range) ? (x0 + y1 * src.w + z0 * src.w * src.h) * src.elempack : -1;
+    offset_ptr[3] = (v11_in_range & z0_in_range) ? (x1 + y1 * src.w + z0 * src.w * src.h) * src.elempack : -1;
+
+    offset_ptr[4] = (v00_in_range & z1_in_range) ? (x0 + y0 * src.w + z1 * src.w * src.h) * src.elempack : -1;
+    offset_ptr[5] = (v01_in_range & z1_in_range) ? (x1 + y0 * src.w + z1 * src.w * src.h) * src.elempack : -1;
+    offset_ptr[6] = (v10_in_range & z1_in_range) ? (x0 + y1 * src.w + z1 * src.w * src.h) * src.elempack : -1;
+    offset_ptr[7] = (v11_in_range & z1_in_range) ? (x1 + y1 * src.w + z1 * src.w * src.h) * src.elempack : -1;
+
+    value_ptr[0] = sample_x - x0;
+    value_ptr[1] = sample_y - y0;
+    value_ptr[2] = sample_z - z0;
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+void gridsample_2d_bilinear_compute_blob(const Mat& src, const Mat& grid, Mat& offset_value, int permute_fusion)
+{
+    const int grid_size = grid.w * grid.h;
+
+    float* offset_value_ptr = offset_value.channel(0);
+
+    if (permute_fusion == 0)
+    {
+        for (int y = 0; y < grid.c; y++)
+        {
+            const float* gridptr = grid.channel(y);
+
+            int x = 0;
+#if __ARM_NEON
+            for (; x + 7 < grid_size; x += 8)
+            {
+                float32x4x2_t _g = vld2q_f32(gridptr);
+
+                gridsample_2d_bilinear_compute_blob_pack4<pd, align_corner>(src, _g.val[0], _g.val[1], offset_value_ptr);
+
+                gridptr += 8;
+                offset_value_ptr += 24;
+            }
+#endif // __ARM_NEON
+            for (; x < grid_size; x += 2)
+            {
+                gridsample_2d_bilinear_compute_blob_pack1<pd, align_corner>(src, gridptr[0], gridptr[1], offset_value_ptr);
+
+                gridptr += 2;
+                offset_value_ptr += 6;
+            }
+        }
+    }
+    else
+    {
+        const float* gridptr_x = grid.channel(0);
+        const float* gridptr_y = grid.channel(1);
+
+        int x = 0;
+#if __ARM_NEON
+        for (; x + 3 < grid_size; x += 4)
+        {
+            gridsample_2d_bilinear_compute_blob_pack4<pd, align_corner>(src, vld1q_f32(gridptr_x), vld1q_f32(gridptr_y), offset_value_ptr);
+
+            gridptr_x += 4;
+            gridptr_y += 4;
+            offset_value_ptr += 24;
+        }
+#endif // __ARM_NEON
+        for (; x < grid_size; x++)
+        {
+            gridsample_2d_bilinear_compute_blob_pack1<pd, align_corner>(src, *gridptr_x, *gridptr_y, offset_value_ptr);
+
+            gridptr_x++;
+            gridptr_y++;
+            offset_value_ptr += 6;
+        }
+    }
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+void gridsample_3d_bilinear_compute_blob(const Mat& src, const Mat& grid, Mat& offset_value, int permute_fusion)
+{
+    const int grid_size = grid.w * grid.h * grid.d;
+
+    float* offset_value_ptr = offset_value.channel(0);
+
+    if (permute_fusion == 0)
+    {
+        for (int y = 0; y < grid.c; y++)
+        {
+            const float* gridptr = grid.channel(y);
+
+            int x = 0;
+#if __ARM_NEON
+            for (; x + 11 < grid_size; x += 12)
+            {
+                float32x4x3_t _g = vld3q_f32(gridptr);
+
+                gridsample_3d_bilinear_compute_blob_pack4<pd, align_corner>(src, _g.val[0], _g.val[1], _g.val[2], offset_value_ptr);
+
+                gridptr += 12;
+                offset_value_ptr += 44;
+            }
+#endif // __ARM_NEON
+            for (; x < grid_size; x += 3)
+            {
+                gridsample_3d_bilinear_compute_blob_pack1<pd, align_corner>(src, gridptr[0], gridptr[1], gridptr[2], offset_value_ptr);
+
+                gridptr += 3;
+                offset_value_ptr += 11;
+            }
+        }
+    }
+    else
+    {
+        const float* gridptr_x = grid.channel(0);
+        const float* gridptr_y = grid.channel(1);
+        const float* gridptr_z = grid.channel(2);
+
+        int x = 0;
+#if __ARM_NEON
+        for (; x + 3 < grid_size; x += 4)
+        {
+            gridsample_3d_bilinear_compute_blob_pack4<pd, align_corner>(src, vld1q_f32(gridptr_x), vld1q_f32(gridptr_y), vld1q_f32(gridptr_z), offset_value_ptr);
+
+            gridptr_x += 4;
+            gridptr_y += 4;
+            gridptr_z += 4;
+            offset_value_ptr += 44;
+        }
+#endif // __ARM_NEON
+        for (; x < grid_size; x++)
+        {
+            gridsample_3d_bilinear_compute_blob_pack1<pd, align_corner>(src, *gridptr_x, *gridptr_y, *gridptr_z, offset_value_ptr);
+
+            gridptr_x++;
+            gridptr_y++;
+            gridptr_z++;
+            offset_value_ptr += 11;
+        }
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+template<bool align_corner>
+struct grid_sample_unormalize;
+
+template<>
+struct grid_sample_unormalize</*align_corner*/ true>
+{
+#if __ARM_NEON
+    float32x4_t operator()(float32x4_t length, float32x4_t coord)
+    {
+        return vmulq_f32(vmulq_n_f32(vaddq_f32(coord, vdupq_n_f32(1.f)), 0.5f), vsubq_f32(length, vdupq_n_f32(1.f)));
+    }
+#endif // __ARM_NEON
+    float operator()(int length, float coord)
+    {
+        return (coord + 1) / 2.f * (length - 1);
+    }
+};
+
+template<>
+struct grid_sample_unormalize</*align_corner*/ false>
+{
+#if __ARM_NEON
+    float32x4_t operator()(float32x4_t length, float32x4_t coord)
+    {
+        return vmulq_n_f32(vsubq_f32(vmulq_f32(vaddq_f32(coord, vdupq_n_f32(1.f)), length), vdupq_n_f32(1.f)), 0.5f);
+    }
+#endif // __ARM_NEON
+    float operator()(int length, float coord)
+    {
+        return ((coord + 1) * length - 1) / 2.f;
+    }
+};
+
+template<GridSample::PaddingMode pd, bool align_corner>
+struct compute_coord
+{
+#if __ARM_NEON
+    float32x4_t operator()(float32x4_t /*length*/, float32x4_t coord)
+    {
+        return coord;
+    }
+#endif // __ARM_NEON
+    float operator()(int /*length*/, float coord)
+    {
+        return coord;
+    }
+};
+
+template<bool align_corner>
+struct compute_coord<GridSample::Padding_BORDER, align_corner>
+{
+#if __ARM_NEON
+    float32x4_t operator()(float32x4_t length, float32x4_t coord)
+    {
+        const float32x4_t border_x = vsubq_f32(length, vdupq_n_f32(1.f));
+
+        return vminq_f32(border_x, vmaxq_f32(coord, vdupq_n_f32(0.f)));
+    }
+#endif // __ARM_NEON
+    float operator()(int length, float coord)
+    {
+        return std::min(length - 1.0f, std::max(coord, 0.0f));
+    }
+};
+
+template<>
+struct compute_coord<GridSample::Padding_REFLECTION, /*align_corner*/ true>
+{
+#if __ARM_NEON
+    float32x4_t operator()(float32x4_t length, float32x4_t coord)
+    {
+        const float32x4_t border_x = vsubq_f32(length, vdupq_n_f32(1.f));
+
+        coord = vabsq_f32(coord);
+        coord = vsubq_f32(border_x, vabsq_f32(vsubq_f32(coord, border_x)));
+
+        return vminq_f32(border_x, vmaxq_f32(coord, vdupq_n_f32(0.f)));
+    }
+#endif // __ARM_NEON
+    float operator()(int length, float coord)
+    {
+        coord = fabs(coord);
+        coord = (length - 1) - fabs(coord - (length - 1));
+
+        return std::min(length - 1.0f, std::max(coord, 0.0f));
+    }
+};
+
+template<>
+struct compute_coord<GridSample::Padding_REFLECTION, /*align_corner*/ false>
+{
+#if __ARM_NEON
+    float32x4_t operator()(float32x4_t length, float32x4_t coord)
+    {
+        const float32x4_t border_x = vsubq_f32(length, vdupq_n_f32(1.f));
+        const float32x4_t _0p5 = vdupq_n_f32(0.5f);
+
+        coord = vabsq_f32(vaddq_f32(coord, _0p5));
+        coord = vsubq_f32(vsubq_f32(length, vabsq_f32(vsubq_f32(coord, length))), _0p5);
+
+        return vminq_f32(border_x, vmaxq_f32(coord, vdupq_n_f32(0.f)));
+    }
+#endif // __ARM_NEON
+    float operator()(int length, float coord)
+    {
+        coord = fabs(coord + 0.5f);
+        coord = length - fabs(coord - length) - 0.5;
+
+        return std::min(length - 1.0f, std::max(coord, 0.0f));
+    }
+};
+
+#if __ARM_NEON
+// lanes with (x > -1) & (x < length)
+static inline uint32x4_t grid_sample_in_range(float32x4_t x, float32x4_t length)
+{
+    return vandq_u32(vcgtq_f32(x, vdupq_n_f32(-1.f)), vcltq_f32(x, length));
+}
+
+// element offset of the in range lanes, -1 for the rest
+static inline int32x4_t grid_sample_offset(int32x4_t offset, uint32x4_t in_range)
+{
+    return vbslq_s32(in_range, offset, vdupq_n_s32(-1));
+}
+#endif // __ARM_NEON
+
+#include "gridsample_bilinear_compute_blob.h"
+#include "gridsample_bicubic_compute_blob.h"
+#include "gridsample_nearest_compute_blob.h"
@@ -0,0 +1,57 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#if __ARM_NEON
+static void gridsample_nearest_apply_interpolation_p4(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int outd = dst.d;
+    const int grid_size = outw * outh * outd;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const int* offset_ptr = offset_value.channel(0);
+
+        for (int i = 0; i < grid_size; i++)
+        {
+            float32x4_t _v = offset_ptr[0] >= 0 ? vld1q_f32(srcptr + offset_ptr[0]) : vdupq_n_f32(0.f);
+            vst1q_f32(dstptr, _v);
+
+            offset_ptr++;
+            dstptr += 4;
+        }
+    }
+}
+#endif // __ARM_NEON
+
+static void gridsample_nearest_apply_interpolation_p1(const Mat& src, Mat& dst, const Mat& offset_value, const Option& opt)
+{
+    const int channels = dst.c;
+    const int outw = dst.w;
+    const int outh = dst.h;
+    const int outd = dst.d;
+    const int grid_size = outw * outh * outd;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* srcptr = src.channel(q);
+        float* dstptr = dst.channel(q);
+
+        const int* offset_ptr = offset_value.channel(0);
+
+        for (int x = 0; x < grid_size; x++)
+        {
+            *dstptr = offset_ptr[0] >= 0 ? *(srcptr + offset_ptr[0]) : 0;
+
+            offset_ptr++;
+            dstptr++;
+        }
+    }
+}
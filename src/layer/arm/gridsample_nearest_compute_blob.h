@@ -0,0 +1,213 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#if __ARM_NEON
+template<GridSample::PaddingMode pd, bool align_corner>
+static int32x4_t gridsample_2d_nearest_compute_blob_pack4(const Mat& src, float32x4_t gx, float32x4_t gy)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    const float32x4_t _w = vdupq_n_f32(src.w);
+    const float32x4_t _h = vdupq_n_f32(src.h);
+
+    gx = get_coord(_w, unormalize(_w, gx));
+    gy = get_coord(_h, unormalize(_h, gy));
+
+    gx = floor_ps(vaddq_f32(gx, vdupq_n_f32(0.5f)));
+    gy = floor_ps(vaddq_f32(gy, vdupq_n_f32(0.5f)));
+
+    uint32x4_t in_range = vandq_u32(grid_sample_in_range(gx, _w), grid_sample_in_range(gy, _h));
+
+    int32x4_t offset = vmulq_s32(vmlaq_s32(vcvtq_s32_f32(gx), vcvtq_s32_f32(gy), vdupq_n_s32(src.w)), vdupq_n_s32(src.elempack));
+
+    return grid_sample_offset(offset, in_range);
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+static int32x4_t gridsample_3d_nearest_compute_blob_pack4(const Mat& src, float32x4_t gx, float32x4_t gy, float32x4_t gz)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    const float32x4_t _w = vdupq_n_f32(src.w);
+    const float32x4_t _h = vdupq_n_f32(src.h);
+    const float32x4_t _d = vdupq_n_f32(src.d);
+
+    gx = get_coord(_w, unormalize(_w, gx));
+    gy = get_coord(_h, unormalize(_h, gy));
+    gz = get_coord(_d, unormalize(_d, gz));
+
+    gx = floor_ps(vaddq_f32(gx, vdupq_n_f32(0.5f)));
+    gy = floor_ps(vaddq_f32(gy, vdupq_n_f32(0.5f)));
+    gz = floor_ps(vaddq_f32(gz, vdupq_n_f32(0.5f)));
+
+    uint32x4_t in_range = vandq_u32(vandq_u32(grid_sample_in_range(gx, _w), grid_sample_in_range(gy, _h)), grid_sample_in_range(gz, _d));
+
+    int32x4_t offset = vmlaq_s32(vmlaq_s32(vcvtq_s32_f32(gx), vcvtq_s32_f32(gy), vdupq_n_s32(src.w)), vcvtq_s32_f32(gz), vdupq_n_s32(src.w * src.h));
+    offset = vmulq_s32(offset, vdupq_n_s32(src.elempack));
+
+    return grid_sample_offset(offset, in_range);
+}
+#endif // __ARM_NEON
+
+template<GridSample::PaddingMode pd, bool align_corner>
+static int gridsample_2d_nearest_compute_blob_pack1(const Mat& src, float sample_x, float sample_y)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    sample_x = get_coord(src.w, unormalize(src.w, sample_x));
+    sample_y = get_coord(src.h, unormalize(src.h, sample_y));
+
+    int x0 = static_cast<int>(floorf(sample_x + 0.5f));
+    int y0 = static_cast<int>(floorf(sample_y + 0.5f));
+
+    bool in_bound = ((x0 > -1) & (x0 < src.w) & (y0 > -1) & (y0 < src.h));
+
+    return in_bound ? (x0 + y0 * src.w) * src.elempack : -1;
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+static int gridsample_3d_nearest_compute_blob_pack1(const Mat& src, float sample_x, float sample_y, float sample_z)
+{
+    grid_sample_unormalize<align_corner> unormalize;
+    compute_coord<pd, align_corner> get_coord;
+
+    sample_x = get_coord(src.w, unormalize(src.w, sample_x));
+    sample_y = get_coord(src.h, unormalize(src.h, sample_y));
+    sample_z = get_coord(src.d, unormalize(src.d, sample_z));
+
+    int x0 = static_cast<int>(floorf(sample_x + 0.5f));
+    int y0 = static_cast<int>(floorf(sample_y + 0.5f));
+    int z0 = static_cast<int>(floorf(sample_z + 0.5f));
+
+    bool in_bound = ((x0 > -1) & (x0 < src.w) & (y0 > -1) & (y0 < src.h) & (z0 > -1) & (z0 < src.d));
+
+    return in_bound ? (x0 + y0 * src.w + z0 * src.w * src.h) * src.elempack : -1;
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+void gridsample_2d_nearest_compute_blob(const Mat& src, const Mat& grid, Mat& offset_value, int permute_fusion)
+{
+    const int grid_size = grid.w * grid.h;
+
+    int* offset_ptr = offset_value.channel(0);
+
+    if (permute_fusion == 0)
+    {
+        for (int y = 0; y < grid.c; y++)
+        {
+            const float* gridptr = grid.channel(y);
+
+            int x = 0;
+#if __ARM_NEON
+            for (; x + 7 < grid_size; x += 8)
+            {
+                float32x4x2_t _g = vld2q_f32(gridptr);
+
+                vst1q_s32(offset_ptr, gridsample_2d_nearest_compute_blob_pack4<pd, align_corner>(src, _g.val[0], _g.val[1]));
+
+                gridptr += 8;
+                offset_ptr += 4;
+            }
+#endif // __ARM_NEON
+            for (; x < grid_size; x += 2)
+            {
+                *offset_ptr = gridsample_2d_nearest_compute_blob_pack1<pd, align_corner>(src, gridptr[0], gridptr[1]);
+
+                gridptr += 2;
+                offset_ptr++;
+            }
+        }
+    }
+    else
+    {
+        const float* gridptr_x = grid.channel(0);
+        const float* gridptr_y = grid.channel(1);
+
+        int x = 0;
+#if __ARM_NEON
+        for (; x + 3 < grid_size; x += 4)
+        {
+            vst1q_s32(offset_ptr, gridsample_2d_nearest_compute_blob_pack4<pd, align_corner>(src, vld1q_f32(gridptr_x), vld1q_f32(gridptr_y)));
+
+            gridptr_x += 4;
+            gridptr_y += 4;
+            offset_ptr += 4;
+        }
+#endif // __ARM_NEON
+        for (; x < grid_size; x++)
+        {
+            *offset_ptr = gridsample_2d_nearest_compute_blob_pack1<pd, align_corner>(src, *gridptr_x, *gridptr_y);
+
+            gridptr_x++;
+            gridptr_y++;
+            offset_ptr++;
+        }
+    }
+}
+
+template<GridSample::PaddingMode pd, bool align_corner>
+void gridsample_3d_nearest_compute_blob(const Mat& src, const Mat& grid, Mat& offset_value, int permute_fusion)
+{
+    const int grid_size = grid.w * grid.h * grid.d;
+
+    int* offset_ptr = offset_value.channel(0);
+
+    if (permute_fusion == 0)
+    {
+        for (int y = 0; y < grid.c; y++)
+        {
+            const float* gridptr = grid.channel(y);
+
+            int x = 0;
+#if __ARM_NEON
+            for (; x + 11 < grid_size; x += 12)
+            {
+                float32x4x3_t _g = vld3q_f32(gridptr);
+
+                vst1q_s32(offset_ptr, gridsample_3d_nearest_compute_blob_pack4<pd, align_corner>(src, _g.val[0], _g.val[1], _g.val[2]));
+
+                gridptr += 12;
+                offset_ptr += 4;
+            }
+#endif // __ARM_NEON
+            for (; x < grid_size; x += 3)
+            {
+                *offset_ptr = gridsample_3d_nearest_compute_blob_pack1<pd, align_corner>(src, gridptr[0], gridptr[1], gridptr[2]);
+
+                gridptr += 3;
+                offset_ptr++;
+            }
+        }
+    }
+    else
+    {
+        const float* gridptr_x = grid.channel(0);
+        const float* gridptr_y = grid.channel(1);
+        const float* gridptr_z = grid.channel(2);
+
+        int x = 0;
+#if __ARM_NEON
+        for (; x + 3 < grid_size; x += 4)
+        {
+            vst1q_s32(offset_ptr, gridsample_3d_nearest_compute_blob_pack4<pd, align_corner>(src, vld1q_f32(gridptr_x), vld1q_f32(gridptr_y), vld1q_f32(gridptr_z)));
+
+            gridptr_x += 4;
+            gridptr_y += 4;
+            gridptr_z += 4;
+            offset_ptr += 4;
+        }
+#endif // __ARM_NEON
+        for (; x < grid_size; x++)
+        {
+            *offset_ptr = gridsample_3d_nearest_compute_blob_pack1<pd, align_corner>(src, *gridptr_x, *gridptr_y, *gridptr_z);
+
+            gridptr_x++;
+            gridptr_y++;
+            gridptr_z++;
+            offset_ptr++;
+        }
+    }
+}
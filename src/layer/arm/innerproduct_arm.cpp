@@ -34,6 +34,8 @@ InnerProduct_arm::InnerProduct_arm()
     support_bf16_storage = true;
 #endif
 
+    support_batch = true;
+
     flatten = 0;
 }
 
@@ -134,8 +136,76 @@ int InnerProduct_arm::destroy_pipeline(const Option& opt)
     return 0;
 }
 
+int InnerProduct_arm::save_pipeline(std::vector<Mat>& weights) const
+{
+    weights.resize(3);
+    weights[0] = weight_data_tm;
+    weights[1] = bias_data_fp16;
+#if NCNN_INT8
+    weights[2] = scale_in_data;
+#endif
+
+    return 0;
+}
+
+int InnerProduct_arm::load_pipeline(const std::vector<Mat>& weights, const Option& opt)
+{
+    if (weights.size() != 3)
+        return -1;
+
+    {
+        flatten = ncnn::create_layer_cpu(ncnn::LayerType::Flatten);
+
+        ncnn::ParamDict pd;
+
+        flatten->load_param(pd);
+
+        flatten->create_pipeline(opt);
+    }
+
+    weight_data_tm = weights[0];
+    bias_data_fp16 = weights[1];
+#if NCNN_INT8
+    scale_in_data = weights[2];
+#endif
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
 int InnerProduct_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (bottom_blob.n > 1)
+    {
+        // fold the batch into the gemm rows
+        const int num_input = weight_data_size / num_output;
+        const int rows = (bottom_blob.dims == 2 && bottom_blob.w == num_input ? bottom_blob.h * bottom_blob.elempack : 1) * bottom_blob.n;
+
+        int elempack = 1;
+        int out_elempack = 1;
+#if __ARM_NEON
+        if (opt.use_packing_layout)
+        {
+#if NCNN_ARM82
+            if (support_fp16_storage && opt.use_fp16_storage && opt.use_fp16_arithmetic && bottom_blob.elembits() == 16)
+            {
+                elempack = rows % 8 == 0 ? 8 : rows % 4 == 0 ? 4 : 1;
+                out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+            }
+            else
+#endif
+            {
+                elempack = rows % 4 == 0 ? 4 : 1;
+                out_elempack = num_output % 4 == 0 ? 4 : 1;
+            }
+        }
+#endif // __ARM_NEON
+
+        return forward_batch(bottom_blob, top_blob, elempack, out_elempack, opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
@@ -0,0 +1,143 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "inversespectrogram_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "cpu.h"
+
+namespace ncnn {
+
+namespace InverseSpectrogram_arm_fft {
+
+#include "fft_functor.h"
+
+} // namespace InverseSpectrogram_arm_fft
+
+#include "spectrogram_fft.h"
+
+int InverseSpectrogram_arm::create_pipeline(const Option& /*opt*/)
+{
+    fft_factorize(n_fft, fft_radices);
+
+    return fft_create_twiddles(fft_radices, fft_twiddles);
+}
+
+int InverseSpectrogram_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    using namespace InverseSpectrogram_arm_fft;
+
+    const int frames = bottom_blob.h;
+    const int freqs = bottom_blob.c;
+
+    const int onesided = freqs == n_fft / 2 + 1 ? 1 : 0;
+
+    const int outsize = center ? (frames - 1) * hoplen + (n_fft - n_fft / 2 * 2) : (frames - 1) * hoplen + n_fft;
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (returns == 0)
+    {
+        top_blob.create(2, outsize, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(outsize, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    float norm = 1.f;
+    if (normalized == 1)
+        norm = sqrtf(n_fft);
+    if (normalized == 2)
+        norm = window_data[n_fft];
+
+    int max_lanes = 1;
+#if __ARM_NEON
+    max_lanes = 4;
+#endif // __ARM_NEON
+
+    // one fft workspace per thread
+    Mat workspace(n_fft * 4 * max_lanes, opt.num_threads, (size_t)4u, opt.workspace_allocator);
+    if (workspace.empty())
+        return -100;
+
+    // the windowed complex signal of every frame
+    Mat frames_blob(n_fft * 2, frames, (size_t)4u, opt.workspace_allocator);
+    if (frames_blob.empty())
+        return -100;
+
+    // transform a group of frames at once, one frame per lane
+    int j = 0;
+#if __ARM_NEON
+    j = inverse_spectrogram_fft_frames<fft_op_pack4>(bottom_blob, frames_blob, j, frames, n_fft, onesided, norm, window_data, fft_radices, fft_twiddles, workspace, opt);
+#endif // __ARM_NEON
+    inverse_spectrogram_fft_frames<fft_op_pack1>(bottom_blob, frames_blob, j, frames, n_fft, onesided, norm, window_data, fft_radices, fft_twiddles, workspace, opt);
+
+    // overlap add
+    Mat window_sumsquare(outsize, (size_t)4u, opt.workspace_allocator);
+    if (window_sumsquare.empty())
+        return -100;
+
+    top_blob.fill(0.f);
+    window_sumsquare.fill(0.f);
+
+    for (int k = 0; k < frames; k++)
+    {
+        const float* ptr = frames_blob.row(k);
+
+        for (int i = 0; i < n_fft; i++)
+        {
+            int output_index = k * hoplen + i;
+            if (center == 1)
+            {
+                output_index -= n_fft / 2;
+            }
+            if (output_index < 0 || output_index >= outsize)
+                continue;
+
+            // square window
+            window_sumsquare[output_index] += window_data[i] * window_data[i];
+
+            if (returns == 0)
+            {
+                top_blob.row(output_index)[0] += ptr[i * 2];
+                top_blob.row(output_index)[1] += ptr[i * 2 + 1];
+            }
+            if (returns == 1)
+            {
+                top_blob[output_index] += ptr[i * 2];
+            }
+            if (returns == 2)
+            {
+                top_blob[output_index] += ptr[i * 2 + 1];
+            }
+        }
+    }
+
+    // square window norm
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < outsize; i++)
+    {
+        if (window_sumsquare[i] == 0.f)
+            continue;
+
+        if (returns == 0)
+        {
+            top_blob.row(i)[0] /= window_sumsquare[i];
+            top_blob.row(i)[1] /= window_sumsquare[i];
+        }
+        else
+        {
+            top_blob[i] /= window_sumsquare[i];
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,180 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "permute_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+#include "strided_copy.h"
+
+Permute_arm::Permute_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+// output axis names from innermost to outermost, indexed by order_type
+static const char* const permute_orders_2d[2] = {"wh", "hw"};
+static const char* const permute_orders_3d[6] = {"whc", "hwc", "wch", "cwh", "hcw", "chw"};
+static const char* const permute_orders_4d[24] = {
+    "whdc", "hwdc", "wdhc", "dwhc", "hdwc", "dhwc",
+    "whcd", "hwcd", "wchd", "cwhd", "hcwd", "chwd",
+    "wdch", "dwch", "wcdh", "cwdh", "dcwh", "cdwh",
+    "hdcw", "dhcw", "hcdw", "chdw", "dchw", "cdhw"
+};
+
+int Permute_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (dims == 1 || order_type == 0)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    if ((dims == 2 && order_type > 1) || (dims == 3 && order_type > 5) || (dims == 4 && order_type > 23))
+    {
+        NCNN_LOGE("unsupported permute order_type %d for dims %d", order_type, dims);
+        return -1;
+    }
+
+    // logical axes from outermost to innermost, the outermost one is packed
+    const char* in_names = dims == 2 ? "hw" : dims == 3 ? "chw" : "cdhw";
+    const char* order = dims == 2 ? permute_orders_2d[order_type] : dims == 3 ? permute_orders_3d[order_type] : permute_orders_4d[order_type];
+
+    size_t mat_strides[4];
+    strided_copy_mat_strides(bottom_blob, mat_strides);
+
+    int in_sizes[4];
+    size_t in_strides[4];
+    if (dims == 2)
+    {
+        in_sizes[0] = bottom_blob.h * elempack;
+        in_sizes[1] = bottom_blob.w;
+        in_strides[0] = mat_strides[2];
+        in_strides[1] = mat_strides[3];
+    }
+    if (dims == 3)
+    {
+        in_sizes[0] = bottom_blob.c * elempack;
+        in_sizes[1] = bottom_blob.h;
+        in_sizes[2] = bottom_blob.w;
+        in_strides[0] = mat_strides[0];
+        in_strides[1] = mat_strides[2];
+        in_strides[2] = mat_strides[3];
+    }
+    if (dims == 4)
+    {
+        in_sizes[0] = bottom_blob.c * elempack;
+        in_sizes[1] = bottom_blob.d;
+        in_sizes[2] = bottom_blob.h;
+        in_sizes[3] = bottom_blob.w;
+        in_strides[0] = mat_strides[0];
+        in_strides[1] = mat_strides[1];
+        in_strides[2] = mat_strides[2];
+        in_strides[3] = mat_strides[3];
+    }
+
+    // perm[k] is the input axis placed at output axis k
+    int perm[4];
+    int out_sizes[4];
+    for (int k = 0; k < dims; k++)
+    {
+        const char name = order[dims - 1 - k];
+        for (int i = 0; i < dims; i++)
+        {
+            if (in_names[i] == name)
+                perm[k] = i;
+        }
+
+        out_sizes[k] = in_sizes[perm[k]];
+    }
+
+    int out_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+#if NCNN_ARM82
+        const bool use_fp16_pack8 = support_fp16_storage && opt.use_fp16_storage && opt.use_fp16_arithmetic && bottom_blob.elembits() == 16;
+        out_elempack = use_fp16_pack8 && out_sizes[0] % 8 == 0 ? 8 : out_sizes[0] % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = out_sizes[0] % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __ARM_NEON
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    if (dims == 2)
+        top_blob.create(out_sizes[1], out_sizes[0] / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (dims == 3)
+        top_blob.create(out_sizes[2], out_sizes[1], out_sizes[0] / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (dims == 4)
+        top_blob.create(out_sizes[3], out_sizes[2], out_sizes[1], out_sizes[0] / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    size_t out_mat_strides[4];
+    strided_copy_mat_strides(top_blob, out_mat_strides);
+
+    size_t out_axis_strides[4];
+    if (dims == 2)
+    {
+        out_axis_strides[0] = out_mat_strides[2];
+        out_axis_strides[1] = out_mat_strides[3];
+    }
+    if (dims == 3)
+    {
+        out_axis_strides[0] = out_mat_strides[0];
+        out_axis_strides[1] = out_mat_strides[2];
+        out_axis_strides[2] = out_mat_strides[3];
+    }
+    if (dims == 4)
+    {
+        out_axis_strides[0] = out_mat_strides[0];
+        out_axis_strides[1] = out_mat_strides[1];
+        out_axis_strides[2] = out_mat_strides[2];
+        out_axis_strides[3] = out_mat_strides[3];
+    }
+
+    int ndim = 0;
+    int sizes[STRIDED_COPY_MAX_AXES];
+    size_t strides[STRIDED_COPY_MAX_AXES];
+    size_t out_strides[STRIDED_COPY_MAX_AXES];
+    for (int k = 0; k < dims; k++)
+    {
+        const int i = perm[k];
+        strided_copy_append_axis(in_sizes[i], i == 0 ? elempack : 1, in_strides[i], k == 0 ? out_elempack : 1, out_axis_strides[k], ndim, sizes, strides, out_strides);
+    }
+
+    if (bottom_blob.elembits() == 16)
+    {
+        strided_copy<unsigned short>(bottom_blob, top_blob, ndim, sizes, strides, out_strides, opt);
+    }
+    else
+    {
+        strided_copy<float>(bottom_blob, top_blob, ndim, sizes, strides, out_strides, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,240 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling3d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include <float.h>
+
+namespace ncnn {
+
+#include "pooling_accumulate.h"
+
+Pooling3D_arm::Pooling3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int Pooling3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int d = bottom_blob.d;
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        top_blob.create(channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const int size = w * h * d;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const float* ptr = bottom_blob.channel(q);
+            float* outptr = (float*)top_blob + q * elempack;
+
+            pooling_accumulate_init(outptr, elempack, pooling_type);
+            pooling_accumulate(ptr, size, elempack, pooling_type, outptr);
+
+            if (pooling_type == PoolMethod_AVE)
+                pooling_accumulate_scale(outptr, elempack, 1.f / size);
+        }
+
+        return 0;
+    }
+
+    if (adaptive_pooling)
+    {
+        const int _out_w = out_w == -233 ? w : out_w;
+        const int _out_h = out_h == -233 ? h : out_h;
+        const int _out_d = out_d == -233 ? d : out_d;
+
+        if (_out_w == w && _out_h == h && _out_d == d)
+        {
+            top_blob = bottom_blob;
+            return 0;
+        }
+
+        top_blob.create(_out_w, _out_h, _out_d, channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const Mat m = bottom_blob.channel(q);
+            float* outptr = top_blob.channel(q);
+
+            for (int z = 0; z < _out_d; z++)
+            {
+                // floor div
+                const int id0 = d * z / _out_d;
+                // ceil div
+                const int id1 = (d * (z + 1) + _out_d - 1) / _out_d;
+
+                for (int i = 0; i < _out_h; i++)
+                {
+                    // floor div
+                    const int ih0 = h * i / _out_h;
+                    // ceil div
+                    const int ih1 = (h * (i + 1) + _out_h - 1) / _out_h;
+
+                    for (int j = 0; j < _out_w; j++)
+                    {
+                        // floor div
+                        const int iw0 = w * j / _out_w;
+                        // ceil div
+                        const int iw1 = (w * (j + 1) + _out_w - 1) / _out_w;
+
+                        pooling_accumulate_init(outptr, elempack, pooling_type);
+
+                        for (int id = id0; id < id1; id++)
+                        {
+                            for (int ih = ih0; ih < ih1; ih++)
+                            {
+                                const float* sptr = m.depth(id).row(ih) + iw0 * elempack;
+
+                                pooling_accumulate(sptr, iw1 - iw0, elempack, pooling_type, outptr);
+                            }
+                        }
+
+                        if (pooling_type == PoolMethod_AVE)
+                            pooling_accumulate_scale(outptr, elempack, 1.f / ((id1 - id0) * (ih1 - ih0) * (iw1 - iw0)));
+
+                        outptr += elempack;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    // padding may pick another packing for the padded blob
+    if (bottom_blob_bordered.elempack != elempack)
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        Mat bottom_blob_padded = bottom_blob_bordered;
+        convert_packing(bottom_blob_padded, bottom_blob_bordered, elempack, opt_b);
+        if (bottom_blob_bordered.empty())
+            return -100;
+    }
+
+    w = bottom_blob_bordered.w;
+    h = bottom_blob_bordered.h;
+    d = bottom_blob_bordered.d;
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+    const int outh = (h - kernel_h) / stride_h + 1;
+    const int outd = (d - kernel_d) / stride_d + 1;
+
+    top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // the window of every output along each axis, padding is skipped unless counted
+    std::vector<int> sx0(outw);
+    std::vector<int> sx1(outw);
+    std::vector<int> sy0(outh);
+    std::vector<int> sy1(outh);
+    std::vector<int> sz0(outd);
+    std::vector<int> sz1(outd);
+    for (int j = 0; j < outw; j++)
+    {
+        sx0[j] = j * stride_w;
+        sx1[j] = sx0[j] + kernel_w;
+    }
+    for (int i = 0; i < outh; i++)
+    {
+        sy0[i] = i * stride_h;
+        sy1[i] = sy0[i] + kernel_h;
+    }
+    for (int z = 0; z < outd; z++)
+    {
+        sz0[z] = z * stride_d;
+        sz1[z] = sz0[z] + kernel_d;
+    }
+
+    if (pooling_type == PoolMethod_AVE && avgpool_count_include_pad == 0)
+    {
+        int wtailpad = 0;
+        int htailpad = 0;
+        int dtailpad = 0;
+
+        if (pad_mode == 0) // full padding
+        {
+            wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+            htailpad = bottom_blob_bordered.h - bottom_blob.h - pad_top - pad_bottom;
+            dtailpad = bottom_blob_bordered.d - bottom_blob.d - pad_front - pad_behind;
+        }
+
+        for (int j = 0; j < outw; j++)
+        {
+            sx0[j] = std::max(sx0[j], pad_left);
+            sx1[j] = std::max(std::min(sx1[j], w - pad_right - wtailpad), sx0[j]);
+        }
+        for (int i = 0; i < outh; i++)
+        {
+            sy0[i] = std::max(sy0[i], pad_top);
+            sy1[i] = std::max(std::min(sy1[i], h - pad_bottom - htailpad), sy0[i]);
+        }
+        for (int z = 0; z < outd; z++)
+        {
+            sz0[z] = std::max(sz0[z], pad_front);
+            sz1[z] = std::max(std::min(sz1[z], d - pad_behind - dtailpad), sz0[z]);
+        }
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const Mat m = bottom_blob_bordered.channel(q);
+        float* outptr = top_blob.channel(q);
+
+        for (int z = 0; z < outd; z++)
+        {
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    pooling_accumulate_init(outptr, elempack, pooling_type);
+
+                    for (int sz = sz0[z]; sz < sz1[z]; sz++)
+                    {
+                        for (int sy = sy0[i]; sy < sy1[i]; sy++)
+                        {
+                            const float* sptr = m.depth(sz).row(sy) + sx0[j] * elempack;
+
+                            pooling_accumulate(sptr, sx1[j] - sx0[j], elempack, pooling_type, outptr);
+                        }
+                    }
+
+                    if (pooling_type == PoolMethod_AVE)
+                        pooling_accumulate_scale(outptr, elempack, 1.f / ((sz1[z] - sz0[z]) * (sy1[i] - sy0[i]) * (sx1[j] - sx0[j])));
+
+                    outptr += elempack;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
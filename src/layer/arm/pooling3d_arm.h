@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_POOLING3D_ARM_H
+#define LAYER_POOLING3D_ARM_H
+
+#include "pooling3d.h"
+
+namespace ncnn {
+
+class Pooling3D_arm : public Pooling3D
+{
+public:
+    Pooling3D_arm();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_POOLING3D_ARM_H
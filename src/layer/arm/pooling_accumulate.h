@@ -0,0 +1,117 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// shared by the packed Pooling1D, Pooling3D, SPP and StatisticsPooling kernels
+// a packed element is elempack lanes, every lane is reduced on its own
+// pooling_type 0 is max and 1 is sum
+
+static void pooling_accumulate_init(float* acc, int elempack, int pooling_type)
+{
+    const float v = pooling_type == 0 ? -FLT_MAX : 0.f;
+    for (int i = 0; i < elempack; i++)
+    {
+        acc[i] = v;
+    }
+}
+
+// acc = reduce(acc, ptr[0, n)) over n contiguous packed elements
+static void pooling_accumulate(const float* ptr, int n, int elempack, int pooling_type, float* acc)
+{
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        float32x4_t _acc = vld1q_f32(acc);
+        if (pooling_type == 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = vmaxq_f32(_acc, vld1q_f32(ptr));
+                ptr += 4;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = vaddq_f32(_acc, vld1q_f32(ptr));
+                ptr += 4;
+            }
+        }
+        vst1q_f32(acc, _acc);
+    }
+#endif // __ARM_NEON
+    if (elempack == 1)
+    {
+        float v = acc[0];
+
+        int i = 0;
+#if __ARM_NEON
+        if (n >= 8)
+        {
+            if (pooling_type == 0)
+            {
+                float32x4_t _acc0 = vdupq_n_f32(v);
+                float32x4_t _acc1 = vdupq_n_f32(v);
+                for (; i + 7 < n; i += 8)
+                {
+                    _acc0 = vmaxq_f32(_acc0, vld1q_f32(ptr));
+                    _acc1 = vmaxq_f32(_acc1, vld1q_f32(ptr + 4));
+                    ptr += 8;
+                }
+                _acc0 = vmaxq_f32(_acc0, _acc1);
+#if __aarch64__
+                v = vmaxvq_f32(_acc0);
+#else
+                float32x2_t _max2 = vmax_f32(vget_low_f32(_acc0), vget_high_f32(_acc0));
+                _max2 = vpmax_f32(_max2, _max2);
+                v = vget_lane_f32(_max2, 0);
+#endif
+            }
+            else
+            {
+                float32x4_t _acc0 = vdupq_n_f32(0.f);
+                float32x4_t _acc1 = vdupq_n_f32(0.f);
+                for (; i + 7 < n; i += 8)
+                {
+                    _acc0 = vaddq_f32(_acc0, vld1q_f32(ptr));
+                    _acc1 = vaddq_f32(_acc1, vld1q_f32(ptr + 4));
+                    ptr += 8;
+                }
+                _acc0 = vaddq_f32(_acc0, _acc1);
+#if __aarch64__
+                v += vaddvq_f32(_acc0);
+#else
+                float32x2_t _sum2 = vadd_f32(vget_low_f32(_acc0), vget_high_f32(_acc0));
+                _sum2 = vpadd_f32(_sum2, _sum2);
+                v += vget_lane_f32(_sum2, 0);
+#endif
+            }
+        }
+#endif // __ARM_NEON
+        if (pooling_type == 0)
+        {
+            for (; i < n; i++)
+            {
+                v = std::max(v, *ptr++);
+            }
+        }
+        else
+        {
+            for (; i < n; i++)
+            {
+                v += *ptr++;
+            }
+        }
+
+        acc[0] = v;
+    }
+}
+
+// acc *= scale for every lane
+static void pooling_accumulate_scale(float* acc, int elempack, float scale)
+{
+    for (int i = 0; i < elempack; i++)
+    {
+        acc[i] *= scale;
+    }
+}
@@ -0,0 +1,199 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "proposal_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+#include "topk_select.h"
+
+namespace ncnn {
+
+#include "detection_nms.h"
+
+Proposal_arm::Proposal_arm()
+{
+}
+
+// decode one row of shifted anchors and clip to image
+static void decode_proposal_row(const float* dxptr, const float* dyptr, const float* dwptr, const float* dhptr, float anchor_x, float anchor_y, float anchor_w, float anchor_h, float feat_stride, float im_w, float im_h, int w, float* x1ptr, float* y1ptr, float* x2ptr, float* y2ptr)
+{
+    const float cy = anchor_y + anchor_h * 0.5f;
+
+    int j = 0;
+#if __ARM_NEON
+    {
+        const float _lane_offset[4] = {0.f, 1.f, 2.f, 3.f};
+        const float32x4_t _anchor_x = vmlaq_n_f32(vdupq_n_f32(anchor_x), vld1q_f32(_lane_offset), feat_stride);
+        const float32x4_t _anchor_w = vdupq_n_f32(anchor_w);
+        const float32x4_t _anchor_h = vdupq_n_f32(anchor_h);
+        const float32x4_t _half_anchor_w = vdupq_n_f32(anchor_w * 0.5f);
+        const float32x4_t _cy = vdupq_n_f32(cy);
+        const float32x4_t _half = vdupq_n_f32(0.5f);
+        const float32x4_t _xmax = vdupq_n_f32(im_w - 1);
+        const float32x4_t _ymax = vdupq_n_f32(im_h - 1);
+        const float32x4_t _zero = vdupq_n_f32(0.f);
+        for (; j + 3 < w; j += 4)
+        {
+            float32x4_t _cx = vaddq_f32(vaddq_f32(_anchor_x, vdupq_n_f32(j * feat_stride)), _half_anchor_w);
+
+            float32x4_t _pb_cx = vmlaq_f32(_cx, _anchor_w, vld1q_f32(dxptr + j));
+            float32x4_t _pb_cy = vmlaq_f32(_cy, _anchor_h, vld1q_f32(dyptr + j));
+            float32x4_t _pb_w = vmulq_f32(_anchor_w, exp_ps(vld1q_f32(dwptr + j)));
+            float32x4_t _pb_h = vmulq_f32(_anchor_h, exp_ps(vld1q_f32(dhptr + j)));
+
+            float32x4_t _x1 = vmlsq_f32(_pb_cx, _pb_w, _half);
+            float32x4_t _y1 = vmlsq_f32(_pb_cy, _pb_h, _half);
+            float32x4_t _x2 = vmlaq_f32(_pb_cx, _pb_w, _half);
+            float32x4_t _y2 = vmlaq_f32(_pb_cy, _pb_h, _half);
+
+            vst1q_f32(x1ptr + j, vmaxq_f32(vminq_f32(_x1, _xmax), _zero));
+            vst1q_f32(y1ptr + j, vmaxq_f32(vminq_f32(_y1, _ymax), _zero));
+            vst1q_f32(x2ptr + j, vmaxq_f32(vminq_f32(_x2, _xmax), _zero));
+            vst1q_f32(y2ptr + j, vmaxq_f32(vminq_f32(_y2, _ymax), _zero));
+        }
+    }
+#endif // __ARM_NEON
+    for (; j < w; j++)
+    {
+        // apply center size
+        float cx = anchor_x + j * feat_stride + anchor_w * 0.5f;
+
+        float pb_cx = cx + anchor_w * dxptr[j];
+        float pb_cy = cy + anchor_h * dyptr[j];
+
+        float pb_w = anchor_w * expf(dwptr[j]);
+        float pb_h = anchor_h * expf(dhptr[j]);
+
+        // clip box
+        x1ptr[j] = std::max(std::min(pb_cx - pb_w * 0.5f, im_w - 1), 0.f);
+        y1ptr[j] = std::max(std::min(pb_cy - pb_h * 0.5f, im_h - 1), 0.f);
+        x2ptr[j] = std::max(std::min(pb_cx + pb_w * 0.5f, im_w - 1), 0.f);
+        y2ptr[j] = std::max(std::min(pb_cy + pb_h * 0.5f, im_h - 1), 0.f);
+    }
+}
+
+int Proposal_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& score_blob = bottom_blobs[0];
+    const Mat& bbox_blob = bottom_blobs[1];
+    const Mat& im_info_blob = bottom_blobs[2];
+
+    const int w = score_blob.w;
+    const int h = score_blob.h;
+    const int size = w * h;
+
+    // generate proposals from bbox deltas and shifted anchors, clipped to image
+    const int num_anchors = anchors.h;
+
+    const float im_w = im_info_blob[1];
+    const float im_h = im_info_blob[0];
+
+    BBoxSoA proposals;
+    proposals.resize(num_anchors * size);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_anchors; q++)
+    {
+        const float* anchor = anchors.row(q);
+
+        const float anchor_w = anchor[2] - anchor[0];
+        const float anchor_h = anchor[3] - anchor[1];
+
+        for (int i = 0; i < h; i++)
+        {
+            const int offset = q * size + i * w;
+
+            decode_proposal_row(bbox_blob.channel(q * 4).row(i), bbox_blob.channel(q * 4 + 1).row(i), bbox_blob.channel(q * 4 + 2).row(i), bbox_blob.channel(q * 4 + 3).row(i),
+                                anchor[0], anchor[1] + i * feat_stride, anchor_w, anchor_h, (float)feat_stride, im_w, im_h, w,
+                                &proposals.xmin[offset], &proposals.ymin[offset], &proposals.xmax[offset], &proposals.ymax[offset]);
+        }
+    }
+
+    // remove predicted boxes with either height or width < threshold
+    const float im_scale = im_info_blob[2];
+    const float min_boxsize = min_size * im_scale;
+
+    std::vector<int> candidates;
+    std::vector<float> scores;
+    for (int q = 0; q < num_anchors; q++)
+    {
+        const float* scoreptr = score_blob.channel(q + num_anchors);
+
+        for (int i = 0; i < size; i++)
+        {
+            const int z = q * size + i;
+
+            float pb_w = proposals.xmax[z] - proposals.xmin[z] + 1;
+            float pb_h = proposals.ymax[z] - proposals.ymin[z] + 1;
+
+            if (pb_w >= min_boxsize && pb_h >= min_boxsize)
+            {
+                candidates.push_back(z);
+                scores.push_back(scoreptr[i]);
+            }
+        }
+    }
+
+    // take top pre_nms_topN by score from highest to lowest
+    const int num_candidates = (int)candidates.size();
+    const int top_k = pre_nms_topN > 0 ? std::min(pre_nms_topN, num_candidates) : num_candidates;
+
+    std::vector<int> sorted(top_k);
+    const int num_sorted = topk_select(scores.data(), 0, num_candidates, top_k, sorted.data());
+
+    BBoxSoA sorted_proposals;
+    sorted_proposals.resize(num_sorted);
+    for (int i = 0; i < num_sorted; i++)
+    {
+        const int z = candidates[sorted[i]];
+        sorted_proposals.xmin[i] = proposals.xmin[z];
+        sorted_proposals.ymin[i] = proposals.ymin[z];
+        sorted_proposals.xmax[i] = proposals.xmax[z];
+        sorted_proposals.ymax[i] = proposals.ymax[z];
+        sorted_proposals.area[i] = (proposals.xmax[z] - proposals.xmin[z]) * (proposals.ymax[z] - proposals.ymin[z]);
+    }
+
+    // apply nms with nms_thresh and take after_nms_topN
+    std::vector<int> picked;
+    nms_sorted_bboxes_soa(sorted_proposals, num_sorted, nms_thresh, after_nms_topN, picked);
+
+    const int picked_count = (int)picked.size();
+
+    // return the top proposals
+    Mat& roi_blob = top_blobs[0];
+    roi_blob.create(4, 1, picked_count, 4u, opt.blob_allocator);
+    if (roi_blob.empty())
+        return -100;
+
+    for (int i = 0; i < picked_count; i++)
+    {
+        float* outptr = roi_blob.channel(i);
+
+        outptr[0] = sorted_proposals.xmin[picked[i]];
+        outptr[1] = sorted_proposals.ymin[picked[i]];
+        outptr[2] = sorted_proposals.xmax[picked[i]];
+        outptr[3] = sorted_proposals.ymax[picked[i]];
+    }
+
+    if (top_blobs.size() > 1)
+    {
+        Mat& roi_score_blob = top_blobs[1];
+        roi_score_blob.create(1, 1, picked_count, 4u, opt.blob_allocator);
+        if (roi_score_blob.empty())
+            return -100;
+
+        for (int i = 0; i < picked_count; i++)
+        {
+            float* outptr = roi_score_blob.channel(i);
+            outptr[0] = scores[sorted[picked[i]]];
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
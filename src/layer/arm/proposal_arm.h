@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_PROPOSAL_ARM_H
+#define LAYER_PROPOSAL_ARM_H
+
+#include "proposal.h"
+
+namespace ncnn {
+
+class Proposal_arm : public Proposal
+{
+public:
+    Proposal_arm();
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_PROPOSAL_ARM_H
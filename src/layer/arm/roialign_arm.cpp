@@ -0,0 +1,416 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "roialign_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "cpu.h"
+
+#include <math.h>
+
+namespace ncnn {
+
+// bilinear taps of one sampling point, the positions are in pixels
+struct ROIAlignPreCalc
+{
+    int pos1;
+    int pos2;
+    int pos3;
+    int pos4;
+    float w1;
+    float w2;
+    float w3;
+    float w4;
+};
+
+// one output bin averages samples [sample_start, sample_end) scaled by scale
+struct ROIAlignBin
+{
+    int sample_start;
+    int sample_end;
+    float scale;
+};
+
+static void roialign_pre_calc_v0(int height, int width, int pooled_height, int pooled_width, float roi_start_h, float roi_start_w, float bin_size_h, float bin_size_w, int sampling_ratio, std::vector<ROIAlignPreCalc>& pre_calc, std::vector<ROIAlignBin>& bins)
+{
+    for (int ph = 0; ph < pooled_height; ph++)
+    {
+        for (int pw = 0; pw < pooled_width; pw++)
+        {
+            float hstart = roi_start_h + ph * bin_size_h;
+            float wstart = roi_start_w + pw * bin_size_w;
+            float hend = roi_start_h + (ph + 1) * bin_size_h;
+            float wend = roi_start_w + (pw + 1) * bin_size_w;
+
+            hstart = std::min(std::max(hstart, 0.f), (float)height);
+            wstart = std::min(std::max(wstart, 0.f), (float)width);
+            hend = std::min(std::max(hend, 0.f), (float)height);
+            wend = std::min(std::max(wend, 0.f), (float)width);
+
+            const int bin_grid_h = (int)(sampling_ratio > 0 ? sampling_ratio : ceil(hend - hstart));
+            const int bin_grid_w = (int)(sampling_ratio > 0 ? sampling_ratio : ceil(wend - wstart));
+
+            // an empty bin outputs zero and takes no samples
+            const bool is_empty = (hend <= hstart) || (wend <= wstart);
+
+            ROIAlignBin bin;
+            bin.sample_start = (int)pre_calc.size();
+            bin.scale = is_empty ? 0.f : 1.f / (bin_grid_h * bin_grid_w);
+
+            for (int by = 0; !is_empty && by < bin_grid_h; by++)
+            {
+                const float y = hstart + (by + 0.5f) * bin_size_h / (float)bin_grid_h;
+
+                for (int bx = 0; bx < bin_grid_w; bx++)
+                {
+                    const float x = wstart + (bx + 0.5f) * bin_size_w / (float)bin_grid_w;
+
+                    int x0 = (int)x;
+                    int x1 = x0 + 1;
+                    int y0 = (int)y;
+                    int y1 = y0 + 1;
+
+                    float a0 = x1 - x;
+                    float a1 = x - x0;
+                    float b0 = y1 - y;
+                    float b1 = y - y0;
+
+                    if (x1 >= width)
+                    {
+                        x1 = width - 1;
+                        a0 = 1.f;
+                        a1 = 0.f;
+                    }
+                    if (y1 >= height)
+                    {
+                        y1 = height - 1;
+                        b0 = 1.f;
+                        b1 = 0.f;
+                    }
+
+                    ROIAlignPreCalc pc;
+                    pc.pos1 = y0 * width + x0;
+                    pc.pos2 = y0 * width + x1;
+                    pc.pos3 = y1 * width + x0;
+                    pc.pos4 = y1 * width + x1;
+                    pc.w1 = a0 * b0;
+                    pc.w2 = a1 * b0;
+                    pc.w3 = a0 * b1;
+                    pc.w4 = a1 * b1;
+                    pre_calc.push_back(pc);
+                }
+            }
+
+            bin.sample_end = (int)pre_calc.size();
+            bins.push_back(bin);
+        }
+    }
+}
+
+static void roialign_pre_calc_v1(int height, int width, int pooled_height, int pooled_width, float roi_start_h, float roi_start_w, float bin_size_h, float bin_size_w, int roi_bin_grid_h, int roi_bin_grid_w, std::vector<ROIAlignPreCalc>& pre_calc, std::vector<ROIAlignBin>& bins)
+{
+    const float scale = 1.f / std::max(roi_bin_grid_h * roi_bin_grid_w, 1);
+
+    for (int ph = 0; ph < pooled_height; ph++)
+    {
+        for (int pw = 0; pw < pooled_width; pw++)
+        {
+            ROIAlignBin bin;
+            bin.sample_start = (int)pre_calc.size();
+            bin.scale = scale;
+
+            for (int iy = 0; iy < roi_bin_grid_h; iy++)
+            {
+                const float yy = roi_start_h + ph * bin_size_h + (iy + 0.5f) * bin_size_h / (float)roi_bin_grid_h;
+
+                for (int ix = 0; ix < roi_bin_grid_w; ix++)
+                {
+                    const float xx = roi_start_w + pw * bin_size_w + (ix + 0.5f) * bin_size_w / (float)roi_bin_grid_w;
+
+                    float x = xx;
+                    float y = yy;
+
+                    // samples outside of the feature map contribute nothing
+                    if (y < -1.0 || y > height || x < -1.0 || x > width)
+                        continue;
+
+                    if (y <= 0)
+                        y = 0;
+                    if (x <= 0)
+                        x = 0;
+
+                    int y_low = (int)y;
+                    int x_low = (int)x;
+                    int y_high;
+                    int x_high;
+
+                    if (y_low >= height - 1)
+                    {
+                        y_high = y_low = height - 1;
+                        y = (float)y_low;
+                    }
+                    else
+                    {
+                        y_high = y_low + 1;
+                    }
+
+                    if (x_low >= width - 1)
+                    {
+                        x_high = x_low = width - 1;
+                        x = (float)x_low;
+                    }
+                    else
+                    {
+                        x_high = x_low + 1;
+                    }
+
+                    const float ly = y - y_low;
+                    const float lx = x - x_low;
+                    const float hy = 1.f - ly;
+                    const float hx = 1.f - lx;
+
+                    ROIAlignPreCalc pc;
+                    pc.pos1 = y_low * width + x_low;
+                    pc.pos2 = y_low * width + x_high;
+                    pc.pos3 = y_high * width + x_low;
+                    pc.pos4 = y_high * width + x_high;
+                    pc.w1 = hy * hx;
+                    pc.w2 = hy * lx;
+                    pc.w3 = ly * hx;
+                    pc.w4 = ly * lx;
+                    pre_calc.push_back(pc);
+                }
+            }
+
+            bin.sample_end = (int)pre_calc.size();
+            bins.push_back(bin);
+        }
+    }
+}
+
+ROIAlign_arm::ROIAlign_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+// fp32 copy of an input blob in the requested packing, fp16 and bf16 storage is cast at the boundary
+static int roialign_cast_fp32(const Mat& src, Mat& dst, int dst_elempack, const Option& opt)
+{
+    Mat src_fp32 = src;
+#if NCNN_ARM82
+    if (opt.use_fp16_storage && src.elembits() == 16)
+    {
+        cast_float16_to_float32(src, src_fp32, opt);
+        if (src_fp32.empty())
+            return -100;
+    }
+    else
+#endif
+#if NCNN_BF16
+    if (opt.use_bf16_storage && src.elembits() == 16)
+    {
+        cast_bfloat16_to_float32(src, src_fp32, opt);
+        if (src_fp32.empty())
+            return -100;
+    }
+#endif
+
+    if (src_fp32.elempack > dst_elempack)
+    {
+        convert_packing(src_fp32, dst, dst_elempack, opt);
+        if (dst.empty())
+            return -100;
+
+        return 0;
+    }
+
+    dst = src_fp32;
+
+    return 0;
+}
+
+int ROIAlign_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& roi_blob = bottom_blobs[1];
+    Mat& top_blob = top_blobs[0];
+
+    const bool use_fp16 = support_fp16_storage && opt.use_fp16_storage && bottom_blob.elembits() == 16;
+    const bool use_bf16 = !use_fp16 && opt.use_bf16_storage && bottom_blob.elembits() == 16;
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    opt_b.use_fp16_storage = use_fp16;
+
+    // a packed 1d roi keeps the element order
+    Mat roi_blob_fp32;
+    int ret = roialign_cast_fp32(roi_blob, roi_blob_fp32, roi_blob.elempack, opt_b);
+    if (ret != 0)
+        return ret;
+
+    if (!use_fp16 && !use_bf16)
+        return forward_fp32(bottom_blob, roi_blob_fp32, top_blob, opt);
+
+    Mat bottom_blob_fp32;
+    ret = roialign_cast_fp32(bottom_blob, bottom_blob_fp32, 4, opt_b);
+    if (ret != 0)
+        return ret;
+
+    Mat top_blob_fp32;
+    ret = forward_fp32(bottom_blob_fp32, roi_blob_fp32, top_blob_fp32, opt_b);
+    if (ret != 0)
+        return ret;
+
+#if NCNN_ARM82
+    if (use_fp16)
+    {
+        cast_float32_to_float16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+#if NCNN_BF16
+    if (use_bf16)
+    {
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+
+    top_blob = top_blob_fp32;
+
+    return 0;
+}
+
+int ROIAlign_arm::forward_fp32(const Mat& bottom_blob, const float* roi_ptr, Mat& top_blob, const Option& opt) const
+{
+    const int width = bottom_blob.w;
+    const int height = bottom_blob.h;
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    top_blob.create(pooled_width, pooled_height, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    float roi_start_w = roi_ptr[0] * spatial_scale;
+    float roi_start_h = roi_ptr[1] * spatial_scale;
+    float roi_end_w = roi_ptr[2] * spatial_scale;
+    float roi_end_h = roi_ptr[3] * spatial_scale;
+    if (aligned)
+    {
+        roi_start_w -= 0.5f;
+        roi_start_h -= 0.5f;
+        roi_end_w -= 0.5f;
+        roi_end_h -= 0.5f;
+    }
+
+    float roi_width = roi_end_w - roi_start_w;
+    float roi_height = roi_end_h - roi_start_h;
+
+    if (!aligned)
+    {
+        roi_width = std::max(roi_width, 1.f);
+        roi_height = std::max(roi_height, 1.f);
+    }
+
+    const float bin_size_w = roi_width / (float)pooled_width;
+    const float bin_size_h = roi_height / (float)pooled_height;
+
+    // the sampling points only depend on the roi, resolve them once for all channels
+    std::vector<ROIAlignPreCalc> pre_calc;
+    std::vector<ROIAlignBin> bins;
+    bins.reserve(pooled_width * pooled_height);
+
+    if (version == 0)
+    {
+        roialign_pre_calc_v0(height, width, pooled_height, pooled_width, roi_start_h, roi_start_w, bin_size_h, bin_size_w, sampling_ratio, pre_calc, bins);
+    }
+    else
+    {
+        const int roi_bin_grid_h = (int)(sampling_ratio > 0 ? sampling_ratio : ceil(roi_height / pooled_height));
+        const int roi_bin_grid_w = (int)(sampling_ratio > 0 ? sampling_ratio : ceil(roi_width / pooled_width));
+
+        roialign_pre_calc_v1(height, width, pooled_height, pooled_width, roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h, roi_bin_grid_w, pre_calc, bins);
+    }
+
+    const int size = pooled_width * pooled_height;
+
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const float* ptr = bottom_blob.channel(q);
+            float* outptr = top_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                const ROIAlignBin& bin = bins[i];
+
+                float32x4_t _sum = vdupq_n_f32(0.f);
+                for (int j = bin.sample_start; j < bin.sample_end; j++)
+                {
+                    const ROIAlignPreCalc& pc = pre_calc[j];
+
+                    _sum = vmlaq_n_f32(_sum, vld1q_f32(ptr + pc.pos1 * 4), pc.w1);
+                    _sum = vmlaq_n_f32(_sum, vld1q_f32(ptr + pc.pos2 * 4), pc.w2);
+                    _sum = vmlaq_n_f32(_sum, vld1q_f32(ptr + pc.pos3 * 4), pc.w3);
+                    _sum = vmlaq_n_f32(_sum, vld1q_f32(ptr + pc.pos4 * 4), pc.w4);
+                }
+
+                vst1q_f32(outptr, vmulq_n_f32(_sum, bin.scale));
+                outptr += 4;
+            }
+        }
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const float* ptr = bottom_blob.channel(q);
+            float* outptr = top_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                const ROIAlignBin& bin = bins[i];
+
+                float sum = 0.f;
+                for (int j = bin.sample_start; j < bin.sample_end; j++)
+                {
+                    const ROIAlignPreCalc& pc = pre_calc[j];
+
+                    sum += pc.w1 * ptr[pc.pos1] + pc.w2 * ptr[pc.pos2] + pc.w3 * ptr[pc.pos3] + pc.w4 * ptr[pc.pos4];
+                }
+
+                outptr[i] = sum * bin.scale;
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,27 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SPECTROGRAM_ARM_H
+#define LAYER_SPECTROGRAM_ARM_H
+
+#include "spectrogram.h"
+
+namespace ncnn {
+
+class Spectrogram_arm : public Spectrogram
+{
+public:
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    // fft plan for n_fft
+    std::vector<int> fft_radices;
+    Mat fft_twiddles;
+    Mat fft_real_twiddles;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_SPECTROGRAM_ARM_H
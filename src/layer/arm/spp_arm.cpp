@@ -0,0 +1,120 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "spp_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include <float.h>
+#include <math.h>
+
+namespace ncnn {
+
+#include "pooling_accumulate.h"
+
+SPP_arm::SPP_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int SPP_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+
+    // 1 + 4 + 16 + 64 + ... + (2*pyramid_height)^2
+    const int pyramid_num_bins = ((1 << (pyramid_height * 2)) - 1) / 3;
+
+    // the output is flat in unpacked channel order, lanes are scattered to their channels
+    top_blob.create(pyramid_num_bins * channels * elempack, (size_t)4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    float* pyramid_ptr = top_blob;
+
+    // all spatial pyramids
+    for (int p = 0; p < pyramid_height; p++)
+    {
+        int w = bottom_blob.w;
+        int h = bottom_blob.h;
+
+        const int num_bins = 1 << p;
+
+        const int kernel_h = (int)ceil(h / (float)num_bins);
+        const int stride_h = kernel_h;
+        const int remainder_h = stride_h * num_bins - h;
+        const int pad_h = (remainder_h + 1) / 2;
+
+        const int kernel_w = (int)ceil(w / (float)num_bins);
+        const int stride_w = kernel_w;
+        const int remainder_w = stride_w * num_bins - w;
+        const int pad_w = (remainder_w + 1) / 2;
+
+        Mat bottom_blob_bordered = bottom_blob;
+        if (pad_h > 0 || pad_w > 0)
+        {
+            Option opt_b = opt;
+            opt_b.blob_allocator = opt.workspace_allocator;
+            copy_make_border(bottom_blob, bottom_blob_bordered, pad_h, pad_h, pad_w, pad_w, BORDER_CONSTANT, 0.f, opt_b);
+            if (bottom_blob_bordered.empty())
+                return -100;
+
+            // padding may pick another packing for the padded blob
+            if (bottom_blob_bordered.elempack != elempack)
+            {
+                Mat bottom_blob_padded = bottom_blob_bordered;
+                convert_packing(bottom_blob_padded, bottom_blob_bordered, elempack, opt_b);
+                if (bottom_blob_bordered.empty())
+                    return -100;
+            }
+
+            w = bottom_blob_bordered.w;
+            h = bottom_blob_bordered.h;
+        }
+
+        const int bins = num_bins * num_bins;
+        const float scale = 1.f / (kernel_h * kernel_w);
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const Mat m = bottom_blob_bordered.channel(q);
+            float* outptr = pyramid_ptr + bins * q * elempack;
+
+            float acc[4];
+
+            for (int i = 0; i < num_bins; i++)
+            {
+                for (int j = 0; j < num_bins; j++)
+                {
+                    pooling_accumulate_init(acc, elempack, pooling_type);
+
+                    for (int ki = 0; ki < kernel_h; ki++)
+                    {
+                        const float* sptr = m.row(i * stride_h + ki) + j * stride_w * elempack;
+
+                        pooling_accumulate(sptr, kernel_w, elempack, pooling_type, acc);
+                    }
+
+                    if (pooling_type == PoolMethod_AVE)
+                        pooling_accumulate_scale(acc, elempack, scale);
+
+                    for (int l = 0; l < elempack; l++)
+                    {
+                        outptr[l * bins + i * num_bins + j] = acc[l];
+                    }
+                }
+            }
+        }
+
+        pyramid_ptr += channels * elempack * bins;
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,132 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "statisticspooling_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include <float.h>
+#include <math.h>
+
+namespace ncnn {
+
+#include "pooling_accumulate.h"
+
+StatisticsPooling_arm::StatisticsPooling_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+// outptr = sum((ptr - mean)^2) over size packed elements
+static void statisticspooling_sqsum(const float* ptr, int size, int elempack, const float* mean, float* outptr)
+{
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        float32x4_t _mean = vld1q_f32(mean);
+        float32x4_t _sum = vdupq_n_f32(0.f);
+        for (int i = 0; i < size; i++)
+        {
+            float32x4_t _v = vsubq_f32(vld1q_f32(ptr), _mean);
+            _sum = vmlaq_f32(_sum, _v, _v);
+            ptr += 4;
+        }
+        vst1q_f32(outptr, _sum);
+    }
+#endif // __ARM_NEON
+    if (elempack == 1)
+    {
+        float sum = 0.f;
+
+        int i = 0;
+#if __ARM_NEON
+        float32x4_t _mean = vdupq_n_f32(mean[0]);
+        float32x4_t _sum = vdupq_n_f32(0.f);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _v = vsubq_f32(vld1q_f32(ptr), _mean);
+            _sum = vmlaq_f32(_sum, _v, _v);
+            ptr += 4;
+        }
+#if __aarch64__
+        sum = vaddvq_f32(_sum);
+#else
+        float32x2_t _sum2 = vadd_f32(vget_low_f32(_sum), vget_high_f32(_sum));
+        _sum2 = vpadd_f32(_sum2, _sum2);
+        sum = vget_lane_f32(_sum2, 0);
+#endif
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            const float v = *ptr++ - mean[0];
+            sum += v * v;
+        }
+
+        outptr[0] = sum;
+    }
+}
+
+int StatisticsPooling_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+
+    if (dims < 3)
+    {
+        // the whole blob is one channel, lanes belong to the same statistics
+        if (elempack == 1)
+            return StatisticsPooling::forward(bottom_blob, top_blob, opt);
+
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+
+        Mat bottom_blob_unpacked;
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_b);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+
+        return StatisticsPooling::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int size = bottom_blob.w * bottom_blob.h * bottom_blob.d;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    // means first, then the standard deviations
+    const int out_channels = include_stddev ? channels * 2 : channels;
+
+    top_blob.create(out_channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* ptr = bottom_blob.channel(q);
+        float* meanptr = (float*)top_blob + q * elempack;
+
+        pooling_accumulate_init(meanptr, elempack, 1);
+        pooling_accumulate(ptr, size, elempack, 1, meanptr);
+        pooling_accumulate_scale(meanptr, elempack, 1.f / size);
+
+        if (include_stddev)
+        {
+            float* stdptr = (float*)top_blob + (channels + q) * elempack;
+
+            statisticspooling_sqsum(ptr, size, elempack, meanptr, stdptr);
+
+            for (int i = 0; i < elempack; i++)
+            {
+                stdptr[i] = sqrtf(stdptr[i] / size);
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
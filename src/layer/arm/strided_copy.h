@@ -0,0 +1,282 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// n-d strided tensor copy shared by permute and tile
+// every logical axis is described by its size, input stride and output stride in elements
+// axes absent in the input have input stride 0, which broadcasts
+
+#define STRIDED_COPY_MAX_AXES 16
+
+template<typename T>
+static NCNN_FORCEINLINE void strided_copy_row(const T* ptr, size_t stride, T* outptr, size_t out_stride, int size)
+{
+    if (stride == 1 && out_stride == 1)
+    {
+        memcpy(outptr, ptr, size * sizeof(T));
+        return;
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        *outptr = *ptr;
+        ptr += stride;
+        outptr += out_stride;
+    }
+}
+
+// out[ia * out_stride + ib] = ptr[ia + ib * stride]
+static NCNN_FORCEINLINE void strided_copy_transpose_block(const float* ptr, size_t stride, float* outptr, size_t out_stride, int na, int nb)
+{
+    int ia = 0;
+#if __ARM_NEON
+    for (; ia + 3 < na; ia += 4)
+    {
+        const float* p0 = ptr + ia;
+        float* outp0 = outptr + ia * out_stride;
+
+        int ib = 0;
+        for (; ib + 3 < nb; ib += 4)
+        {
+            const float* p = p0 + ib * stride;
+            float* outp = outp0 + ib;
+
+            float32x4_t _r0 = vld1q_f32(p);
+            float32x4_t _r1 = vld1q_f32(p + stride);
+            float32x4_t _r2 = vld1q_f32(p + stride * 2);
+            float32x4_t _r3 = vld1q_f32(p + stride * 3);
+            transpose4x4_ps(_r0, _r1, _r2, _r3);
+            vst1q_f32(outp, _r0);
+            vst1q_f32(outp + out_stride, _r1);
+            vst1q_f32(outp + out_stride * 2, _r2);
+            vst1q_f32(outp + out_stride * 3, _r3);
+        }
+        for (; ib < nb; ib++)
+        {
+            strided_copy_row(p0 + ib * stride, 1, outp0 + ib, out_stride, 4);
+        }
+    }
+#endif // __ARM_NEON
+    for (; ia < na; ia++)
+    {
+        strided_copy_row(ptr + ia, stride, outptr + ia * out_stride, 1, nb);
+    }
+}
+
+static NCNN_FORCEINLINE void strided_copy_transpose_block(const unsigned short* ptr, size_t stride, unsigned short* outptr, size_t out_stride, int na, int nb)
+{
+    int ia = 0;
+#if __ARM_NEON
+    for (; ia + 7 < na; ia += 8)
+    {
+        const unsigned short* p0 = ptr + ia;
+        unsigned short* outp0 = outptr + ia * out_stride;
+
+        int ib = 0;
+        for (; ib + 7 < nb; ib += 8)
+        {
+            const unsigned short* p = p0 + ib * stride;
+            unsigned short* outp = outp0 + ib;
+
+            uint16x8_t _r0 = vld1q_u16(p);
+            uint16x8_t _r1 = vld1q_u16(p + stride);
+            uint16x8_t _r2 = vld1q_u16(p + stride * 2);
+            uint16x8_t _r3 = vld1q_u16(p + stride * 3);
+            uint16x8_t _r4 = vld1q_u16(p + stride * 4);
+            uint16x8_t _r5 = vld1q_u16(p + stride * 5);
+            uint16x8_t _r6 = vld1q_u16(p + stride * 6);
+            uint16x8_t _r7 = vld1q_u16(p + stride * 7);
+            transpose8x8_u16(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
+            vst1q_u16(outp, _r0);
+            vst1q_u16(outp + out_stride, _r1);
+            vst1q_u16(outp + out_stride * 2, _r2);
+            vst1q_u16(outp + out_stride * 3, _r3);
+            vst1q_u16(outp + out_stride * 4, _r4);
+            vst1q_u16(outp + out_stride * 5, _r5);
+            vst1q_u16(outp + out_stride * 6, _r6);
+            vst1q_u16(outp + out_stride * 7, _r7);
+        }
+        for (; ib < nb; ib++)
+        {
+            strided_copy_row(p0 + ib * stride, 1, outp0 + ib, out_stride, 8);
+        }
+    }
+#endif // __ARM_NEON
+    for (; ia < na; ia++)
+    {
+        strided_copy_row(ptr + ia, stride, outptr + ia * out_stride, 1, nb);
+    }
+}
+
+template<typename T>
+static void strided_copy(const T* ptr, T* outptr, int ndim, const int* _sizes, const size_t* _strides, const size_t* _out_strides, const Option& opt)
+{
+    // drop unit axes and sort by output stride, outermost first
+    int sizes[STRIDED_COPY_MAX_AXES];
+    size_t strides[STRIDED_COPY_MAX_AXES];
+    size_t out_strides[STRIDED_COPY_MAX_AXES];
+
+    int n = 0;
+    for (int i = 0; i < ndim; i++)
+    {
+        if (_sizes[i] == 1)
+            continue;
+
+        int j = n;
+        while (j > 0 && out_strides[j - 1] < _out_strides[i])
+        {
+            sizes[j] = sizes[j - 1];
+            strides[j] = strides[j - 1];
+            out_strides[j] = out_strides[j - 1];
+            j--;
+        }
+
+        sizes[j] = _sizes[i];
+        strides[j] = _strides[i];
+        out_strides[j] = _out_strides[i];
+        n++;
+    }
+
+    // merge axes contiguous in both input and output
+    {
+        int m = 0;
+        for (int i = 1; i < n; i++)
+        {
+            if (strides[m] == strides[i] * sizes[i] && out_strides[m] == out_strides[i] * sizes[i])
+            {
+                sizes[m] *= sizes[i];
+                strides[m] = strides[i];
+                out_strides[m] = out_strides[i];
+            }
+            else
+            {
+                m++;
+                sizes[m] = sizes[i];
+                strides[m] = strides[i];
+                out_strides[m] = out_strides[i];
+            }
+        }
+
+        if (n > 0)
+            n = m + 1;
+    }
+
+    if (n == 0)
+    {
+        outptr[0] = ptr[0];
+        return;
+    }
+
+    // the output contiguous axis is innermost, look for the input contiguous axis
+    const int b = n - 1;
+    int a = -1;
+    if (strides[b] != 1 && out_strides[b] == 1)
+    {
+        for (int i = 0; i < b; i++)
+        {
+            if (strides[i] == 1)
+                a = i;
+        }
+    }
+
+    if (a == -1)
+    {
+        int outer = 1;
+        for (int i = 0; i < b; i++)
+        {
+            outer *= sizes[i];
+        }
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < outer; i++)
+        {
+            size_t offset = 0;
+            size_t out_offset = 0;
+
+            int t = i;
+            for (int j = b - 1; j >= 0; j--)
+            {
+                const int index = t % sizes[j];
+                t /= sizes[j];
+
+                offset += index * strides[j];
+                out_offset += index * out_strides[j];
+            }
+
+            strided_copy_row(ptr + offset, strides[b], outptr + out_offset, out_strides[b], sizes[b]);
+        }
+
+        return;
+    }
+
+    // cache blocked transpose of axis a and b, 16 rows of axis a per task
+    const int tiles = (sizes[a] + 15) / 16;
+
+    int outer = tiles;
+    for (int i = 0; i < b; i++)
+    {
+        if (i != a)
+            outer *= sizes[i];
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < outer; i++)
+    {
+        const int ia = (i % tiles) * 16;
+        const int na = std::min(16, sizes[a] - ia);
+
+        size_t offset = ia;
+        size_t out_offset = ia * out_strides[a];
+
+        int t = i / tiles;
+        for (int j = b - 1; j >= 0; j--)
+        {
+            if (j == a)
+                continue;
+
+            const int index = t % sizes[j];
+            t /= sizes[j];
+
+            offset += index * strides[j];
+            out_offset += index * out_strides[j];
+        }
+
+        strided_copy_transpose_block(ptr + offset, strides[b], outptr + out_offset, out_strides[a], na, sizes[b]);
+    }
+}
+
+// append the strides of one logical axis to a strided copy
+// the axis is packed by elempack in the input and by out_elempack in the output
+// stride and out_stride are the strides of one packed group, in elements
+static void strided_copy_append_axis(int size, int elempack, size_t stride, int out_elempack, size_t out_stride, int& ndim, int* sizes, size_t* strides, size_t* out_strides)
+{
+    // index = g * big + m * small + l
+    const int big = std::max(elempack, out_elempack);
+    const int small = std::min(elempack, out_elempack);
+
+    sizes[ndim] = size / big;
+    strides[ndim] = elempack == big ? stride : stride * (big / small);
+    out_strides[ndim] = out_elempack == big ? out_stride : out_stride * (big / small);
+    ndim++;
+
+    sizes[ndim] = big / small;
+    strides[ndim] = elempack == big ? small : stride;
+    out_strides[ndim] = out_elempack == big ? small : out_stride;
+    ndim++;
+
+    sizes[ndim] = small;
+    strides[ndim] = 1;
+    out_strides[ndim] = 1;
+    ndim++;
+}
+
+// the group strides of the logical axes c d h w of a mat, in elements
+// the packed axis is c for 3d and 4d, h for 2d and w for 1d
+static void strided_copy_mat_strides(const Mat& m, size_t* strides)
+{
+    const int elempack = m.elempack;
+
+    strides[3] = elempack;
+    strides[2] = (size_t)m.w * elempack;
+    strides[1] = (size_t)m.w * m.h * elempack;
+    strides[0] = m.cstep * elempack;
+}
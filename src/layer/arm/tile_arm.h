@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_TILE_ARM_H
+#define LAYER_TILE_ARM_H
+
+#include "tile.h"
+
+namespace ncnn {
+
+class Tile_arm : public Tile
+{
+public:
+    Tile_arm();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_TILE_ARM_H
@@ -0,0 +1,240 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "yolov3detectionoutput_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include <float.h>
+
+#include "topk_select.h"
+
+namespace ncnn {
+
+#include "detection_nms.h"
+
+Yolov3DetectionOutput_arm::Yolov3DetectionOutput_arm()
+{
+}
+
+static inline float sigmoid(float x)
+{
+    return 1.f / (1.f + expf(-x));
+}
+
+int Yolov3DetectionOutput_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    // gather all box
+    std::vector<BBoxRect> all_bbox_rects;
+
+    for (size_t b = 0; b < bottom_blobs.size(); b++)
+    {
+        std::vector<std::vector<BBoxRect> > all_box_bbox_rects;
+        all_box_bbox_rects.resize(num_box);
+        const Mat& bottom_top_blobs = bottom_blobs[b];
+
+        int w = bottom_top_blobs.w;
+        int h = bottom_top_blobs.h;
+        int channels = bottom_top_blobs.c;
+        const int channels_per_box = channels / num_box;
+
+        // anchor coord + box score + num_class
+        if (channels_per_box != 4 + 1 + num_class)
+            return -1;
+        size_t mask_offset = b * num_box;
+        int net_w = (int)(anchors_scale[b] * w);
+        int net_h = (int)(anchors_scale[b] * h);
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int pp = 0; pp < num_box; pp++)
+        {
+            int p = pp * channels_per_box;
+            int biases_index = static_cast<int>(mask[pp + mask_offset]);
+            const float bias_w = biases[biases_index * 2];
+            const float bias_h = biases[biases_index * 2 + 1];
+            const float* xptr = bottom_top_blobs.channel(p);
+            const float* yptr = bottom_top_blobs.channel(p + 1);
+            const float* wptr = bottom_top_blobs.channel(p + 2);
+            const float* hptr = bottom_top_blobs.channel(p + 3);
+
+            const float* box_score_ptr = bottom_top_blobs.channel(p + 4);
+
+            Mat scores = bottom_top_blobs.channel_range(p + 5, num_class);
+
+            const int cs = (int)scores.cstep;
+
+            for (int i = 0; i < h; i++)
+            {
+                // class index and max class score of each position in this row, -1 for boxes rejected by box score
+                int class_indexes[4];
+                float class_scores[4];
+
+                for (int j = 0; j < w;)
+                {
+                    const int z = i * w + j;
+                    const float* ptr = (const float*)scores.data + z;
+
+                    // the class score sigmoid is at most one, so a low box score rejects the box without looking at any class
+                    int nn = 0;
+                    int alive = 0;
+#if __ARM_NEON
+                    if (j + 3 < w)
+                    {
+                        nn = 4;
+                        for (int k = 0; k < 4; k++)
+                        {
+                            class_indexes[k] = sigmoid(box_score_ptr[z + k]) < confidence_threshold ? -1 : 0;
+                            alive |= class_indexes[k] + 1;
+                        }
+
+                        if (alive)
+                        {
+                            // the class scores of four neighbouring positions are contiguous, find their max in parallel
+                            float32x4_t _max = vld1q_f32(ptr);
+                            uint32x4_t _index = vdupq_n_u32(0);
+                            for (int q = 1; q < num_class; q++)
+                            {
+                                float32x4_t _p = vld1q_f32(ptr + q * cs);
+                                uint32x4_t _gt = vcgtq_f32(_p, _max);
+                                _max = vbslq_f32(_gt, _p, _max);
+                                _index = vbslq_u32(_gt, vdupq_n_u32(q), _index);
+                            }
+
+                            unsigned int indexes[4];
+                            vst1q_f32(class_scores, _max);
+                            vst1q_u32(indexes, _index);
+                            for (int k = 0; k < 4; k++)
+                            {
+                                if (class_indexes[k] != -1)
+                                    class_indexes[k] = (int)indexes[k];
+                            }
+                        }
+                    }
+                    else
+#endif // __ARM_NEON
+                    {
+                        nn = 1;
+                        class_indexes[0] = sigmoid(box_score_ptr[z]) < confidence_threshold ? -1 : 0;
+                        alive = class_indexes[0] + 1;
+
+                        if (alive)
+                        {
+                            // find class index with max class score
+                            int class_index = 0;
+                            float class_score = -FLT_MAX;
+                            for (int q = 0; q < num_class; q++)
+                            {
+                                float score = ptr[q * cs];
+                                if (score > class_score)
+                                {
+                                    class_index = q;
+                                    class_score = score;
+                                }
+                            }
+
+                            class_indexes[0] = class_index;
+                            class_scores[0] = class_score;
+                        }
+                    }
+
+                    for (int k = 0; alive && k < nn; k++)
+                    {
+                        if (class_indexes[k] == -1)
+                            continue;
+
+                        const int zk = z + k;
+                        const int jk = j + k;
+                        const float class_score = class_scores[k];
+
+                        //sigmoid(box_score) * sigmoid(class_score)
+                        float confidence = 1.f / ((1.f + expf(-box_score_ptr[zk]) * (1.f + expf(-class_score))));
+                        if (confidence >= confidence_threshold)
+                        {
+                            // region box
+                            float bbox_cx = (jk + sigmoid(xptr[zk])) / w;
+                            float bbox_cy = (i + sigmoid(yptr[zk])) / h;
+                            float bbox_w = expf(wptr[zk]) * bias_w / net_w;
+                            float bbox_h = expf(hptr[zk]) * bias_h / net_h;
+
+                            float bbox_xmin = bbox_cx - bbox_w * 0.5f;
+                            float bbox_ymin = bbox_cy - bbox_h * 0.5f;
+                            float bbox_xmax = bbox_cx + bbox_w * 0.5f;
+                            float bbox_ymax = bbox_cy + bbox_h * 0.5f;
+
+                            float area = bbox_w * bbox_h;
+
+                            BBoxRect c = {confidence, bbox_xmin, bbox_ymin, bbox_xmax, bbox_ymax, area, class_indexes[k]};
+                            all_box_bbox_rects[pp].push_back(c);
+                        }
+                    }
+
+                    j += nn;
+                }
+            }
+        }
+
+        for (int i = 0; i < num_box; i++)
+        {
+            const std::vector<BBoxRect>& box_bbox_rects = all_box_bbox_rects[i];
+
+            all_bbox_rects.insert(all_bbox_rects.end(), box_bbox_rects.begin(), box_bbox_rects.end());
+        }
+    }
+
+    // global sort
+    const int num_bbox = (int)all_bbox_rects.size();
+
+    std::vector<float> all_bbox_scores(num_bbox);
+    for (int i = 0; i < num_bbox; i++)
+    {
+        all_bbox_scores[i] = all_bbox_rects[i].score;
+    }
+
+    std::vector<int> sorted(num_bbox);
+    topk_select(all_bbox_scores.data(), 0, num_bbox, num_bbox, sorted.data());
+
+    BBoxSoA sorted_bboxes;
+    sorted_bboxes.resize(num_bbox);
+    for (int i = 0; i < num_bbox; i++)
+    {
+        const BBoxRect& r = all_bbox_rects[sorted[i]];
+        sorted_bboxes.xmin[i] = r.xmin;
+        sorted_bboxes.ymin[i] = r.ymin;
+        sorted_bboxes.xmax[i] = r.xmax;
+        sorted_bboxes.ymax[i] = r.ymax;
+        sorted_bboxes.area[i] = r.area;
+    }
+
+    // apply nms
+    std::vector<int> picked;
+    nms_sorted_bboxes_soa(sorted_bboxes, num_bbox, nms_threshold, num_bbox, picked);
+
+    // fill result
+    int num_detected = static_cast<int>(picked.size());
+    if (num_detected == 0)
+        return 0;
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(6, num_detected, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    for (int i = 0; i < num_detected; i++)
+    {
+        const BBoxRect& r = all_bbox_rects[sorted[picked[i]]];
+        float* outptr = top_blob.row(i);
+
+        outptr[0] = r.label + 1.0f; // +1 for prepend background class
+        outptr[1] = r.score;
+        outptr[2] = r.xmin;
+        outptr[3] = r.ymin;
+        outptr[4] = r.xmax;
+        outptr[5] = r.ymax;
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
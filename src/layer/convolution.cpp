@@ -325,6 +325,84 @@ int Convolution::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
     return 0;
 }
 
+int Convolution::forward_batch(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // the zero rows between the stacked items must match the padding of every single item
+    if (bottom_blob.dims != 3 || pad_left < 0 || pad_right < 0 || pad_top < 0 || pad_bottom < 0 || pad_value != 0.f)
+        return forward_batch_items(bottom_blob, top_blob, opt);
+
+    const int batch = bottom_blob.n;
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    const int outh = (h + pad_top + pad_bottom - kernel_extent_h) / stride_h + 1;
+    if (outh <= 0)
+        return forward_batch_items(bottom_blob, top_blob, opt);
+
+    // consecutive batch items are period rows apart, the zero rows in between serve as their bottom and top padding
+    // period is a multiple of stride_h so that every item starts at an output row
+    const int period = (h + pad_top + pad_bottom + stride_h - 1) / stride_h * stride_h;
+    const int stacked_h = period * (batch - 1) + h;
+
+    Mat bottom_blob_stacked;
+    bottom_blob_stacked.create(w, stacked_h, channels, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_blob_stacked.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        Mat m = bottom_blob_stacked.channel(q);
+
+        for (int b = 0; b < batch; b++)
+        {
+            unsigned char* outptr = m.row<unsigned char>(b * period);
+
+            memcpy(outptr, bottom_blob.batch(b).channel(q), w * h * elemsize);
+
+            if (b + 1 < batch)
+            {
+                memset(outptr + w * h * elemsize, 0, w * (period - h) * elemsize);
+            }
+        }
+    }
+
+    Option opt_stacked = opt;
+    opt_stacked.blob_allocator = opt.workspace_allocator;
+
+    Mat top_blob_stacked;
+    int ret = forward(bottom_blob_stacked, top_blob_stacked, opt_stacked);
+    if (ret != 0)
+        return ret;
+
+    const int outw = top_blob_stacked.w;
+    const int out_channels = top_blob_stacked.c;
+    const size_t out_elemsize = top_blob_stacked.elemsize;
+    const int out_elempack = top_blob_stacked.elempack;
+
+    top_blob.create_batch(outw, outh, out_channels, batch, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < out_channels; q++)
+    {
+        const Mat m = top_blob_stacked.channel(q);
+
+        for (int b = 0; b < batch; b++)
+        {
+            memcpy(top_blob.batch(b).channel(q), m.row<const unsigned char>(b * period / stride_h), outw * outh * out_elemsize);
+        }
+    }
+
+    return 0;
+}
+
 void Convolution::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, const Option& opt) const
 {
     make_padding(bottom_blob, bottom_blob_bordered, kernel_w, kernel_h, opt);
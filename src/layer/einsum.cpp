@@ -2,8 +2,12 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "einsum.h"
+
+#include <ctype.h>
 #include <string.h>
 
+#include <algorithm>
+
 namespace ncnn {
 
 Einsum::Einsum()
@@ -30,27 +34,20 @@ int Einsum::load_param(const ParamDict& pd)
         }
     }
 
-    if (equation == "ii")
-    {
-        // trace
-        rhs_token = "ii";
-
-        return 0;
-    }
+    // drop spaces
+    equation.erase(std::remove(equation.begin(), equation.end(), ' '), equation.end());
+    equation_ptr = (char*)equation.c_str();
 
     // split into tokens
     char* arrow = strstr(equation_ptr, "->");
-    if (!arrow)
+
+    if (arrow)
     {
-        NCNN_LOGE("invalid equation %s", equation_ptr);
-        return -1;
+        arrow[0] = '\0';
+        arrow[1] = '\0';
     }
 
-    arrow[0] = '\0';
-    arrow[1] = '\0';
-
     char* lhs = equation_ptr;
-    char* rhs = arrow + 2;
 
     {
         char* t = strtok(lhs, ",");
@@ -61,97 +58,132 @@ int Einsum::load_param(const ParamDict& pd)
         }
     }
 
-    rhs_token = std::string(rhs);
+    if (lhs_tokens.empty())
+    {
+        NCNN_LOGE("invalid equation");
+        return -1;
+    }
 
-    // check token always in ijkl
+    // check token always in a-zA-Z
+    for (size_t i = 0; i < lhs_tokens.size(); i++)
     {
-        for (size_t i = 0; i < rhs_token.size(); i++)
+        const std::string& lhs_token = lhs_tokens[i];
+        if (lhs_token.size() > 4)
+        {
+            NCNN_LOGE("invalid lhs_token %s", lhs_token.c_str());
+            return -1;
+        }
+
+        for (size_t j = 0; j < lhs_token.size(); j++)
         {
-            if (rhs_token[i] < 'i' || rhs_token[i] > 'l')
+            if (!isalpha((unsigned char)lhs_token[j]))
             {
-                NCNN_LOGE("invalid rhs_token %s", rhs_token.c_str());
+                NCNN_LOGE("invalid lhs_token %s", lhs_token.c_str());
                 return -1;
             }
         }
+    }
 
+    if (arrow)
+    {
+        rhs_token = std::string(arrow + 2);
+    }
+    else
+    {
+        // implicit output, the labels appearing exactly once in alphabetical order
+        int label_count[128] = {0};
         for (size_t i = 0; i < lhs_tokens.size(); i++)
         {
             const std::string& lhs_token = lhs_tokens[i];
             for (size_t j = 0; j < lhs_token.size(); j++)
             {
-                if (lhs_token[j] < 'i' || lhs_token[j] > 'x')
-                {
-                    NCNN_LOGE("invalid lhs_token %s", lhs_token.c_str());
-                    return -1;
-                }
+                label_count[(int)lhs_token[j]] += 1;
             }
         }
+
+        rhs_token.clear();
+        for (int i = 'A'; i <= 'z'; i++)
+        {
+            if (label_count[i] == 1)
+                rhs_token.push_back((char)i);
+        }
+    }
+
+    if (rhs_token.size() > 4)
+    {
+        NCNN_LOGE("invalid rhs_token %s", rhs_token.c_str());
+        return -1;
+    }
+
+    for (size_t i = 0; i < rhs_token.size(); i++)
+    {
+        bool found = false;
+        for (size_t j = 0; j < lhs_tokens.size(); j++)
+        {
+            if (lhs_tokens[j].find(rhs_token[i]) != std::string::npos)
+                found = true;
+        }
+
+        if (!found || rhs_token.find(rhs_token[i]) != i)
+        {
+            NCNN_LOGE("invalid rhs_token %s", rhs_token.c_str());
+            return -1;
+        }
     }
 
     return 0;
 }
 
-static float get_indexed_value(const Mat& m, const std::string& token, std::vector<int>& indexes)
+static void resolve_label_strides(const Mat& m, const std::string& token, std::vector<size_t>& label_strides, std::vector<int>& label_sizes)
 {
     const int dims = m.dims;
 
+    // the outermost axis comes first in the token
+    int shape[4] = {1, 1, 1, 1};
+    size_t strides[4] = {0, 0, 0, 0};
+
     if (dims == 1)
     {
-        int x = indexes[token[0] - 'i'];
-        return m[x];
+        shape[0] = m.w;
+        strides[0] = 1;
     }
-
     if (dims == 2)
     {
-        int y = indexes[token[0] - 'i'];
-        int x = indexes[token[1] - 'i'];
-        return m.row(y)[x];
+        shape[0] = m.h;
+        shape[1] = m.w;
+        strides[0] = m.w;
+        strides[1] = 1;
     }
-
     if (dims == 3)
     {
-        int c = indexes[token[0] - 'i'];
-        int y = indexes[token[1] - 'i'];
-        int x = indexes[token[2] - 'i'];
-        return m.channel(c).row(y)[x];
+        shape[0] = m.c;
+        shape[1] = m.h;
+        shape[2] = m.w;
+        strides[0] = m.cstep;
+        strides[1] = m.w;
+        strides[2] = 1;
     }
-
     if (dims == 4)
     {
-        int c = indexes[token[0] - 'i'];
-        int z = indexes[token[1] - 'i'];
-        int y = indexes[token[2] - 'i'];
-        int x = indexes[token[3] - 'i'];
-        return m.channel(c).depth(z).row(y)[x];
+        shape[0] = m.c;
+        shape[1] = m.d;
+        shape[2] = m.h;
+        shape[3] = m.w;
+        strides[0] = m.cstep;
+        strides[1] = (size_t)m.w * m.h;
+        strides[2] = m.w;
+        strides[3] = 1;
     }
 
-    // should never reach here
-    return 0;
-}
-
-static float sum_dim(const std::vector<int>& dim_sizes, int d, const std::vector<Mat>& bottom_blobs, const std::vector<std::string>& tokens, std::vector<int>& indexes)
-{
-    if (d == (int)dim_sizes.size())
-    {
-        float v = 1.f;
-        for (size_t b = 0; b < bottom_blobs.size(); b++)
-        {
-            v *= get_indexed_value(bottom_blobs[b], tokens[b], indexes);
-        }
-
-        return v;
-    }
+    label_strides.resize(128);
+    std::fill(label_strides.begin(), label_strides.end(), (size_t)0);
 
-    float sum = 0.f;
-
-    for (int i = 0; i < dim_sizes[d]; i++)
+    for (int s = 0; s < dims; s++)
     {
-        indexes[d] = i;
-
-        sum += sum_dim(dim_sizes, d + 1, bottom_blobs, tokens, indexes);
+        // repeated labels walk the diagonal
+        label_strides[(int)token[s]] += strides[s];
+        label_sizes[(int)token[s]] = shape[s];
     }
-
-    return sum;
 }
 
 int Einsum::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
@@ -159,166 +191,121 @@ int Einsum::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
     // assert bottom_blobs.size() == lhs_tokens.size()
     // assert top_blobs.size() == 1
 
-    size_t elemsize = bottom_blobs[0].elemsize;
+    const size_t elemsize = bottom_blobs[0].elemsize;
+    const int input_count = (int)bottom_blobs.size();
 
-    if (lhs_tokens.empty() && rhs_token == "ii")
+    if (input_count != (int)lhs_tokens.size())
     {
-        // assert bottom_blobs.size() == 1
-        // assert bottom_blob.dims == 2
-        // assert bottom_blob.w == bottom_blob.h
-
-        // trace
-        Mat& top_blob = top_blobs[0];
-        top_blob.create(1, elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        const Mat& bottom_blob = bottom_blobs[0];
-
-        float sum = 0.f;
+        NCNN_LOGE("einsum expects %d inputs but got %d", (int)lhs_tokens.size(), input_count);
+        return -1;
+    }
 
-        for (int i = 0; i < bottom_blob.h; i++)
+    // resolve dimension sizes
+    std::vector<int> label_sizes(128, 0);
+    std::vector<std::vector<size_t> > label_strides(input_count);
+    for (int b = 0; b < input_count; b++)
+    {
+        if (bottom_blobs[b].dims != (int)lhs_tokens[b].size())
         {
-            sum += bottom_blob.row(i)[i];
+            NCNN_LOGE("einsum input %d dims %d mismatch with token %s", b, bottom_blobs[b].dims, lhs_tokens[b].c_str());
+            return -1;
         }
 
-        top_blob[0] = sum;
-
-        return 0;
+        resolve_label_strides(bottom_blobs[b], lhs_tokens[b], label_strides[b], label_sizes);
     }
 
-    // resolve dimension sizes
-    std::vector<int> dim_sizes(16, 1); // map ijklmnopqrstuvwx -> dim_size
-    int dim_sizes_count = 0;
-
-    for (size_t b = 0; b < bottom_blobs.size(); b++)
+    // the labels absent in output are summed
+    std::string sum_labels;
+    for (int b = 0; b < input_count; b++)
     {
         const std::string& lhs_token = lhs_tokens[b];
-        const Mat& bottom_blob = bottom_blobs[b];
-        const int in_dims = bottom_blob.dims;
-
-        for (int s = 0; s < in_dims; s++)
+        for (size_t s = 0; s < lhs_token.size(); s++)
         {
-            int dim_size = 1;
-            if (in_dims == 1) dim_size = bottom_blob.w;
-            if (in_dims == 2 && s == 0) dim_size = bottom_blob.h;
-            if (in_dims == 2 && s == 1) dim_size = bottom_blob.w;
-            if (in_dims == 3 && s == 0) dim_size = bottom_blob.c;
-            if (in_dims == 3 && s == 1) dim_size = bottom_blob.h;
-            if (in_dims == 3 && s == 2) dim_size = bottom_blob.w;
-            if (in_dims == 4 && s == 0) dim_size = bottom_blob.c;
-            if (in_dims == 4 && s == 1) dim_size = bottom_blob.d;
-            if (in_dims == 4 && s == 2) dim_size = bottom_blob.h;
-            if (in_dims == 4 && s == 3) dim_size = bottom_blob.w;
-
-            int dim_sizes_index = lhs_token[s] - 'i';
-            dim_sizes[dim_sizes_index] = dim_size;
-            dim_sizes_count = std::max(dim_sizes_count, dim_sizes_index + 1);
+            if (rhs_token.find(lhs_token[s]) == std::string::npos && sum_labels.find(lhs_token[s]) == std::string::npos)
+                sum_labels.push_back(lhs_token[s]);
         }
     }
 
-    dim_sizes.resize(dim_sizes_count);
-
     const int out_dims = (int)rhs_token.size();
 
-    std::vector<int> indexes(dim_sizes_count);
-
+    Mat& top_blob = top_blobs[0];
+    if (out_dims == 0)
+        top_blob.create(1, elemsize, opt.blob_allocator);
     if (out_dims == 1)
-    {
-        Mat& top_blob = top_blobs[0];
-        top_blob.create(dim_sizes[0], elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        for (int i = 0; i < top_blob.w; i++)
-        {
-            indexes[0] = i;
-
-            float sum = sum_dim(dim_sizes, 1, bottom_blobs, lhs_tokens, indexes);
+        top_blob.create(label_sizes[(int)rhs_token[0]], elemsize, opt.blob_allocator);
+    if (out_dims == 2)
+        top_blob.create(label_sizes[(int)rhs_token[1]], label_sizes[(int)rhs_token[0]], elemsize, opt.blob_allocator);
+    if (out_dims == 3)
+        top_blob.create(label_sizes[(int)rhs_token[2]], label_sizes[(int)rhs_token[1]], label_sizes[(int)rhs_token[0]], elemsize, opt.blob_allocator);
+    if (out_dims == 4)
+        top_blob.create(label_sizes[(int)rhs_token[3]], label_sizes[(int)rhs_token[2]], label_sizes[(int)rhs_token[1]], label_sizes[(int)rhs_token[0]], elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
 
-            top_blob[i] = sum;
-        }
+    std::vector<size_t> top_label_strides(128, 0);
+    if (out_dims > 0)
+    {
+        std::vector<int> top_label_sizes(128, 0);
+        resolve_label_strides(top_blob, rhs_token, top_label_strides, top_label_sizes);
     }
 
-    if (out_dims == 2)
+    int out_size = 1;
+    for (int s = 0; s < out_dims; s++)
     {
-        Mat& top_blob = top_blobs[0];
-        top_blob.create(dim_sizes[1], dim_sizes[0], elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
-
-        for (int i = 0; i < top_blob.h; i++)
-        {
-            indexes[0] = i;
-
-            for (int j = 0; j < top_blob.w; j++)
-            {
-                indexes[1] = j;
-
-                float sum = sum_dim(dim_sizes, 2, bottom_blobs, lhs_tokens, indexes);
+        out_size *= label_sizes[(int)rhs_token[s]];
+    }
 
-                top_blob.row(i)[j] = sum;
-            }
-        }
+    int sum_size = 1;
+    for (size_t s = 0; s < sum_labels.size(); s++)
+    {
+        sum_size *= label_sizes[(int)sum_labels[s]];
     }
 
-    if (out_dims == 3)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < out_size; i++)
     {
-        Mat& top_blob = top_blobs[0];
-        top_blob.create(dim_sizes[2], dim_sizes[1], dim_sizes[0], elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
+        std::vector<size_t> offsets(input_count, 0);
+        size_t outptr_offset = 0;
 
-        for (int i = 0; i < top_blob.c; i++)
+        int t = i;
+        for (int s = out_dims - 1; s >= 0; s--)
         {
-            indexes[0] = i;
+            const int label = rhs_token[s];
+            const int index = t % label_sizes[label];
+            t /= label_sizes[label];
 
-            for (int j = 0; j < top_blob.h; j++)
+            for (int b = 0; b < input_count; b++)
             {
-                indexes[1] = j;
-
-                for (int k = 0; k < top_blob.w; k++)
-                {
-                    indexes[2] = k;
-
-                    float sum = sum_dim(dim_sizes, 3, bottom_blobs, lhs_tokens, indexes);
-
-                    top_blob.channel(i).row(j)[k] = sum;
-                }
+                offsets[b] += index * label_strides[b][label];
             }
+            outptr_offset += index * top_label_strides[label];
         }
-    }
 
-    if (out_dims == 4)
-    {
-        Mat& top_blob = top_blobs[0];
-        top_blob.create(dim_sizes[3], dim_sizes[2], dim_sizes[1], dim_sizes[0], elemsize, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
+        float sum = 0.f;
 
-        for (int i = 0; i < top_blob.c; i++)
+        for (int j = 0; j < sum_size; j++)
         {
-            indexes[0] = i;
+            float v = 1.f;
 
-            for (int j = 0; j < top_blob.d; j++)
+            for (int b = 0; b < input_count; b++)
             {
-                indexes[1] = j;
+                size_t offset = offsets[b];
 
-                for (int k = 0; k < top_blob.h; k++)
+                int u = j;
+                for (int s = (int)sum_labels.size() - 1; s >= 0; s--)
                 {
-                    indexes[2] = k;
-
-                    for (int l = 0; l < top_blob.w; l++)
-                    {
-                        indexes[3] = l;
-
-                        float sum = sum_dim(dim_sizes, 4, bottom_blobs, lhs_tokens, indexes);
-
-                        top_blob.channel(i).depth(j).row(k)[l] = sum;
-                    }
+                    const int label = sum_labels[s];
+                    offset += (u % label_sizes[label]) * label_strides[b][label];
+                    u /= label_sizes[label];
                 }
+
+                v *= ((const float*)bottom_blobs[b])[offset];
             }
+
+            sum += v;
         }
+
+        ((float*)top_blob)[outptr_offset] = sum;
     }
 
     return 0;
@@ -3,6 +3,8 @@
 
 #include "embed.h"
 
+#include "weight_quant.h"
+
 #include <string.h>
 
 namespace ncnn {
@@ -20,6 +22,33 @@ int Embed::load_param(const ParamDict& pd)
     bias_term = pd.get(2, 0);
     weight_data_size = pd.get(3, 0);
     int8_scale_term = pd.get(18, 0);
+    weight_quant_bits = pd.get(19, 0);
+    weight_quant_group_size = pd.get(20, 32);
+
+    if (weight_quant_bits)
+    {
+#if !NCNN_INT8
+        NCNN_LOGE("please build ncnn with NCNN_INT8 enabled for weight quantization");
+        return -1;
+#endif
+        if (weight_quant_bits != 8 && weight_quant_bits != 4)
+        {
+            NCNN_LOGE("weight_quant_bits must be 8 or 4");
+            return -1;
+        }
+
+        if (weight_quant_bits == 4 && (weight_quant_group_size <= 0 || weight_quant_group_size % 8 != 0))
+        {
+            NCNN_LOGE("weight_quant_group_size must be a positive multiple of 8");
+            return -1;
+        }
+
+        if (int8_scale_term)
+        {
+            NCNN_LOGE("weight_quant_bits and int8_scale_term can not be both enabled");
+            return -1;
+        }
+    }
 
     return 0;
 }
@@ -44,6 +73,19 @@ int Embed::load_model(const ModelBin& mb)
     }
 #endif // NCNN_INT8
 
+#if NCNN_INT8
+    if (weight_quant_bits)
+    {
+        // every word is one row of num_output
+        Mat weight_data_quant;
+        int ret = load_weight_quant(weight_data, mb, num_output, input_dim, weight_quant_bits, weight_quant_group_size, weight_data_quant, weight_quant_scales, weight_quant_zeros);
+        if (ret != 0)
+            return ret;
+
+        weight_data = weight_data_quant;
+    }
+#endif // NCNN_INT8
+
     return 0;
 }
 
@@ -122,6 +164,46 @@ static void embed_int8(const Mat& bottom_blob, const Mat& weight_data, float wei
         }
     }
 }
+
+static void embed_weight_quant(const Mat& bottom_blob, const Mat& weight_data, const Mat& weight_quant_scales, const Mat& weight_quant_zeros, int weight_quant_bits, int group_size, const Mat& bias_data, Mat& top_blob, int input_dim, const Option& opt)
+{
+    const int num_output = top_blob.w;
+    const int words = top_blob.h;
+
+    const int num_groups = weight_quant_group_count(num_output, weight_quant_bits, group_size);
+
+    const float* bias_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < words; q++)
+    {
+        float* outptr = top_blob.row(q);
+
+        int word_index = ((const int*)bottom_blob)[q];
+
+        if (word_index < 0)
+            word_index = 0;
+        if (word_index >= input_dim)
+            word_index = input_dim - 1;
+
+        for (int p = 0; p < num_output; p++)
+        {
+            float v;
+            if (weight_quant_bits == 8)
+            {
+                v = weight_data.row<const signed char>(word_index)[p] * weight_quant_scales[word_index];
+            }
+            else
+            {
+                const int g = num_groups * word_index + p / group_size;
+                const int w = (weight_data.row<const unsigned char>(word_index)[p / 2] >> ((p % 2) * 4)) & 15;
+                v = (w - weight_quant_zeros[g]) * weight_quant_scales[g];
+            }
+
+            outptr[p] = bias_ptr ? v + bias_ptr[p] : v;
+        }
+    }
+}
 #endif // NCNN_INT8
 
 int Embed::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
@@ -133,7 +215,11 @@ int Embed::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) con
         return -100;
 
 #if NCNN_INT8
-    if (int8_scale_term)
+    if (weight_quant_bits)
+    {
+        embed_weight_quant(bottom_blob, weight_data, weight_quant_scales, weight_quant_zeros, weight_quant_bits, weight_quant_group_size, bias_data, top_blob, input_dim, opt);
+    }
+    else if (int8_scale_term)
     {
         embed_int8(bottom_blob, weight_data, weight_data_int8_scale, bias_data, top_blob, input_dim, opt);
     }
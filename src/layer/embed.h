@@ -29,12 +29,20 @@ public:
 
     int int8_scale_term;
 
+    // weight-only quantization, 0=off 8=int8 per word 4=uint4 per group
+    int weight_quant_bits;
+    int weight_quant_group_size;
+
     // model
     Mat weight_data;
     Mat bias_data;
 
 #if NCNN_INT8
     float weight_data_int8_scale;
+
+    // weight_data holds the quantized rows when weight_quant_bits is set
+    Mat weight_quant_scales;
+    Mat weight_quant_zeros;
 #endif
 };
 
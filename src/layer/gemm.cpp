@@ -3,6 +3,8 @@
 
 #include "gemm.h"
 
+#include "weight_quant.h"
+
 namespace ncnn {
 
 Gemm::Gemm()
@@ -32,6 +34,8 @@ int Gemm::load_param(const ParamDict& pd)
     constant_TILE_M = pd.get(20, 0);
     constant_TILE_N = pd.get(21, 0);
     constant_TILE_K = pd.get(22, 0);
+    weight_quant_bits = pd.get(23, 0);
+    weight_quant_group_size = pd.get(24, 32);
 
     if (int8_scale_term)
     {
@@ -41,6 +45,31 @@ int Gemm::load_param(const ParamDict& pd)
 #endif
     }
 
+    if (weight_quant_bits)
+    {
+#if !NCNN_INT8
+        NCNN_LOGE("please build ncnn with NCNN_INT8 enabled for weight quantization");
+        return -1;
+#endif
+        if (weight_quant_bits != 8 && weight_quant_bits != 4)
+        {
+            NCNN_LOGE("weight_quant_bits must be 8 or 4");
+            return -1;
+        }
+
+        if (weight_quant_bits == 4 && (weight_quant_group_size <= 0 || weight_quant_group_size % 8 != 0))
+        {
+            NCNN_LOGE("weight_quant_group_size must be a positive multiple of 8");
+            return -1;
+        }
+
+        if (constantA == 1 || constantB == 0 || int8_scale_term)
+        {
+            NCNN_LOGE("weight_quant_bits requires constant B, non-constant A and int8_scale_term disabled");
+            return -1;
+        }
+    }
+
     if (constantA == 1 && (constantM == 0 || constantK == 0))
     {
         NCNN_LOGE("constantM and constantK must be non-zero when constantA enabled");
@@ -110,6 +139,34 @@ int Gemm::load_model(const ModelBin& mb)
     }
 
 #if NCNN_INT8
+    if (weight_quant_bits)
+    {
+        // quantize the N rows of K
+        Mat B_data_rows = B_data;
+        if (transB == 0)
+        {
+            B_data_rows.create(constantK, constantN, B_data.elemsize);
+            if (B_data_rows.empty())
+                return -100;
+
+            for (int i = 0; i < constantN; i++)
+            {
+                unsigned char* ptr = B_data_rows.row<unsigned char>(i);
+                for (int k = 0; k < constantK; k++)
+                {
+                    memcpy(ptr + k * B_data.elemsize, B_data.row<const unsigned char>(k) + i * B_data.elemsize, B_data.elemsize);
+                }
+            }
+        }
+
+        Mat B_data_quant;
+        int ret = load_weight_quant(B_data_rows, mb, constantK, constantN, weight_quant_bits, weight_quant_group_size, B_data_quant, B_quant_scales, B_quant_zeros);
+        if (ret != 0)
+            return ret;
+
+        B_data = B_data_quant;
+    }
+
     if (int8_scale_term)
     {
         if (constantA == 1)
@@ -298,7 +355,19 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
 #endif // NCNN_INT8
 
     const Mat& A0 = constantA ? A_data : bottom_blobs[0];
-    const Mat& B0 = constantB ? B_data : constantA ? bottom_blobs[0] : bottom_blobs[1];
+    Mat B0 = constantB ? B_data : constantA ? bottom_blobs[0] : bottom_blobs[1];
+    int B0_transposed = transB;
+
+#if NCNN_INT8
+    if (weight_quant_bits)
+    {
+        int ret = dequantize_weight(B_data, B_quant_scales, B_quant_zeros, constantK, constantN, weight_quant_bits, weight_quant_group_size, B0, opt.workspace_allocator);
+        if (ret != 0)
+            return ret;
+
+        B0_transposed = 1;
+    }
+#endif
 
     size_t elemsize = A0.elemsize;
 
@@ -327,7 +396,7 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
     }
 
     Mat BT;
-    if (transB == 0)
+    if (B0_transposed == 0)
     {
         // transpose B to col-major
         BT.create((B0.dims == 3 ? B0.c : B0.h), B0.w, elemsize, opt.workspace_allocator);
@@ -434,6 +503,90 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
     return 0;
 }
 
+int Gemm::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, int elempack, int out_elempack, const Option& opt) const
+{
+    const Mat& A = bottom_blobs[0];
+
+    // C broadcast along M would differ between the stacked batch items
+    const bool broadcast_C_M = constantC && constant_broadcast_type_C != 0 && constant_broadcast_type_C != 4;
+    if (constantA || !constantB || transA || output_transpose || output_N1M || int8_scale_term || broadcast_C_M || bottom_blobs.size() != 1 || A.dims != 2)
+        return forward_batch_items(bottom_blobs, top_blobs, opt);
+
+    const int batch = A.n;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    Mat A_unpacked = A;
+    if (A.elempack != 1)
+    {
+        convert_packing(A, A_unpacked, 1, opt_ws);
+        if (A_unpacked.empty())
+            return -100;
+    }
+
+    const int K = A_unpacked.w;
+    const int M = A_unpacked.h;
+    const size_t elemsize = A_unpacked.elemsize;
+
+    Mat A_rows;
+    A_rows.create(K, M * batch, elemsize, opt.workspace_allocator);
+    if (A_rows.empty())
+        return -100;
+
+    for (int b = 0; b < batch; b++)
+    {
+        memcpy(A_rows.row<unsigned char>(b * M), A_unpacked.batch(b), K * M * elemsize);
+    }
+
+    std::vector<Mat> bottom_rows(1);
+    bottom_rows[0] = A_rows;
+    if (elempack != 1)
+    {
+        convert_packing(A_rows, bottom_rows[0], elempack, opt_ws);
+        if (bottom_rows[0].empty())
+            return -100;
+    }
+
+    // the constant B is packed once for the whole batch
+    std::vector<Mat> top_rows(1);
+    int ret = forward(bottom_rows, top_rows, opt_ws);
+    if (ret != 0)
+        return ret;
+
+    Mat top_rows_unpacked = top_rows[0];
+    if (top_rows[0].elempack != 1)
+    {
+        convert_packing(top_rows[0], top_rows_unpacked, 1, opt_ws);
+        if (top_rows_unpacked.empty())
+            return -100;
+    }
+
+    const int N = top_rows_unpacked.w;
+    const size_t out_elemsize = top_rows_unpacked.elemsize;
+
+    Mat top_blob_unpacked;
+    top_blob_unpacked.create_batch(N, M, batch, out_elemsize, 1, out_elempack == 1 ? opt.blob_allocator : opt.workspace_allocator);
+    if (top_blob_unpacked.empty())
+        return -100;
+
+    for (int b = 0; b < batch; b++)
+    {
+        memcpy(top_blob_unpacked.batch(b), top_rows_unpacked.row<const unsigned char>(b * M), N * M * out_elemsize);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob = top_blob_unpacked;
+    if (out_elempack != 1)
+    {
+        convert_packing(top_blob_unpacked, top_blob, out_elempack, opt);
+        if (top_blob.empty())
+            return -100;
+    }
+
+    return 0;
+}
+
 #if NCNN_INT8
 int Gemm::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
@@ -22,6 +22,10 @@ public:
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
 protected:
+    // fold the batched A (n > 1) into the gemm rows when B and C are shared by all batch items
+    // the rows are packed by elempack, the batch items come out packed by out_elempack
+    int forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, int elempack, int out_elempack, const Option& opt) const;
+
 #if NCNN_INT8
     int forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 #endif
@@ -46,6 +50,10 @@ public:
 
     int int8_scale_term;
 
+    // weight-only quantization of the constant B, 0=off 8=int8 per column 4=uint4 per group
+    int weight_quant_bits;
+    int weight_quant_group_size;
+
     int constant_TILE_M;
     int constant_TILE_N;
     int constant_TILE_K;
@@ -58,6 +66,10 @@ public:
 #if NCNN_INT8
     Mat A_data_int8_scales;
     float B_data_int8_scale;
+
+    // B_data holds the quantized N rows of K when weight_quant_bits is set
+    Mat B_quant_scales;
+    Mat B_quant_zeros;
 #endif
 };
 
@@ -6,6 +6,7 @@
 #include "layer_type.h"
 
 #include "fused_activation.h"
+#include "weight_quant.h"
 
 namespace ncnn {
 
@@ -23,6 +24,8 @@ int InnerProduct::load_param(const ParamDict& pd)
     int8_scale_term = pd.get(8, 0);
     activation_type = pd.get(9, 0);
     activation_params = pd.get(10, Mat());
+    weight_quant_bits = pd.get(11, 0);
+    weight_quant_group_size = pd.get(12, 32);
 
     if (int8_scale_term)
     {
@@ -34,6 +37,31 @@ int InnerProduct::load_param(const ParamDict& pd)
 #endif
     }
 
+    if (weight_quant_bits)
+    {
+#if !NCNN_INT8
+        NCNN_LOGE("please build ncnn with NCNN_INT8 enabled for weight quantization");
+        return -1;
+#endif
+        if (weight_quant_bits != 8 && weight_quant_bits != 4)
+        {
+            NCNN_LOGE("weight_quant_bits must be 8 or 4");
+            return -1;
+        }
+
+        if (weight_quant_bits == 4 && (weight_quant_group_size <= 0 || weight_quant_group_size % 8 != 0))
+        {
+            NCNN_LOGE("weight_quant_group_size must be a positive multiple of 8");
+            return -1;
+        }
+
+        if (int8_scale_term)
+        {
+            NCNN_LOGE("weight_quant_bits and int8_scale_term can not be both enabled");
+            return -1;
+        }
+    }
+
     return 0;
 }
 
@@ -50,6 +78,20 @@ int InnerProduct::load_model(const ModelBin& mb)
             return -100;
     }
 
+#if NCNN_INT8
+    if (weight_quant_bits)
+    {
+        const int num_input = weight_data_size / num_output;
+
+        Mat weight_data_quant;
+        int ret = load_weight_quant(weight_data, mb, num_input, num_output, weight_quant_bits, weight_quant_group_size, weight_data_quant, weight_quant_scales, weight_quant_zeros);
+        if (ret != 0)
+            return ret;
+
+        weight_data = weight_data_quant;
+    }
+#endif // NCNN_INT8
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -84,7 +126,7 @@ int InnerProduct::load_model(const ModelBin& mb)
 int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
 #if NCNN_INT8
-    if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
+    if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u && !weight_quant_bits)
     {
         return forward_int8(bottom_blob, top_blob, opt);
     }
@@ -92,6 +134,16 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
 
     const int num_input = weight_data_size / num_output;
 
+    Mat weight = weight_data;
+#if NCNN_INT8
+    if (weight_quant_bits)
+    {
+        int ret = dequantize_weight(weight_data, weight_quant_scales, weight_quant_zeros, num_input, num_output, weight_quant_bits, weight_quant_group_size, weight, opt.workspace_allocator);
+        if (ret != 0)
+            return ret;
+    }
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int d = bottom_blob.d;
@@ -114,7 +166,7 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
 
             for (int p = 0; p < num_output; p++)
             {
-                const float* kptr = (const float*)weight_data + w * p;
+                const float* kptr = (const float*)weight + w * p;
 
                 float sum = 0.f;
 
@@ -149,7 +201,7 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
         // channels
         for (int q = 0; q < channels; q++)
         {
-            const float* w = (const float*)weight_data + size * channels * p + size * q;
+            const float* w = (const float*)weight + size * channels * p + size * q;
             const float* m = bottom_blob.channel(q);
 
             for (int i = 0; i < size; i++)
@@ -164,6 +216,109 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
     return 0;
 }
 
+int InnerProduct::forward_batch(const Mat& bottom_blob, Mat& top_blob, int elempack, int out_elempack, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+    const int batch = bottom_blob.n;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    // every batch item contributes its h rows, or one row when flattened
+    const bool gemm = bottom_blob.dims == 2 && bottom_blob.w == num_input;
+
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (gemm && bottom_blob.elempack != 1)
+    {
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_ws);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+    }
+
+    const int h = gemm ? bottom_blob_unpacked.h : 1;
+    const size_t elemsize = bottom_blob.elemsize / bottom_blob.elempack;
+
+    Mat bottom_rows;
+    bottom_rows.create(num_input, h * batch, elemsize, opt.workspace_allocator);
+    if (bottom_rows.empty())
+        return -100;
+
+    for (int b = 0; b < batch; b++)
+    {
+        Mat bottom_blob_b = bottom_blob_unpacked.batch(b);
+        if (!gemm && bottom_blob_b.dims != 1)
+        {
+            Mat bottom_blob_b_flattened;
+            flatten(bottom_blob_b, bottom_blob_b_flattened, opt_ws);
+            if (bottom_blob_b_flattened.empty())
+                return -100;
+
+            bottom_blob_b = bottom_blob_b_flattened;
+        }
+
+        memcpy(bottom_rows.row<unsigned char>(b * h), bottom_blob_b, num_input * h * elemsize);
+    }
+
+    Mat bottom_rows_packed = bottom_rows;
+    if (elempack != 1)
+    {
+        convert_packing(bottom_rows, bottom_rows_packed, elempack, opt_ws);
+        if (bottom_rows_packed.empty())
+            return -100;
+    }
+
+    // the weights are read once for the whole batch
+    Mat top_rows;
+    int ret = forward(bottom_rows_packed, top_rows, opt_ws);
+    if (ret != 0)
+        return ret;
+
+    Mat top_rows_unpacked = top_rows;
+    if (top_rows.elempack != 1)
+    {
+        convert_packing(top_rows, top_rows_unpacked, 1, opt_ws);
+        if (top_rows_unpacked.empty())
+            return -100;
+    }
+
+    const size_t out_elemsize = top_rows_unpacked.elemsize;
+
+    if (gemm)
+    {
+        Mat top_blob_unpacked;
+        top_blob_unpacked.create_batch(num_output, h, batch, out_elemsize, 1, bottom_blob.elempack == 1 ? opt.blob_allocator : opt.workspace_allocator);
+        if (top_blob_unpacked.empty())
+            return -100;
+
+        for (int b = 0; b < batch; b++)
+        {
+            memcpy(top_blob_unpacked.batch(b), top_rows_unpacked.row<const unsigned char>(b * h), num_output * h * out_elemsize);
+        }
+
+        top_blob = top_blob_unpacked;
+        if (bottom_blob.elempack != 1)
+        {
+            // keep the packing of the batch items
+            convert_packing(top_blob_unpacked, top_blob, bottom_blob.elempack, opt);
+            if (top_blob.empty())
+                return -100;
+        }
+
+        return 0;
+    }
+
+    top_blob.create_batch(num_output / out_elempack, batch, out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    for (int b = 0; b < batch; b++)
+    {
+        memcpy(top_blob.batch(b), top_rows_unpacked.row<const unsigned char>(b), num_output * out_elemsize);
+    }
+
+    return 0;
+}
+
 #if NCNN_INT8
 int InnerProduct::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
@@ -20,6 +20,10 @@ public:
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
 protected:
+    // fold the batched input (n > 1) into the gemm rows
+    // the rows are packed by elempack, the flattened batch items come out packed by out_elempack
+    int forward_batch(const Mat& bottom_blob, Mat& top_blob, int elempack, int out_elempack, const Option& opt) const;
+
 #if NCNN_INT8
     int forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #endif
@@ -33,6 +37,10 @@ public:
 
     int int8_scale_term;
 
+    // weight-only quantization, 0=off 8=int8 per output 4=uint4 per group
+    int weight_quant_bits;
+    int weight_quant_group_size;
+
     // 0=none 1=relu 2=leakyrelu 3=clip 4=sigmoid
     int activation_type;
     Mat activation_params;
@@ -44,6 +52,10 @@ public:
 #if NCNN_INT8
     Mat weight_data_int8_scales;
     Mat bottom_blob_int8_scales;
+
+    // weight_data holds the quantized rows when weight_quant_bits is set
+    Mat weight_quant_scales;
+    Mat weight_quant_zeros;
 #endif
 };
 
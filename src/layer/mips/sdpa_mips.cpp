@@ -158,50 +158,14 @@ int SDPA_mips::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& t
     const size_t elemsize = query.elemsize;
 
     Mat key;
-    if (past_seqlen > 0)
-    {
-        key.create(embed_dim, dst_seqlen, num_group, elemsize, opt.blob_allocator);
-        if (key.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
-        {
-            const Mat past_key_head = past_key.channel(q);
-            const Mat cur_key_head = cur_key.channel(q);
-            Mat key_head = key.channel(q);
-
-            memcpy(key_head.row(0), past_key_head, embed_dim * past_seqlen * elemsize);
-            memcpy(key_head.row(past_seqlen), cur_key_head, embed_dim * cur_seqlen * elemsize);
-        }
-    }
-    else
-    {
-        key = cur_key;
-    }
+    int retk = concat_kv_cache(past_key, cur_key, embed_dim, key, opt);
+    if (retk != 0)
+        return retk;
 
     Mat value;
-    if (past_seqlen > 0)
-    {
-        value.create(out_embed_dim, dst_seqlen, num_group, elemsize, opt.blob_allocator);
-        if (value.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
-        {
-            const Mat past_value_head = past_value.channel(q);
-            const Mat cur_value_head = cur_value.channel(q);
-            Mat value_head = value.channel(q);
-
-            memcpy(value_head.row(0), past_value_head, out_embed_dim * past_seqlen * elemsize);
-            memcpy(value_head.row(past_seqlen), cur_value_head, out_embed_dim * cur_seqlen * elemsize);
-        }
-    }
-    else
-    {
-        value = cur_value;
-    }
+    int retv = concat_kv_cache(past_value, cur_value, out_embed_dim, value, opt);
+    if (retv != 0)
+        return retv;
 
     const int num_heads_per_group = num_heads / num_group;
 
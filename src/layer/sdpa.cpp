@@ -23,6 +23,57 @@ int SDPA::load_param(const ParamDict& pd)
     return 0;
 }
 
+int SDPA::concat_kv_cache(const Mat& past, const Mat& cur, int w, Mat& out, const Option& opt) const
+{
+    const int past_seqlen = past.h;
+    const int cur_seqlen = cur.h;
+    const int dst_seqlen = past_seqlen + cur_seqlen;
+    const int num_group = cur.c;
+    const size_t elemsize = cur.elemsize;
+
+    if (past.empty() || past_seqlen == 0)
+    {
+        out = cur;
+        return 0;
+    }
+
+    // a past blob whose channel step exceeds its own shape carries reserved capacity
+    const size_t past_cstep = past.dims == 3 ? alignSize((size_t)past.w * past.h * past.elemsize, 16) / past.elemsize : (size_t)past.w * past.h;
+    if (past.w == w && past.c == num_group && past.elemsize == elemsize && past.elempack == cur.elempack && past.cstep > past_cstep && past.cstep >= (size_t)w * dst_seqlen)
+    {
+        out = past;
+        out.h = dst_seqlen;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < num_group; q++)
+        {
+            const Mat cur_head = cur.channel(q);
+            Mat out_head = out.channel(q);
+
+            memcpy(out_head.row<unsigned char>(past_seqlen), cur_head, w * cur_seqlen * elemsize);
+        }
+
+        return 0;
+    }
+
+    out.create(w, dst_seqlen, num_group, elemsize, opt.blob_allocator);
+    if (out.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_group; q++)
+    {
+        const Mat past_head = past.channel(q);
+        const Mat cur_head = cur.channel(q);
+        Mat out_head = out.channel(q);
+
+        memcpy(out_head.row<unsigned char>(0), past_head, w * past_seqlen * elemsize);
+        memcpy(out_head.row<unsigned char>(past_seqlen), cur_head, w * cur_seqlen * elemsize);
+    }
+
+    return 0;
+}
+
 // refers to https://pytorch.org/docs/stable/generated/torch.nn.functional.scaled_dot_product_attention.html
 int SDPA::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
@@ -66,45 +117,15 @@ int SDPA::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
     if (qk_cross.empty())
         return -100;
 
-    Mat key = cur_key;
-    if (past_seqlen > 0)
-    {
-        key.create(embed_dim, dst_seqlen, num_group, 4u, opt.blob_allocator);
-        if (key.empty())
-            return -100;
-
-        // concat
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
-        {
-            const Mat past_key_head = past_key.channel(q);
-            const Mat cur_key_head = cur_key.channel(q);
-            Mat key_head = key.channel(q);
-
-            memcpy(key_head.row(0), past_key_head, embed_dim * past_seqlen * sizeof(float));
-            memcpy(key_head.row(past_seqlen), cur_key_head, embed_dim * cur_seqlen * sizeof(float));
-        }
-    }
+    Mat key;
+    int retk = concat_kv_cache(past_key, cur_key, embed_dim, key, opt);
+    if (retk != 0)
+        return retk;
 
-    Mat value = cur_value;
-    if (past_seqlen > 0)
-    {
-        value.create(out_embed_dim, dst_seqlen, num_group, 4u, opt.blob_allocator);
-        if (value.empty())
-            return -100;
-
-        // concat
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
-        {
-            const Mat past_value_head = past_value.channel(q);
-            const Mat cur_value_head = cur_value.channel(q);
-            Mat value_head = value.channel(q);
-
-            memcpy(value_head.row(0), past_value_head, out_embed_dim * past_seqlen * sizeof(float));
-            memcpy(value_head.row(past_seqlen), cur_value_head, out_embed_dim * cur_seqlen * sizeof(float));
-        }
-    }
+    Mat value;
+    int retv = concat_kv_cache(past_value, cur_value, out_embed_dim, value, opt);
+    if (retv != 0)
+        return retv;
 
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < num_heads; q++)
@@ -327,45 +348,15 @@ int SDPA::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& t
     if (query_or_qk_cross_int8_scales.empty())
         return -100;
 
-    Mat key = cur_key;
-    if (past_seqlen > 0)
-    {
-        key.create(embed_dim, dst_seqlen, num_group, 4u, opt.blob_allocator);
-        if (key.empty())
-            return -100;
+    Mat key;
+    int retk = concat_kv_cache(past_key, cur_key, embed_dim, key, opt);
+    if (retk != 0)
+        return retk;
 
-        // concat
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
-        {
-            const Mat past_key_head = past_key.channel(q);
-            const Mat cur_key_head = cur_key.channel(q);
-            Mat key_head = key.channel(q);
-
-            memcpy(key_head.row(0), past_key_head, embed_dim * past_seqlen * sizeof(float));
-            memcpy(key_head.row(past_seqlen), cur_key_head, embed_dim * cur_seqlen * sizeof(float));
-        }
-    }
-
-    Mat value = cur_value;
-    if (past_seqlen > 0)
-    {
-        value.create(out_embed_dim, dst_seqlen, num_group, 4u, opt.blob_allocator);
-        if (value.empty())
-            return -100;
-
-        // concat
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
-        {
-            const Mat past_value_head = past_value.channel(q);
-            const Mat cur_value_head = cur_value.channel(q);
-            Mat value_head = value.channel(q);
-
-            memcpy(value_head.row(0), past_value_head, out_embed_dim * past_seqlen * sizeof(float));
-            memcpy(value_head.row(past_seqlen), cur_value_head, out_embed_dim * cur_seqlen * sizeof(float));
-        }
-    }
+    Mat value;
+    int retv = concat_kv_cache(past_value, cur_value, out_embed_dim, value, opt);
+    if (retv != 0)
+        return retv;
 
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < num_heads; q++)
@@ -18,6 +18,10 @@ public:
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
 protected:
+    // concat past and current key/value of w elements per row along seqlen
+    // rows are appended in place when past carries reserved capacity, see KVCache
+    int concat_kv_cache(const Mat& past, const Mat& cur, int w, Mat& out, const Option& opt) const;
+
 #if NCNN_INT8
     int forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 #endif
@@ -0,0 +1,584 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SPECTROGRAM_FFT_H
+#define LAYER_SPECTROGRAM_FFT_H
+
+// mixed radix fft shared by the Spectrogram and InverseSpectrogram backends
+//
+// the Stockham autosort formulation keeps the output in natural order without bit reversal,
+// the radices are 4, 2, 3, 5 with a generic odd prime radix for the rest
+//
+// a group of lanes frames is transformed together, lane l of every vector belongs to frame l,
+// so the butterflies are plain vector arithmetic for any fft size
+// complex element k of a group is stored as lanes real parts followed by lanes imaginary parts
+//
+// Op provides the vector type and arithmetic for its lane count
+//   enum { lanes = N };
+//   typedef ... vec;
+//   vec set1(float), load(const float*), add/sub/mul(vec, vec)
+//   void store(float*, vec)
+
+// factorize n into radices, 4 and 2 first, then odd primes
+static inline void fft_factorize(int n, std::vector<int>& radices)
+{
+    radices.clear();
+
+    while (n % 4 == 0)
+    {
+        radices.push_back(4);
+        n /= 4;
+    }
+    while (n % 2 == 0)
+    {
+        radices.push_back(2);
+        n /= 2;
+    }
+    for (int p = 3; p * p <= n; p += 2)
+    {
+        while (n % p == 0)
+        {
+            radices.push_back(p);
+            n /= p;
+        }
+    }
+    if (n > 1)
+        radices.push_back(n);
+}
+
+// twiddles of all stages as (cos, -sin) pairs
+// the stage with stride Ns and radix R holds exp(-2 pi i * r * j / (Ns * R)) for j in [0, Ns) and r in [1, R),
+// followed by the roots exp(-2 pi i * r / R) for r in [0, R) when R is a generic radix
+static inline int fft_create_twiddles(const std::vector<int>& radices, Mat& twiddles)
+{
+    int size = 0;
+    {
+        int Ns = 1;
+        for (size_t s = 0; s < radices.size(); s++)
+        {
+            const int R = radices[s];
+            size += Ns * (R - 1) * 2;
+            if (R > 5)
+                size += R * 2;
+            Ns *= R;
+        }
+    }
+
+    twiddles.create(std::max(size, 1));
+    if (twiddles.empty())
+        return -100;
+
+    float* ptr = twiddles;
+
+    int Ns = 1;
+    for (size_t s = 0; s < radices.size(); s++)
+    {
+        const int R = radices[s];
+
+        for (int j = 0; j < Ns; j++)
+        {
+            for (int r = 1; r < R; r++)
+            {
+                const double angle = 2 * 3.14159265358979323846 * r * j / (Ns * R);
+                ptr[0] = (float)cos(angle);
+                ptr[1] = (float)-sin(angle);
+                ptr += 2;
+            }
+        }
+
+        if (R > 5)
+        {
+            for (int r = 0; r < R; r++)
+            {
+                const double angle = 2 * 3.14159265358979323846 * r / R;
+                ptr[0] = (float)cos(angle);
+                ptr[1] = (float)-sin(angle);
+                ptr += 2;
+            }
+        }
+
+        Ns *= R;
+    }
+
+    return 0;
+}
+
+// exp(-2 pi i * k / n) for k in [0, n / 2] as (cos, -sin) pairs
+// for recovering the spectrum of n real values from the fft of n / 2 complex values
+static inline int fft_create_real_twiddles(int n, Mat& twiddles)
+{
+    twiddles.create((n / 2 + 1) * 2);
+    if (twiddles.empty())
+        return -100;
+
+    for (int k = 0; k <= n / 2; k++)
+    {
+        const double angle = 2 * 3.14159265358979323846 * k / n;
+        twiddles[k * 2] = (float)cos(angle);
+        twiddles[k * 2 + 1] = (float)-sin(angle);
+    }
+
+    return 0;
+}
+
+template<typename Op>
+static inline void fft_twiddle(typename Op::vec& re, typename Op::vec& im, const float* w)
+{
+    const typename Op::vec _wr = Op::set1(w[0]);
+    const typename Op::vec _wi = Op::set1(w[1]);
+    const typename Op::vec _re = Op::sub(Op::mul(re, _wr), Op::mul(im, _wi));
+    im = Op::add(Op::mul(re, _wi), Op::mul(im, _wr));
+    re = _re;
+}
+
+template<typename Op>
+static void fft_radix2(const float* src, float* dst, int m, int Ns, const float* tw)
+{
+    typedef typename Op::vec vec;
+    const int L = Op::lanes;
+
+    for (int j = 0; j < m; j++)
+    {
+        const int jj = j % Ns;
+        const float* w = tw + jj * 2;
+
+        const float* p0 = src + j * 2 * L;
+        const float* p1 = src + (j + m) * 2 * L;
+
+        vec _r0 = Op::load(p0);
+        vec _i0 = Op::load(p0 + L);
+        vec _r1 = Op::load(p1);
+        vec _i1 = Op::load(p1 + L);
+        fft_twiddle<Op>(_r1, _i1, w);
+
+        float* outptr = dst + ((j - jj) * 2 + jj) * 2 * L;
+        Op::store(outptr, Op::add(_r0, _r1));
+        Op::store(outptr + L, Op::add(_i0, _i1));
+        Op::store(outptr + Ns * 2 * L, Op::sub(_r0, _r1));
+        Op::store(outptr + Ns * 2 * L + L, Op::sub(_i0, _i1));
+    }
+}
+
+template<typename Op>
+static void fft_radix3(const float* src, float* dst, int m, int Ns, const float* tw)
+{
+    typedef typename Op::vec vec;
+    const int L = Op::lanes;
+
+    const vec _half = Op::set1(0.5f);
+    const vec _s = Op::set1(0.86602540378443864676f);
+
+    for (int j = 0; j < m; j++)
+    {
+        const int jj = j % Ns;
+        const float* w = tw + jj * 2 * 2;
+
+        const float* p0 = src + j * 2 * L;
+        const float* p1 = src + (j + m) * 2 * L;
+        const float* p2 = src + (j + m * 2) * 2 * L;
+
+        vec _r0 = Op::load(p0);
+        vec _i0 = Op::load(p0 + L);
+        vec _r1 = Op::load(p1);
+        vec _i1 = Op::load(p1 + L);
+        vec _r2 = Op::load(p2);
+        vec _i2 = Op::load(p2 + L);
+        fft_twiddle<Op>(_r1, _i1, w);
+        fft_twiddle<Op>(_r2, _i2, w + 2);
+
+        // y1 = t - i s d    y2 = t + i s d
+        vec _sr = Op::add(_r1, _r2);
+        vec _si = Op::add(_i1, _i2);
+        vec _tr = Op::sub(_r0, Op::mul(_sr, _half));
+        vec _ti = Op::sub(_i0, Op::mul(_si, _half));
+        vec _dr = Op::mul(Op::sub(_r1, _r2), _s);
+        vec _di = Op::mul(Op::sub(_i1, _i2), _s);
+
+        float* outptr = dst + ((j - jj) * 3 + jj) * 2 * L;
+        Op::store(outptr, Op::add(_r0, _sr));
+        Op::store(outptr + L, Op::add(_i0, _si));
+        Op::store(outptr + Ns * 2 * L, Op::add(_tr, _di));
+        Op::store(outptr + Ns * 2 * L + L, Op::sub(_ti, _dr));
+        Op::store(outptr + Ns * 4 * L, Op::sub(_tr, _di));
+        Op::store(outptr + Ns * 4 * L + L, Op::add(_ti, _dr));
+    }
+}
+
+template<typename Op>
+static void fft_radix4(const float* src, float* dst, int m, int Ns, const float* tw)
+{
+    typedef typename Op::vec vec;
+    const int L = Op::lanes;
+
+    for (int j = 0; j < m; j++)
+    {
+        const int jj = j % Ns;
+        const float* w = tw + jj * 3 * 2;
+
+        const float* p0 = src + j * 2 * L;
+        const float* p1 = src + (j + m) * 2 * L;
+        const float* p2 = src + (j + m * 2) * 2 * L;
+        const float* p3 = src + (j + m * 3) * 2 * L;
+
+        vec _r0 = Op::load(p0);
+        vec _i0 = Op::load(p0 + L);
+        vec _r1 = Op::load(p1);
+        vec _i1 = Op::load(p1 + L);
+        vec _r2 = Op::load(p2);
+        vec _i2 = Op::load(p2 + L);
+        vec _r3 = Op::load(p3);
+        vec _i3 = Op::load(p3 + L);
+        fft_twiddle<Op>(_r1, _i1, w);
+        fft_twiddle<Op>(_r2, _i2, w + 2);
+        fft_twiddle<Op>(_r3, _i3, w + 4);
+
+        vec _t0r = Op::add(_r0, _r2);
+        vec _t0i = Op::add(_i0, _i2);
+        vec _t1r = Op::sub(_r0, _r2);
+        vec _t1i = Op::sub(_i0, _i2);
+        vec _t2r = Op::add(_r1, _r3);
+        vec _t2i = Op::add(_i1, _i3);
+        vec _t3r = Op::sub(_r1, _r3);
+        vec _t3i = Op::sub(_i1, _i3);
+
+        // y1 = t1 - i t3    y3 = t1 + i t3
+        float* outptr = dst + ((j - jj) * 4 + jj) * 2 * L;
+        Op::store(outptr, Op::add(_t0r, _t2r));
+        Op::store(outptr + L, Op::add(_t0i, _t2i));
+        Op::store(outptr + Ns * 2 * L, Op::add(_t1r, _t3i));
+        Op::store(outptr + Ns * 2 * L + L, Op::sub(_t1i, _t3r));
+        Op::store(outptr + Ns * 4 * L, Op::sub(_t0r, _t2r));
+        Op::store(outptr + Ns * 4 * L + L, Op::sub(_t0i, _t2i));
+        Op::store(outptr + Ns * 6 * L, Op::sub(_t1r, _t3i));
+        Op::store(outptr + Ns * 6 * L + L, Op::add(_t1i, _t3r));
+    }
+}
+
+template<typename Op>
+static void fft_radix5(const float* src, float* dst, int m, int Ns, const float* tw)
+{
+    typedef typename Op::vec vec;
+    const int L = Op::lanes;
+
+    const vec _c1 = Op::set1(0.30901699437494742410f);  // cos(2pi/5)
+    const vec _c2 = Op::set1(-0.80901699437494742410f); // cos(4pi/5)
+    const vec _s1 = Op::set1(0.95105651629515357212f);  // sin(2pi/5)
+    const vec _s2 = Op::set1(0.58778525229247312917f);  // sin(4pi/5)
+
+    for (int j = 0; j < m; j++)
+    {
+        const int jj = j % Ns;
+        const float* w = tw + jj * 4 * 2;
+
+        vec _r[5];
+        vec _i[5];
+        for (int r = 0; r < 5; r++)
+        {
+            const float* p = src + (j + m * r) * 2 * L;
+            _r[r] = Op::load(p);
+            _i[r] = Op::load(p + L);
+            if (r > 0)
+                fft_twiddle<Op>(_r[r], _i[r], w + (r - 1) * 2);
+        }
+
+        vec _b1r = Op::add(_r[1], _r[4]);
+        vec _b1i = Op::add(_i[1], _i[4]);
+        vec _b2r = Op::add(_r[2], _r[3]);
+        vec _b2i = Op::add(_i[2], _i[3]);
+        vec _d1r = Op::sub(_r[1], _r[4]);
+        vec _d1i = Op::sub(_i[1], _i[4]);
+        vec _d2r = Op::sub(_r[2], _r[3]);
+        vec _d2i = Op::sub(_i[2], _i[3]);
+
+        vec _t1r = Op::add(_r[0], Op::add(Op::mul(_b1r, _c1), Op::mul(_b2r, _c2)));
+        vec _t1i = Op::add(_i[0], Op::add(Op::mul(_b1i, _c1), Op::mul(_b2i, _c2)));
+        vec _t2r = Op::add(_r[0], Op::add(Op::mul(_b1r, _c2), Op::mul(_b2r, _c1)));
+        vec _t2i = Op::add(_i[0], Op::add(Op::mul(_b1i, _c2), Op::mul(_b2i, _c1)));
+        vec _u1r = Op::add(Op::mul(_d1r, _s1), Op::mul(_d2r, _s2));
+        vec _u1i = Op::add(Op::mul(_d1i, _s1), Op::mul(_d2i, _s2));
+        vec _u2r = Op::sub(Op::mul(_d1r, _s2), Op::mul(_d2r, _s1));
+        vec _u2i = Op::sub(Op::mul(_d1i, _s2), Op::mul(_d2i, _s1));
+
+        // y1 = t1 - i u1    y4 = t1 + i u1    y2 = t2 - i u2    y3 = t2 + i u2
+        float* outptr = dst + ((j - jj) * 5 + jj) * 2 * L;
+        Op::store(outptr, Op::add(_r[0], Op::add(_b1r, _b2r)));
+        Op::store(outptr + L, Op::add(_i[0], Op::add(_b1i, _b2i)));
+        Op::store(outptr + Ns * 2 * L, Op::add(_t1r, _u1i));
+        Op::store(outptr + Ns * 2 * L + L, Op::sub(_t1i, _u1r));
+        Op::store(outptr + Ns * 4 * L, Op::add(_t2r, _u2i));
+        Op::store(outptr + Ns * 4 * L + L, Op::sub(_t2i, _u2r));
+        Op::store(outptr + Ns * 6 * L, Op::sub(_t2r, _u2i));
+        Op::store(outptr + Ns * 6 * L + L, Op::add(_t2i, _u2r));
+        Op::store(outptr + Ns * 8 * L, Op::sub(_t1r, _u1i));
+        Op::store(outptr + Ns * 8 * L + L, Op::add(_t1i, _u1r));
+    }
+}
+
+// direct dft of an odd prime radix
+template<typename Op>
+static void fft_radix_generic(const float* src, float* dst, int m, int Ns, int R, const float* tw, const float* roots)
+{
+    typedef typename Op::vec vec;
+    const int L = Op::lanes;
+
+    for (int j = 0; j < m; j++)
+    {
+        const int jj = j % Ns;
+        const float* w = tw + jj * (R - 1) * 2;
+
+        float* outptr = dst + ((j - jj) * R + jj) * 2 * L;
+
+        for (int q = 0; q < R; q++)
+        {
+            vec _sumr = Op::load(src + j * 2 * L);
+            vec _sumi = Op::load(src + j * 2 * L + L);
+
+            for (int r = 1; r < R; r++)
+            {
+                const float* p = src + (j + m * r) * 2 * L;
+                vec _re = Op::load(p);
+                vec _im = Op::load(p + L);
+                fft_twiddle<Op>(_re, _im, w + (r - 1) * 2);
+                fft_twiddle<Op>(_re, _im, roots + (q * r % R) * 2);
+                _sumr = Op::add(_sumr, _re);
+                _sumi = Op::add(_sumi, _im);
+            }
+
+            Op::store(outptr + q * Ns * 2 * L, _sumr);
+            Op::store(outptr + q * Ns * 2 * L + L, _sumi);
+        }
+    }
+}
+
+// forward complex fft of n elements, data and tmp hold n * 2 * lanes floats
+// return the buffer holding the result, either data or tmp
+template<typename Op>
+static float* fft_forward(float* data, float* tmp, int n, const std::vector<int>& radices, const Mat& twiddles)
+{
+    const float* tw = twiddles;
+
+    float* src = data;
+    float* dst = tmp;
+
+    int Ns = 1;
+    for (size_t s = 0; s < radices.size(); s++)
+    {
+        const int R = radices[s];
+        const int m = n / R;
+
+        if (R == 2)
+            fft_radix2<Op>(src, dst, m, Ns, tw);
+        else if (R == 3)
+            fft_radix3<Op>(src, dst, m, Ns, tw);
+        else if (R == 4)
+            fft_radix4<Op>(src, dst, m, Ns, tw);
+        else if (R == 5)
+            fft_radix5<Op>(src, dst, m, Ns, tw);
+        else
+            fft_radix_generic<Op>(src, dst, m, Ns, R, tw, tw + Ns * (R - 1) * 2);
+
+        tw += Ns * (R - 1) * 2;
+        if (R > 5)
+            tw += R * 2;
+
+        Ns *= R;
+
+        float* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    return src;
+}
+
+// the spectrum X[k] for k in [0, n / 2] of n real values from Z, the fft of z[k] = x[2k] + i x[2k+1]
+//   X[k] = (Z[k] + conj(Z[n/2-k])) / 2 - i / 2 * exp(-2 pi i k / n) * (Z[k] - conj(Z[n/2-k]))
+template<typename Op>
+static void fft_real_unpack(const float* Z, float* X, int n, const Mat& real_twiddles)
+{
+    typedef typename Op::vec vec;
+    const int L = Op::lanes;
+    const int half = n / 2;
+
+    const vec _half = Op::set1(0.5f);
+
+    for (int k = 0; k <= half; k++)
+    {
+        const float* p0 = Z + (k % half) * 2 * L;
+        const float* p1 = Z + ((half - k) % half) * 2 * L;
+
+        vec _zr = Op::load(p0);
+        vec _zi = Op::load(p0 + L);
+        vec _cr = Op::load(p1);
+        vec _ci = Op::load(p1 + L);
+
+        // E = (Z[k] + conj(Z[n/2-k])) / 2    O = -i / 2 * (Z[k] - conj(Z[n/2-k]))
+        vec _er = Op::mul(Op::add(_zr, _cr), _half);
+        vec _ei = Op::mul(Op::sub(_zi, _ci), _half);
+        vec _or = Op::mul(Op::add(_zi, _ci), _half);
+        vec _oi = Op::mul(Op::sub(_cr, _zr), _half);
+        fft_twiddle<Op>(_or, _oi, (const float*)real_twiddles + k * 2);
+
+        Op::store(X + k * 2 * L, Op::add(_er, _or));
+        Op::store(X + k * 2 * L + L, Op::add(_ei, _oi));
+    }
+}
+
+// windowed frames [j, j + lanes) of the bordered signal to the onesided spectrum in top_blob
+// the even n_fft takes the fft of n_fft / 2 complex values, the odd one of n_fft complex values
+// workspace holds n_fft * 4 * lanes floats
+template<typename Op>
+static void spectrogram_fft(const Mat& bottom_blob_bordered, Mat& top_blob, int j, int n_fft, int hoplen, int power, float norm, const float* window, const std::vector<int>& radices, const Mat& twiddles, const Mat& real_twiddles, float* workspace)
+{
+    const int L = Op::lanes;
+    const int fft_size = n_fft % 2 == 0 ? n_fft / 2 : n_fft;
+    const int freqs_onesided = n_fft / 2 + 1;
+
+    float* data = workspace;
+    float* tmp = workspace + fft_size * 2 * L;
+
+    for (int l = 0; l < L; l++)
+    {
+        const float* ptr = (const float*)bottom_blob_bordered + (j + l) * hoplen;
+
+        if (n_fft % 2 == 0)
+        {
+            for (int k = 0; k < fft_size; k++)
+            {
+                data[k * 2 * L + l] = ptr[k * 2] * window[k * 2];
+                data[k * 2 * L + L + l] = ptr[k * 2 + 1] * window[k * 2 + 1];
+            }
+        }
+        else
+        {
+            for (int k = 0; k < fft_size; k++)
+            {
+                data[k * 2 * L + l] = ptr[k] * window[k];
+                data[k * 2 * L + L + l] = 0.f;
+            }
+        }
+    }
+
+    const float* spectrum = fft_forward<Op>(data, tmp, fft_size, radices, twiddles);
+
+    if (n_fft % 2 == 0)
+    {
+        // the free buffer of the two
+        float* outptr = spectrum == data ? tmp : data;
+        fft_real_unpack<Op>(spectrum, outptr, n_fft, real_twiddles);
+        spectrum = outptr;
+    }
+
+    for (int i = 0; i < freqs_onesided; i++)
+    {
+        const float* ptr = spectrum + i * 2 * L;
+
+        for (int l = 0; l < L; l++)
+        {
+            const float re = ptr[l] * norm;
+            const float im = ptr[L + l] * norm;
+
+            if (power == 0)
+            {
+                // complex as real
+                float* outptr = top_blob.channel(i);
+                outptr[(j + l) * 2] = re;
+                outptr[(j + l) * 2 + 1] = im;
+            }
+            if (power == 1)
+            {
+                // magnitude
+                top_blob.row(i)[j + l] = sqrtf(re * re + im * im);
+            }
+            if (power == 2)
+            {
+                top_blob.row(i)[j + l] = re * re + im * im;
+            }
+        }
+    }
+}
+
+// inverse fft of frames [j, j + lanes) of the spectrum, windowed to rows of frames_blob as complex pairs
+// ifft(x) = conj(fft(conj(x))) / n_fft
+// workspace holds n_fft * 4 * lanes floats
+template<typename Op>
+static void inverse_spectrogram_fft(const Mat& bottom_blob, Mat& frames_blob, int j, int n_fft, int onesided, float norm, const float* window, const std::vector<int>& radices, const Mat& twiddles, float* workspace)
+{
+    const int L = Op::lanes;
+
+    float* data = workspace;
+    float* tmp = workspace + n_fft * 2 * L;
+
+    for (int l = 0; l < L; l++)
+    {
+        for (int k = 0; k < n_fft; k++)
+        {
+            // collect complex
+            float re;
+            float im;
+            if (onesided == 1 && k >= n_fft / 2 + 1)
+            {
+                const float* ptr = bottom_blob.channel(n_fft - k).row(j + l);
+                re = ptr[0];
+                im = -ptr[1];
+            }
+            else
+            {
+                const float* ptr = bottom_blob.channel(k).row(j + l);
+                re = ptr[0];
+                im = ptr[1];
+            }
+
+            data[k * 2 * L + l] = re * norm;
+            data[k * 2 * L + L + l] = -im * norm;
+        }
+    }
+
+    const float* result = fft_forward<Op>(data, tmp, n_fft, radices, twiddles);
+
+    for (int l = 0; l < L; l++)
+    {
+        float* outptr = frames_blob.row(j + l);
+
+        for (int i = 0; i < n_fft; i++)
+        {
+            const float scale = window[i] / n_fft;
+            outptr[i * 2] = result[i * 2 * L + l] * scale;
+            outptr[i * 2 + 1] = -result[i * 2 * L + L + l] * scale;
+        }
+    }
+}
+
+// all whole groups of lanes frames from frame j, return the first frame left
+template<typename Op>
+static int spectrogram_fft_frames(const Mat& bottom_blob_bordered, Mat& top_blob, int j, int frames, int n_fft, int hoplen, int power, float norm, const float* window, const std::vector<int>& radices, const Mat& twiddles, const Mat& real_twiddles, Mat& workspace, const Option& opt)
+{
+    const int L = Op::lanes;
+    const int nn_frames = (frames - j) / L;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ii = 0; ii < nn_frames; ii++)
+    {
+        spectrogram_fft<Op>(bottom_blob_bordered, top_blob, j + ii * L, n_fft, hoplen, power, norm, window, radices, twiddles, real_twiddles, workspace.row(get_omp_thread_num()));
+    }
+
+    return j + nn_frames * L;
+}
+
+// all whole groups of lanes frames from frame j, return the first frame left
+template<typename Op>
+static int inverse_spectrogram_fft_frames(const Mat& bottom_blob, Mat& frames_blob, int j, int frames, int n_fft, int onesided, float norm, const float* window, const std::vector<int>& radices, const Mat& twiddles, Mat& workspace, const Option& opt)
+{
+    const int L = Op::lanes;
+    const int nn_frames = (frames - j) / L;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ii = 0; ii < nn_frames; ii++)
+    {
+        inverse_spectrogram_fft<Op>(bottom_blob, frames_blob, j + ii * L, n_fft, onesided, norm, window, radices, twiddles, workspace.row(get_omp_thread_num()));
+    }
+
+    return j + nn_frames * L;
+}
+
+#endif // LAYER_SPECTROGRAM_FFT_H
@@ -25,7 +25,7 @@ int SPP::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 
     // 1 + 4 + 16 + 64 + ... + (2*pyramid_height)^2
     int pyramid_num_bins = ((1 << (pyramid_height * 2)) - 1) / 3;
-    top_blob.create(pyramid_num_bins, 1, 2, elemsize, opt.blob_allocator);
+    top_blob.create(pyramid_num_bins * bottom_blob.c, elemsize, opt.blob_allocator);
     if (top_blob.empty())
         return -100;
 
@@ -20,13 +20,12 @@ int Tile::load_param(const ParamDict& pd)
     return 0;
 }
 
-int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+void Tile::resolve_repeats(int dims, int& repeat_w, int& repeat_h, int& repeat_d, int& repeat_c) const
 {
-    int dims = bottom_blob.dims;
-    int repeat_w = 1;
-    int repeat_h = 1;
-    int repeat_d = 1;
-    int repeat_c = 1;
+    repeat_w = 1;
+    repeat_h = 1;
+    repeat_d = 1;
+    repeat_c = 1;
 
     const int repeats_num = repeats.w;
 
@@ -92,6 +91,18 @@ int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
             repeat_w = repeats_ptr[3];
         }
     }
+}
+
+int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int dims = bottom_blob.dims;
+    int repeat_w;
+    int repeat_h;
+    int repeat_d;
+    int repeat_c;
+    resolve_repeats(dims, repeat_w, repeat_h, repeat_d, repeat_c);
+
+    const int repeats_num = repeats.w;
 
     int w = bottom_blob.w;
     int h = bottom_blob.h;
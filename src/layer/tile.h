@@ -17,6 +17,9 @@ public:
 
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
+protected:
+    void resolve_repeats(int dims, int& repeat_w, int& repeat_h, int& repeat_d, int& repeat_c) const;
+
 public:
     int axis;
     int tiles;
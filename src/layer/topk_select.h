@@ -0,0 +1,200 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef TOPK_SELECT_H
+#define TOPK_SELECT_H
+
+#include "mat.h"
+
+#include <algorithm>
+#include <vector>
+
+// order by value then by index, both descending
+// this is std::greater on (value, index) pairs, so ties resolve the same way as a partial_sort over such pairs
+static NCNN_FORCEINLINE bool topk_greater(float va, int ia, float vb, int ib)
+{
+    return va > vb || (va == vb && ia > ib);
+}
+
+// restore the min-heap property below slot i, the heap root is the smallest kept candidate
+static void topk_sift_down(const float* values, int* heap, int size, int i)
+{
+    const int index = heap[i];
+    const float value = values[index];
+
+    for (;;)
+    {
+        int child = i * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && topk_greater(values[heap[child]], heap[child], values[heap[child + 1]], heap[child + 1]))
+            child++;
+
+        if (!topk_greater(value, index, values[heap[child]], heap[child]))
+            break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = index;
+}
+
+// fill heap with the first k candidates and heapify, the root is the smallest kept candidate
+static void topk_select_init(const float* values, const int* candidates, int k, int* heap)
+{
+    for (int i = 0; i < k; i++)
+    {
+        heap[i] = candidates ? candidates[i] : i;
+    }
+
+    for (int i = k / 2 - 1; i >= 0; i--)
+    {
+        topk_sift_down(values, heap, k, i);
+    }
+}
+
+// offer values[begin, end) to a full k-sized heap
+static void topk_select_push(const float* values, int begin, int end, int k, int* heap)
+{
+    for (int i = begin; i < end; i++)
+    {
+        if (topk_greater(values[i], i, values[heap[0]], heap[0]))
+        {
+            heap[0] = i;
+            topk_sift_down(values, heap, k, 0);
+        }
+    }
+}
+
+// heap sort, the smallest goes to the back and heap ends up in descending order
+static void topk_select_sort(const float* values, int k, int* heap)
+{
+    for (int i = k - 1; i > 0; i--)
+    {
+        std::swap(heap[0], heap[i]);
+        topk_sift_down(values, heap, i, 0);
+    }
+}
+
+// map float to an unsigned key with the same ordering
+static NCNN_FORCEINLINE unsigned int topk_radix_key(float v)
+{
+    union
+    {
+        float f;
+        unsigned int u;
+    } tmp;
+    tmp.f = v == 0.f ? 0.f : v; // -0 and +0 compare equal
+    return (tmp.u & 0x80000000) ? ~tmp.u : (tmp.u | 0x80000000);
+}
+
+// radix select the k-th largest key of values[0, size) with 11-11-10 bit histogram passes
+// then gather the k winners into indices without copying values, ties on the threshold keep the largest indices
+static void topk_select_radix(const float* values, int size, int k, int* indices)
+{
+    const int shifts[3] = {21, 10, 0};
+    const unsigned int bins[3] = {2048, 2048, 1024};
+
+    unsigned int prefix = 0;
+    unsigned int prefix_mask = 0;
+    int remain = k;
+
+    std::vector<int> histogram(2048);
+    for (int pass = 0; pass < 3; pass++)
+    {
+        const int shift = shifts[pass];
+        const unsigned int nbins = bins[pass];
+
+        std::fill(histogram.begin(), histogram.end(), 0);
+        for (int i = 0; i < size; i++)
+        {
+            const unsigned int key = topk_radix_key(values[i]);
+            if ((key & prefix_mask) == prefix)
+                histogram[(key >> shift) & (nbins - 1)]++;
+        }
+
+        // walk from the largest bin until the k-th key is covered
+        int b = nbins - 1;
+        for (; b > 0; b--)
+        {
+            if (histogram[b] >= remain)
+                break;
+
+            remain -= histogram[b];
+        }
+
+        prefix |= (unsigned int)b << shift;
+        prefix_mask |= (nbins - 1) << shift;
+    }
+
+    // prefix is now the threshold key, remain counts how many ties are kept
+    int n = 0;
+    for (int i = 0; i < size; i++)
+    {
+        if (topk_radix_key(values[i]) > prefix)
+            indices[n++] = i;
+    }
+    for (int i = size - 1; i >= 0 && remain > 0; i--)
+    {
+        if (topk_radix_key(values[i]) == prefix)
+        {
+            indices[n++] = i;
+            remain--;
+        }
+    }
+
+    topk_select_init(values, indices, k, indices);
+    topk_select_sort(values, k, indices);
+}
+
+// radix select wins once k is large, while the heap is cheapest when few values ever enter it
+static NCNN_FORCEINLINE bool topk_select_prefer_radix(int size, int k)
+{
+    return k >= 128 && k <= size / 4;
+}
+
+// write the indices of the k largest candidates to indices in descending order and return how many were written
+// candidates lists the indices into values to consider, pass null to consider all of values[0, size)
+// a k-sized min-heap is kept so that neither values nor candidates are copied or reordered
+// a large k over plain values switches to radix select, whose cost does not grow with k
+static int topk_select(const float* values, const int* candidates, int size, int k, int* indices)
+{
+    if (k > size)
+        k = size;
+
+    if (k <= 0)
+        return 0;
+
+    if (!candidates && topk_select_prefer_radix(size, k))
+    {
+        topk_select_radix(values, size, k, indices);
+        return k;
+    }
+
+    topk_select_init(values, candidates, k, indices);
+
+    if (candidates)
+    {
+        for (int i = k; i < size; i++)
+        {
+            const int index = candidates[i];
+            if (topk_greater(values[index], index, values[indices[0]], indices[0]))
+            {
+                indices[0] = index;
+                topk_sift_down(values, indices, k, 0);
+            }
+        }
+    }
+    else
+    {
+        topk_select_push(values, k, size, k, indices);
+    }
+
+    topk_select_sort(values, k, indices);
+
+    return k;
+}
+
+#endif // TOPK_SELECT_H
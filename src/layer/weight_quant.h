@@ -0,0 +1,206 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_WEIGHT_QUANT_H
+#define LAYER_WEIGHT_QUANT_H
+
+#include "mat.h"
+#include "modelbin.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace ncnn {
+
+// weight-only quantization shared by InnerProduct and Gemm
+// the activations stay in fp32, the weight is dequantized on the fly
+//
+// the weight is num_output rows of num_input, every row starts on a byte boundary
+//   8 bit  w = q * scale           symmetric int8, one scale per row
+//   4 bit  w = (q - zero) * scale  asymmetric uint4, one scale and zero per group_size inputs,
+//                                  two inputs per byte, the even input in the low nibble
+//
+// the model stores either the fp32 weight, quantized at load time,
+// or the int8 quantized weight followed by the scales and for 4 bit the zeros
+// a 4 bit weight is stored unpacked, one uint4 value per int8
+
+static inline int weight_quant_group_count(int num_input, int weight_quant_bits, int group_size)
+{
+    return weight_quant_bits == 4 ? (num_input + group_size - 1) / group_size : 1;
+}
+
+static inline int weight_quant_row_bytes(int num_input, int weight_quant_bits)
+{
+    return weight_quant_bits == 4 ? (num_input + 1) / 2 : num_input;
+}
+
+static inline int weight_quant_round(float v)
+{
+    return (int)(v >= 0.f ? v + 0.5f : v - 0.5f);
+}
+
+static inline int quantize_weight(const Mat& weight, int num_input, int num_output, int weight_quant_bits, int group_size, Mat& weight_quant, Mat& scales, Mat& zeros)
+{
+    const int num_groups = weight_quant_group_count(num_input, weight_quant_bits, group_size);
+
+    weight_quant.create(weight_quant_row_bytes(num_input, weight_quant_bits), num_output, (size_t)1u);
+    scales.create(num_groups * num_output);
+    if (weight_quant.empty() || scales.empty())
+        return -100;
+
+    if (weight_quant_bits == 4)
+    {
+        zeros.create(num_groups * num_output);
+        if (zeros.empty())
+            return -100;
+    }
+
+    for (int p = 0; p < num_output; p++)
+    {
+        const float* ptr = (const float*)weight + (size_t)num_input * p;
+
+        if (weight_quant_bits == 8)
+        {
+            signed char* outptr = weight_quant.row<signed char>(p);
+
+            float absmax = 0.f;
+            for (int k = 0; k < num_input; k++)
+            {
+                absmax = std::max(absmax, (float)fabs(ptr[k]));
+            }
+
+            const float scale = absmax / 127.f;
+            const float scale_inv = absmax == 0.f ? 0.f : 127.f / absmax;
+
+            for (int k = 0; k < num_input; k++)
+            {
+                int q = weight_quant_round(ptr[k] * scale_inv);
+                outptr[k] = (signed char)std::min(std::max(q, -127), 127);
+            }
+
+            scales[p] = scale;
+        }
+
+        if (weight_quant_bits == 4)
+        {
+            unsigned char* outptr = weight_quant.row<unsigned char>(p);
+            memset(outptr, 0, weight_quant.w);
+
+            for (int g = 0; g < num_groups; g++)
+            {
+                const int k0 = g * group_size;
+                const int k1 = std::min(k0 + group_size, num_input);
+
+                // keep zero exactly representable
+                float vmin = 0.f;
+                float vmax = 0.f;
+                for (int k = k0; k < k1; k++)
+                {
+                    vmin = std::min(vmin, ptr[k]);
+                    vmax = std::max(vmax, ptr[k]);
+                }
+
+                const float scale = (vmax - vmin) / 15.f;
+                const float scale_inv = scale == 0.f ? 0.f : 1.f / scale;
+                const int zero = std::min(std::max(weight_quant_round(-vmin * scale_inv), 0), 15);
+
+                for (int k = k0; k < k1; k++)
+                {
+                    int q = std::min(std::max(weight_quant_round(ptr[k] * scale_inv) + zero, 0), 15);
+                    outptr[k / 2] |= (unsigned char)(q << ((k % 2) * 4));
+                }
+
+                scales[num_groups * p + g] = scale;
+                zeros[num_groups * p + g] = (float)zero;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// turn the loaded weight into the quantized layout
+// the fp32 weight is quantized, the int8 weight takes its scales and zeros from the model
+static inline int load_weight_quant(const Mat& weight, const ModelBin& mb, int num_input, int num_output, int weight_quant_bits, int group_size, Mat& weight_quant, Mat& scales, Mat& zeros)
+{
+    if (weight.elemsize == (size_t)4u)
+        return quantize_weight(weight, num_input, num_output, weight_quant_bits, group_size, weight_quant, scales, zeros);
+
+    if (weight.elemsize != (size_t)1u)
+    {
+        NCNN_LOGE("weight quantization expects fp32 or int8 weight data");
+        return -1;
+    }
+
+    const int num_groups = weight_quant_group_count(num_input, weight_quant_bits, group_size);
+
+    scales = mb.load(num_groups * num_output, 1);
+    if (scales.empty())
+        return -100;
+
+    if (weight_quant_bits == 8)
+    {
+        weight_quant = weight.reshape(num_input, num_output);
+        if (weight_quant.empty())
+            return -100;
+
+        return 0;
+    }
+
+    zeros = mb.load(num_groups * num_output, 1);
+    if (zeros.empty())
+        return -100;
+
+    weight_quant.create(weight_quant_row_bytes(num_input, weight_quant_bits), num_output, (size_t)1u);
+    if (weight_quant.empty())
+        return -100;
+
+    for (int p = 0; p < num_output; p++)
+    {
+        const unsigned char* ptr = (const unsigned char*)weight + (size_t)num_input * p;
+        unsigned char* outptr = weight_quant.row<unsigned char>(p);
+        memset(outptr, 0, weight_quant.w);
+
+        for (int k = 0; k < num_input; k++)
+        {
+            outptr[k / 2] |= (unsigned char)((ptr[k] & 15) << ((k % 2) * 4));
+        }
+    }
+
+    return 0;
+}
+
+// the reference path, expand the whole weight to fp32 num_output rows of num_input
+static inline int dequantize_weight(const Mat& weight_quant, const Mat& scales, const Mat& zeros, int num_input, int num_output, int weight_quant_bits, int group_size, Mat& weight, Allocator* allocator)
+{
+    const int num_groups = weight_quant_group_count(num_input, weight_quant_bits, group_size);
+
+    weight.create(num_input, num_output, (size_t)4u, allocator);
+    if (weight.empty())
+        return -100;
+
+    for (int p = 0; p < num_output; p++)
+    {
+        float* outptr = weight.row(p);
+
+        for (int k = 0; k < num_input; k++)
+        {
+            if (weight_quant_bits == 8)
+            {
+                outptr[k] = weight_quant.row<const signed char>(p)[k] * scales[p];
+            }
+            else
+            {
+                const int g = num_groups * p + k / group_size;
+                const int q = (weight_quant.row<const unsigned char>(p)[k / 2] >> ((k % 2) * 4)) & 15;
+                outptr[k] = (q - zeros[g]) * scales[g];
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
+
+#endif // LAYER_WEIGHT_QUANT_H
@@ -0,0 +1,214 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "argmax_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "cpu.h"
+#include "topk_select.h"
+
+namespace ncnn {
+
+ArgMax_x86::ArgMax_x86()
+{
+}
+
+// top k of ptr[0, size) with k <= size, indices are relative to ptr
+// blocks of 16 values that are all below the current heap root never touch the heap
+static void argmax_topk(const float* ptr, int size, int k, int* indices)
+{
+    if (topk_select_prefer_radix(size, k))
+    {
+        topk_select(ptr, 0, size, k, indices);
+        return;
+    }
+
+    topk_select_init(ptr, 0, k, indices);
+
+    int i = k;
+    for (; i + 15 < size; i += 16)
+    {
+        const float threshold = ptr[indices[0]];
+
+#if __AVX512F__
+        const bool may_enter = _mm512_cmp_ps_mask(_mm512_loadu_ps(ptr + i), _mm512_set1_ps(threshold), _CMP_GE_OQ) != 0;
+#elif __AVX__
+        __m256 _threshold = _mm256_set1_ps(threshold);
+        __m256 _ge0 = _mm256_cmp_ps(_mm256_loadu_ps(ptr + i), _threshold, _CMP_GE_OQ);
+        __m256 _ge1 = _mm256_cmp_ps(_mm256_loadu_ps(ptr + i + 8), _threshold, _CMP_GE_OQ);
+        const bool may_enter = _mm256_movemask_ps(_mm256_or_ps(_ge0, _ge1)) != 0;
+#elif __SSE2__
+        __m128 _threshold = _mm_set1_ps(threshold);
+        __m128 _ge0 = _mm_cmpge_ps(_mm_loadu_ps(ptr + i), _threshold);
+        __m128 _ge1 = _mm_cmpge_ps(_mm_loadu_ps(ptr + i + 4), _threshold);
+        __m128 _ge2 = _mm_cmpge_ps(_mm_loadu_ps(ptr + i + 8), _threshold);
+        __m128 _ge3 = _mm_cmpge_ps(_mm_loadu_ps(ptr + i + 12), _threshold);
+        const bool may_enter = _mm_movemask_ps(_mm_or_ps(_mm_or_ps(_ge0, _ge1), _mm_or_ps(_ge2, _ge3))) != 0;
+#else
+        bool may_enter = false;
+        for (int j = 0; j < 16; j++)
+        {
+            may_enter = may_enter || ptr[i + j] >= threshold;
+        }
+#endif
+
+        if (may_enter)
+            topk_select_push(ptr, i, i + 16, k, indices);
+    }
+
+    topk_select_push(ptr, i, size, k, indices);
+
+    topk_select_sort(ptr, k, indices);
+}
+
+int ArgMax_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+    const int channels = bottom_blob.c;
+
+    if (axis == -233)
+    {
+        // the whole blob as one row, channel gaps are left to the reference
+        if (dims >= 3 && bottom_blob.cstep != (size_t)w * h * d)
+            return ArgMax::forward(bottom_blob, top_blob, opt);
+
+        const int size = w * h * d * channels;
+        const int k = std::min(topk, size);
+
+        if (out_max_val)
+            top_blob.create(topk, 2, 4u, opt.blob_allocator);
+        else
+            top_blob.create(topk, 1, 4u, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const float* ptr = bottom_blob;
+
+        std::vector<int> indices(k);
+
+        // long rows like vocabulary logits are split across threads
+        // each part keeps its own top k and the survivors are merged
+        int nn_part = std::min(opt.num_threads, size / 65536);
+        if (nn_part < 2 || k * 8 > size / nn_part)
+            nn_part = 1;
+
+        if (nn_part == 1)
+        {
+            argmax_topk(ptr, size, k, indices.data());
+        }
+        else
+        {
+            const int part_size = (size + nn_part - 1) / nn_part;
+
+            std::vector<int> candidates(nn_part * k);
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int pi = 0; pi < nn_part; pi++)
+            {
+                const int begin = pi * part_size;
+                const int end = std::min(begin + part_size, size);
+
+                int* cptr = candidates.data() + pi * k;
+
+                argmax_topk(ptr + begin, end - begin, k, cptr);
+
+                for (int j = 0; j < k; j++)
+                {
+                    cptr[j] += begin;
+                }
+            }
+
+            topk_select(ptr, candidates.data(), nn_part * k, k, indices.data());
+        }
+
+        float* outptr = top_blob;
+
+        if (out_max_val)
+        {
+            float* valptr = outptr + topk;
+            for (int i = 0; i < k; i++)
+            {
+                outptr[i] = ptr[indices[i]];
+                valptr[i] = indices[i];
+            }
+        }
+        else
+        {
+            for (int i = 0; i < k; i++)
+            {
+                outptr[i] = indices[i];
+            }
+        }
+
+        return 0;
+    }
+
+    const int positive_axis = axis < 0 ? dims + axis : axis;
+    if (positive_axis != dims - 1)
+        return ArgMax::forward(bottom_blob, top_blob, opt);
+
+    // select along w, every row is independent
+    const int k = std::min(topk, w);
+    const int outw = out_max_val ? k * 2 : k;
+
+    if (dims == 1)
+        top_blob.create(outw, 4u, opt.blob_allocator);
+    if (dims == 2)
+        top_blob.create(outw, h, 4u, opt.blob_allocator);
+    if (dims == 3)
+        top_blob.create(outw, h, channels, 4u, opt.blob_allocator);
+    if (dims == 4)
+        top_blob.create(outw, h, d, channels, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int rows_per_channel = dims >= 3 ? h * d : 1;
+    const int rows = dims == 2 ? h : rows_per_channel * channels;
+
+    Mat indices_buffer(k, 1, opt.num_threads, 4u, opt.workspace_allocator);
+    if (indices_buffer.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int r = 0; r < rows; r++)
+    {
+        const int q = r / rows_per_channel;
+        const int y = r % rows_per_channel;
+
+        const float* ptr = dims == 2 ? bottom_blob.row(r) : (const float*)bottom_blob.channel(q) + y * w;
+        float* outptr = dims == 2 ? top_blob.row(r) : (float*)top_blob.channel(q) + y * outw;
+
+        int* indices = indices_buffer.channel(get_omp_thread_num());
+
+        argmax_topk(ptr, w, k, indices);
+
+        if (out_max_val)
+        {
+            for (int j = 0; j < k; j++)
+            {
+                outptr[j] = ptr[indices[j]];
+                outptr[k + j] = indices[j];
+            }
+        }
+        else
+        {
+            for (int j = 0; j < k; j++)
+            {
+                outptr[j] = indices[j];
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_ARGMAX_X86_H
+#define LAYER_ARGMAX_X86_H
+
+#include "argmax.h"
+
+namespace ncnn {
+
+class ArgMax_x86 : public ArgMax
+{
+public:
+    ArgMax_x86();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_ARGMAX_X86_H
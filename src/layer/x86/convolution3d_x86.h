@@ -0,0 +1,28 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_CONVOLUTION3D_X86_H
+#define LAYER_CONVOLUTION3D_X86_H
+
+#include "convolution3d.h"
+
+namespace ncnn {
+
+class Convolution3D_x86 : public Convolution3D
+{
+public:
+    Convolution3D_x86();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    // 2d convolution over the kernel_d input depth slices stacked along channels
+    Layer* convolution;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_CONVOLUTION3D_X86_H
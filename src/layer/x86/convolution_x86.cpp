@@ -71,6 +71,8 @@ Convolution_x86::Convolution_x86()
     support_bf16_storage = true;
 #endif // NCNN_BF16
 
+    support_batch = true;
+
     activation = 0;
     nT = 0;
     convolution_dilation1 = 0;
@@ -279,7 +281,10 @@ static bool test_prefer_winograd23(int num_input, int num_output, int w, int h)
 int Convolution_x86::create_pipeline(const Option& opt)
 {
     if (dynamic_weight)
+    {
+        support_batch = false;
         return 0;
+    }
 
     activation = create_activation_layer(activation_type, activation_params, opt);
     nT = opt.num_threads;
@@ -520,6 +525,9 @@ int Convolution_x86::destroy_pipeline(const Option& opt)
 
 int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (bottom_blob.n > 1)
+        return forward_batch(bottom_blob, top_blob, opt);
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
@@ -40,13 +40,19 @@ ConvolutionDepthWise_x86::ConvolutionDepthWise_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+    support_batch = true;
+
     activation = 0;
 }
 
 int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
 {
     if (dynamic_weight)
+    {
+        support_batch = false;
         return 0;
+    }
 
     activation = create_activation_layer(activation_type, activation_params, opt);
 
@@ -254,6 +260,9 @@ int ConvolutionDepthWise_x86::destroy_pipeline(const Option& opt)
 
 int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (bottom_blob.n > 1)
+        return forward_batch(bottom_blob, top_blob, opt);
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
@@ -0,0 +1,229 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "cumulativesum_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "cpu.h"
+
+namespace ncnn {
+
+CumulativeSum_x86::CumulativeSum_x86()
+{
+}
+
+// inclusive scan of ptr[0, size) starting from carry, returns the last sum
+static float cumulativesum_scan(float* ptr, int size, float carry)
+{
+    int i = 0;
+#if __SSE2__
+    // log-step prefix sum inside the register, then add the running carry
+    __m128 _carry = _mm_set1_ps(carry);
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        _p = _mm_add_ps(_p, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(_p), 4)));
+        _p = _mm_add_ps(_p, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(_p), 8)));
+        _p = _mm_add_ps(_p, _carry);
+        _mm_storeu_ps(ptr, _p);
+        _carry = _mm_shuffle_ps(_p, _p, _MM_SHUFFLE(3, 3, 3, 3));
+        ptr += 4;
+    }
+    carry = _mm_cvtss_f32(_carry);
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        carry += *ptr;
+        *ptr++ = carry;
+    }
+
+    return carry;
+}
+
+// ptr[0, size) += value
+static void cumulativesum_add_scalar(float* ptr, int size, float value)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+    __m256 _value_avx = _mm256_set1_ps(value);
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(ptr, _mm256_add_ps(_mm256_loadu_ps(ptr), _value_avx));
+        ptr += 8;
+    }
+#endif // __AVX__
+    __m128 _value = _mm_set1_ps(value);
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(ptr, _mm_add_ps(_mm_loadu_ps(ptr), _value));
+        ptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *ptr++ += value;
+    }
+}
+
+// slice j += slice j - 1 for count slices of size elements, stride apart
+static void cumulativesum_accumulate(float* ptr, int count, int size, size_t stride)
+{
+    for (int j = 1; j < count; j++)
+    {
+        const float* prev = ptr + (j - 1) * stride;
+        float* cur = ptr + j * stride;
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        for (; i + 15 < size; i += 16)
+        {
+            _mm512_storeu_ps(cur + i, _mm512_add_ps(_mm512_loadu_ps(cur + i), _mm512_loadu_ps(prev + i)));
+        }
+#endif // __AVX512F__
+        for (; i + 7 < size; i += 8)
+        {
+            _mm256_storeu_ps(cur + i, _mm256_add_ps(_mm256_loadu_ps(cur + i), _mm256_loadu_ps(prev + i)));
+        }
+#endif // __AVX__
+        for (; i + 3 < size; i += 4)
+        {
+            _mm_storeu_ps(cur + i, _mm_add_ps(_mm_loadu_ps(cur + i), _mm_loadu_ps(prev + i)));
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            cur[i] += prev[i];
+        }
+    }
+}
+
+// parallel prefix over one long row
+// every part is scanned on its own, then the part totals are carried forward
+static void cumulativesum_scan_parallel(float* ptr, int size, const Option& opt)
+{
+    int nn_part = std::min(opt.num_threads, size / 16384);
+    if (nn_part < 2)
+    {
+        cumulativesum_scan(ptr, size, 0.f);
+        return;
+    }
+
+    const int part_size = (size + nn_part - 1) / nn_part;
+
+    std::vector<float> part_sums(nn_part);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pi = 0; pi < nn_part; pi++)
+    {
+        const int begin = pi * part_size;
+        const int end = std::min(begin + part_size, size);
+
+        part_sums[pi] = cumulativesum_scan(ptr + begin, end - begin, 0.f);
+    }
+
+    for (int pi = 1; pi < nn_part; pi++)
+    {
+        part_sums[pi] += part_sums[pi - 1];
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pi = 1; pi < nn_part; pi++)
+    {
+        const int begin = pi * part_size;
+        const int end = std::min(begin + part_size, size);
+
+        cumulativesum_add_scalar(ptr + begin, end - begin, part_sums[pi - 1]);
+    }
+}
+
+int CumulativeSum_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    const int dims = bottom_top_blob.dims;
+    const int positive_axis = axis < 0 ? dims + axis : axis;
+    if (dims > 1 && (positive_axis < 0 || positive_axis >= dims))
+        return -100;
+
+    const int w = bottom_top_blob.w;
+    const int h = bottom_top_blob.h;
+    const int d = bottom_top_blob.d;
+    const int channels = bottom_top_blob.c;
+
+    if (dims == 1 || (dims == 2 && h == 1 && positive_axis == 1))
+    {
+        cumulativesum_scan_parallel(bottom_top_blob, w, opt);
+
+        return 0;
+    }
+
+    if (positive_axis == dims - 1)
+    {
+        // scan along w, rows are independent
+        const int rows_per_channel = dims == 2 ? h : h * d;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int r = 0; r < rows_per_channel * channels; r++)
+        {
+            const int q = r / rows_per_channel;
+            const int y = r % rows_per_channel;
+
+            float* ptr = (float*)bottom_top_blob.channel(q) + y * w;
+
+            cumulativesum_scan(ptr, w, 0.f);
+        }
+
+        return 0;
+    }
+
+    if (positive_axis == 0)
+    {
+        // accumulate whole slices, split the slice across threads
+        const int count = dims == 2 ? h : channels;
+        const int size = dims == 2 ? w : w * h * d;
+        const size_t stride = dims == 2 ? (size_t)w : bottom_top_blob.cstep;
+
+        const int tile = 256;
+        const int nn_tile = (size + tile - 1) / tile;
+
+        float* ptr = bottom_top_blob;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ti = 0; ti < nn_tile; ti++)
+        {
+            const int i = ti * tile;
+
+            cumulativesum_accumulate(ptr + i, count, std::min(tile, size - i), stride);
+        }
+
+        return 0;
+    }
+
+    // accumulate inside each channel, channels are independent
+    // dims 3 axis 1 runs over rows, dims 4 axis 1 over depth slices and axis 2 over rows in each depth slice
+    const int count = dims == 3 ? h : positive_axis == 1 ? d : h;
+    const int size = dims == 3 ? w : positive_axis == 1 ? w * h : w;
+    const int outer = dims == 4 && positive_axis == 2 ? d : 1;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        for (int z = 0; z < outer; z++)
+        {
+            cumulativesum_accumulate(ptr + z * count * size, count, size, size);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,290 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolutiondepthwise3d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+
+#include "layer_type.h"
+
+namespace ncnn {
+
+static void accumulate_slice(const float* ptr, float* outptr, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr, _mm512_add_ps(_mm512_loadu_ps(outptr), _mm512_loadu_ps(ptr)));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr, _mm256_add_ps(_mm256_loadu_ps(outptr), _mm256_loadu_ps(ptr)));
+        ptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr, _mm_add_ps(_mm_loadu_ps(outptr), _mm_loadu_ps(ptr)));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr += *ptr;
+        ptr++;
+        outptr++;
+    }
+}
+
+DeconvolutionDepthWise3D_x86::DeconvolutionDepthWise3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+
+    activation = 0;
+}
+
+int DeconvolutionDepthWise3D_x86::create_pipeline(const Option& opt)
+{
+    // the overlapping depth slices are accumulated in fp32
+    Option opt_fp32 = opt;
+    opt_fp32.use_bf16_storage = false;
+
+    activation = create_activation_layer(activation_type, activation_params, opt_fp32);
+
+    const int maxk = kernel_w * kernel_h;
+    const int weight_data_size_2d = weight_data_size / kernel_d;
+
+    depth_ops.resize(kernel_d);
+
+    for (int k = 0; k < kernel_d; k++)
+    {
+        // maxk-kd-inch_g-outch to maxk-inch_g-outch at depth k
+        Mat weight_data_2d(weight_data_size_2d);
+        {
+            const float* kptr = weight_data;
+            float* ptr = weight_data_2d;
+
+            for (int i = 0; i < weight_data_size_2d / maxk; i++)
+            {
+                const float* k0 = kptr + (i * kernel_d + k) * maxk;
+
+                for (int j = 0; j < maxk; j++)
+                {
+                    ptr[j] = k0[j];
+                }
+
+                ptr += maxk;
+            }
+        }
+
+        ncnn::Layer* op = ncnn::create_layer_cpu(ncnn::LayerType::DeconvolutionDepthWise);
+
+        // bias and activation are applied after accumulation
+        ncnn::ParamDict pd;
+        pd.set(0, num_output);
+        pd.set(1, kernel_w);
+        pd.set(11, kernel_h);
+        pd.set(2, dilation_w);
+        pd.set(12, dilation_h);
+        pd.set(3, stride_w);
+        pd.set(13, stride_h);
+        pd.set(18, output_pad_right);
+        pd.set(19, output_pad_bottom);
+        pd.set(5, 0);
+        pd.set(6, weight_data_size_2d);
+        pd.set(7, group);
+
+        op->load_param(pd);
+
+        ncnn::Mat weights[1];
+        weights[0] = weight_data_2d;
+
+        op->load_model(ModelBinFromMatArray(weights));
+
+        op->create_pipeline(opt_fp32);
+
+        depth_ops[k] = op;
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int DeconvolutionDepthWise3D_x86::destroy_pipeline(const Option& opt)
+{
+    Option opt_fp32 = opt;
+    opt_fp32.use_bf16_storage = false;
+
+    if (activation)
+    {
+        activation->destroy_pipeline(opt_fp32);
+        delete activation;
+        activation = 0;
+    }
+
+    for (int i = 0; i < (int)depth_ops.size(); i++)
+    {
+        depth_ops[i]->destroy_pipeline(opt_fp32);
+        delete depth_ops[i];
+    }
+    depth_ops.clear();
+
+    return 0;
+}
+
+int DeconvolutionDepthWise3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    opt_b.use_bf16_storage = false;
+
+    bool use_bf16 = false;
+    Mat bottom_blob_fp32 = bottom_blob;
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_blob.elembits() == 16)
+    {
+        use_bf16 = true;
+
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_b);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+#endif
+
+    const int w = bottom_blob_fp32.w;
+    const int h = bottom_blob_fp32.h;
+    const int d = bottom_blob_fp32.d;
+    const int channels = bottom_blob_fp32.c;
+    const size_t elemsize = bottom_blob_fp32.elemsize;
+    const int elempack = bottom_blob_fp32.elempack;
+
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    const int outd = (d - 1) * stride_d + kernel_extent_d + output_pad_behind;
+
+    const bool cut = pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0 || (output_w > 0 && output_h > 0 && output_d > 0);
+
+    Mat top_blob_bordered;
+
+    // depth-major layout, channel z * channels + q is the depth slice z of channel q
+    Mat bottom_blob_sliced(w, h, d * channels, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_blob_sliced.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        for (int z = 0; z < d; z++)
+        {
+            memcpy(bottom_blob_sliced.channel(z * channels + q), bottom_blob_fp32.channel(q).depth(z), (size_t)w * h * elemsize);
+        }
+    }
+
+    for (int z = 0; z < d; z++)
+    {
+        const Mat bottom_blob_slice = bottom_blob_sliced.channel_range(z * channels, channels);
+
+        for (int k = 0; k < kernel_d; k++)
+        {
+            Mat top_blob_2d;
+            int ret = depth_ops[k]->forward(bottom_blob_slice, top_blob_2d, opt_b);
+            if (ret != 0)
+                return ret;
+
+            const int outw = top_blob_2d.w;
+            const int outh = top_blob_2d.h;
+            const int out_elempack = top_blob_2d.elempack;
+
+            if (z == 0 && k == 0)
+            {
+                if (cut || use_bf16)
+                {
+                    top_blob_bordered.create(outw, outh, outd, top_blob_2d.c, top_blob_2d.elemsize, out_elempack, opt.workspace_allocator);
+                }
+                else
+                {
+                    top_blob_bordered = top_blob;
+                    top_blob_bordered.create(outw, outh, outd, top_blob_2d.c, top_blob_2d.elemsize, out_elempack, opt.blob_allocator);
+                }
+                if (top_blob_bordered.empty())
+                    return -100;
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int p = 0; p < top_blob_bordered.c; p++)
+                {
+                    float* outptr = top_blob_bordered.channel(p);
+
+                    for (int i = 0; i < outw * outh * outd; i++)
+                    {
+                        for (int j = 0; j < out_elempack; j++)
+                        {
+                            outptr[j] = bias_term ? bias_data[p * out_elempack + j] : 0.f;
+                        }
+                        outptr += out_elempack;
+                    }
+                }
+            }
+
+            const int size = outw * outh * out_elempack;
+            const int zo = z * stride_d + k * dilation_d;
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int p = 0; p < top_blob_bordered.c; p++)
+            {
+                accumulate_slice(top_blob_2d.channel(p), top_blob_bordered.channel(p).depth(zo), size);
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_bordered, opt_b);
+    }
+
+#if NCNN_BF16
+    if (use_bf16)
+    {
+        Mat top_blob_fp32;
+        cut_padding(top_blob_bordered, top_blob_fp32, opt_b);
+        if (top_blob_fp32.empty())
+            return -100;
+
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
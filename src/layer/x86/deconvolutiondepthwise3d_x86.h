@@ -0,0 +1,30 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_DECONVOLUTIONDEPTHWISE3D_X86_H
+#define LAYER_DECONVOLUTIONDEPTHWISE3D_X86_H
+
+#include "deconvolutiondepthwise3d.h"
+
+namespace ncnn {
+
+class DeconvolutionDepthWise3D_x86 : public DeconvolutionDepthWise3D
+{
+public:
+    DeconvolutionDepthWise3D_x86();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* activation;
+
+    // 2d depthwise deconvolution for each kernel depth
+    std::vector<ncnn::Layer*> depth_ops;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_DECONVOLUTIONDEPTHWISE3D_X86_H
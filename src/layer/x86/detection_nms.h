@@ -0,0 +1,106 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// greedy nms over score sorted boxes shared by detectionoutput, proposal and yolov3detectionoutput
+// boxes are kept as separate coordinate arrays so that one picked box is tested against many at once
+
+struct BBoxSoA
+{
+    std::vector<float> xmin;
+    std::vector<float> ymin;
+    std::vector<float> xmax;
+    std::vector<float> ymax;
+    std::vector<float> area;
+
+    void resize(int n)
+    {
+        xmin.resize(n);
+        ymin.resize(n);
+        xmax.resize(n);
+        ymax.resize(n);
+        area.resize(n);
+    }
+};
+
+// a box is dropped when its iou with any earlier picked box exceeds nms_threshold
+// picking stops after max_picked boxes, which is all a caller truncating the result needs
+static void nms_sorted_bboxes_soa(const BBoxSoA& boxes, int n, float nms_threshold, int max_picked, std::vector<int>& picked)
+{
+    picked.clear();
+
+    if (n == 0 || max_picked <= 0)
+        return;
+
+    const float* xmin = &boxes.xmin[0];
+    const float* ymin = &boxes.ymin[0];
+    const float* xmax = &boxes.xmax[0];
+    const float* ymax = &boxes.ymax[0];
+    const float* area = &boxes.area[0];
+
+    // 1.f marks a box suppressed by a picked one
+    std::vector<float> suppressed(n, 0.f);
+    float* sptr = &suppressed[0];
+
+    for (int i = 0; i < n; i++)
+    {
+        if (sptr[i] != 0.f)
+            continue;
+
+        picked.push_back(i);
+        if ((int)picked.size() >= max_picked)
+            break;
+
+        int j = i + 1;
+#if __SSE2__
+#if __AVX__
+        {
+            const __m256 _axmin = _mm256_set1_ps(xmin[i]);
+            const __m256 _aymin = _mm256_set1_ps(ymin[i]);
+            const __m256 _axmax = _mm256_set1_ps(xmax[i]);
+            const __m256 _aymax = _mm256_set1_ps(ymax[i]);
+            const __m256 _aarea = _mm256_set1_ps(area[i]);
+            const __m256 _thresh = _mm256_set1_ps(nms_threshold);
+            const __m256 _zero = _mm256_setzero_ps();
+            const __m256 _one = _mm256_set1_ps(1.f);
+            for (; j + 7 < n; j += 8)
+            {
+                __m256 _w = _mm256_sub_ps(_mm256_min_ps(_axmax, _mm256_loadu_ps(xmax + j)), _mm256_max_ps(_axmin, _mm256_loadu_ps(xmin + j)));
+                __m256 _h = _mm256_sub_ps(_mm256_min_ps(_aymax, _mm256_loadu_ps(ymax + j)), _mm256_max_ps(_aymin, _mm256_loadu_ps(ymin + j)));
+                __m256 _inter = _mm256_mul_ps(_mm256_max_ps(_w, _zero), _mm256_max_ps(_h, _zero));
+                __m256 _union = _mm256_sub_ps(_mm256_add_ps(_aarea, _mm256_loadu_ps(area + j)), _inter);
+                __m256 _mask = _mm256_cmp_ps(_mm256_div_ps(_inter, _union), _thresh, _CMP_GT_OQ);
+                _mm256_storeu_ps(sptr + j, _mm256_or_ps(_mm256_loadu_ps(sptr + j), _mm256_and_ps(_mask, _one)));
+            }
+        }
+#endif // __AVX__
+        {
+            const __m128 _axmin = _mm_set1_ps(xmin[i]);
+            const __m128 _aymin = _mm_set1_ps(ymin[i]);
+            const __m128 _axmax = _mm_set1_ps(xmax[i]);
+            const __m128 _aymax = _mm_set1_ps(ymax[i]);
+            const __m128 _aarea = _mm_set1_ps(area[i]);
+            const __m128 _thresh = _mm_set1_ps(nms_threshold);
+            const __m128 _zero = _mm_setzero_ps();
+            const __m128 _one = _mm_set1_ps(1.f);
+            for (; j + 3 < n; j += 4)
+            {
+                __m128 _w = _mm_sub_ps(_mm_min_ps(_axmax, _mm_loadu_ps(xmax + j)), _mm_max_ps(_axmin, _mm_loadu_ps(xmin + j)));
+                __m128 _h = _mm_sub_ps(_mm_min_ps(_aymax, _mm_loadu_ps(ymax + j)), _mm_max_ps(_aymin, _mm_loadu_ps(ymin + j)));
+                __m128 _inter = _mm_mul_ps(_mm_max_ps(_w, _zero), _mm_max_ps(_h, _zero));
+                __m128 _union = _mm_sub_ps(_mm_add_ps(_aarea, _mm_loadu_ps(area + j)), _inter);
+                __m128 _mask = _mm_cmpgt_ps(_mm_div_ps(_inter, _union), _thresh);
+                _mm_storeu_ps(sptr + j, _mm_or_ps(_mm_loadu_ps(sptr + j), _mm_and_ps(_mask, _one)));
+            }
+        }
+#endif // __SSE2__
+        for (; j < n; j++)
+        {
+            float w = std::max(std::min(xmax[i], xmax[j]) - std::max(xmin[i], xmin[j]), 0.f);
+            float h = std::max(std::min(ymax[i], ymax[j]) - std::max(ymin[i], ymin[j]), 0.f);
+            float inter = w * h;
+            float union_area = area[i] + area[j] - inter;
+            if (inter / union_area > nms_threshold)
+                sptr[j] = 1.f;
+        }
+    }
+}
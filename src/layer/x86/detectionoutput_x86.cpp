@@ -0,0 +1,301 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "detectionoutput_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "topk_select.h"
+
+namespace ncnn {
+
+#include "detection_nms.h"
+
+DetectionOutput_x86::DetectionOutput_x86()
+{
+}
+
+// decode center size offsets of num_prior priors into separate corner arrays
+static void decode_bboxes(const float* loc, const float* pb, const float* var, const float* variances, int num_prior, BBoxSoA& bboxes, const Option& opt)
+{
+    float* xmin = &bboxes.xmin[0];
+    float* ymin = &bboxes.ymin[0];
+    float* xmax = &bboxes.xmax[0];
+    float* ymax = &bboxes.ymax[0];
+
+    int nn_prior = 0;
+#if __SSE2__
+    nn_prior = num_prior / 4;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ii = 0; ii < nn_prior; ii++)
+    {
+        const int i = ii * 4;
+
+        __m128 _dx = _mm_loadu_ps(loc + i * 4);
+        __m128 _dy = _mm_loadu_ps(loc + i * 4 + 4);
+        __m128 _dw = _mm_loadu_ps(loc + i * 4 + 8);
+        __m128 _dh = _mm_loadu_ps(loc + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(_dx, _dy, _dw, _dh);
+
+        __m128 _x0 = _mm_loadu_ps(pb + i * 4);
+        __m128 _y0 = _mm_loadu_ps(pb + i * 4 + 4);
+        __m128 _x1 = _mm_loadu_ps(pb + i * 4 + 8);
+        __m128 _y1 = _mm_loadu_ps(pb + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(_x0, _y0, _x1, _y1);
+
+        __m128 _v0;
+        __m128 _v1;
+        __m128 _v2;
+        __m128 _v3;
+        if (var)
+        {
+            _v0 = _mm_loadu_ps(var + i * 4);
+            _v1 = _mm_loadu_ps(var + i * 4 + 4);
+            _v2 = _mm_loadu_ps(var + i * 4 + 8);
+            _v3 = _mm_loadu_ps(var + i * 4 + 12);
+            _MM_TRANSPOSE4_PS(_v0, _v1, _v2, _v3);
+        }
+        else
+        {
+            _v0 = _mm_set1_ps(variances[0]);
+            _v1 = _mm_set1_ps(variances[1]);
+            _v2 = _mm_set1_ps(variances[2]);
+            _v3 = _mm_set1_ps(variances[3]);
+        }
+
+        const __m128 _half = _mm_set1_ps(0.5f);
+
+        __m128 _pb_w = _mm_sub_ps(_x1, _x0);
+        __m128 _pb_h = _mm_sub_ps(_y1, _y0);
+        __m128 _pb_cx = _mm_mul_ps(_mm_add_ps(_x0, _x1), _half);
+        __m128 _pb_cy = _mm_mul_ps(_mm_add_ps(_y0, _y1), _half);
+
+        __m128 _cx = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_v0, _dx), _pb_w), _pb_cx);
+        __m128 _cy = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_v1, _dy), _pb_h), _pb_cy);
+        __m128 _w = _mm_mul_ps(exp_ps(_mm_mul_ps(_v2, _dw)), _pb_w);
+        __m128 _h = _mm_mul_ps(exp_ps(_mm_mul_ps(_v3, _dh)), _pb_h);
+
+        _mm_storeu_ps(xmin + i, _mm_sub_ps(_cx, _mm_mul_ps(_w, _half)));
+        _mm_storeu_ps(ymin + i, _mm_sub_ps(_cy, _mm_mul_ps(_h, _half)));
+        _mm_storeu_ps(xmax + i, _mm_add_ps(_cx, _mm_mul_ps(_w, _half)));
+        _mm_storeu_ps(ymax + i, _mm_add_ps(_cy, _mm_mul_ps(_h, _half)));
+    }
+#endif // __SSE2__
+    for (int i = nn_prior * 4; i < num_prior; i++)
+    {
+        const float* l = loc + i * 4;
+        const float* p = pb + i * 4;
+        const float* v = var ? var + i * 4 : variances;
+
+        // CENTER_SIZE
+        float pb_w = p[2] - p[0];
+        float pb_h = p[3] - p[1];
+        float pb_cx = (p[0] + p[2]) * 0.5f;
+        float pb_cy = (p[1] + p[3]) * 0.5f;
+
+        float bbox_cx = v[0] * l[0] * pb_w + pb_cx;
+        float bbox_cy = v[1] * l[1] * pb_h + pb_cy;
+        float bbox_w = expf(v[2] * l[2]) * pb_w;
+        float bbox_h = expf(v[3] * l[3]) * pb_h;
+
+        xmin[i] = bbox_cx - bbox_w * 0.5f;
+        ymin[i] = bbox_cy - bbox_h * 0.5f;
+        xmax[i] = bbox_cx + bbox_w * 0.5f;
+        ymax[i] = bbox_cy + bbox_h * 0.5f;
+    }
+}
+
+// append j to candidates[i] for every class i in [1, num_class) whose score exceeds the threshold
+static void filter_class_scores(const float* ptr, int num_class, float confidence_threshold, int j, std::vector<std::vector<int> >& candidates)
+{
+    int i = 1;
+#if __SSE2__
+    const __m128 _thresh = _mm_set1_ps(confidence_threshold);
+    for (; i + 3 < num_class; i += 4)
+    {
+        int mask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(ptr + i), _thresh));
+        while (mask)
+        {
+#ifdef _MSC_VER
+            unsigned long k;
+            _BitScanForward(&k, mask);
+#else
+            const int k = __builtin_ctz(mask);
+#endif
+            candidates[i + k].push_back(j);
+            mask &= mask - 1;
+        }
+    }
+#endif // __SSE2__
+    for (; i < num_class; i++)
+    {
+        if (ptr[i] > confidence_threshold)
+            candidates[i].push_back(j);
+    }
+}
+
+int DetectionOutput_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& location = bottom_blobs[0];
+    const Mat& confidence = bottom_blobs[1];
+    const Mat& priorbox = bottom_blobs[2];
+
+    bool mxnet_ssd_style = num_class == -233;
+
+    // mxnet-ssd _contrib_MultiBoxDetection
+    const int num_prior = mxnet_ssd_style ? priorbox.h : priorbox.w / 4;
+
+    int num_class_copy = mxnet_ssd_style ? confidence.h : num_class;
+
+    // apply location with priorbox
+    BBoxSoA bboxes;
+    bboxes.resize(num_prior);
+
+    const float* priorbox_ptr = priorbox.row(0);
+    const float* variance_ptr = mxnet_ssd_style ? 0 : priorbox.row(1);
+
+    decode_bboxes(location, priorbox_ptr, variance_ptr, variances, num_prior, bboxes, opt);
+
+    // prob data layout
+    // caffe-ssd = num_class x num_prior
+    // mxnet-ssd = num_prior x num_class
+    const float* confidence_ptr = confidence;
+
+    // filter by confidence_threshold, start from 1 to ignore background class
+    // priors whose background score is at least 1 - confidence_threshold are skipped up front
+    const double background_threshold = 1.0 - confidence_threshold;
+
+    std::vector<std::vector<int> > all_class_candidates(num_class_copy);
+    if (mxnet_ssd_style)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 1; i < num_class_copy; i++)
+        {
+            const float* ptr = confidence_ptr + i * num_prior;
+            for (int j = 0; j < num_prior; j++)
+            {
+                if (confidence_ptr[j] >= background_threshold)
+                    continue;
+
+                if (ptr[j] > confidence_threshold)
+                    all_class_candidates[i].push_back(j);
+            }
+        }
+    }
+    else
+    {
+        for (int j = 0; j < num_prior; j++)
+        {
+            if (confidence_ptr[(size_t)j * num_class_copy] >= background_threshold)
+                continue;
+
+            filter_class_scores(confidence_ptr + (size_t)j * num_class_copy, num_class_copy, confidence_threshold, j, all_class_candidates);
+        }
+    }
+
+    // sort and nms for each class
+    std::vector<std::vector<int> > all_class_picked(num_class_copy);
+    std::vector<std::vector<float> > all_class_picked_scores(num_class_copy);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 1; i < num_class_copy; i++)
+    {
+        const std::vector<int>& candidates = all_class_candidates[i];
+        const int num_candidates = (int)candidates.size();
+        if (num_candidates == 0)
+            continue;
+
+        std::vector<float> scores(num_candidates);
+        for (int j = 0; j < num_candidates; j++)
+        {
+            const int z = candidates[j];
+            scores[j] = mxnet_ssd_style ? confidence_ptr[i * num_prior + z] : confidence_ptr[(size_t)z * num_class_copy + i];
+        }
+
+        // keep nms_top_k, negative keeps all
+        const int top_k = nms_top_k < 0 ? num_candidates : std::min(nms_top_k, num_candidates);
+        std::vector<int> sorted(top_k);
+        const int num_sorted = topk_select(scores.data(), 0, num_candidates, top_k, sorted.data());
+
+        BBoxSoA class_bboxes;
+        class_bboxes.resize(num_sorted);
+        for (int j = 0; j < num_sorted; j++)
+        {
+            const int z = candidates[sorted[j]];
+            class_bboxes.xmin[j] = bboxes.xmin[z];
+            class_bboxes.ymin[j] = bboxes.ymin[z];
+            class_bboxes.xmax[j] = bboxes.xmax[z];
+            class_bboxes.ymax[j] = bboxes.ymax[z];
+            class_bboxes.area[j] = (bboxes.xmax[z] - bboxes.xmin[z]) * (bboxes.ymax[z] - bboxes.ymin[z]);
+        }
+
+        // apply nms, no class can contribute more than keep_top_k boxes
+        std::vector<int> picked;
+        nms_sorted_bboxes_soa(class_bboxes, num_sorted, nms_threshold, keep_top_k < 0 ? num_sorted : keep_top_k, picked);
+
+        for (size_t j = 0; j < picked.size(); j++)
+        {
+            const int z = sorted[picked[j]];
+            all_class_picked[i].push_back(candidates[z]);
+            all_class_picked_scores[i].push_back(scores[z]);
+        }
+    }
+
+    // gather all class
+    std::vector<int> bbox_labels;
+    std::vector<int> bbox_indices;
+    std::vector<float> bbox_scores;
+
+    for (int i = 1; i < num_class_copy; i++)
+    {
+        const std::vector<int>& class_picked = all_class_picked[i];
+        const std::vector<float>& class_picked_scores = all_class_picked_scores[i];
+
+        bbox_labels.insert(bbox_labels.end(), class_picked.size(), i);
+        bbox_indices.insert(bbox_indices.end(), class_picked.begin(), class_picked.end());
+        bbox_scores.insert(bbox_scores.end(), class_picked_scores.begin(), class_picked_scores.end());
+    }
+
+    // global sort and keep_top_k, negative keeps all
+    const int num_picked = (int)bbox_scores.size();
+    if (num_picked == 0)
+        return 0;
+
+    const int top_k = keep_top_k < 0 ? num_picked : std::min(keep_top_k, num_picked);
+    std::vector<int> sorted(top_k);
+    const int num_detected = topk_select(bbox_scores.data(), 0, num_picked, top_k, sorted.data());
+
+    // fill result
+    if (num_detected == 0)
+        return 0;
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(6, num_detected, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    for (int i = 0; i < num_detected; i++)
+    {
+        const int k = sorted[i];
+        const int z = bbox_indices[k];
+        float* outptr = top_blob.row(i);
+
+        outptr[0] = static_cast<float>(bbox_labels[k]);
+        outptr[1] = bbox_scores[k];
+        outptr[2] = bboxes.xmin[z];
+        outptr[3] = bboxes.ymin[z];
+        outptr[4] = bboxes.xmax[z];
+        outptr[5] = bboxes.ymax[z];
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_DETECTIONOUTPUT_X86_H
+#define LAYER_DETECTIONOUTPUT_X86_H
+
+#include "detectionoutput.h"
+
+namespace ncnn {
+
+class DetectionOutput_x86 : public DetectionOutput
+{
+public:
+    DetectionOutput_x86();
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_DETECTIONOUTPUT_X86_H
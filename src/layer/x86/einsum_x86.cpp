@@ -0,0 +1,652 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "einsum_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include "layer_type.h"
+
+#include <limits.h>
+
+namespace ncnn {
+
+Einsum_x86::Einsum_x86()
+{
+    for (int i = 0; i < 4; i++)
+    {
+        gemm[i] = 0;
+    }
+}
+
+static std::string unique_labels(const std::string& token)
+{
+    std::string labels;
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        if (labels.find(token[i]) == std::string::npos)
+            labels.push_back(token[i]);
+    }
+
+    return labels;
+}
+
+int Einsum_x86::create_pipeline(const Option& opt)
+{
+    contraction_a.clear();
+    contraction_b.clear();
+    contraction_batch_tokens.clear();
+    contraction_m_tokens.clear();
+    contraction_n_tokens.clear();
+    contraction_k_tokens.clear();
+
+    std::vector<std::string> operands(lhs_tokens.size());
+    for (size_t i = 0; i < lhs_tokens.size(); i++)
+    {
+        operands[i] = unique_labels(lhs_tokens[i]);
+    }
+
+    // greedy contraction order, pick the pair with the fewest result labels and the most shared labels
+    while (operands.size() > 1)
+    {
+        int best_i = 0;
+        int best_j = 1;
+        int best_result_count = INT_MAX;
+        int best_shared_count = -1;
+
+        for (int i = 0; i < (int)operands.size(); i++)
+        {
+            for (int j = i + 1; j < (int)operands.size(); j++)
+            {
+                std::string needed = rhs_token;
+                for (int q = 0; q < (int)operands.size(); q++)
+                {
+                    if (q != i && q != j)
+                        needed += operands[q];
+                }
+
+                const std::string ab = unique_labels(operands[i] + operands[j]);
+
+                int result_count = 0;
+                int shared_count = 0;
+                for (size_t s = 0; s < ab.size(); s++)
+                {
+                    if (needed.find(ab[s]) != std::string::npos)
+                        result_count++;
+                    if (operands[i].find(ab[s]) != std::string::npos && operands[j].find(ab[s]) != std::string::npos)
+                        shared_count++;
+                }
+
+                if (result_count < best_result_count || (result_count == best_result_count && shared_count > best_shared_count))
+                {
+                    best_i = i;
+                    best_j = j;
+                    best_result_count = result_count;
+                    best_shared_count = shared_count;
+                }
+            }
+        }
+
+        const std::string& a = operands[best_i];
+        const std::string& b = operands[best_j];
+
+        std::string needed = rhs_token;
+        for (int q = 0; q < (int)operands.size(); q++)
+        {
+            if (q != best_i && q != best_j)
+                needed += operands[q];
+        }
+
+        // labels only in a or b and not needed later are summed while packing
+        std::string batch_token;
+        std::string m_token;
+        std::string n_token;
+        std::string k_token;
+        for (size_t s = 0; s < a.size(); s++)
+        {
+            const bool in_b = b.find(a[s]) != std::string::npos;
+            const bool in_needed = needed.find(a[s]) != std::string::npos;
+
+            if (in_b && in_needed)
+                batch_token.push_back(a[s]);
+            if (in_b && !in_needed)
+                k_token.push_back(a[s]);
+            if (!in_b && in_needed)
+                m_token.push_back(a[s]);
+        }
+        for (size_t s = 0; s < b.size(); s++)
+        {
+            if (a.find(b[s]) == std::string::npos && needed.find(b[s]) != std::string::npos)
+                n_token.push_back(b[s]);
+        }
+
+        contraction_a.push_back(best_i);
+        contraction_b.push_back(best_j);
+        contraction_batch_tokens.push_back(batch_token);
+        contraction_m_tokens.push_back(m_token);
+        contraction_n_tokens.push_back(n_token);
+        contraction_k_tokens.push_back(k_token);
+
+        operands.erase(operands.begin() + best_j);
+        operands.erase(operands.begin() + best_i);
+        operands.push_back(batch_token + m_token + n_token);
+    }
+
+    if (!contraction_a.empty())
+    {
+        Option opt_fp32 = opt;
+        opt_fp32.use_bf16_storage = false;
+        opt_fp32.use_fp16_storage = false;
+
+        for (int i = 0; i < 4; i++)
+        {
+            gemm[i] = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+            ncnn::ParamDict pd;
+            pd.set(2, i / 2); // transA
+            pd.set(3, i % 2); // transB
+            pd.set(12, 1);    // output_elempack
+
+            gemm[i]->load_param(pd);
+
+            gemm[i]->load_model(ModelBinFromMatArray(0));
+
+            gemm[i]->create_pipeline(opt_fp32);
+        }
+    }
+
+    return 0;
+}
+
+int Einsum_x86::destroy_pipeline(const Option& opt)
+{
+    Option opt_fp32 = opt;
+    opt_fp32.use_bf16_storage = false;
+    opt_fp32.use_fp16_storage = false;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (gemm[i])
+        {
+            gemm[i]->destroy_pipeline(opt_fp32);
+            delete gemm[i];
+            gemm[i] = 0;
+        }
+    }
+
+    return 0;
+}
+
+// strided view of an operand, strides are indexed by label
+struct einsum_operand
+{
+    Mat data;
+    const float* ptr;
+    std::string labels;
+    std::vector<size_t> strides;
+};
+
+static void resolve_operand(const Mat& m, const std::string& token, einsum_operand& op, std::vector<int>& label_sizes)
+{
+    const int dims = m.dims;
+
+    // the outermost axis comes first in the token
+    int shape[4] = {1, 1, 1, 1};
+    size_t strides[4] = {0, 0, 0, 0};
+
+    if (dims == 1)
+    {
+        shape[0] = m.w;
+        strides[0] = 1;
+    }
+    if (dims == 2)
+    {
+        shape[0] = m.h;
+        shape[1] = m.w;
+        strides[0] = m.w;
+        strides[1] = 1;
+    }
+    if (dims == 3)
+    {
+        shape[0] = m.c;
+        shape[1] = m.h;
+        shape[2] = m.w;
+        strides[0] = m.cstep;
+        strides[1] = m.w;
+        strides[2] = 1;
+    }
+    if (dims == 4)
+    {
+        shape[0] = m.c;
+        shape[1] = m.d;
+        shape[2] = m.h;
+        shape[3] = m.w;
+        strides[0] = m.cstep;
+        strides[1] = (size_t)m.w * m.h;
+        strides[2] = m.w;
+        strides[3] = 1;
+    }
+
+    op.data = m;
+    op.ptr = m;
+    op.labels = unique_labels(token);
+    op.strides.resize(128);
+    std::fill(op.strides.begin(), op.strides.end(), (size_t)0);
+
+    for (int s = 0; s < dims; s++)
+    {
+        // repeated labels walk the diagonal
+        op.strides[(int)token[s]] += strides[s];
+        label_sizes[(int)token[s]] = shape[s];
+    }
+}
+
+static void make_contiguous_strides(const std::string& labels, const std::vector<int>& label_sizes, std::vector<size_t>& strides)
+{
+    strides.resize(128);
+    std::fill(strides.begin(), strides.end(), (size_t)0);
+
+    size_t stride = 1;
+    for (int s = (int)labels.size() - 1; s >= 0; s--)
+    {
+        strides[(int)labels[s]] = stride;
+        stride *= label_sizes[(int)labels[s]];
+    }
+}
+
+static bool is_contiguous(const einsum_operand& op, const std::string& labels, const std::vector<int>& label_sizes)
+{
+    size_t stride = 1;
+    for (int s = (int)labels.size() - 1; s >= 0; s--)
+    {
+        const int size = label_sizes[(int)labels[s]];
+        if (size != 1 && op.strides[(int)labels[s]] != stride)
+            return false;
+
+        stride *= size;
+    }
+
+    return true;
+}
+
+static int count_elements(const std::string& labels, const std::vector<int>& label_sizes)
+{
+    int size = 1;
+    for (size_t s = 0; s < labels.size(); s++)
+    {
+        size *= label_sizes[(int)labels[s]];
+    }
+
+    return size;
+}
+
+static size_t batch_offset(int b, const std::string& batch_labels, const std::vector<size_t>& strides, const std::vector<int>& label_sizes)
+{
+    size_t offset = 0;
+    for (int s = (int)batch_labels.size() - 1; s >= 0; s--)
+    {
+        const int size = label_sizes[(int)batch_labels[s]];
+        offset += (b % size) * strides[(int)batch_labels[s]];
+        b /= size;
+    }
+
+    return offset;
+}
+
+// gather src into dst in dst_labels order, the sum_labels are reduced
+static void permute_sum(const einsum_operand& src, const std::string& sum_labels, const std::string& dst_labels, const std::vector<size_t>& dst_strides, float* dst, const std::vector<int>& label_sizes, const Option& opt)
+{
+    const int dst_dims = (int)dst_labels.size();
+
+    // the innermost dst axis is walked in the inner loop
+    int inner = 1;
+    size_t src_inner_stride = 0;
+    size_t dst_inner_stride = 0;
+    if (dst_dims > 0)
+    {
+        const int label = dst_labels[dst_dims - 1];
+        inner = label_sizes[label];
+        src_inner_stride = src.strides[label];
+        dst_inner_stride = dst_strides[label];
+    }
+
+    const int outer = count_elements(dst_labels.substr(0, dst_dims > 0 ? dst_dims - 1 : 0), label_sizes);
+
+    std::vector<size_t> sum_offsets(1, 0);
+    for (size_t s = 0; s < sum_labels.size(); s++)
+    {
+        const int size = label_sizes[(int)sum_labels[s]];
+        const size_t stride = src.strides[(int)sum_labels[s]];
+
+        std::vector<size_t> offsets;
+        offsets.reserve(sum_offsets.size() * size);
+        for (size_t i = 0; i < sum_offsets.size(); i++)
+        {
+            for (int j = 0; j < size; j++)
+            {
+                offsets.push_back(sum_offsets[i] + j * stride);
+            }
+        }
+
+        sum_offsets.swap(offsets);
+    }
+
+    const int sum_count = (int)sum_offsets.size();
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < outer; i++)
+    {
+        size_t src_offset = 0;
+        size_t dst_offset = 0;
+
+        int t = i;
+        for (int s = dst_dims - 2; s >= 0; s--)
+        {
+            const int label = dst_labels[s];
+            const int index = t % label_sizes[label];
+            t /= label_sizes[label];
+
+            src_offset += index * src.strides[label];
+            dst_offset += index * dst_strides[label];
+        }
+
+        const float* ptr = src.ptr + src_offset;
+        float* outptr = dst + dst_offset;
+
+        if (sum_count == 1 && src_inner_stride == 1 && dst_inner_stride == 1)
+        {
+            memcpy(outptr, ptr, inner * sizeof(float));
+        }
+        else
+        {
+            for (int j = 0; j < inner; j++)
+            {
+                outptr[j * dst_inner_stride] = 0.f;
+            }
+
+            for (int k = 0; k < sum_count; k++)
+            {
+                const float* p = ptr + sum_offsets[k];
+                for (int j = 0; j < inner; j++)
+                {
+                    outptr[j * dst_inner_stride] += p[j * src_inner_stride];
+                }
+            }
+        }
+    }
+}
+
+static float dot(const float* a, const float* b, int K)
+{
+    float sum = 0.f;
+
+    int k = 0;
+#if __SSE2__
+#if __AVX__
+    __m256 _sum8 = _mm256_setzero_ps();
+    for (; k + 7 < K; k += 8)
+    {
+        _sum8 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k), _sum8);
+    }
+    sum += _mm256_reduce_add_ps(_sum8);
+#endif // __AVX__
+    __m128 _sum4 = _mm_setzero_ps();
+    for (; k + 3 < K; k += 4)
+    {
+        _sum4 = _mm_comp_fmadd_ps(_mm_loadu_ps(a + k), _mm_loadu_ps(b + k), _sum4);
+    }
+    sum += _mm_reduce_add_ps(_sum4);
+#endif // __SSE2__
+    for (; k < K; k++)
+    {
+        sum += a[k] * b[k];
+    }
+
+    return sum;
+}
+
+int Einsum_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int input_count = (int)bottom_blobs.size();
+
+    if (input_count != (int)lhs_tokens.size())
+    {
+        NCNN_LOGE("einsum expects %d inputs but got %d", (int)lhs_tokens.size(), input_count);
+        return -1;
+    }
+
+    // resolve dimension sizes
+    std::vector<int> label_sizes(128, 0);
+    std::vector<einsum_operand> operands(input_count);
+    for (int b = 0; b < input_count; b++)
+    {
+        if (bottom_blobs[b].dims != (int)lhs_tokens[b].size())
+        {
+            NCNN_LOGE("einsum input %d dims %d mismatch with token %s", b, bottom_blobs[b].dims, lhs_tokens[b].c_str());
+            return -1;
+        }
+
+        resolve_operand(bottom_blobs[b], lhs_tokens[b], operands[b], label_sizes);
+    }
+
+    const int out_dims = (int)rhs_token.size();
+
+    Mat& top_blob = top_blobs[0];
+    if (out_dims == 0)
+        top_blob.create(1, 4u, opt.blob_allocator);
+    if (out_dims == 1)
+        top_blob.create(label_sizes[(int)rhs_token[0]], 4u, opt.blob_allocator);
+    if (out_dims == 2)
+        top_blob.create(label_sizes[(int)rhs_token[1]], label_sizes[(int)rhs_token[0]], 4u, opt.blob_allocator);
+    if (out_dims == 3)
+        top_blob.create(label_sizes[(int)rhs_token[2]], label_sizes[(int)rhs_token[1]], label_sizes[(int)rhs_token[0]], 4u, opt.blob_allocator);
+    if (out_dims == 4)
+        top_blob.create(label_sizes[(int)rhs_token[3]], label_sizes[(int)rhs_token[2]], label_sizes[(int)rhs_token[1]], label_sizes[(int)rhs_token[0]], 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    einsum_operand top;
+    if (out_dims == 0)
+    {
+        top.data = top_blob;
+        top.ptr = top_blob;
+        top.strides.resize(128, 0);
+    }
+    else
+    {
+        std::vector<int> top_label_sizes(128, 0);
+        resolve_operand(top_blob, rhs_token, top, top_label_sizes);
+    }
+
+    Option opt_g = opt;
+    opt_g.use_bf16_storage = false;
+    opt_g.use_fp16_storage = false;
+    // let gemm write into the preallocated output views
+    opt_g.blob_allocator = 0;
+
+    bool top_written = false;
+
+    for (size_t i = 0; i < contraction_a.size(); i++)
+    {
+        const std::string& batch_token = contraction_batch_tokens[i];
+        const std::string& m_token = contraction_m_tokens[i];
+        const std::string& n_token = contraction_n_tokens[i];
+        const std::string& k_token = contraction_k_tokens[i];
+
+        einsum_operand A = operands[contraction_a[i]];
+        einsum_operand B = operands[contraction_b[i]];
+
+        const int batch = count_elements(batch_token, label_sizes);
+        const int M = count_elements(m_token, label_sizes);
+        const int N = count_elements(n_token, label_sizes);
+        const int K = count_elements(k_token, label_sizes);
+
+        // tiny or outer products are cheaper without gemm packing
+        const bool use_gemm = K > 1 && (size_t)M * N > 1 && (size_t)M * N * K >= 4096;
+
+        std::string sum_a;
+        for (size_t s = 0; s < A.labels.size(); s++)
+        {
+            if ((batch_token + m_token + k_token).find(A.labels[s]) == std::string::npos)
+                sum_a.push_back(A.labels[s]);
+        }
+
+        std::string sum_b;
+        for (size_t s = 0; s < B.labels.size(); s++)
+        {
+            if ((batch_token + n_token + k_token).find(B.labels[s]) == std::string::npos)
+                sum_b.push_back(B.labels[s]);
+        }
+
+        // use the operands in place when the gemm block is contiguous
+        int transA = 0;
+        if (sum_a.empty() && is_contiguous(A, m_token + k_token, label_sizes))
+        {
+            transA = 0;
+        }
+        else if (use_gemm && sum_a.empty() && is_contiguous(A, k_token + m_token, label_sizes))
+        {
+            transA = 1;
+        }
+        else
+        {
+            const std::string labels = batch_token + m_token + k_token;
+
+            einsum_operand A_packed;
+            A_packed.data.create(batch * M * K, 4u, opt.workspace_allocator);
+            if (A_packed.data.empty())
+                return -100;
+
+            A_packed.ptr = A_packed.data;
+            A_packed.labels = labels;
+            make_contiguous_strides(labels, label_sizes, A_packed.strides);
+
+            permute_sum(A, sum_a, labels, A_packed.strides, A_packed.data, label_sizes, opt);
+
+            A = A_packed;
+        }
+
+        int transB = 1;
+        if (sum_b.empty() && is_contiguous(B, n_token + k_token, label_sizes))
+        {
+            transB = 1;
+        }
+        else if (use_gemm && sum_b.empty() && is_contiguous(B, k_token + n_token, label_sizes))
+        {
+            transB = 0;
+        }
+        else
+        {
+            const std::string labels = batch_token + n_token + k_token;
+
+            einsum_operand B_packed;
+            B_packed.data.create(batch * N * K, 4u, opt.workspace_allocator);
+            if (B_packed.data.empty())
+                return -100;
+
+            B_packed.ptr = B_packed.data;
+            B_packed.labels = labels;
+            make_contiguous_strides(labels, label_sizes, B_packed.strides);
+
+            permute_sum(B, sum_b, labels, B_packed.strides, B_packed.data, label_sizes, opt);
+
+            B = B_packed;
+        }
+
+        // the result is batch-m-n
+        einsum_operand C;
+        C.labels = batch_token + m_token + n_token;
+        make_contiguous_strides(C.labels, label_sizes, C.strides);
+
+        if (i + 1 == contraction_a.size() && C.labels == rhs_token && is_contiguous(top, rhs_token, label_sizes))
+        {
+            C.data = top_blob;
+            top_written = true;
+        }
+        else
+        {
+            C.data.create(batch * M * N, 4u, opt.workspace_allocator);
+            if (C.data.empty())
+                return -100;
+        }
+        C.ptr = C.data;
+
+        float* outptr = C.data;
+
+        if (use_gemm)
+        {
+            Layer* op = gemm[transA * 2 + transB];
+
+            std::vector<Mat> gemm_bottom_blobs(2);
+            std::vector<Mat> gemm_top_blobs(1);
+
+            for (int b = 0; b < batch; b++)
+            {
+                float* pa = (float*)A.ptr + batch_offset(b, batch_token, A.strides, label_sizes);
+                float* pb = (float*)B.ptr + batch_offset(b, batch_token, B.strides, label_sizes);
+                float* pc = outptr + (size_t)b * M * N;
+
+                gemm_bottom_blobs[0] = transA ? Mat(M, K, pa) : Mat(K, M, pa);
+                gemm_bottom_blobs[1] = transB ? Mat(K, N, pb) : Mat(N, K, pb);
+                gemm_top_blobs[0] = Mat(N, M, pc);
+
+                int ret = op->forward(gemm_bottom_blobs, gemm_top_blobs, opt_g);
+                if (ret != 0)
+                    return ret;
+
+                // gemm writes in place unless it reallocated the output
+                if ((float*)gemm_top_blobs[0].data != pc)
+                {
+                    memcpy(pc, gemm_top_blobs[0].data, (size_t)M * N * sizeof(float));
+                }
+            }
+        }
+        else
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int bm = 0; bm < batch * M; bm++)
+            {
+                const int b = bm / M;
+                const int m = bm % M;
+
+                const float* pa = A.ptr + batch_offset(b, batch_token, A.strides, label_sizes) + (size_t)m * K;
+                const float* pb = B.ptr + batch_offset(b, batch_token, B.strides, label_sizes);
+                float* pc = outptr + (size_t)bm * N;
+
+                for (int n = 0; n < N; n++)
+                {
+                    pc[n] = dot(pa, pb + (size_t)n * K, K);
+                }
+            }
+        }
+
+        operands.erase(operands.begin() + contraction_b[i]);
+        operands.erase(operands.begin() + contraction_a[i]);
+        operands.push_back(C);
+    }
+
+    if (!top_written)
+    {
+        const einsum_operand& X = operands[0];
+
+        std::string sum_labels;
+        for (size_t s = 0; s < X.labels.size(); s++)
+        {
+            if (rhs_token.find(X.labels[s]) == std::string::npos)
+                sum_labels.push_back(X.labels[s]);
+        }
+
+        permute_sum(X, sum_labels, rhs_token, top.strides, top_blob, label_sizes, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,448 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "embed_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __SSE4_1__
+#include <smmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE4_1__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+// columns gathered per word before interleaving into the packed output, 16 words of them fit in l1
+#define EMBED_CHUNK 256
+
+Embed_x86::Embed_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+    weight_data_type = 0;
+}
+
+int Embed_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (weight_quant_bits || int8_scale_term)
+    {
+        // the quantized table is gathered as it is, mapped model data is never touched beyond the looked up words
+        weight_data_type = weight_quant_bits == 4 ? 4 : 3;
+        return 0;
+    }
+#endif // NCNN_INT8
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        cast_float32_to_bfloat16(weight_data, weight_data_tm, opt);
+        if (weight_data_tm.empty())
+            return -100;
+
+        weight_data_type = 2;
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+#endif // NCNN_BF16
+
+#if __F16C__
+    if (cpu_support_x86_f16c() && opt.use_fp16_storage)
+    {
+        cast_float32_to_float16(weight_data, weight_data_tm, opt);
+        if (weight_data_tm.empty())
+            return -100;
+
+        weight_data_type = 1;
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+#endif // __F16C__
+
+    weight_data_type = 0;
+
+    return 0;
+}
+
+#if __SSE2__
+// the low and high nibbles interleaved back to column order, one uint4 per byte
+static NCNN_FORCEINLINE __m128i embed_unpack_uint4(__m128i _p)
+{
+    const __m128i _mask = _mm_set1_epi8(15);
+    __m128i _lo = _mm_and_si128(_p, _mask);
+    __m128i _hi = _mm_and_si128(_mm_srli_epi16(_p, 4), _mask);
+    return _mm_unpacklo_epi8(_lo, _hi);
+}
+#endif // __SSE2__
+
+void Embed_x86::embed_row(int word_index, int p0, int n, float* outptr) const
+{
+    if (weight_data_type == 0)
+    {
+        const float* ptr = (const float*)weight_data + (size_t)num_output * word_index + p0;
+
+        memcpy(outptr, ptr, n * sizeof(float));
+    }
+
+    if (weight_data_type == 1)
+    {
+        const unsigned short* ptr = (const unsigned short*)weight_data_tm + (size_t)num_output * word_index + p0;
+
+        int i = 0;
+#if __F16C__
+#if __AVX512F__
+        for (; i + 15 < n; i += 16)
+        {
+            _mm512_storeu_ps(outptr + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(ptr + i))));
+        }
+#endif // __AVX512F__
+        for (; i + 7 < n; i += 8)
+        {
+            _mm256_storeu_ps(outptr + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(ptr + i))));
+        }
+#endif // __F16C__
+        for (; i < n; i++)
+        {
+            outptr[i] = float16_to_float32(ptr[i]);
+        }
+    }
+
+    if (weight_data_type == 2)
+    {
+        const unsigned short* ptr = (const unsigned short*)weight_data_tm + (size_t)num_output * word_index + p0;
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        for (; i + 15 < n; i += 16)
+        {
+            _mm512_storeu_ps(outptr + i, bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)(ptr + i))));
+        }
+#endif // __AVX512F__
+        for (; i + 7 < n; i += 8)
+        {
+            _mm256_storeu_ps(outptr + i, bfloat2float_avx(_mm_loadu_si128((const __m128i*)(ptr + i))));
+        }
+#endif // __AVX__
+        for (; i + 3 < n; i += 4)
+        {
+            _mm_storeu_ps(outptr + i, bfloat2float_sse(_mm_loadl_epi64((const __m128i*)(ptr + i))));
+        }
+#endif // __SSE2__
+        for (; i < n; i++)
+        {
+            outptr[i] = bfloat16_to_float32(ptr[i]);
+        }
+    }
+
+#if NCNN_INT8
+    if (weight_data_type == 3)
+    {
+        const signed char* ptr = (const signed char*)weight_data + (size_t)num_output * word_index + p0;
+        const float scale = weight_quant_bits ? weight_quant_scales[word_index] : 1.f / weight_data_int8_scale;
+
+        int i = 0;
+#if __SSE4_1__
+#if __AVX2__
+#if __AVX512F__
+        __m512 _scale16 = _mm512_set1_ps(scale);
+        for (; i + 15 < n; i += 16)
+        {
+            __m512 _w = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)(ptr + i))));
+            _mm512_storeu_ps(outptr + i, _mm512_mul_ps(_w, _scale16));
+        }
+#endif // __AVX512F__
+        __m256 _scale8 = _mm256_set1_ps(scale);
+        for (; i + 7 < n; i += 8)
+        {
+            __m256 _w = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)(ptr + i))));
+            _mm256_storeu_ps(outptr + i, _mm256_mul_ps(_w, _scale8));
+        }
+#endif // __AVX2__
+        __m128 _scale4 = _mm_set1_ps(scale);
+        for (; i + 3 < n; i += 4)
+        {
+            __m128 _w = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(*(const int*)(ptr + i))));
+            _mm_storeu_ps(outptr + i, _mm_mul_ps(_w, _scale4));
+        }
+#endif // __SSE4_1__
+        for (; i < n; i++)
+        {
+            outptr[i] = ptr[i] * scale;
+        }
+    }
+
+    if (weight_data_type == 4)
+    {
+        const int num_groups = (num_output + weight_quant_group_size - 1) / weight_quant_group_size;
+
+        const unsigned char* ptr = weight_data.row<const unsigned char>(word_index);
+        const float* scales = (const float*)weight_quant_scales + num_groups * word_index;
+        const float* zeros = (const float*)weight_quant_zeros + num_groups * word_index;
+
+        // p0 and the group boundaries are multiples of 8, so every run starts on a byte
+        int i = 0;
+        while (i < n)
+        {
+            const int p = p0 + i;
+            const int g = p / weight_quant_group_size;
+            const int nn = std::min(n - i, (g + 1) * weight_quant_group_size - p);
+
+            const unsigned char* w = ptr + p / 2;
+            const float scale = scales[g];
+            const float zero = zeros[g];
+            float* out = outptr + i;
+
+            int k = 0;
+#if __SSE4_1__
+#if __AVX2__
+            __m256 _scale8 = _mm256_set1_ps(scale);
+            __m256 _zero8 = _mm256_set1_ps(zero);
+            for (; k + 7 < nn; k += 8)
+            {
+                __m128i _q = embed_unpack_uint4(_mm_cvtsi32_si128(*(const int*)(w + k / 2)));
+                __m256 _w = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_q));
+                _mm256_storeu_ps(out + k, _mm256_mul_ps(_mm256_sub_ps(_w, _zero8), _scale8));
+            }
+#endif // __AVX2__
+            __m128 _scale4 = _mm_set1_ps(scale);
+            __m128 _zero4 = _mm_set1_ps(zero);
+            for (; k + 3 < nn; k += 4)
+            {
+                __m128i _q = embed_unpack_uint4(_mm_cvtsi32_si128(*(const unsigned short*)(w + k / 2)));
+                __m128 _w = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_q));
+                _mm_storeu_ps(out + k, _mm_mul_ps(_mm_sub_ps(_w, _zero4), _scale4));
+            }
+#endif // __SSE4_1__
+            for (; k < nn; k++)
+            {
+                out[k] = (((w[k / 2] >> ((k % 2) * 4)) & 15) - zero) * scale;
+            }
+
+            i += nn;
+        }
+    }
+#endif // NCNN_INT8
+
+    if (bias_term)
+    {
+        const float* bias_ptr = (const float*)bias_data + p0;
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        for (; i + 15 < n; i += 16)
+        {
+            _mm512_storeu_ps(outptr + i, _mm512_add_ps(_mm512_loadu_ps(outptr + i), _mm512_loadu_ps(bias_ptr + i)));
+        }
+#endif // __AVX512F__
+        for (; i + 7 < n; i += 8)
+        {
+            _mm256_storeu_ps(outptr + i, _mm256_add_ps(_mm256_loadu_ps(outptr + i), _mm256_loadu_ps(bias_ptr + i)));
+        }
+#endif // __AVX__
+        for (; i + 3 < n; i += 4)
+        {
+            _mm_storeu_ps(outptr + i, _mm_add_ps(_mm_loadu_ps(outptr + i), _mm_loadu_ps(bias_ptr + i)));
+        }
+#endif // __SSE2__
+        for (; i < n; i++)
+        {
+            outptr[i] += bias_ptr[i];
+        }
+    }
+}
+
+#if __SSE2__
+// outptr[i * elempack + l] = ptr[l * stride + i]
+static void embed_interleave(const float* ptr, int stride, int elempack, int n, float* outptr)
+{
+    int i = 0;
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        for (; i + 15 < n; i += 16)
+        {
+            const float* p = ptr + i;
+            float* outp = outptr + i * 16;
+
+            __m512 _r0 = _mm512_loadu_ps(p);
+            __m512 _r1 = _mm512_loadu_ps(p + stride);
+            __m512 _r2 = _mm512_loadu_ps(p + stride * 2);
+            __m512 _r3 = _mm512_loadu_ps(p + stride * 3);
+            __m512 _r4 = _mm512_loadu_ps(p + stride * 4);
+            __m512 _r5 = _mm512_loadu_ps(p + stride * 5);
+            __m512 _r6 = _mm512_loadu_ps(p + stride * 6);
+            __m512 _r7 = _mm512_loadu_ps(p + stride * 7);
+            __m512 _r8 = _mm512_loadu_ps(p + stride * 8);
+            __m512 _r9 = _mm512_loadu_ps(p + stride * 9);
+            __m512 _ra = _mm512_loadu_ps(p + stride * 10);
+            __m512 _rb = _mm512_loadu_ps(p + stride * 11);
+            __m512 _rc = _mm512_loadu_ps(p + stride * 12);
+            __m512 _rd = _mm512_loadu_ps(p + stride * 13);
+            __m512 _re = _mm512_loadu_ps(p + stride * 14);
+            __m512 _rf = _mm512_loadu_ps(p + stride * 15);
+            transpose16x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
+            _mm512_storeu_ps(outp, _r0);
+            _mm512_storeu_ps(outp + 16, _r1);
+            _mm512_storeu_ps(outp + 16 * 2, _r2);
+            _mm512_storeu_ps(outp + 16 * 3, _r3);
+            _mm512_storeu_ps(outp + 16 * 4, _r4);
+            _mm512_storeu_ps(outp + 16 * 5, _r5);
+            _mm512_storeu_ps(outp + 16 * 6, _r6);
+            _mm512_storeu_ps(outp + 16 * 7, _r7);
+            _mm512_storeu_ps(outp + 16 * 8, _r8);
+            _mm512_storeu_ps(outp + 16 * 9, _r9);
+            _mm512_storeu_ps(outp + 16 * 10, _ra);
+            _mm512_storeu_ps(outp + 16 * 11, _rb);
+            _mm512_storeu_ps(outp + 16 * 12, _rc);
+            _mm512_storeu_ps(outp + 16 * 13, _rd);
+            _mm512_storeu_ps(outp + 16 * 14, _re);
+            _mm512_storeu_ps(outp + 16 * 15, _rf);
+        }
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        for (; i + 7 < n; i += 8)
+        {
+            const float* p = ptr + i;
+            float* outp = outptr + i * 8;
+
+            __m256 _r0 = _mm256_loadu_ps(p);
+            __m256 _r1 = _mm256_loadu_ps(p + stride);
+            __m256 _r2 = _mm256_loadu_ps(p + stride * 2);
+            __m256 _r3 = _mm256_loadu_ps(p + stride * 3);
+            __m256 _r4 = _mm256_loadu_ps(p + stride * 4);
+            __m256 _r5 = _mm256_loadu_ps(p + stride * 5);
+            __m256 _r6 = _mm256_loadu_ps(p + stride * 6);
+            __m256 _r7 = _mm256_loadu_ps(p + stride * 7);
+            transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
+            _mm256_storeu_ps(outp, _r0);
+            _mm256_storeu_ps(outp + 8, _r1);
+            _mm256_storeu_ps(outp + 8 * 2, _r2);
+            _mm256_storeu_ps(outp + 8 * 3, _r3);
+            _mm256_storeu_ps(outp + 8 * 4, _r4);
+            _mm256_storeu_ps(outp + 8 * 5, _r5);
+            _mm256_storeu_ps(outp + 8 * 6, _r6);
+            _mm256_storeu_ps(outp + 8 * 7, _r7);
+        }
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        for (; i + 3 < n; i += 4)
+        {
+            const float* p = ptr + i;
+            float* outp = outptr + i * 4;
+
+            __m128 _r0 = _mm_loadu_ps(p);
+            __m128 _r1 = _mm_loadu_ps(p + stride);
+            __m128 _r2 = _mm_loadu_ps(p + stride * 2);
+            __m128 _r3 = _mm_loadu_ps(p + stride * 3);
+            _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
+            _mm_storeu_ps(outp, _r0);
+            _mm_storeu_ps(outp + 4, _r1);
+            _mm_storeu_ps(outp + 4 * 2, _r2);
+            _mm_storeu_ps(outp + 4 * 3, _r3);
+        }
+    }
+    for (; i < n; i++)
+    {
+        for (int l = 0; l < elempack; l++)
+        {
+            outptr[i * elempack + l] = ptr[l * stride + i];
+        }
+    }
+}
+#endif // __SSE2__
+
+int Embed_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // a packed 1d blob keeps the word order
+    const int words = bottom_blob.w * bottom_blob.elempack;
+    const int* word_ptr = bottom_blob;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = words % 16 == 0 ? 16 : words % 8 == 0 ? 8 : words % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = words % 8 == 0 ? 8 : words % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = words % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    top_blob.create(num_output, words / out_elempack, 4u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (out_elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < words; q++)
+        {
+            const int word_index = std::min(std::max(word_ptr[q], 0), input_dim - 1);
+
+            embed_row(word_index, 0, num_output, top_blob.row(q));
+        }
+
+        return 0;
+    }
+
+#if __SSE2__
+    // gather a chunk of every word in the pack, then interleave them into the output
+    Mat rows(EMBED_CHUNK * out_elempack, 1, opt.num_threads, 4u, opt.workspace_allocator);
+    if (rows.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < top_blob.h; q++)
+    {
+        float* rowsptr = rows.channel(get_omp_thread_num());
+        float* outptr = top_blob.row(q);
+
+        for (int p0 = 0; p0 < num_output; p0 += EMBED_CHUNK)
+        {
+            const int n = std::min(EMBED_CHUNK, num_output - p0);
+
+            for (int l = 0; l < out_elempack; l++)
+            {
+                const int word_index = std::min(std::max(word_ptr[q * out_elempack + l], 0), input_dim - 1);
+
+                embed_row(word_index, p0, n, rowsptr + l * EMBED_CHUNK);
+            }
+
+            embed_interleave(rowsptr, EMBED_CHUNK, out_elempack, n, outptr + p0 * out_elempack);
+        }
+    }
+#endif // __SSE2__
+
+    return 0;
+}
+
+} // namespace ncnn
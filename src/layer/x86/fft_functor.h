@@ -0,0 +1,146 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// vector arithmetic of one fft lane group, see spectrogram_fft.h
+
+struct fft_op_pack1
+{
+    enum
+    {
+        lanes = 1
+    };
+    typedef float vec;
+
+    static NCNN_FORCEINLINE float set1(float v)
+    {
+        return v;
+    }
+    static NCNN_FORCEINLINE float load(const float* ptr)
+    {
+        return *ptr;
+    }
+    static NCNN_FORCEINLINE void store(float* ptr, float v)
+    {
+        *ptr = v;
+    }
+    static NCNN_FORCEINLINE float add(float x, float y)
+    {
+        return x + y;
+    }
+    static NCNN_FORCEINLINE float sub(float x, float y)
+    {
+        return x - y;
+    }
+    static NCNN_FORCEINLINE float mul(float x, float y)
+    {
+        return x * y;
+    }
+};
+
+#if __SSE2__
+struct fft_op_pack4
+{
+    enum
+    {
+        lanes = 4
+    };
+    typedef __m128 vec;
+
+    static NCNN_FORCEINLINE __m128 set1(float v)
+    {
+        return _mm_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE __m128 load(const float* ptr)
+    {
+        return _mm_loadu_ps(ptr);
+    }
+    static NCNN_FORCEINLINE void store(float* ptr, __m128 v)
+    {
+        _mm_storeu_ps(ptr, v);
+    }
+    static NCNN_FORCEINLINE __m128 add(__m128 x, __m128 y)
+    {
+        return _mm_add_ps(x, y);
+    }
+    static NCNN_FORCEINLINE __m128 sub(__m128 x, __m128 y)
+    {
+        return _mm_sub_ps(x, y);
+    }
+    static NCNN_FORCEINLINE __m128 mul(__m128 x, __m128 y)
+    {
+        return _mm_mul_ps(x, y);
+    }
+};
+
+#if __AVX__
+struct fft_op_pack8
+{
+    enum
+    {
+        lanes = 8
+    };
+    typedef __m256 vec;
+
+    static NCNN_FORCEINLINE __m256 set1(float v)
+    {
+        return _mm256_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE __m256 load(const float* ptr)
+    {
+        return _mm256_loadu_ps(ptr);
+    }
+    static NCNN_FORCEINLINE void store(float* ptr, __m256 v)
+    {
+        _mm256_storeu_ps(ptr, v);
+    }
+    static NCNN_FORCEINLINE __m256 add(__m256 x, __m256 y)
+    {
+        return _mm256_add_ps(x, y);
+    }
+    static NCNN_FORCEINLINE __m256 sub(__m256 x, __m256 y)
+    {
+        return _mm256_sub_ps(x, y);
+    }
+    static NCNN_FORCEINLINE __m256 mul(__m256 x, __m256 y)
+    {
+        return _mm256_mul_ps(x, y);
+    }
+};
+
+#if __AVX512F__
+struct fft_op_pack16
+{
+    enum
+    {
+        lanes = 16
+    };
+    typedef __m512 vec;
+
+    static NCNN_FORCEINLINE __m512 set1(float v)
+    {
+        return _mm512_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE __m512 load(const float* ptr)
+    {
+        return _mm512_loadu_ps(ptr);
+    }
+    static NCNN_FORCEINLINE void store(float* ptr, __m512 v)
+    {
+        _mm512_storeu_ps(ptr, v);
+    }
+    static NCNN_FORCEINLINE __m512 add(__m512 x, __m512 y)
+    {
+        return _mm512_add_ps(x, y);
+    }
+    static NCNN_FORCEINLINE __m512 sub(__m512 x, __m512 y)
+    {
+        return _mm512_sub_ps(x, y);
+    }
+    static NCNN_FORCEINLINE __m512 mul(__m512 x, __m512 y)
+    {
+        return _mm512_mul_ps(x, y);
+    }
+};
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
@@ -0,0 +1,295 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// weight-only quantized gemm, see weight_quant.h for the weight layout
+// the decode path with a single row dequantizes inside the dot product,
+// more rows share one dequantized weight row per output
+
+static inline float dot_int8_sse(const float* x, const signed char* w, int n)
+{
+    float sum = 0.f;
+
+    int k = 0;
+#if __SSE4_1__
+#if __AVX2__
+#if __AVX512F__
+    __m512 _sum16 = _mm512_setzero_ps();
+    for (; k + 15 < n; k += 16)
+    {
+        __m512 _w = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)(w + k))));
+        _sum16 = _mm512_fmadd_ps(_mm512_loadu_ps(x + k), _w, _sum16);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum16);
+#endif // __AVX512F__
+    __m256 _sum8 = _mm256_setzero_ps();
+    for (; k + 7 < n; k += 8)
+    {
+        __m256 _w = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)(w + k))));
+        _sum8 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x + k), _w, _sum8);
+    }
+    sum += _mm256_reduce_add_ps(_sum8);
+#endif // __AVX2__
+    __m128 _sum4 = _mm_setzero_ps();
+    for (; k + 3 < n; k += 4)
+    {
+        __m128 _w = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(*(const int*)(w + k))));
+        _sum4 = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k), _w, _sum4);
+    }
+    sum += _mm_reduce_add_ps(_sum4);
+#endif // __SSE4_1__
+    for (; k < n; k++)
+    {
+        sum += x[k] * w[k];
+    }
+
+    return sum;
+}
+
+#if __SSE2__
+// the low and high nibbles interleaved back to input order, one uint4 per byte
+static inline __m128i unpack_uint4_sse(__m128i _p)
+{
+    const __m128i _mask = _mm_set1_epi8(15);
+    __m128i _lo = _mm_and_si128(_p, _mask);
+    __m128i _hi = _mm_and_si128(_mm_srli_epi16(_p, 4), _mask);
+    return _mm_unpacklo_epi8(_lo, _hi);
+}
+#endif // __SSE2__
+
+// w points to the packed byte of x[0], which is an even input
+static inline float dot_uint4_sse(const float* x, const unsigned char* w, int n)
+{
+    float sum = 0.f;
+
+    int k = 0;
+#if __SSE4_1__
+#if __AVX2__
+#if __AVX512F__
+    __m512 _sum16 = _mm512_setzero_ps();
+    for (; k + 15 < n; k += 16)
+    {
+        __m128i _q = unpack_uint4_sse(_mm_loadl_epi64((const __m128i*)(w + k / 2)));
+        __m512 _w = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_q));
+        _sum16 = _mm512_fmadd_ps(_mm512_loadu_ps(x + k), _w, _sum16);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum16);
+#endif // __AVX512F__
+    __m256 _sum8 = _mm256_setzero_ps();
+    for (; k + 7 < n; k += 8)
+    {
+        __m128i _q = unpack_uint4_sse(_mm_cvtsi32_si128(*(const int*)(w + k / 2)));
+        __m256 _w = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_q));
+        _sum8 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x + k), _w, _sum8);
+    }
+    sum += _mm256_reduce_add_ps(_sum8);
+#endif // __AVX2__
+    __m128 _sum4 = _mm_setzero_ps();
+    for (; k + 3 < n; k += 4)
+    {
+        __m128i _q = unpack_uint4_sse(_mm_cvtsi32_si128(*(const unsigned short*)(w + k / 2)));
+        __m128 _w = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_q));
+        _sum4 = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k), _w, _sum4);
+    }
+    sum += _mm_reduce_add_ps(_sum4);
+#endif // __SSE4_1__
+    for (; k < n; k++)
+    {
+        sum += x[k] * ((w[k / 2] >> ((k % 2) * 4)) & 15);
+    }
+
+    return sum;
+}
+
+static inline float dot_sse(const float* x, const float* w, int n)
+{
+    float sum = 0.f;
+
+    int k = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _sum16 = _mm512_setzero_ps();
+    for (; k + 15 < n; k += 16)
+    {
+        _sum16 = _mm512_fmadd_ps(_mm512_loadu_ps(x + k), _mm512_loadu_ps(w + k), _sum16);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum16);
+#endif // __AVX512F__
+    __m256 _sum8 = _mm256_setzero_ps();
+    for (; k + 7 < n; k += 8)
+    {
+        _sum8 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x + k), _mm256_loadu_ps(w + k), _sum8);
+    }
+    sum += _mm256_reduce_add_ps(_sum8);
+#endif // __AVX__
+    __m128 _sum4 = _mm_setzero_ps();
+    for (; k + 3 < n; k += 4)
+    {
+        _sum4 = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k), _mm_loadu_ps(w + k), _sum4);
+    }
+    sum += _mm_reduce_add_ps(_sum4);
+#endif // __SSE2__
+    for (; k < n; k++)
+    {
+        sum += x[k] * w[k];
+    }
+
+    return sum;
+}
+
+static void dequantize_weight_row_sse(const Mat& weight_quant, const Mat& scales, const Mat& zeros, int p, int K, int weight_quant_bits, int group_size, float* outptr)
+{
+    if (weight_quant_bits == 8)
+    {
+        const signed char* w = weight_quant.row<const signed char>(p);
+        const float scale = scales[p];
+
+        int k = 0;
+#if __SSE4_1__
+#if __AVX2__
+        __m256 _scale8 = _mm256_set1_ps(scale);
+        for (; k + 7 < K; k += 8)
+        {
+            __m256 _w = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)(w + k))));
+            _mm256_storeu_ps(outptr + k, _mm256_mul_ps(_w, _scale8));
+        }
+#endif // __AVX2__
+        __m128 _scale4 = _mm_set1_ps(scale);
+        for (; k + 3 < K; k += 4)
+        {
+            __m128 _w = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(*(const int*)(w + k))));
+            _mm_storeu_ps(outptr + k, _mm_mul_ps(_w, _scale4));
+        }
+#endif // __SSE4_1__
+        for (; k < K; k++)
+        {
+            outptr[k] = w[k] * scale;
+        }
+
+        return;
+    }
+
+    const int num_groups = (K + group_size - 1) / group_size;
+
+    for (int g = 0; g < num_groups; g++)
+    {
+        const int k0 = g * group_size;
+        const int n = std::min(group_size, K - k0);
+
+        const unsigned char* w = weight_quant.row<const unsigned char>(p) + k0 / 2;
+        const float scale = scales[num_groups * p + g];
+        const float zero = zeros[num_groups * p + g];
+        float* ptr = outptr + k0;
+
+        int k = 0;
+#if __SSE4_1__
+#if __AVX2__
+        __m256 _scale8 = _mm256_set1_ps(scale);
+        __m256 _zero8 = _mm256_set1_ps(zero);
+        for (; k + 7 < n; k += 8)
+        {
+            __m128i _q = unpack_uint4_sse(_mm_cvtsi32_si128(*(const int*)(w + k / 2)));
+            __m256 _w = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_q));
+            _mm256_storeu_ps(ptr + k, _mm256_mul_ps(_mm256_sub_ps(_w, _zero8), _scale8));
+        }
+#endif // __AVX2__
+        __m128 _scale4 = _mm_set1_ps(scale);
+        __m128 _zero4 = _mm_set1_ps(zero);
+        for (; k + 3 < n; k += 4)
+        {
+            __m128i _q = unpack_uint4_sse(_mm_cvtsi32_si128(*(const unsigned short*)(w + k / 2)));
+            __m128 _w = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_q));
+            _mm_storeu_ps(ptr + k, _mm_mul_ps(_mm_sub_ps(_w, _zero4), _scale4));
+        }
+#endif // __SSE4_1__
+        for (; k < n; k++)
+        {
+            ptr[k] = (((w[k / 2] >> ((k % 2) * 4)) & 15) - zero) * scale;
+        }
+    }
+}
+
+// top_blob row i = A row i * dequantize(weight_quant)^T
+// A is M rows of K, top_blob is M rows of N, both fp32 without packing
+static int gemm_weight_quant_sse(const Mat& A, const Mat& weight_quant, const Mat& scales, const Mat& zeros, Mat& top_blob, int N, int K, int weight_quant_bits, int group_size, const Option& opt)
+{
+    const int M = A.h;
+
+    if (M == 1)
+    {
+        const float* x = A;
+        float* outptr = top_blob;
+
+        if (weight_quant_bits == 8)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int p = 0; p < N; p++)
+            {
+                outptr[p] = dot_int8_sse(x, weight_quant.row<const signed char>(p), K) * scales[p];
+            }
+
+            return 0;
+        }
+
+        const int num_groups = (K + group_size - 1) / group_size;
+
+        // sum((q - zero) * x) = sum(q * x) - zero * sum(x), sum(x) is shared by all outputs
+        Mat x_sums(num_groups, (size_t)4u, opt.workspace_allocator);
+        if (x_sums.empty())
+            return -100;
+
+        for (int g = 0; g < num_groups; g++)
+        {
+            const int k0 = g * group_size;
+            const int k1 = std::min(k0 + group_size, K);
+
+            float sum = 0.f;
+            for (int k = k0; k < k1; k++)
+            {
+                sum += x[k];
+            }
+            x_sums[g] = sum;
+        }
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < N; p++)
+        {
+            const unsigned char* w = weight_quant.row<const unsigned char>(p);
+            const float* scale = (const float*)scales + num_groups * p;
+            const float* zero = (const float*)zeros + num_groups * p;
+
+            float sum = 0.f;
+            for (int g = 0; g < num_groups; g++)
+            {
+                const int k0 = g * group_size;
+                const int n = std::min(group_size, K - k0);
+
+                sum += (dot_uint4_sse(x + k0, w + k0 / 2, n) - zero[g] * x_sums[g]) * scale[g];
+            }
+
+            outptr[p] = sum;
+        }
+
+        return 0;
+    }
+
+    // one dequantized weight row per thread
+    Mat weight_rows(K, opt.num_threads, (size_t)4u, opt.workspace_allocator);
+    if (weight_rows.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < N; p++)
+    {
+        float* w = weight_rows.row(get_omp_thread_num());
+
+        dequantize_weight_row_sse(weight_quant, scales, zeros, p, K, weight_quant_bits, group_size, w);
+
+        for (int i = 0; i < M; i++)
+        {
+            top_blob.row(i)[p] = dot_sse(A.row(i), w, K);
+        }
+    }
+
+    return 0;
+}
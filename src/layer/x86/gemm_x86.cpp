@@ -22,6 +22,7 @@ namespace ncnn {
 
 #if NCNN_INT8
 #include "gemm_int8.h"
+#include "gemm_weight_quant.h"
 #endif
 
 #if NCNN_BF16
@@ -38,6 +39,8 @@ Gemm_x86::Gemm_x86()
     support_bf16_storage = true;
 #endif // NCNN_BF16
 
+    support_batch = true;
+
     nT = 0;
 }
 
@@ -7440,6 +7443,17 @@ int Gemm_x86::create_pipeline(const Option& opt)
         support_bf16_storage = false;
         return create_pipeline_int8(opt);
     }
+
+    if (weight_quant_bits)
+    {
+        // B_data stays quantized, dequantized on the fly in forward
+        support_bf16_storage = false;
+
+        if (constantC && constant_broadcast_type_C != -1)
+            CT_data = C_data;
+
+        return 0;
+    }
 #endif
 
 #if NCNN_BF16
@@ -7588,12 +7602,51 @@ int Gemm_x86::create_pipeline(const Option& opt)
 
 int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    int batch = 1;
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        batch = std::max(batch, bottom_blobs[i].n);
+    }
+    if (batch > 1)
+    {
+        // fold the batch into the gemm rows
+        const int M = bottom_blobs[0].h * bottom_blobs[0].elempack;
+        const int rows = M * batch;
+
+        int elempack = 1;
+        int out_elempack = 1;
+#if __SSE2__
+        if (opt.use_packing_layout)
+        {
+#if __AVX512F__
+            elempack = rows % 16 == 0 ? 16 : rows % 8 == 0 ? 8 : rows % 4 == 0 ? 4 : 1;
+            out_elempack = M % 16 == 0 ? 16 : M % 8 == 0 ? 8 : M % 4 == 0 ? 4 : 1;
+#elif __AVX__
+            elempack = rows % 8 == 0 ? 8 : rows % 4 == 0 ? 4 : 1;
+            out_elempack = M % 8 == 0 ? 8 : M % 4 == 0 ? 4 : 1;
+#else
+            elempack = rows % 4 == 0 ? 4 : 1;
+            out_elempack = M % 4 == 0 ? 4 : 1;
+#endif
+        }
+#endif // __SSE2__
+        if (output_elempack)
+            out_elempack = output_elempack;
+
+        return forward_batch(bottom_blobs, top_blobs, elempack, out_elempack, opt);
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
         // return Gemm::forward_int8(bottom_blobs, top_blobs, opt);
         return forward_int8(bottom_blobs, top_blobs, opt);
     }
+
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant(bottom_blobs, top_blobs, opt);
+    }
 #endif
 
     const Mat& bottom_blob = bottom_blobs.empty() ? AT_data : bottom_blobs[0];
@@ -8797,6 +8850,176 @@ int Gemm_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat
 
     return ret;
 }
+
+int Gemm_x86::forward_weight_quant(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int N = constantN;
+    const int K = constantK;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    Mat A0 = bottom_blobs[0];
+    if (A0.elempack != 1)
+    {
+        convert_packing(bottom_blobs[0], A0, 1, opt_ws);
+        if (A0.empty())
+            return -100;
+    }
+
+    // A as M rows of K
+    Mat A;
+    if (transA == 0)
+    {
+        A = A0.dims == 3 ? A0.reshape(K, A0.c, opt.workspace_allocator) : A0;
+        if (A.empty())
+            return -100;
+    }
+    else
+    {
+        A.create(K, A0.w, (size_t)4u, opt.workspace_allocator);
+        if (A.empty())
+            return -100;
+
+        for (int i = 0; i < A.h; i++)
+        {
+            float* ptr = A.row(i);
+            for (int k = 0; k < K; k++)
+            {
+                ptr[k] = A0.dims == 3 ? A0.channel(k)[i] : A0.row(k)[i];
+            }
+        }
+    }
+
+    const int M = A.h;
+
+    Mat C;
+    int broadcast_type_C = 0;
+    if (constantC)
+    {
+        C = CT_data;
+        broadcast_type_C = constant_broadcast_type_C;
+    }
+    else
+    {
+        C = bottom_blobs.size() == 2 ? bottom_blobs[1] : Mat();
+
+        if (!C.empty())
+        {
+            if (C.elempack != 1)
+            {
+                convert_packing(bottom_blobs[1], C, 1, opt_ws);
+                if (C.empty())
+                    return -100;
+            }
+
+            if (C.dims == 1 && C.w == 1)
+            {
+                // scalar
+                broadcast_type_C = 0;
+            }
+            if (C.dims == 1 && C.w == M)
+            {
+                // M
+                // auto broadcast from h to w is the ncnn-style convention
+                broadcast_type_C = 1;
+            }
+            if (C.dims == 1 && C.w == N)
+            {
+                // N
+                broadcast_type_C = 4;
+            }
+            if (C.dims == 2 && C.w == 1 && C.h == M)
+            {
+                // Mx1
+                broadcast_type_C = 2;
+            }
+            if (C.dims == 2 && C.w == N && C.h == M)
+            {
+                // MxN
+                broadcast_type_C = 3;
+            }
+            if (C.dims == 2 && C.w == N && C.h == 1)
+            {
+                // 1xN
+                broadcast_type_C = 4;
+            }
+        }
+    }
+
+    Mat top_rows(N, M, (size_t)4u, opt.workspace_allocator);
+    if (top_rows.empty())
+        return -100;
+
+    int ret = gemm_weight_quant_sse(A, B_data, B_quant_scales, B_quant_zeros, top_rows, N, K, weight_quant_bits, weight_quant_group_size, opt);
+    if (ret != 0)
+        return ret;
+
+    Mat top_blob_unpacked;
+    if (output_transpose)
+    {
+        if (output_N1M)
+            top_blob_unpacked.create(M, 1, N, (size_t)4u, output_elempack > 1 ? opt.workspace_allocator : opt.blob_allocator);
+        else
+            top_blob_unpacked.create(M, N, (size_t)4u, output_elempack > 1 ? opt.workspace_allocator : opt.blob_allocator);
+    }
+    else
+    {
+        if (output_N1M)
+            top_blob_unpacked.create(N, 1, M, (size_t)4u, output_elempack > 1 ? opt.workspace_allocator : opt.blob_allocator);
+        else
+            top_blob_unpacked.create(N, M, (size_t)4u, output_elempack > 1 ? opt.workspace_allocator : opt.blob_allocator);
+    }
+    if (top_blob_unpacked.empty())
+        return -100;
+
+    const size_t out_hstep = top_blob_unpacked.dims == 3 ? top_blob_unpacked.cstep : (size_t)top_blob_unpacked.w;
+    const float* ptrC = C;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < M; i++)
+    {
+        const float* ptr = top_rows.row(i);
+
+        for (int j = 0; j < N; j++)
+        {
+            float sum = ptr[j];
+
+            if (ptrC)
+            {
+                float c = 0.f;
+                if (broadcast_type_C == 0)
+                    c = ptrC[0];
+                if (broadcast_type_C == 1 || broadcast_type_C == 2)
+                    c = ptrC[i];
+                if (broadcast_type_C == 3)
+                    c = ptrC[i * N + j];
+                if (broadcast_type_C == 4)
+                    c = ptrC[j];
+
+                sum += c * beta;
+            }
+
+            sum *= alpha;
+
+            if (output_transpose)
+                top_blob_unpacked[j * out_hstep + i] = sum;
+            else
+                top_blob_unpacked[i * out_hstep + j] = sum;
+        }
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob = top_blob_unpacked;
+    if (output_elempack > 1)
+    {
+        convert_packing(top_blob_unpacked, top_blob, output_elempack, opt);
+        if (top_blob.empty())
+            return -100;
+    }
+
+    return 0;
+}
 #endif
 
 namespace Gemm_x86_utility {
@@ -34,6 +34,10 @@ namespace ncnn {
 #include "innerproduct_gemm_bf16s.h"
 #endif
 
+#if NCNN_INT8
+#include "gemm_weight_quant.h"
+#endif
+
 InnerProduct_x86::InnerProduct_x86()
 {
 #if __SSE2__
@@ -44,6 +48,8 @@ InnerProduct_x86::InnerProduct_x86()
     support_bf16_storage = true;
 #endif
 
+    support_batch = true;
+
     flatten = 0;
 }
 
@@ -61,6 +67,12 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
     }
 
 #if NCNN_INT8
+    if (weight_quant_bits)
+    {
+        // weight_data stays quantized, dequantized on the fly in forward
+        return 0;
+    }
+
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
         return create_pipeline_int8_x86(opt);
@@ -105,7 +117,39 @@ int InnerProduct_x86::destroy_pipeline(const Option& opt)
 
 int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (bottom_blob.n > 1)
+    {
+        // fold the batch into the gemm rows
+        const int num_input = weight_data_size / num_output;
+        const int rows = (bottom_blob.dims == 2 && bottom_blob.w == num_input ? bottom_blob.h * bottom_blob.elempack : 1) * bottom_blob.n;
+
+        int elempack = 1;
+        int out_elempack = 1;
+#if __SSE2__
+        if (opt.use_packing_layout)
+        {
+#if __AVX512F__
+            elempack = rows % 16 == 0 ? 16 : rows % 8 == 0 ? 8 : rows % 4 == 0 ? 4 : 1;
+            out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+            elempack = rows % 8 == 0 ? 8 : rows % 4 == 0 ? 4 : 1;
+            out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+            elempack = rows % 4 == 0 ? 4 : 1;
+            out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+        }
+#endif // __SSE2__
+
+        return forward_batch(bottom_blob, top_blob, elempack, out_elempack, opt);
+    }
+
 #if NCNN_INT8
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant(bottom_blob, top_blob, opt);
+    }
+
     if (opt.use_int8_inference && int8_scale_term)
     {
 #if NCNN_BF16
@@ -862,6 +906,79 @@ int InnerProduct_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, co
 
     return 0;
 }
+
+int InnerProduct_x86::forward_weight_quant(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    Mat bottom_blob_fp32 = bottom_blob;
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_blob.elembits() == 16)
+    {
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_ws);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+#endif
+
+    const bool gemm = bottom_blob.dims == 2 && bottom_blob.w == num_input;
+
+    Mat bottom_blob_flattened = bottom_blob_fp32;
+    if (!gemm && bottom_blob_fp32.dims != 1)
+    {
+        flatten->forward(bottom_blob_fp32, bottom_blob_flattened, opt_ws);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    Mat A = bottom_blob_flattened;
+    if (A.elempack != 1)
+    {
+        convert_packing(bottom_blob_flattened, A, 1, opt_ws);
+        if (A.empty())
+            return -100;
+    }
+
+    // A as rows of num_input
+    if (!gemm)
+        A = A.reshape(num_input, 1);
+
+    const int h = A.h;
+
+    if (gemm)
+        top_blob.create(num_output, h, (size_t)4u, opt.blob_allocator);
+    else
+        top_blob.create(num_output, (size_t)4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    Mat top_rows = gemm ? top_blob : top_blob.reshape(num_output, 1);
+
+    int ret = gemm_weight_quant_sse(A, weight_data, weight_quant_scales, weight_quant_zeros, top_rows, num_output, num_input, weight_quant_bits, weight_quant_group_size, opt);
+    if (ret != 0)
+        return ret;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int j = 0; j < h; j++)
+    {
+        float* outptr = top_rows.row(j);
+
+        for (int p = 0; p < num_output; p++)
+        {
+            float sum = outptr[p];
+
+            if (bias_term)
+                sum += bias_data[p];
+
+            outptr[p] = activation_ss(sum, activation_type, activation_params);
+        }
+    }
+
+    return 0;
+}
 #endif // NCNN_INT8
 
 } // namespace ncnn
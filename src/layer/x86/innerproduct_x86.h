@@ -30,6 +30,7 @@ protected:
 #if NCNN_INT8
     int create_pipeline_int8_x86(const Option& opt);
     int forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+    int forward_weight_quant(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #endif
 
 public:
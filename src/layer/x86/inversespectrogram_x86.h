@@ -0,0 +1,26 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_INVERSESPECTROGRAM_X86_H
+#define LAYER_INVERSESPECTROGRAM_X86_H
+
+#include "inversespectrogram.h"
+
+namespace ncnn {
+
+class InverseSpectrogram_x86 : public InverseSpectrogram
+{
+public:
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    // fft plan for n_fft
+    std::vector<int> fft_radices;
+    Mat fft_twiddles;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_INVERSESPECTROGRAM_X86_H
@@ -0,0 +1,160 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling1d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include <float.h>
+
+namespace ncnn {
+
+#include "pooling_accumulate.h"
+
+Pooling1D_x86::Pooling1D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int Pooling1D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        top_blob.create(h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < h; q++)
+        {
+            const float* ptr = bottom_blob.row(q);
+            float* outptr = (float*)top_blob + q * elempack;
+
+            pooling_accumulate_init(outptr, elempack, pooling_type);
+            pooling_accumulate(ptr, w, elempack, pooling_type, outptr);
+
+            if (pooling_type == PoolMethod_AVE)
+                pooling_accumulate_scale(outptr, elempack, 1.f / w);
+        }
+
+        return 0;
+    }
+
+    if (adaptive_pooling)
+    {
+        top_blob.create(out_w, h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < h; q++)
+        {
+            const float* inptr = bottom_blob.row(q);
+            float* outptr = top_blob.row(q);
+
+            for (int j = 0; j < out_w; j++)
+            {
+                // floor div
+                const int iw0 = w * j / out_w;
+                // ceil div
+                const int iw1 = (w * (j + 1) + out_w - 1) / out_w;
+
+                pooling_accumulate_init(outptr, elempack, pooling_type);
+                pooling_accumulate(inptr + iw0 * elempack, iw1 - iw0, elempack, pooling_type, outptr);
+
+                if (pooling_type == PoolMethod_AVE)
+                    pooling_accumulate_scale(outptr, elempack, 1.f / (iw1 - iw0));
+
+                outptr += elempack;
+            }
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    // padding may pick another packing for the padded blob
+    if (bottom_blob_bordered.elempack != elempack)
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        Mat bottom_blob_padded = bottom_blob_bordered;
+        convert_packing(bottom_blob_padded, bottom_blob_bordered, elempack, opt_b);
+        if (bottom_blob_bordered.empty())
+            return -100;
+    }
+
+    w = bottom_blob_bordered.w;
+    h = bottom_blob_bordered.h;
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // the window of every output, padding is skipped unless counted
+    std::vector<int> sx0(outw);
+    std::vector<int> sx1(outw);
+    for (int j = 0; j < outw; j++)
+    {
+        sx0[j] = j * stride_w;
+        sx1[j] = sx0[j] + kernel_w;
+    }
+
+    if (pooling_type == PoolMethod_AVE && avgpool_count_include_pad == 0)
+    {
+        int wtailpad = 0;
+
+        if (pad_mode == 0) // full padding
+        {
+            wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+        }
+
+        for (int j = 0; j < outw; j++)
+        {
+            sx0[j] = std::max(sx0[j], pad_left);
+            sx1[j] = std::max(std::min(sx1[j], w - pad_right - wtailpad), sx0[j]);
+        }
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < h; q++)
+    {
+        const float* ptr = bottom_blob_bordered.row(q);
+        float* outptr = top_blob.row(q);
+
+        for (int j = 0; j < outw; j++)
+        {
+            pooling_accumulate_init(outptr, elempack, pooling_type);
+            pooling_accumulate(ptr + sx0[j] * elempack, sx1[j] - sx0[j], elempack, pooling_type, outptr);
+
+            if (pooling_type == PoolMethod_AVE)
+                pooling_accumulate_scale(outptr, elempack, 1.f / (sx1[j] - sx0[j]));
+
+            outptr += elempack;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
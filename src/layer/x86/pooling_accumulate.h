@@ -0,0 +1,148 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// shared by the packed Pooling1D, Pooling3D, SPP and StatisticsPooling kernels
+// a packed element is elempack lanes, every lane is reduced on its own
+// pooling_type 0 is max and 1 is sum
+
+static void pooling_accumulate_init(float* acc, int elempack, int pooling_type)
+{
+    const float v = pooling_type == 0 ? -FLT_MAX : 0.f;
+    for (int i = 0; i < elempack; i++)
+    {
+        acc[i] = v;
+    }
+}
+
+// acc = reduce(acc, ptr[0, n)) over n contiguous packed elements
+static void pooling_accumulate(const float* ptr, int n, int elempack, int pooling_type, float* acc)
+{
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        __m512 _acc = _mm512_loadu_ps(acc);
+        if (pooling_type == 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = _mm512_max_ps(_acc, _mm512_loadu_ps(ptr));
+                ptr += 16;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = _mm512_add_ps(_acc, _mm512_loadu_ps(ptr));
+                ptr += 16;
+            }
+        }
+        _mm512_storeu_ps(acc, _acc);
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        __m256 _acc = _mm256_loadu_ps(acc);
+        if (pooling_type == 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = _mm256_max_ps(_acc, _mm256_loadu_ps(ptr));
+                ptr += 8;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = _mm256_add_ps(_acc, _mm256_loadu_ps(ptr));
+                ptr += 8;
+            }
+        }
+        _mm256_storeu_ps(acc, _acc);
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        __m128 _acc = _mm_loadu_ps(acc);
+        if (pooling_type == 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = _mm_max_ps(_acc, _mm_loadu_ps(ptr));
+                ptr += 4;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+            {
+                _acc = _mm_add_ps(_acc, _mm_loadu_ps(ptr));
+                ptr += 4;
+            }
+        }
+        _mm_storeu_ps(acc, _acc);
+    }
+#endif // __SSE2__
+    if (elempack == 1)
+    {
+        float v = acc[0];
+
+        int i = 0;
+#if __SSE2__
+        if (n >= 8)
+        {
+            __m128 _acc0 = _mm_set1_ps(v);
+            __m128 _acc1 = pooling_type == 0 ? _acc0 : _mm_setzero_ps();
+            if (pooling_type == 0)
+            {
+                for (; i + 7 < n; i += 8)
+                {
+                    _acc0 = _mm_max_ps(_acc0, _mm_loadu_ps(ptr));
+                    _acc1 = _mm_max_ps(_acc1, _mm_loadu_ps(ptr + 4));
+                    ptr += 8;
+                }
+                v = _mm_reduce_max_ps(_mm_max_ps(_acc0, _acc1));
+            }
+            else
+            {
+                _acc0 = _mm_setzero_ps();
+                for (; i + 7 < n; i += 8)
+                {
+                    _acc0 = _mm_add_ps(_acc0, _mm_loadu_ps(ptr));
+                    _acc1 = _mm_add_ps(_acc1, _mm_loadu_ps(ptr + 4));
+                    ptr += 8;
+                }
+                v += _mm_reduce_add_ps(_mm_add_ps(_acc0, _acc1));
+            }
+        }
+#endif // __SSE2__
+        if (pooling_type == 0)
+        {
+            for (; i < n; i++)
+            {
+                v = std::max(v, *ptr++);
+            }
+        }
+        else
+        {
+            for (; i < n; i++)
+            {
+                v += *ptr++;
+            }
+        }
+
+        acc[0] = v;
+    }
+}
+
+// acc *= scale for every lane
+static void pooling_accumulate_scale(float* acc, int elempack, float scale)
+{
+    for (int i = 0; i < elempack; i++)
+    {
+        acc[i] *= scale;
+    }
+}
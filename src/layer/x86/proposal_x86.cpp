@@ -0,0 +1,234 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "proposal_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "topk_select.h"
+
+namespace ncnn {
+
+#include "detection_nms.h"
+
+Proposal_x86::Proposal_x86()
+{
+}
+
+// decode one row of shifted anchors and clip to image
+static void decode_proposal_row(const float* dxptr, const float* dyptr, const float* dwptr, const float* dhptr, float anchor_x, float anchor_y, float anchor_w, float anchor_h, float feat_stride, float im_w, float im_h, int w, float* x1ptr, float* y1ptr, float* x2ptr, float* y2ptr)
+{
+    const float cy = anchor_y + anchor_h * 0.5f;
+
+    int j = 0;
+#if __SSE2__
+#if __AVX__
+    {
+        const __m256 _anchor_x = _mm256_add_ps(_mm256_set1_ps(anchor_x), _mm256_mul_ps(_mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f), _mm256_set1_ps(feat_stride)));
+        const __m256 _anchor_w = _mm256_set1_ps(anchor_w);
+        const __m256 _anchor_h = _mm256_set1_ps(anchor_h);
+        const __m256 _half_anchor_w = _mm256_set1_ps(anchor_w * 0.5f);
+        const __m256 _cy = _mm256_set1_ps(cy);
+        const __m256 _half = _mm256_set1_ps(0.5f);
+        const __m256 _xmax = _mm256_set1_ps(im_w - 1);
+        const __m256 _ymax = _mm256_set1_ps(im_h - 1);
+        const __m256 _zero = _mm256_setzero_ps();
+        for (; j + 7 < w; j += 8)
+        {
+            __m256 _cx = _mm256_add_ps(_mm256_add_ps(_anchor_x, _mm256_set1_ps(j * feat_stride)), _half_anchor_w);
+
+            __m256 _pb_cx = _mm256_add_ps(_cx, _mm256_mul_ps(_anchor_w, _mm256_loadu_ps(dxptr + j)));
+            __m256 _pb_cy = _mm256_add_ps(_cy, _mm256_mul_ps(_anchor_h, _mm256_loadu_ps(dyptr + j)));
+            __m256 _pb_w = _mm256_mul_ps(_anchor_w, exp256_ps(_mm256_loadu_ps(dwptr + j)));
+            __m256 _pb_h = _mm256_mul_ps(_anchor_h, exp256_ps(_mm256_loadu_ps(dhptr + j)));
+
+            __m256 _x1 = _mm256_sub_ps(_pb_cx, _mm256_mul_ps(_pb_w, _half));
+            __m256 _y1 = _mm256_sub_ps(_pb_cy, _mm256_mul_ps(_pb_h, _half));
+            __m256 _x2 = _mm256_add_ps(_pb_cx, _mm256_mul_ps(_pb_w, _half));
+            __m256 _y2 = _mm256_add_ps(_pb_cy, _mm256_mul_ps(_pb_h, _half));
+
+            _mm256_storeu_ps(x1ptr + j, _mm256_max_ps(_mm256_min_ps(_x1, _xmax), _zero));
+            _mm256_storeu_ps(y1ptr + j, _mm256_max_ps(_mm256_min_ps(_y1, _ymax), _zero));
+            _mm256_storeu_ps(x2ptr + j, _mm256_max_ps(_mm256_min_ps(_x2, _xmax), _zero));
+            _mm256_storeu_ps(y2ptr + j, _mm256_max_ps(_mm256_min_ps(_y2, _ymax), _zero));
+        }
+    }
+#endif // __AVX__
+    {
+        const __m128 _anchor_x = _mm_add_ps(_mm_set1_ps(anchor_x), _mm_mul_ps(_mm_setr_ps(0.f, 1.f, 2.f, 3.f), _mm_set1_ps(feat_stride)));
+        const __m128 _anchor_w = _mm_set1_ps(anchor_w);
+        const __m128 _anchor_h = _mm_set1_ps(anchor_h);
+        const __m128 _half_anchor_w = _mm_set1_ps(anchor_w * 0.5f);
+        const __m128 _cy = _mm_set1_ps(cy);
+        const __m128 _half = _mm_set1_ps(0.5f);
+        const __m128 _xmax = _mm_set1_ps(im_w - 1);
+        const __m128 _ymax = _mm_set1_ps(im_h - 1);
+        const __m128 _zero = _mm_setzero_ps();
+        for (; j + 3 < w; j += 4)
+        {
+            __m128 _cx = _mm_add_ps(_mm_add_ps(_anchor_x, _mm_set1_ps(j * feat_stride)), _half_anchor_w);
+
+            __m128 _pb_cx = _mm_add_ps(_cx, _mm_mul_ps(_anchor_w, _mm_loadu_ps(dxptr + j)));
+            __m128 _pb_cy = _mm_add_ps(_cy, _mm_mul_ps(_anchor_h, _mm_loadu_ps(dyptr + j)));
+            __m128 _pb_w = _mm_mul_ps(_anchor_w, exp_ps(_mm_loadu_ps(dwptr + j)));
+            __m128 _pb_h = _mm_mul_ps(_anchor_h, exp_ps(_mm_loadu_ps(dhptr + j)));
+
+            __m128 _x1 = _mm_sub_ps(_pb_cx, _mm_mul_ps(_pb_w, _half));
+            __m128 _y1 = _mm_sub_ps(_pb_cy, _mm_mul_ps(_pb_h, _half));
+            __m128 _x2 = _mm_add_ps(_pb_cx, _mm_mul_ps(_pb_w, _half));
+            __m128 _y2 = _mm_add_ps(_pb_cy, _mm_mul_ps(_pb_h, _half));
+
+            _mm_storeu_ps(x1ptr + j, _mm_max_ps(_mm_min_ps(_x1, _xmax), _zero));
+            _mm_storeu_ps(y1ptr + j, _mm_max_ps(_mm_min_ps(_y1, _ymax), _zero));
+            _mm_storeu_ps(x2ptr + j, _mm_max_ps(_mm_min_ps(_x2, _xmax), _zero));
+            _mm_storeu_ps(y2ptr + j, _mm_max_ps(_mm_min_ps(_y2, _ymax), _zero));
+        }
+    }
+#endif // __SSE2__
+    for (; j < w; j++)
+    {
+        // apply center size
+        float cx = anchor_x + j * feat_stride + anchor_w * 0.5f;
+
+        float pb_cx = cx + anchor_w * dxptr[j];
+        float pb_cy = cy + anchor_h * dyptr[j];
+
+        float pb_w = anchor_w * expf(dwptr[j]);
+        float pb_h = anchor_h * expf(dhptr[j]);
+
+        // clip box
+        x1ptr[j] = std::max(std::min(pb_cx - pb_w * 0.5f, im_w - 1), 0.f);
+        y1ptr[j] = std::max(std::min(pb_cy - pb_h * 0.5f, im_h - 1), 0.f);
+        x2ptr[j] = std::max(std::min(pb_cx + pb_w * 0.5f, im_w - 1), 0.f);
+        y2ptr[j] = std::max(std::min(pb_cy + pb_h * 0.5f, im_h - 1), 0.f);
+    }
+}
+
+int Proposal_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& score_blob = bottom_blobs[0];
+    const Mat& bbox_blob = bottom_blobs[1];
+    const Mat& im_info_blob = bottom_blobs[2];
+
+    const int w = score_blob.w;
+    const int h = score_blob.h;
+    const int size = w * h;
+
+    // generate proposals from bbox deltas and shifted anchors, clipped to image
+    const int num_anchors = anchors.h;
+
+    const float im_w = im_info_blob[1];
+    const float im_h = im_info_blob[0];
+
+    BBoxSoA proposals;
+    proposals.resize(num_anchors * size);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_anchors; q++)
+    {
+        const float* anchor = anchors.row(q);
+
+        const float anchor_w = anchor[2] - anchor[0];
+        const float anchor_h = anchor[3] - anchor[1];
+
+        for (int i = 0; i < h; i++)
+        {
+            const int offset = q * size + i * w;
+
+            decode_proposal_row(bbox_blob.channel(q * 4).row(i), bbox_blob.channel(q * 4 + 1).row(i), bbox_blob.channel(q * 4 + 2).row(i), bbox_blob.channel(q * 4 + 3).row(i),
+                                anchor[0], anchor[1] + i * feat_stride, anchor_w, anchor_h, (float)feat_stride, im_w, im_h, w,
+                                &proposals.xmin[offset], &proposals.ymin[offset], &proposals.xmax[offset], &proposals.ymax[offset]);
+        }
+    }
+
+    // remove predicted boxes with either height or width < threshold
+    const float im_scale = im_info_blob[2];
+    const float min_boxsize = min_size * im_scale;
+
+    std::vector<int> candidates;
+    std::vector<float> scores;
+    for (int q = 0; q < num_anchors; q++)
+    {
+        const float* scoreptr = score_blob.channel(q + num_anchors);
+
+        for (int i = 0; i < size; i++)
+        {
+            const int z = q * size + i;
+
+            float pb_w = proposals.xmax[z] - proposals.xmin[z] + 1;
+            float pb_h = proposals.ymax[z] - proposals.ymin[z] + 1;
+
+            if (pb_w >= min_boxsize && pb_h >= min_boxsize)
+            {
+                candidates.push_back(z);
+                scores.push_back(scoreptr[i]);
+            }
+        }
+    }
+
+    // take top pre_nms_topN by score from highest to lowest
+    const int num_candidates = (int)candidates.size();
+    const int top_k = pre_nms_topN > 0 ? std::min(pre_nms_topN, num_candidates) : num_candidates;
+
+    std::vector<int> sorted(top_k);
+    const int num_sorted = topk_select(scores.data(), 0, num_candidates, top_k, sorted.data());
+
+    BBoxSoA sorted_proposals;
+    sorted_proposals.resize(num_sorted);
+    for (int i = 0; i < num_sorted; i++)
+    {
+        const int z = candidates[sorted[i]];
+        sorted_proposals.xmin[i] = proposals.xmin[z];
+        sorted_proposals.ymin[i] = proposals.ymin[z];
+        sorted_proposals.xmax[i] = proposals.xmax[z];
+        sorted_proposals.ymax[i] = proposals.ymax[z];
+        sorted_proposals.area[i] = (proposals.xmax[z] - proposals.xmin[z]) * (proposals.ymax[z] - proposals.ymin[z]);
+    }
+
+    // apply nms with nms_thresh and take after_nms_topN
+    std::vector<int> picked;
+    nms_sorted_bboxes_soa(sorted_proposals, num_sorted, nms_thresh, after_nms_topN, picked);
+
+    const int picked_count = (int)picked.size();
+
+    // return the top proposals
+    Mat& roi_blob = top_blobs[0];
+    roi_blob.create(4, 1, picked_count, 4u, opt.blob_allocator);
+    if (roi_blob.empty())
+        return -100;
+
+    for (int i = 0; i < picked_count; i++)
+    {
+        float* outptr = roi_blob.channel(i);
+
+        outptr[0] = sorted_proposals.xmin[picked[i]];
+        outptr[1] = sorted_proposals.ymin[picked[i]];
+        outptr[2] = sorted_proposals.xmax[picked[i]];
+        outptr[3] = sorted_proposals.ymax[picked[i]];
+    }
+
+    if (top_blobs.size() > 1)
+    {
+        Mat& roi_score_blob = top_blobs[1];
+        roi_score_blob.create(1, 1, picked_count, 4u, opt.blob_allocator);
+        if (roi_score_blob.empty())
+            return -100;
+
+        for (int i = 0; i < picked_count; i++)
+        {
+            float* outptr = roi_score_blob.channel(i);
+            outptr[0] = scores[sorted[picked[i]]];
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,828 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "reduction_x86.h"
+
+#include <float.h>
+#include <math.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+Reduction_x86::Reduction_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+namespace Reduction_x86_functor {
+
+struct reduction_op_add
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_mul
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x * y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_mul_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_mul_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_mul_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_asum
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + fabsf(y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, abs_ps(y));
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, abs256_ps(y));
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, abs512_ps(y));
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_sumsq
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y * y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_comp_fmadd_ps(y, y, x);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_comp_fmadd_ps(y, y, x);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_fmadd_ps(y, y, x);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_sumexp
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + expf(y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, exp_ps(y));
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, exp256_ps(y));
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, exp512_ps(y));
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_max
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::max(x, y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_max_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_max_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_max_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_min
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::min(x, y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_min_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_min_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_min_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+} // namespace Reduction_x86_functor
+
+// acc[i] = op(acc[i], ptr[i + j * stride]) over all rows j
+// columns are walked in 16 float blocks kept in registers so that every cache line is read once
+template<typename Op>
+static void reduction_vertical(float* acc, const float* ptr, int n, int rows, size_t stride)
+{
+    const Op op;
+
+    int i = 0;
+#if __SSE2__
+    for (; i + 15 < n; i += 16)
+    {
+        const float* p = ptr + i;
+#if __AVX512F__
+        __m512 _acc = _mm512_loadu_ps(acc + i);
+        for (int j = 0; j < rows; j++)
+        {
+            _acc = op.func_pack16(_acc, _mm512_loadu_ps(p));
+            p += stride;
+        }
+        _mm512_storeu_ps(acc + i, _acc);
+#elif __AVX__
+        __m256 _acc0 = _mm256_loadu_ps(acc + i);
+        __m256 _acc1 = _mm256_loadu_ps(acc + i + 8);
+        for (int j = 0; j < rows; j++)
+        {
+            _acc0 = op.func_pack8(_acc0, _mm256_loadu_ps(p));
+            _acc1 = op.func_pack8(_acc1, _mm256_loadu_ps(p + 8));
+            p += stride;
+        }
+        _mm256_storeu_ps(acc + i, _acc0);
+        _mm256_storeu_ps(acc + i + 8, _acc1);
+#else
+        __m128 _acc0 = _mm_loadu_ps(acc + i);
+        __m128 _acc1 = _mm_loadu_ps(acc + i + 4);
+        __m128 _acc2 = _mm_loadu_ps(acc + i + 8);
+        __m128 _acc3 = _mm_loadu_ps(acc + i + 12);
+        for (int j = 0; j < rows; j++)
+        {
+            _acc0 = op.func_pack4(_acc0, _mm_loadu_ps(p));
+            _acc1 = op.func_pack4(_acc1, _mm_loadu_ps(p + 4));
+            _acc2 = op.func_pack4(_acc2, _mm_loadu_ps(p + 8));
+            _acc3 = op.func_pack4(_acc3, _mm_loadu_ps(p + 12));
+            p += stride;
+        }
+        _mm_storeu_ps(acc + i, _acc0);
+        _mm_storeu_ps(acc + i + 4, _acc1);
+        _mm_storeu_ps(acc + i + 8, _acc2);
+        _mm_storeu_ps(acc + i + 12, _acc3);
+#endif
+    }
+    for (; i + 3 < n; i += 4)
+    {
+        const float* p = ptr + i;
+        __m128 _acc = _mm_loadu_ps(acc + i);
+        for (int j = 0; j < rows; j++)
+        {
+            _acc = op.func_pack4(_acc, _mm_loadu_ps(p));
+            p += stride;
+        }
+        _mm_storeu_ps(acc + i, _acc);
+    }
+#endif // __SSE2__
+    for (; i < n; i++)
+    {
+        const float* p = ptr + i;
+        float sum = acc[i];
+        for (int j = 0; j < rows; j++)
+        {
+            sum = op.func(sum, *p);
+            p += stride;
+        }
+        acc[i] = sum;
+    }
+}
+
+// reduce n contiguous floats to one, partial lanes are combined with op2
+template<typename Op, typename Op2>
+static float reduction_horizontal(float v0, const float* ptr, int n)
+{
+    const Op op;
+    const Op2 op2;
+
+    float sum = v0;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (n >= 16)
+    {
+        __m512 _sum = _mm512_set1_ps(v0);
+        for (; i + 15 < n; i += 16)
+        {
+            _sum = op.func_pack16(_sum, _mm512_loadu_ps(ptr + i));
+        }
+
+        float tmp[16];
+        _mm512_storeu_ps(tmp, _sum);
+        for (int k = 0; k < 16; k++)
+        {
+            sum = op2.func(sum, tmp[k]);
+        }
+    }
+#endif // __AVX512F__
+    if (i + 7 < n)
+    {
+        __m256 _sum = _mm256_set1_ps(v0);
+        for (; i + 7 < n; i += 8)
+        {
+            _sum = op.func_pack8(_sum, _mm256_loadu_ps(ptr + i));
+        }
+
+        float tmp[8];
+        _mm256_storeu_ps(tmp, _sum);
+        for (int k = 0; k < 8; k++)
+        {
+            sum = op2.func(sum, tmp[k]);
+        }
+    }
+#endif // __AVX__
+    if (i + 3 < n)
+    {
+        __m128 _sum = _mm_set1_ps(v0);
+        for (; i + 3 < n; i += 4)
+        {
+            _sum = op.func_pack4(_sum, _mm_loadu_ps(ptr + i));
+        }
+
+        float tmp[4];
+        _mm_storeu_ps(tmp, _sum);
+        for (int k = 0; k < 4; k++)
+        {
+            sum = op2.func(sum, tmp[k]);
+        }
+    }
+#endif // __SSE2__
+    for (; i < n; i++)
+    {
+        sum = op.func(sum, ptr[i]);
+    }
+
+    return sum;
+}
+
+struct reduction_axis
+{
+    int size;
+    size_t stride;
+    size_t out_stride;
+    bool reduced;
+};
+
+static float reduction_post(float v, int operation, float coeff)
+{
+    if (operation == Reduction::ReductionOp_LogSum || operation == Reduction::ReductionOp_LogSumExp)
+        v = logf(v);
+
+    if (operation == Reduction::ReductionOp_L2)
+    {
+        // flush subnormal input to zero as the reference does
+        v = sqrtf(v < FLT_MIN ? 0.f : v);
+    }
+
+    return v * coeff;
+}
+
+// every input offset visited by the reduced axes, outermost first
+static void reduction_offsets(const std::vector<reduction_axis>& axes, std::vector<size_t>& offsets)
+{
+    offsets.resize(1);
+    offsets[0] = 0;
+
+    for (size_t i = 0; i < axes.size(); i++)
+    {
+        const int size = axes[i].size;
+        const size_t stride = axes[i].stride;
+
+        std::vector<size_t> offsets2(offsets.size() * size);
+        for (size_t j = 0; j < offsets.size(); j++)
+        {
+            for (int k = 0; k < size; k++)
+            {
+                offsets2[j * size + k] = offsets[j] + k * stride;
+            }
+        }
+
+        offsets.swap(offsets2);
+    }
+}
+
+static void reduction_kept_offset(const std::vector<reduction_axis>& kept, int index, size_t& offset, size_t& out_offset)
+{
+    offset = 0;
+    out_offset = 0;
+    for (int j = (int)kept.size() - 1; j >= 0; j--)
+    {
+        const int k = index % kept[j].size;
+        index /= kept[j].size;
+
+        offset += k * kept[j].stride;
+        out_offset += k * kept[j].out_stride;
+    }
+}
+
+// axes are in memory order and already merged, the innermost one has stride 1
+template<typename Op, typename Op2>
+static int reduction_op(const float* ptr, float* outptr, std::vector<reduction_axis>& axes, int elempack, float v0, int operation, float coeff, const Option& opt)
+{
+    const Op2 op2;
+
+    // reducing the packed lanes of a kept contiguous axis accumulates the whole rows and folds the lanes at the end
+    const int naxes = (int)axes.size();
+    const bool fold_lanes = elempack > 1 && naxes >= 2 && axes[naxes - 1].reduced && axes[naxes - 1].size == elempack && !axes[naxes - 2].reduced && axes[naxes - 2].stride == (size_t)elempack;
+
+    if (fold_lanes || !axes[naxes - 1].reduced)
+    {
+        const int fold = fold_lanes ? elempack : 1;
+
+        const reduction_axis row = fold_lanes ? axes[naxes - 2] : axes[naxes - 1];
+        axes.resize(fold_lanes ? naxes - 2 : naxes - 1);
+
+        std::vector<reduction_axis> kept;
+        std::vector<reduction_axis> reduced;
+        for (size_t i = 0; i < axes.size(); i++)
+        {
+            if (axes[i].reduced)
+                reduced.push_back(axes[i]);
+            else
+                kept.push_back(axes[i]);
+        }
+
+        // the innermost reduced axis is walked inside the kernel
+        int rows = 1;
+        size_t row_stride = 0;
+        if (!reduced.empty())
+        {
+            rows = reduced.back().size;
+            row_stride = reduced.back().stride;
+            reduced.pop_back();
+        }
+
+        std::vector<size_t> offsets;
+        reduction_offsets(reduced, offsets);
+
+        int kept_count = 1;
+        for (size_t i = 0; i < kept.size(); i++)
+        {
+            kept_count *= kept[i].size;
+        }
+
+        // split the row when there are too few kept rows to feed all threads
+        const int outsize = row.size;
+        int nn_chunk = 1;
+        if (kept_count < opt.num_threads)
+        {
+            nn_chunk = std::min((opt.num_threads + kept_count - 1) / kept_count, (outsize * fold + 63) / 64);
+        }
+        int chunk = (outsize + nn_chunk - 1) / nn_chunk;
+        chunk = std::min((chunk + 15) / 16 * 16, outsize);
+        nn_chunk = (outsize + chunk - 1) / chunk;
+
+        Mat acc_buffer(chunk * fold, 1, opt.num_threads, 4u, opt.workspace_allocator);
+        if (acc_buffer.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int t = 0; t < kept_count * nn_chunk; t++)
+        {
+            const int ii = t % nn_chunk * chunk;
+            const int size = std::min(chunk, outsize - ii);
+
+            size_t offset;
+            size_t out_offset;
+            reduction_kept_offset(kept, t / nn_chunk, offset, out_offset);
+
+            const float* p = ptr + offset + ii * fold;
+            float* acc = acc_buffer.channel(get_omp_thread_num());
+
+            for (int i = 0; i < size * fold; i++)
+            {
+                acc[i] = v0;
+            }
+
+            for (size_t j = 0; j < offsets.size(); j++)
+            {
+                reduction_vertical<Op>(acc, p + offsets[j], size * fold, rows, row_stride);
+            }
+
+            float* outp = outptr + out_offset + ii * row.out_stride;
+            for (int i = 0; i < size; i++)
+            {
+                float sum = acc[i * fold];
+                for (int k = 1; k < fold; k++)
+                {
+                    sum = op2.func(sum, acc[i * fold + k]);
+                }
+
+                outp[i * row.out_stride] = reduction_post(sum, operation, coeff);
+            }
+        }
+
+        return 0;
+    }
+
+    // the innermost axis is reduced, sum up contiguous runs
+    const int n = axes[naxes - 1].size;
+    axes.resize(naxes - 1);
+
+    std::vector<reduction_axis> kept;
+    std::vector<reduction_axis> reduced;
+    for (size_t i = 0; i < axes.size(); i++)
+    {
+        if (axes[i].reduced)
+            reduced.push_back(axes[i]);
+        else
+            kept.push_back(axes[i]);
+    }
+
+    std::vector<size_t> offsets;
+    reduction_offsets(reduced, offsets);
+
+    int kept_count = 1;
+    for (size_t i = 0; i < kept.size(); i++)
+    {
+        kept_count *= kept[i].size;
+    }
+
+    // too few outputs to feed all threads, split the runs or the run itself into partial sums
+    const int noffsets = (int)offsets.size();
+    int nn_part = 1;
+    int part_n = n;
+    if (kept_count < opt.num_threads)
+    {
+        nn_part = (opt.num_threads + kept_count - 1) / kept_count;
+        if (noffsets == 1)
+        {
+            nn_part = std::min(nn_part, (n + 63) / 64);
+            part_n = (n + nn_part - 1) / nn_part;
+            part_n = std::min((part_n + 15) / 16 * 16, n);
+            nn_part = (n + part_n - 1) / part_n;
+        }
+        else
+        {
+            nn_part = std::min(nn_part, noffsets);
+        }
+    }
+
+    Mat partials(nn_part, kept_count, 4u, opt.workspace_allocator);
+    if (partials.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < kept_count * nn_part; t++)
+    {
+        const int part = t % nn_part;
+
+        size_t offset;
+        size_t out_offset;
+        reduction_kept_offset(kept, t / nn_part, offset, out_offset);
+
+        const float* p = ptr + offset;
+
+        float sum = v0;
+        if (noffsets == 1)
+        {
+            const int ii = part * part_n;
+            sum = reduction_horizontal<Op, Op2>(v0, p + offsets[0] + ii, std::min(part_n, n - ii));
+        }
+        else
+        {
+            const int j0 = (int)((long long)noffsets * part / nn_part);
+            const int j1 = (int)((long long)noffsets * (part + 1) / nn_part);
+            for (int j = j0; j < j1; j++)
+            {
+                sum = op2.func(sum, reduction_horizontal<Op, Op2>(v0, p + offsets[j], n));
+            }
+        }
+
+        partials.row(t / nn_part)[part] = sum;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < kept_count; i++)
+    {
+        size_t offset;
+        size_t out_offset;
+        reduction_kept_offset(kept, i, offset, out_offset);
+
+        const float* pp = partials.row(i);
+
+        float sum = pp[0];
+        for (int k = 1; k < nn_part; k++)
+        {
+            sum = op2.func(sum, pp[k]);
+        }
+
+        outptr[out_offset] = reduction_post(sum, operation, coeff);
+    }
+
+    return 0;
+}
+
+int Reduction_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    using namespace Reduction_x86_functor;
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    opt_b.use_bf16_storage = false;
+
+    bool use_bf16 = false;
+    Mat bottom_blob_fp32 = bottom_blob;
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_blob.elembits() == 16)
+    {
+        use_bf16 = true;
+
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_b);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+#endif
+
+    bool reduce_w, reduce_h, reduce_d, reduce_c;
+    int outdims, outw, outh, outd, outc;
+    resolve_reduce_flags_and_output_shape(bottom_blob_fp32, reduce_w, reduce_h, reduce_d, reduce_c, outdims, outw, outh, outd, outc);
+
+    const Mat& a = bottom_blob_fp32;
+    const int dims = a.dims;
+    const int elempack = a.elempack;
+
+    // the packed axis is c for 3d and 4d, h for 2d and w for 1d
+    const bool reduce_lanes = dims == 1 ? reduce_w : dims == 2 ? reduce_h : reduce_c;
+    const int out_elempack = reduce_lanes ? 1 : elempack;
+
+    Mat top_blob_fp32;
+    Allocator* out_allocator = use_bf16 ? opt.workspace_allocator : opt.blob_allocator;
+    if (outdims == 0)
+    {
+        top_blob_fp32.create(1, 4u, out_allocator);
+    }
+    if (outdims == 1)
+    {
+        top_blob_fp32.create(outw, 4u * out_elempack, out_elempack, out_allocator);
+    }
+    if (outdims == 2)
+    {
+        top_blob_fp32.create(outw, outh, 4u * out_elempack, out_elempack, out_allocator);
+    }
+    if (outdims == 3)
+    {
+        top_blob_fp32.create(outw, outh, outc, 4u * out_elempack, out_elempack, out_allocator);
+    }
+    if (outdims == 4)
+    {
+        top_blob_fp32.create(outw, outh, outd, outc, 4u * out_elempack, out_elempack, out_allocator);
+    }
+    if (top_blob_fp32.empty())
+        return -100;
+
+    // logical axes c d h w, strides of one packed group in floats
+    const int sizes[4] = {a.c, a.d, a.h, a.w};
+    const size_t strides[4] = {a.cstep * elempack, (size_t)a.w * a.h * elempack, (size_t)a.w * elempack, (size_t)elempack};
+    const bool reduce_flags[4] = {reduce_c, reduce_d, reduce_h, reduce_w};
+
+    const Mat& b = top_blob_fp32;
+    const size_t out_strides[4] = {b.cstep * out_elempack, (size_t)b.w * b.h * out_elempack, (size_t)b.w * out_elempack, (size_t)out_elempack};
+
+    static const int axes_1d[1] = {3};
+    static const int axes_2d[2] = {2, 3};
+    static const int axes_3d[3] = {0, 2, 3};
+    static const int axes_4d[4] = {0, 1, 2, 3};
+    static const int* const dims_axes[5] = {0, axes_1d, axes_2d, axes_3d, axes_4d};
+
+    std::vector<reduction_axis> axes;
+    int scale = 1;
+    int out_axis = 0;
+    for (int i = 0; i < dims; i++)
+    {
+        const int q = dims_axes[dims][i];
+
+        reduction_axis axis;
+        axis.size = sizes[q];
+        axis.stride = strides[q];
+        axis.out_stride = 0;
+        axis.reduced = reduce_flags[q];
+
+        if (axis.reduced)
+        {
+            scale *= i == 0 ? sizes[q] * elempack : sizes[q];
+        }
+        else
+        {
+            // dropped axes shift the kept ones toward the innermost output axes
+            const int out_q = keepdims ? q : dims_axes[outdims][out_axis];
+            axis.out_stride = out_strides[out_q];
+            out_axis++;
+        }
+
+        if (axis.size > 1)
+            axes.push_back(axis);
+    }
+
+    if (elempack > 1)
+    {
+        reduction_axis axis;
+        axis.size = elempack;
+        axis.stride = 1;
+        axis.out_stride = reduce_lanes ? 0 : 1;
+        axis.reduced = reduce_lanes;
+        axes.push_back(axis);
+    }
+
+    // merge neighbouring axes that are contiguous in both input and output
+    {
+        int m = 0;
+        for (int i = 1; i < (int)axes.size(); i++)
+        {
+            reduction_axis& outer = axes[m];
+            const reduction_axis& inner = axes[i];
+            if (outer.reduced == inner.reduced && outer.stride == inner.stride * inner.size && (outer.reduced || outer.out_stride == inner.out_stride * inner.size))
+            {
+                outer.size *= inner.size;
+                outer.stride = inner.stride;
+                outer.out_stride = inner.out_stride;
+            }
+            else
+            {
+                m++;
+                axes[m] = inner;
+            }
+        }
+
+        if (!axes.empty())
+            axes.resize(m + 1);
+    }
+
+    if (axes.empty() || axes.back().stride != 1)
+    {
+        reduction_axis axis;
+        axis.size = 1;
+        axis.stride = 1;
+        axis.out_stride = 1;
+        axis.reduced = axes.empty() || axes.back().reduced;
+        axes.push_back(axis);
+    }
+
+    float coeff2 = coeff;
+    if (operation == ReductionOp_MEAN)
+        coeff2 = coeff / scale;
+
+    const float* ptr = a;
+    float* outptr = top_blob_fp32;
+
+    int ret = 0;
+    switch (operation)
+    {
+    case ReductionOp_SUM:
+    case ReductionOp_MEAN:
+    case ReductionOp_LogSum:
+        ret = reduction_op<reduction_op_add, reduction_op_add>(ptr, outptr, axes, elempack, 0.f, operation, coeff2, opt);
+        break;
+    case ReductionOp_ASUM:
+    case ReductionOp_L1:
+        ret = reduction_op<reduction_op_asum, reduction_op_add>(ptr, outptr, axes, elempack, 0.f, operation, coeff2, opt);
+        break;
+    case ReductionOp_SUMSQ:
+    case ReductionOp_L2:
+        ret = reduction_op<reduction_op_sumsq, reduction_op_add>(ptr, outptr, axes, elempack, 0.f, operation, coeff2, opt);
+        break;
+    case ReductionOp_MAX:
+        ret = reduction_op<reduction_op_max, reduction_op_max>(ptr, outptr, axes, elempack, -FLT_MAX, operation, coeff2, opt);
+        break;
+    case ReductionOp_MIN:
+        ret = reduction_op<reduction_op_min, reduction_op_min>(ptr, outptr, axes, elempack, FLT_MAX, operation, coeff2, opt);
+        break;
+    case ReductionOp_PROD:
+        ret = reduction_op<reduction_op_mul, reduction_op_mul>(ptr, outptr, axes, elempack, 1.f, operation, coeff2, opt);
+        break;
+    case ReductionOp_LogSumExp:
+        ret = reduction_op<reduction_op_sumexp, reduction_op_add>(ptr, outptr, axes, elempack, 0.f, operation, coeff2, opt);
+        break;
+    default:
+        // should never reach here
+        break;
+    }
+    if (ret != 0)
+        return ret;
+
+#if NCNN_BF16
+    if (use_bf16)
+    {
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+#endif
+
+    top_blob = top_blob_fp32;
+
+    return 0;
+}
+
+} // namespace ncnn
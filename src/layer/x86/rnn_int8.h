@@ -0,0 +1,300 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+void rnn_int8_avx512vnni(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+void rnn_int8_avxvnni(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+void rnn_int8_avx2(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_XOP && __SSE2__ && !__XOP__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+void rnn_int8_xop(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+static float rnn_dynamic_quantize_get_absmax(const float* ptr, int size)
+{
+    float absmax = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _absmax_avx512 = _mm512_set1_ps(0.f);
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = _mm512_loadu_ps(ptr);
+        _absmax_avx512 = _mm512_max_ps(_absmax_avx512, abs512_ps(_p));
+        ptr += 16;
+    }
+    absmax = std::max(absmax, _mm512_comp_reduce_max_ps(_absmax_avx512));
+#endif // __AVX512F__
+    __m256 _absmax_avx = _mm256_set1_ps(0.f);
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = _mm256_loadu_ps(ptr);
+        _absmax_avx = _mm256_max_ps(_absmax_avx, abs256_ps(_p));
+        ptr += 8;
+    }
+    absmax = std::max(absmax, _mm256_reduce_max_ps(_absmax_avx));
+#endif // __AVX__
+    __m128 _absmax = _mm_set1_ps(0.f);
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        _absmax = _mm_max_ps(_absmax, abs_ps(_p));
+        ptr += 4;
+    }
+    absmax = std::max(absmax, _mm_reduce_max_ps(_absmax));
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(*ptr));
+        ptr++;
+    }
+
+    return absmax;
+}
+
+static void rnn_dynamic_quantize_scale2int8(const float* ptr, int size, float scale, signed char* outptr)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _scale_avx512 = _mm512_set1_ps(scale);
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = _mm512_loadu_ps(ptr);
+        _p = _mm512_mul_ps(_p, _scale_avx512);
+        _mm_storeu_si128((__m128i*)outptr, float2int8_avx512(_p));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    __m256 _scale_avx = _mm256_set1_ps(scale);
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = _mm256_loadu_ps(ptr);
+        _p = _mm256_mul_ps(_p, _scale_avx);
+        *(int64_t*)outptr = float2int8_avx(_p);
+        ptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+    __m128 _scale = _mm_set1_ps(scale);
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        _p = _mm_mul_ps(_p, _scale);
+        *(int32_t*)outptr = float2int8_sse(_p);
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr++ = float2int8(*ptr++ * scale);
+    }
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128i rnn_int8_load_epi16(const signed char* ptr)
+{
+    __m128i _v = _mm_loadl_epi64((const __m128i*)ptr);
+#if __SSE4_1__
+    return _mm_cvtepi8_epi16(_v);
+#else
+    return _mm_srai_epi16(_mm_unpacklo_epi8(_v, _v), 8);
+#endif
+}
+#endif // __SSE2__
+
+static int rnn_int8_dot(const signed char* x, const signed char* w, int n)
+{
+    int sum = 0;
+
+    int i = 0;
+#if __SSE2__
+    __m128i _sum0 = _mm_setzero_si128();
+    __m128i _sum1 = _mm_setzero_si128();
+#if __AVX2__
+    __m256i _sum0_avx = _mm256_setzero_si256();
+    __m256i _sum1_avx = _mm256_setzero_si256();
+#if __AVX512F__
+    __m512i _sum0_avx512 = _mm512_setzero_si512();
+    __m512i _sum1_avx512 = _mm512_setzero_si512();
+    for (; i + 63 < n; i += 64)
+    {
+        __m512i _x0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(x + i)));
+        __m512i _x1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(x + i + 32)));
+        __m512i _w0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(w + i)));
+        __m512i _w1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(w + i + 32)));
+        _sum0_avx512 = _mm512_comp_dpwssd_epi32(_sum0_avx512, _x0, _w0);
+        _sum1_avx512 = _mm512_comp_dpwssd_epi32(_sum1_avx512, _x1, _w1);
+    }
+    _sum0_avx512 = _mm512_add_epi32(_sum0_avx512, _sum1_avx512);
+    _sum0_avx = _mm256_add_epi32(_mm512_castsi512_si256(_sum0_avx512), _mm512_extracti64x4_epi64(_sum0_avx512, 1));
+#endif // __AVX512F__
+    for (; i + 31 < n; i += 32)
+    {
+        __m256i _x0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(x + i)));
+        __m256i _x1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(x + i + 16)));
+        __m256i _w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(w + i)));
+        __m256i _w1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(w + i + 16)));
+        _sum0_avx = _mm256_comp_dpwssd_epi32(_sum0_avx, _x0, _w0);
+        _sum1_avx = _mm256_comp_dpwssd_epi32(_sum1_avx, _x1, _w1);
+    }
+    _sum0_avx = _mm256_add_epi32(_sum0_avx, _sum1_avx);
+    _sum0 = _mm_add_epi32(_mm256_castsi256_si128(_sum0_avx), _mm256_extracti128_si256(_sum0_avx, 1));
+#endif // __AVX2__
+    for (; i + 15 < n; i += 16)
+    {
+        __m128i _x0 = rnn_int8_load_epi16(x + i);
+        __m128i _x1 = rnn_int8_load_epi16(x + i + 8);
+        __m128i _w0 = rnn_int8_load_epi16(w + i);
+        __m128i _w1 = rnn_int8_load_epi16(w + i + 8);
+        _sum0 = _mm_comp_dpwssd_epi32(_sum0, _x0, _w0);
+        _sum1 = _mm_comp_dpwssd_epi32(_sum1, _x1, _w1);
+    }
+    for (; i + 7 < n; i += 8)
+    {
+        __m128i _x0 = rnn_int8_load_epi16(x + i);
+        __m128i _w0 = rnn_int8_load_epi16(w + i);
+        _sum0 = _mm_comp_dpwssd_epi32(_sum0, _x0, _w0);
+    }
+    sum = _mm_reduce_add_epi32(_mm_add_epi32(_sum0, _sum1));
+#endif // __SSE2__
+    for (; i < n; i++)
+    {
+        sum += w[i] * x[i];
+    }
+
+    return sum;
+}
+
+static void rnn_int8(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        rnn_int8_avx512vnni(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx_vnni())
+    {
+        rnn_int8_avxvnni(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        rnn_int8_avx2(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_XOP && __SSE2__ && !__XOP__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_xop())
+    {
+        rnn_int8_xop(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+    int size = bottom_blob_int8.w;
+    int T = bottom_blob_int8.h;
+
+    int num_output = top_blob.w;
+
+    // num_output
+    Mat gates(num_output, 4u, opt.workspace_allocator);
+
+    Mat hidden_state_int8(num_output, (size_t)1u, 1, opt.workspace_allocator);
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        // dynamic quantize hidden_state
+        float hidden_state_int8_descale = 0.f;
+        {
+            const float* ptr = hidden_state;
+
+            const float absmax = rnn_dynamic_quantize_get_absmax(ptr, num_output);
+
+            if (absmax == 0.f)
+            {
+                hidden_state_int8.fill<signed char>(0);
+            }
+            else
+            {
+                hidden_state_int8_descale = absmax / 127.f;
+
+                rnn_dynamic_quantize_scale2int8(ptr, num_output, 127.f / absmax, hidden_state_int8);
+            }
+        }
+
+        const signed char* x = bottom_blob_int8.row<const signed char>(ti);
+        const signed char* hs = hidden_state_int8;
+        const float descale_x = bottom_blob_int8_descales[ti];
+        const float descale_h = hidden_state_int8_descale;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < num_output; q++)
+        {
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+
+            const int Hx = rnn_int8_dot(x, kptr, size);
+            const int Hh = rnn_int8_dot(hs, kptr + size, num_output);
+
+            gates[q] = Hx * (descale_x * descales_ptr[0]) + Hh * (descale_h * descales_ptr[1]);
+        }
+
+        // tanh(H)
+        float* output_data = top_blob.row(ti);
+        float* hidden_ptr = hidden_state;
+        const float* bias_c_ptr = bias_c;
+
+        int q = 0;
+#if __SSE2__
+#if __AVX__
+        for (; q + 7 < num_output; q += 8)
+        {
+            __m256 _H = _mm256_add_ps(_mm256_loadu_ps((const float*)gates + q), _mm256_loadu_ps(bias_c_ptr + q));
+            _H = tanh_avx(_H);
+
+            _mm256_storeu_ps(hidden_ptr + q, _H);
+            _mm256_storeu_ps(output_data + q, _H);
+        }
+#endif // __AVX__
+        for (; q + 3 < num_output; q += 4)
+        {
+            __m128 _H = _mm_add_ps(_mm_loadu_ps((const float*)gates + q), _mm_loadu_ps(bias_c_ptr + q));
+            _H = tanh_sse(_H);
+
+            _mm_storeu_ps(hidden_ptr + q, _H);
+            _mm_storeu_ps(output_data + q, _H);
+        }
+#endif // __SSE2__
+        for (; q < num_output; q++)
+        {
+            float H = tanhf(gates[q] + bias_c_ptr[q]);
+
+            hidden_ptr[q] = H;
+            output_data[q] = H;
+        }
+    }
+}
@@ -0,0 +1,584 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rnn_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+#include "rnn_int8.h"
+
+RNN_x86::RNN_x86()
+{
+    one_blob_only = false;
+    support_inplace = false;
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int RNN_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return create_pipeline_int8(opt);
+    }
+#endif
+
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output;
+
+#if __SSE2__
+    weight_xc_data_packed.create(size * 4, num_output / 4 + num_output % 4, num_directions);
+    weight_hc_data_packed.create(num_output * 4, num_output / 4 + num_output % 4, num_directions);
+#else
+    weight_xc_data_packed.create(size, num_output, num_directions);
+    weight_hc_data_packed.create(num_output, num_output, num_directions);
+#endif
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc = weight_xc_data.channel(dr);
+        const Mat weight_hc = weight_hc_data.channel(dr);
+
+        Mat weight_xc_data_packed_dr = weight_xc_data_packed.channel(dr);
+        Mat weight_hc_data_packed_dr = weight_hc_data_packed.channel(dr);
+
+        int q = 0;
+#if __SSE2__
+        for (; q + 3 < num_output; q += 4)
+        {
+            float* weight_xc_ptr = weight_xc_data_packed_dr.row(q / 4);
+            float* weight_hc_ptr = weight_hc_data_packed_dr.row(q / 4);
+
+            // W0 W1 W2 W3 per input
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    weight_xc_ptr[j] = weight_xc.row(q + j)[i];
+                }
+
+                weight_xc_ptr += 4;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    weight_hc_ptr[j] = weight_hc.row(q + j)[i];
+                }
+
+                weight_hc_ptr += 4;
+            }
+        }
+#endif // __SSE2__
+        for (; q < num_output; q++)
+        {
+#if __SSE2__
+            float* weight_xc_ptr = weight_xc_data_packed_dr.row(q / 4 + q % 4);
+            float* weight_hc_ptr = weight_hc_data_packed_dr.row(q / 4 + q % 4);
+#else
+            float* weight_xc_ptr = weight_xc_data_packed_dr.row(q);
+            float* weight_hc_ptr = weight_hc_data_packed_dr.row(q);
+#endif // __SSE2__
+
+            memcpy(weight_xc_ptr, weight_xc.row(q), size * sizeof(float));
+            memcpy(weight_hc_ptr, weight_hc.row(q), num_output * sizeof(float));
+        }
+    }
+
+    bias_c_data_packed = bias_c_data;
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        return create_pipeline_bf16s(opt);
+    }
+#endif
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+static NCNN_FORCEINLINE float rnn_load_weight(const float* ptr)
+{
+    return *ptr;
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128 rnn_load_weight_ps(const float* ptr)
+{
+    return _mm_loadu_ps(ptr);
+}
+
+#if __AVX__
+static NCNN_FORCEINLINE __m256 rnn_load_weight_ps256(const float* ptr)
+{
+    return _mm256_loadu_ps(ptr);
+}
+#endif // __AVX__
+#endif // __SSE2__
+
+#if NCNN_BF16
+static NCNN_FORCEINLINE float rnn_load_weight(const unsigned short* ptr)
+{
+    return bfloat16_to_float32(*ptr);
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128 rnn_load_weight_ps(const unsigned short* ptr)
+{
+    return bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr));
+}
+
+#if __AVX__
+static NCNN_FORCEINLINE __m256 rnn_load_weight_ps256(const unsigned short* ptr)
+{
+    return bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr));
+}
+#endif // __AVX__
+#endif // __SSE2__
+#endif // NCNN_BF16
+
+#if __SSE2__
+// accumulate 4 hidden units, weights in W0 W1 W2 W3 order
+template<typename WT>
+static __m128 rnn_gemv_pack4(const float* x, const WT*& kptr, int n, __m128 _H)
+{
+    int i = 0;
+#if __AVX__
+    // two inputs per lane half
+    __m256 _sum0 = _mm256_setzero_ps();
+    __m256 _sum1 = _mm256_setzero_ps();
+    for (; i + 3 < n; i += 4)
+    {
+        __m256 _x01 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(x[i])), _mm_set1_ps(x[i + 1]), 1);
+        __m256 _x23 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(x[i + 2])), _mm_set1_ps(x[i + 3]), 1);
+        _sum0 = _mm256_comp_fmadd_ps(rnn_load_weight_ps256(kptr), _x01, _sum0);
+        _sum1 = _mm256_comp_fmadd_ps(rnn_load_weight_ps256(kptr + 8), _x23, _sum1);
+
+        kptr += 16;
+    }
+
+    _sum0 = _mm256_add_ps(_sum0, _sum1);
+    _H = _mm_add_ps(_H, _mm_add_ps(_mm256_castps256_ps128(_sum0), _mm256_extractf128_ps(_sum0, 1)));
+#else  // __AVX__
+    __m128 _sum1 = _mm_setzero_ps();
+    __m128 _sum2 = _mm_setzero_ps();
+    __m128 _sum3 = _mm_setzero_ps();
+    for (; i + 3 < n; i += 4)
+    {
+        _H = _mm_comp_fmadd_ps(rnn_load_weight_ps(kptr), _mm_set1_ps(x[i]), _H);
+        _sum1 = _mm_comp_fmadd_ps(rnn_load_weight_ps(kptr + 4), _mm_set1_ps(x[i + 1]), _sum1);
+        _sum2 = _mm_comp_fmadd_ps(rnn_load_weight_ps(kptr + 8), _mm_set1_ps(x[i + 2]), _sum2);
+        _sum3 = _mm_comp_fmadd_ps(rnn_load_weight_ps(kptr + 12), _mm_set1_ps(x[i + 3]), _sum3);
+
+        kptr += 16;
+    }
+
+    _H = _mm_add_ps(_mm_add_ps(_H, _sum1), _mm_add_ps(_sum2, _sum3));
+#endif // __AVX__
+    for (; i < n; i++)
+    {
+        _H = _mm_comp_fmadd_ps(rnn_load_weight_ps(kptr), _mm_set1_ps(x[i]), _H);
+
+        kptr += 4;
+    }
+
+    return _H;
+}
+#endif // __SSE2__
+
+template<typename WT>
+static int rnn(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_xc, const Mat& bias_c, const Mat& weight_hc, Mat& hidden_state, const Option& opt)
+{
+    int size = bottom_blob.w;
+    int T = bottom_blob.h;
+
+    int num_output = top_blob.w;
+
+    // num_output
+    Mat gates(num_output, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        const float* x = bottom_blob.row(ti);
+        const float* hs = hidden_state;
+
+        int remain_num_output_start = 0;
+#if __SSE2__
+        int nn_num_output = num_output >> 2;
+        remain_num_output_start = nn_num_output << 2;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            int q = qq * 4;
+
+            const WT* weight_xc_ptr = weight_xc.row<const WT>(q / 4);
+            const WT* weight_hc_ptr = weight_hc.row<const WT>(q / 4);
+
+            __m128 _H = _mm_loadu_ps((const float*)bias_c + q);
+            _H = rnn_gemv_pack4(x, weight_xc_ptr, size, _H);
+            _H = rnn_gemv_pack4(hs, weight_hc_ptr, num_output, _H);
+
+            _H = tanh_sse(_H);
+
+            _mm_storeu_ps((float*)gates + q, _H);
+        }
+#endif // __SSE2__
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = remain_num_output_start; q < num_output; q++)
+        {
+#if __SSE2__
+            const WT* weight_xc_ptr = weight_xc.row<const WT>(q / 4 + q % 4);
+            const WT* weight_hc_ptr = weight_hc.row<const WT>(q / 4 + q % 4);
+#else
+            const WT* weight_xc_ptr = weight_xc.row<const WT>(q);
+            const WT* weight_hc_ptr = weight_hc.row<const WT>(q);
+#endif // __SSE2__
+
+            float H = bias_c[q];
+
+            for (int i = 0; i < size; i++)
+            {
+                H += rnn_load_weight(weight_xc_ptr + i) * x[i];
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                H += rnn_load_weight(weight_hc_ptr + i) * hs[i];
+            }
+
+            H = tanhf(H);
+
+            gates[q] = H;
+        }
+
+        float* output_data = top_blob.row(ti);
+        float* hidden_ptr = hidden_state;
+
+        memcpy(hidden_ptr, gates, num_output * sizeof(float));
+        memcpy(output_data, gates, num_output * sizeof(float));
+    }
+
+    return 0;
+}
+
+#if NCNN_INT8
+static void rnn_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt)
+{
+    // one row per hidden unit
+    // weight_xc + weight_hc
+    weight_data_tm.create(size + num_output, num_output, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(2, num_output, num_directions);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat weight_data_tm_int8_descales_dr = weight_data_tm_int8_descales.channel(dr);
+
+        for (int q = 0; q < num_output; q++)
+        {
+            signed char* kptr = weight_data_tm_dr.row<signed char>(q);
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(q);
+
+            memcpy(kptr, weight_xc_dr.row<const signed char>(q), size);
+            memcpy(kptr + size, weight_hc_dr.row<const signed char>(q), num_output);
+
+            descales_ptr[0] = 1.f / weight_xc_int8_scales_ptr[q];
+            descales_ptr[1] = 1.f / weight_hc_int8_scales_ptr[q];
+        }
+    }
+
+    bias_c_tm = bias_c;
+}
+
+static void rnn_dynamic_quantize(const Mat& bottom_blob, Mat& bottom_blob_int8, Mat& bottom_blob_int8_descales, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    bottom_blob_int8.create(size, T, (size_t)1u, 1, opt.workspace_allocator);
+    bottom_blob_int8_descales.create(T, (size_t)4u, 1, opt.workspace_allocator);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < T; t++)
+    {
+        const float* ptr = bottom_blob.row(t);
+        signed char* outptr = bottom_blob_int8.row<signed char>(t);
+
+        const float absmax = rnn_dynamic_quantize_get_absmax(ptr, size);
+
+        if (absmax == 0.f)
+        {
+            bottom_blob_int8_descales[t] = 0.f;
+            memset(outptr, 0, size);
+        }
+        else
+        {
+            bottom_blob_int8_descales[t] = absmax / 127.f;
+            rnn_dynamic_quantize_scale2int8(ptr, size, 127.f / absmax, outptr);
+        }
+    }
+}
+#endif // NCNN_INT8
+
+int RNN_x86::forward_direction(const Mat& bottom_blob, const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, int dr, Mat& hidden_state, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        rnn_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm.channel(dr), weight_data_tm_int8_descales.channel(dr), bias_c_data_packed.channel(dr), hidden_state, opt);
+        return 0;
+    }
+#else
+    (void)bottom_blob_int8;
+    (void)bottom_blob_int8_descales;
+#endif
+
+#if NCNN_BF16
+    if (weight_xc_data_packed.elemsize == 2u)
+    {
+        return rnn<unsigned short>(bottom_blob, top_blob, reverse, weight_xc_data_packed.channel(dr), bias_c_data_packed.channel(dr), weight_hc_data_packed.channel(dr), hidden_state, opt);
+    }
+#endif
+
+    return rnn<float>(bottom_blob, top_blob, reverse, weight_xc_data_packed.channel(dr), bias_c_data_packed.channel(dr), weight_hc_data_packed.channel(dr), hidden_state, opt);
+}
+
+int RNN_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    std::vector<Mat> bottom_blobs(1, bottom_blob);
+    std::vector<Mat> top_blobs(1, top_blob);
+    int ret = forward(bottom_blobs, top_blobs, opt);
+    top_blob = top_blobs[0];
+    return ret;
+}
+
+int RNN_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    // the recurrence always runs in fp32, bf16 storage is cast at the boundary
+    bool use_bf16 = false;
+#if NCNN_BF16
+    use_bf16 = opt.use_bf16_storage && bottom_blob.elembits() == 16;
+#endif
+
+    Mat bottom_blob_fp32 = bottom_blob;
+#if NCNN_BF16
+    if (use_bf16)
+    {
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_ws);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+#endif
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 && !use_bf16 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+#if NCNN_BF16
+        if (use_bf16)
+        {
+            Option opt_cast = opt;
+            opt_cast.blob_allocator = hidden_allocator;
+            cast_bfloat16_to_float32(bottom_blobs[1], hidden, opt_cast);
+        }
+        else
+#endif
+        {
+            hidden = bottom_blobs[1].clone(hidden_allocator);
+        }
+        if (hidden.empty())
+            return -100;
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    // dynamic quantize bottom_blob
+    Mat bottom_blob_int8;
+    Mat bottom_blob_int8_descales;
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        rnn_dynamic_quantize(bottom_blob_fp32, bottom_blob_int8, bottom_blob_int8_descales, opt_ws);
+        if (bottom_blob_int8.empty() || bottom_blob_int8_descales.empty())
+            return -100;
+    }
+#endif
+
+    Mat top_blob_fp32;
+    top_blob_fp32.create(num_output * num_directions, T, 4u, use_bf16 ? opt.workspace_allocator : opt.blob_allocator);
+    if (top_blob_fp32.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = forward_direction(bottom_blob_fp32, bottom_blob_int8, bottom_blob_int8_descales, top_blob_fp32, direction, 0, hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        Mat hidden0 = hidden.row_range(0, 1);
+        {
+            int ret = forward_direction(bottom_blob_fp32, bottom_blob_int8, bottom_blob_int8_descales, top_blob_forward, 0, 0, hidden0, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        Mat hidden1 = hidden.row_range(1, 1);
+        {
+            int ret = forward_direction(bottom_blob_fp32, bottom_blob_int8, bottom_blob_int8_descales, top_blob_reverse, 1, 1, hidden1, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob_fp32.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+#if NCNN_BF16
+    if (use_bf16)
+    {
+        cast_float32_to_bfloat16(top_blob_fp32, top_blobs[0], opt);
+        if (top_blobs[0].empty())
+            return -100;
+
+        if (top_blobs.size() == 2)
+        {
+            cast_float32_to_bfloat16(hidden, top_blobs[1], opt);
+            if (top_blobs[1].empty())
+                return -100;
+        }
+
+        return 0;
+    }
+#endif
+
+    top_blobs[0] = top_blob_fp32;
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+#if NCNN_BF16
+int RNN_x86::create_pipeline_bf16s(const Option& opt)
+{
+    // the packed weights are stored in bf16 and widened on load
+    Mat weight_xc_data_packed_bf16;
+    cast_float32_to_bfloat16(weight_xc_data_packed, weight_xc_data_packed_bf16, opt);
+    if (weight_xc_data_packed_bf16.empty())
+        return -100;
+
+    Mat weight_hc_data_packed_bf16;
+    cast_float32_to_bfloat16(weight_hc_data_packed, weight_hc_data_packed_bf16, opt);
+    if (weight_hc_data_packed_bf16.empty())
+        return -100;
+
+    weight_xc_data_packed = weight_xc_data_packed_bf16;
+    weight_hc_data_packed = weight_hc_data_packed_bf16;
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+#endif // NCNN_BF16
+
+#if NCNN_INT8
+int RNN_x86::create_pipeline_int8(const Option& opt)
+{
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output;
+
+    rnn_transform_weight_int8(weight_xc_data, weight_xc_data_int8_scales, weight_hc_data, weight_hc_data_int8_scales, bias_c_data, weight_data_tm, weight_data_tm_int8_descales, bias_c_data_packed, size, num_output, num_directions, opt);
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        weight_hc_data.release();
+        weight_xc_data_int8_scales.release();
+        weight_hc_data_int8_scales.release();
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
+} // namespace ncnn
@@ -3,10 +3,986 @@
 
 #include "sdpa_x86.h"
 
+#include <float.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include "cpu.h"
 #include "layer_type.h"
 
 namespace ncnn {
 
+static NCNN_FORCEINLINE float sdpa_load(const float* p)
+{
+    return p[0];
+}
+
+static NCNN_FORCEINLINE float sdpa_load(const unsigned short* p)
+{
+    return bfloat16_to_float32(p[0]);
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128 sdpa_load_sse(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+
+static NCNN_FORCEINLINE __m128 sdpa_load_sse(const unsigned short* p)
+{
+    return bfloat2float_sse(_mm_loadl_epi64((const __m128i*)p));
+}
+
+#if __AVX__
+static NCNN_FORCEINLINE __m256 sdpa_load_avx(const float* p)
+{
+    return _mm256_loadu_ps(p);
+}
+
+static NCNN_FORCEINLINE __m256 sdpa_load_avx(const unsigned short* p)
+{
+    return bfloat2float_avx(_mm_loadu_si128((const __m128i*)p));
+}
+
+#if __AVX512F__
+static NCNN_FORCEINLINE __m512 sdpa_load_avx512(const float* p)
+{
+    return _mm512_loadu_ps(p);
+}
+
+static NCNN_FORCEINLINE __m512 sdpa_load_avx512(const unsigned short* p)
+{
+    return bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)p));
+}
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+template<typename T>
+static float sdpa_dot(const float* q0, const T* kptr, int size)
+{
+    float sum = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _sum_avx512 = _mm512_setzero_ps();
+    for (; i + 15 < size; i += 16)
+    {
+        _sum_avx512 = _mm512_fmadd_ps(_mm512_loadu_ps(q0 + i), sdpa_load_avx512(kptr + i), _sum_avx512);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum_avx512);
+#endif // __AVX512F__
+    __m256 _sum_avx = _mm256_setzero_ps();
+    for (; i + 7 < size; i += 8)
+    {
+        _sum_avx = _mm256_comp_fmadd_ps(_mm256_loadu_ps(q0 + i), sdpa_load_avx(kptr + i), _sum_avx);
+    }
+    sum += _mm256_reduce_add_ps(_sum_avx);
+#endif // __AVX__
+    __m128 _sum = _mm_setzero_ps();
+    for (; i + 3 < size; i += 4)
+    {
+        _sum = _mm_comp_fmadd_ps(_mm_loadu_ps(q0 + i), sdpa_load_sse(kptr + i), _sum);
+    }
+    sum += _mm_reduce_add_ps(_sum);
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        sum += q0[i] * sdpa_load(kptr + i);
+    }
+
+    return sum;
+}
+
+template<typename T>
+static void sdpa_axpy(float* outptr, float p, const T* vptr, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _p_avx512 = _mm512_set1_ps(p);
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr + i, _mm512_fmadd_ps(_p_avx512, sdpa_load_avx512(vptr + i), _mm512_loadu_ps(outptr + i)));
+    }
+#endif // __AVX512F__
+    __m256 _p_avx = _mm256_set1_ps(p);
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr + i, _mm256_comp_fmadd_ps(_p_avx, sdpa_load_avx(vptr + i), _mm256_loadu_ps(outptr + i)));
+    }
+#endif // __AVX__
+    __m128 _p = _mm_set1_ps(p);
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr + i, _mm_comp_fmadd_ps(_p, sdpa_load_sse(vptr + i), _mm_loadu_ps(outptr + i)));
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        outptr[i] += p * sdpa_load(vptr + i);
+    }
+}
+
+static void sdpa_mul(float* ptr, float s, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _s_avx512 = _mm512_set1_ps(s);
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(ptr + i, _mm512_mul_ps(_mm512_loadu_ps(ptr + i), _s_avx512));
+    }
+#endif // __AVX512F__
+    __m256 _s_avx = _mm256_set1_ps(s);
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(ptr + i, _mm256_mul_ps(_mm256_loadu_ps(ptr + i), _s_avx));
+    }
+#endif // __AVX__
+    __m128 _s = _mm_set1_ps(s);
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(ptr + i, _mm_mul_ps(_mm_loadu_ps(ptr + i), _s));
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        ptr[i] *= s;
+    }
+}
+
+// ptr = exp(ptr - max), return sum
+static float sdpa_exp_sub_sum(float* ptr, float max, int size)
+{
+    float sum = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _max_avx512 = _mm512_set1_ps(max);
+    __m512 _sum_avx512 = _mm512_setzero_ps();
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = exp512_ps(_mm512_sub_ps(_mm512_loadu_ps(ptr + i), _max_avx512));
+        _mm512_storeu_ps(ptr + i, _p);
+        _sum_avx512 = _mm512_add_ps(_sum_avx512, _p);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum_avx512);
+#endif // __AVX512F__
+    __m256 _max_avx = _mm256_set1_ps(max);
+    __m256 _sum_avx = _mm256_setzero_ps();
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(ptr + i), _max_avx));
+        _mm256_storeu_ps(ptr + i, _p);
+        _sum_avx = _mm256_add_ps(_sum_avx, _p);
+    }
+    sum += _mm256_reduce_add_ps(_sum_avx);
+#endif // __AVX__
+    __m128 _max = _mm_set1_ps(max);
+    __m128 _sum = _mm_setzero_ps();
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = exp_ps(_mm_sub_ps(_mm_loadu_ps(ptr + i), _max));
+        _mm_storeu_ps(ptr + i, _p);
+        _sum = _mm_add_ps(_sum, _p);
+    }
+    sum += _mm_reduce_add_ps(_sum);
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        ptr[i] = expf(ptr[i] - max);
+        sum += ptr[i];
+    }
+
+    return sum;
+}
+
+// sptr += mask[i][j0 .. j0 + max_jj]
+static void sdpa_add_mask(float* sptr, const Mat& maskm, int i, int j0, int max_jj)
+{
+    if (maskm.elembits() == 16)
+    {
+        const unsigned short* mptr = maskm.row<const unsigned short>(i) + j0;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            sptr[jj] += bfloat16_to_float32(mptr[jj]);
+        }
+    }
+    else
+    {
+        const float* mptr = maskm.row(i) + j0;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            sptr[jj] += mptr[jj];
+        }
+    }
+}
+
+// turn scores into exp(s - max), update running max and sum, rescale the output row when max grows
+static void sdpa_online_softmax(float* sptr, int max_jj, float& running_max, float& running_sum, float* outptr, int out_embed_dim)
+{
+    float max = running_max;
+    for (int jj = 0; jj < max_jj; jj++)
+    {
+        max = std::max(max, sptr[jj]);
+    }
+
+    if (max > running_max)
+    {
+        const float correction = expf(running_max - max);
+        running_sum *= correction;
+        sdpa_mul(outptr, correction, out_embed_dim);
+        running_max = max;
+    }
+
+    running_sum += sdpa_exp_sub_sum(sptr, max, max_jj);
+}
+
+// S^T[jj][ii] += mask[i0 + ii][j0 + jj]
+static void sdpa_add_mask_transposed(float* sptr, int M, const Mat& maskm, int i0, int max_ii, int j0, int max_jj)
+{
+    for (int ii = 0; ii < max_ii; ii++)
+    {
+        if (maskm.elembits() == 16)
+        {
+            const unsigned short* mptr = maskm.row<const unsigned short>(i0 + ii) + j0;
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                sptr[jj * M + ii] += bfloat16_to_float32(mptr[jj]);
+            }
+        }
+        else
+        {
+            const float* mptr = maskm.row(i0 + ii) + j0;
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                sptr[jj * M + ii] += mptr[jj];
+            }
+        }
+    }
+}
+
+// online softmax down the columns of S^T[max_jj][M], scores become exp(s - max)
+// running max and sum are updated per query and the rescale factor for the previous output goes to corrptr
+static void sdpa_online_softmax_transposed(float* sptr, int M, int max_jj, float* maxptr, float* sumptr, float* corrptr)
+{
+    int ii = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; ii + 15 < M; ii += 16)
+    {
+        __m512 _max0 = _mm512_loadu_ps(maxptr + ii);
+        __m512 _max = _max0;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            _max = _mm512_max_ps(_max, _mm512_loadu_ps(sptr + jj * M + ii));
+        }
+
+        __m512 _corr = exp512_ps(_mm512_sub_ps(_max0, _max));
+        __m512 _sum = _mm512_mul_ps(_mm512_loadu_ps(sumptr + ii), _corr);
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m512 _p = exp512_ps(_mm512_sub_ps(_mm512_loadu_ps(sptr + jj * M + ii), _max));
+            _mm512_storeu_ps(sptr + jj * M + ii, _p);
+            _sum = _mm512_add_ps(_sum, _p);
+        }
+
+        _mm512_storeu_ps(maxptr + ii, _max);
+        _mm512_storeu_ps(sumptr + ii, _sum);
+        _mm512_storeu_ps(corrptr + ii, _corr);
+    }
+#endif // __AVX512F__
+    for (; ii + 7 < M; ii += 8)
+    {
+        __m256 _max0 = _mm256_loadu_ps(maxptr + ii);
+        __m256 _max = _max0;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            _max = _mm256_max_ps(_max, _mm256_loadu_ps(sptr + jj * M + ii));
+        }
+
+        __m256 _corr = exp256_ps(_mm256_sub_ps(_max0, _max));
+        __m256 _sum = _mm256_mul_ps(_mm256_loadu_ps(sumptr + ii), _corr);
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m256 _p = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(sptr + jj * M + ii), _max));
+            _mm256_storeu_ps(sptr + jj * M + ii, _p);
+            _sum = _mm256_add_ps(_sum, _p);
+        }
+
+        _mm256_storeu_ps(maxptr + ii, _max);
+        _mm256_storeu_ps(sumptr + ii, _sum);
+        _mm256_storeu_ps(corrptr + ii, _corr);
+    }
+#endif // __AVX__
+    for (; ii + 3 < M; ii += 4)
+    {
+        __m128 _max0 = _mm_loadu_ps(maxptr + ii);
+        __m128 _max = _max0;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            _max = _mm_max_ps(_max, _mm_loadu_ps(sptr + jj * M + ii));
+        }
+
+        __m128 _corr = exp_ps(_mm_sub_ps(_max0, _max));
+        __m128 _sum = _mm_mul_ps(_mm_loadu_ps(sumptr + ii), _corr);
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m128 _p = exp_ps(_mm_sub_ps(_mm_loadu_ps(sptr + jj * M + ii), _max));
+            _mm_storeu_ps(sptr + jj * M + ii, _p);
+            _sum = _mm_add_ps(_sum, _p);
+        }
+
+        _mm_storeu_ps(maxptr + ii, _max);
+        _mm_storeu_ps(sumptr + ii, _sum);
+        _mm_storeu_ps(corrptr + ii, _corr);
+    }
+#endif // __SSE2__
+    for (; ii < M; ii++)
+    {
+        float max = maxptr[ii];
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            max = std::max(max, sptr[jj * M + ii]);
+        }
+
+        const float corr = expf(maxptr[ii] - max);
+        float sum = sumptr[ii] * corr;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            float p = expf(sptr[jj * M + ii] - max);
+            sptr[jj * M + ii] = p;
+            sum += p;
+        }
+
+        maxptr[ii] = max;
+        sumptr[ii] = sum;
+        corrptr[ii] = corr;
+    }
+}
+
+// S^T[4][M] (+)= K[4][K] * Q^T[K][M], four key rows against a tile of transposed query
+static void sdpa_qk_tile_4(const float* kptr, int kstride, int K, const float* qtptr, float* sptr, int M, bool accumulate)
+{
+    const float* k0 = kptr;
+    const float* k1 = kptr + kstride;
+    const float* k2 = kptr + kstride * 2;
+    const float* k3 = kptr + kstride * 3;
+
+    int ii = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; ii + 31 < M; ii += 32)
+    {
+        __m512 _s00 = accumulate ? _mm512_loadu_ps(sptr + ii) : _mm512_setzero_ps();
+        __m512 _s01 = accumulate ? _mm512_loadu_ps(sptr + ii + 16) : _mm512_setzero_ps();
+        __m512 _s10 = accumulate ? _mm512_loadu_ps(sptr + M + ii) : _mm512_setzero_ps();
+        __m512 _s11 = accumulate ? _mm512_loadu_ps(sptr + M + ii + 16) : _mm512_setzero_ps();
+        __m512 _s20 = accumulate ? _mm512_loadu_ps(sptr + M * 2 + ii) : _mm512_setzero_ps();
+        __m512 _s21 = accumulate ? _mm512_loadu_ps(sptr + M * 2 + ii + 16) : _mm512_setzero_ps();
+        __m512 _s30 = accumulate ? _mm512_loadu_ps(sptr + M * 3 + ii) : _mm512_setzero_ps();
+        __m512 _s31 = accumulate ? _mm512_loadu_ps(sptr + M * 3 + ii + 16) : _mm512_setzero_ps();
+
+        const float* qt = qtptr + ii;
+        for (int k = 0; k < K; k++)
+        {
+            __m512 _q0 = _mm512_loadu_ps(qt);
+            __m512 _q1 = _mm512_loadu_ps(qt + 16);
+            __m512 _k0 = _mm512_set1_ps(k0[k]);
+            __m512 _k1 = _mm512_set1_ps(k1[k]);
+            __m512 _k2 = _mm512_set1_ps(k2[k]);
+            __m512 _k3 = _mm512_set1_ps(k3[k]);
+            _s00 = _mm512_fmadd_ps(_k0, _q0, _s00);
+            _s01 = _mm512_fmadd_ps(_k0, _q1, _s01);
+            _s10 = _mm512_fmadd_ps(_k1, _q0, _s10);
+            _s11 = _mm512_fmadd_ps(_k1, _q1, _s11);
+            _s20 = _mm512_fmadd_ps(_k2, _q0, _s20);
+            _s21 = _mm512_fmadd_ps(_k2, _q1, _s21);
+            _s30 = _mm512_fmadd_ps(_k3, _q0, _s30);
+            _s31 = _mm512_fmadd_ps(_k3, _q1, _s31);
+            qt += M;
+        }
+
+        _mm512_storeu_ps(sptr + ii, _s00);
+        _mm512_storeu_ps(sptr + ii + 16, _s01);
+        _mm512_storeu_ps(sptr + M + ii, _s10);
+        _mm512_storeu_ps(sptr + M + ii + 16, _s11);
+        _mm512_storeu_ps(sptr + M * 2 + ii, _s20);
+        _mm512_storeu_ps(sptr + M * 2 + ii + 16, _s21);
+        _mm512_storeu_ps(sptr + M * 3 + ii, _s30);
+        _mm512_storeu_ps(sptr + M * 3 + ii + 16, _s31);
+    }
+#endif // __AVX512F__
+    for (; ii + 15 < M; ii += 16)
+    {
+        __m256 _s00 = accumulate ? _mm256_loadu_ps(sptr + ii) : _mm256_setzero_ps();
+        __m256 _s01 = accumulate ? _mm256_loadu_ps(sptr + ii + 8) : _mm256_setzero_ps();
+        __m256 _s10 = accumulate ? _mm256_loadu_ps(sptr + M + ii) : _mm256_setzero_ps();
+        __m256 _s11 = accumulate ? _mm256_loadu_ps(sptr + M + ii + 8) : _mm256_setzero_ps();
+        __m256 _s20 = accumulate ? _mm256_loadu_ps(sptr + M * 2 + ii) : _mm256_setzero_ps();
+        __m256 _s21 = accumulate ? _mm256_loadu_ps(sptr + M * 2 + ii + 8) : _mm256_setzero_ps();
+        __m256 _s30 = accumulate ? _mm256_loadu_ps(sptr + M * 3 + ii) : _mm256_setzero_ps();
+        __m256 _s31 = accumulate ? _mm256_loadu_ps(sptr + M * 3 + ii + 8) : _mm256_setzero_ps();
+
+        const float* qt = qtptr + ii;
+        for (int k = 0; k < K; k++)
+        {
+            __m256 _q0 = _mm256_loadu_ps(qt);
+            __m256 _q1 = _mm256_loadu_ps(qt + 8);
+            __m256 _k0 = _mm256_broadcast_ss(k0 + k);
+            __m256 _k1 = _mm256_broadcast_ss(k1 + k);
+            __m256 _k2 = _mm256_broadcast_ss(k2 + k);
+            __m256 _k3 = _mm256_broadcast_ss(k3 + k);
+            _s00 = _mm256_comp_fmadd_ps(_k0, _q0, _s00);
+            _s01 = _mm256_comp_fmadd_ps(_k0, _q1, _s01);
+            _s10 = _mm256_comp_fmadd_ps(_k1, _q0, _s10);
+            _s11 = _mm256_comp_fmadd_ps(_k1, _q1, _s11);
+            _s20 = _mm256_comp_fmadd_ps(_k2, _q0, _s20);
+            _s21 = _mm256_comp_fmadd_ps(_k2, _q1, _s21);
+            _s30 = _mm256_comp_fmadd_ps(_k3, _q0, _s30);
+            _s31 = _mm256_comp_fmadd_ps(_k3, _q1, _s31);
+            qt += M;
+        }
+
+        _mm256_storeu_ps(sptr + ii, _s00);
+        _mm256_storeu_ps(sptr + ii + 8, _s01);
+        _mm256_storeu_ps(sptr + M + ii, _s10);
+        _mm256_storeu_ps(sptr + M + ii + 8, _s11);
+        _mm256_storeu_ps(sptr + M * 2 + ii, _s20);
+        _mm256_storeu_ps(sptr + M * 2 + ii + 8, _s21);
+        _mm256_storeu_ps(sptr + M * 3 + ii, _s30);
+        _mm256_storeu_ps(sptr + M * 3 + ii + 8, _s31);
+    }
+#endif // __AVX__
+    for (; ii + 7 < M; ii += 8)
+    {
+        __m128 _s00 = accumulate ? _mm_loadu_ps(sptr + ii) : _mm_setzero_ps();
+        __m128 _s01 = accumulate ? _mm_loadu_ps(sptr + ii + 4) : _mm_setzero_ps();
+        __m128 _s10 = accumulate ? _mm_loadu_ps(sptr + M + ii) : _mm_setzero_ps();
+        __m128 _s11 = accumulate ? _mm_loadu_ps(sptr + M + ii + 4) : _mm_setzero_ps();
+        __m128 _s20 = accumulate ? _mm_loadu_ps(sptr + M * 2 + ii) : _mm_setzero_ps();
+        __m128 _s21 = accumulate ? _mm_loadu_ps(sptr + M * 2 + ii + 4) : _mm_setzero_ps();
+        __m128 _s30 = accumulate ? _mm_loadu_ps(sptr + M * 3 + ii) : _mm_setzero_ps();
+        __m128 _s31 = accumulate ? _mm_loadu_ps(sptr + M * 3 + ii + 4) : _mm_setzero_ps();
+
+        const float* qt = qtptr + ii;
+        for (int k = 0; k < K; k++)
+        {
+            __m128 _q0 = _mm_loadu_ps(qt);
+            __m128 _q1 = _mm_loadu_ps(qt + 4);
+            __m128 _k0 = _mm_set1_ps(k0[k]);
+            __m128 _k1 = _mm_set1_ps(k1[k]);
+            __m128 _k2 = _mm_set1_ps(k2[k]);
+            __m128 _k3 = _mm_set1_ps(k3[k]);
+            _s00 = _mm_comp_fmadd_ps(_k0, _q0, _s00);
+            _s01 = _mm_comp_fmadd_ps(_k0, _q1, _s01);
+            _s10 = _mm_comp_fmadd_ps(_k1, _q0, _s10);
+            _s11 = _mm_comp_fmadd_ps(_k1, _q1, _s11);
+            _s20 = _mm_comp_fmadd_ps(_k2, _q0, _s20);
+            _s21 = _mm_comp_fmadd_ps(_k2, _q1, _s21);
+            _s30 = _mm_comp_fmadd_ps(_k3, _q0, _s30);
+            _s31 = _mm_comp_fmadd_ps(_k3, _q1, _s31);
+            qt += M;
+        }
+
+        _mm_storeu_ps(sptr + ii, _s00);
+        _mm_storeu_ps(sptr + ii + 4, _s01);
+        _mm_storeu_ps(sptr + M + ii, _s10);
+        _mm_storeu_ps(sptr + M + ii + 4, _s11);
+        _mm_storeu_ps(sptr + M * 2 + ii, _s20);
+        _mm_storeu_ps(sptr + M * 2 + ii + 4, _s21);
+        _mm_storeu_ps(sptr + M * 3 + ii, _s30);
+        _mm_storeu_ps(sptr + M * 3 + ii + 4, _s31);
+    }
+#endif // __SSE2__
+    for (; ii < M; ii++)
+    {
+        float sum0 = accumulate ? sptr[ii] : 0.f;
+        float sum1 = accumulate ? sptr[M + ii] : 0.f;
+        float sum2 = accumulate ? sptr[M * 2 + ii] : 0.f;
+        float sum3 = accumulate ? sptr[M * 3 + ii] : 0.f;
+
+        const float* qt = qtptr + ii;
+        for (int k = 0; k < K; k++)
+        {
+            sum0 += k0[k] * qt[0];
+            sum1 += k1[k] * qt[0];
+            sum2 += k2[k] * qt[0];
+            sum3 += k3[k] * qt[0];
+            qt += M;
+        }
+
+        sptr[ii] = sum0;
+        sptr[M + ii] = sum1;
+        sptr[M * 2 + ii] = sum2;
+        sptr[M * 3 + ii] = sum3;
+    }
+}
+
+// O[4][N] += P[4][max_jj] * V[max_jj][N], P is stored transposed as [max_jj][pstride]
+static void sdpa_pv_tile_4(const float* pptr, int pstride, const float* vptr, int vstride, int max_jj, float* optr, int ostride, int N)
+{
+    float* o0 = optr;
+    float* o1 = optr + ostride;
+    float* o2 = optr + ostride * 2;
+    float* o3 = optr + ostride * 3;
+
+    int c = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; c + 31 < N; c += 32)
+    {
+        __m512 _o00 = _mm512_loadu_ps(o0 + c);
+        __m512 _o01 = _mm512_loadu_ps(o0 + c + 16);
+        __m512 _o10 = _mm512_loadu_ps(o1 + c);
+        __m512 _o11 = _mm512_loadu_ps(o1 + c + 16);
+        __m512 _o20 = _mm512_loadu_ps(o2 + c);
+        __m512 _o21 = _mm512_loadu_ps(o2 + c + 16);
+        __m512 _o30 = _mm512_loadu_ps(o3 + c);
+        __m512 _o31 = _mm512_loadu_ps(o3 + c + 16);
+
+        const float* p = pptr;
+        const float* v = vptr + c;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m512 _v0 = _mm512_loadu_ps(v);
+            __m512 _v1 = _mm512_loadu_ps(v + 16);
+            __m512 _p0 = _mm512_set1_ps(p[0]);
+            __m512 _p1 = _mm512_set1_ps(p[1]);
+            __m512 _p2 = _mm512_set1_ps(p[2]);
+            __m512 _p3 = _mm512_set1_ps(p[3]);
+            _o00 = _mm512_fmadd_ps(_p0, _v0, _o00);
+            _o01 = _mm512_fmadd_ps(_p0, _v1, _o01);
+            _o10 = _mm512_fmadd_ps(_p1, _v0, _o10);
+            _o11 = _mm512_fmadd_ps(_p1, _v1, _o11);
+            _o20 = _mm512_fmadd_ps(_p2, _v0, _o20);
+            _o21 = _mm512_fmadd_ps(_p2, _v1, _o21);
+            _o30 = _mm512_fmadd_ps(_p3, _v0, _o30);
+            _o31 = _mm512_fmadd_ps(_p3, _v1, _o31);
+            p += pstride;
+            v += vstride;
+        }
+
+        _mm512_storeu_ps(o0 + c, _o00);
+        _mm512_storeu_ps(o0 + c + 16, _o01);
+        _mm512_storeu_ps(o1 + c, _o10);
+        _mm512_storeu_ps(o1 + c + 16, _o11);
+        _mm512_storeu_ps(o2 + c, _o20);
+        _mm512_storeu_ps(o2 + c + 16, _o21);
+        _mm512_storeu_ps(o3 + c, _o30);
+        _mm512_storeu_ps(o3 + c + 16, _o31);
+    }
+    for (; c + 15 < N; c += 16)
+    {
+        __m512 _o0 = _mm512_loadu_ps(o0 + c);
+        __m512 _o1 = _mm512_loadu_ps(o1 + c);
+        __m512 _o2 = _mm512_loadu_ps(o2 + c);
+        __m512 _o3 = _mm512_loadu_ps(o3 + c);
+
+        const float* p = pptr;
+        const float* v = vptr + c;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m512 _v = _mm512_loadu_ps(v);
+            _o0 = _mm512_fmadd_ps(_mm512_set1_ps(p[0]), _v, _o0);
+            _o1 = _mm512_fmadd_ps(_mm512_set1_ps(p[1]), _v, _o1);
+            _o2 = _mm512_fmadd_ps(_mm512_set1_ps(p[2]), _v, _o2);
+            _o3 = _mm512_fmadd_ps(_mm512_set1_ps(p[3]), _v, _o3);
+            p += pstride;
+            v += vstride;
+        }
+
+        _mm512_storeu_ps(o0 + c, _o0);
+        _mm512_storeu_ps(o1 + c, _o1);
+        _mm512_storeu_ps(o2 + c, _o2);
+        _mm512_storeu_ps(o3 + c, _o3);
+    }
+#endif // __AVX512F__
+    for (; c + 15 < N; c += 16)
+    {
+        __m256 _o00 = _mm256_loadu_ps(o0 + c);
+        __m256 _o01 = _mm256_loadu_ps(o0 + c + 8);
+        __m256 _o10 = _mm256_loadu_ps(o1 + c);
+        __m256 _o11 = _mm256_loadu_ps(o1 + c + 8);
+        __m256 _o20 = _mm256_loadu_ps(o2 + c);
+        __m256 _o21 = _mm256_loadu_ps(o2 + c + 8);
+        __m256 _o30 = _mm256_loadu_ps(o3 + c);
+        __m256 _o31 = _mm256_loadu_ps(o3 + c + 8);
+
+        const float* p = pptr;
+        const float* v = vptr + c;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m256 _v0 = _mm256_loadu_ps(v);
+            __m256 _v1 = _mm256_loadu_ps(v + 8);
+            __m256 _p0 = _mm256_broadcast_ss(p);
+            __m256 _p1 = _mm256_broadcast_ss(p + 1);
+            __m256 _p2 = _mm256_broadcast_ss(p + 2);
+            __m256 _p3 = _mm256_broadcast_ss(p + 3);
+            _o00 = _mm256_comp_fmadd_ps(_p0, _v0, _o00);
+            _o01 = _mm256_comp_fmadd_ps(_p0, _v1, _o01);
+            _o10 = _mm256_comp_fmadd_ps(_p1, _v0, _o10);
+            _o11 = _mm256_comp_fmadd_ps(_p1, _v1, _o11);
+            _o20 = _mm256_comp_fmadd_ps(_p2, _v0, _o20);
+            _o21 = _mm256_comp_fmadd_ps(_p2, _v1, _o21);
+            _o30 = _mm256_comp_fmadd_ps(_p3, _v0, _o30);
+            _o31 = _mm256_comp_fmadd_ps(_p3, _v1, _o31);
+            p += pstride;
+            v += vstride;
+        }
+
+        _mm256_storeu_ps(o0 + c, _o00);
+        _mm256_storeu_ps(o0 + c + 8, _o01);
+        _mm256_storeu_ps(o1 + c, _o10);
+        _mm256_storeu_ps(o1 + c + 8, _o11);
+        _mm256_storeu_ps(o2 + c, _o20);
+        _mm256_storeu_ps(o2 + c + 8, _o21);
+        _mm256_storeu_ps(o3 + c, _o30);
+        _mm256_storeu_ps(o3 + c + 8, _o31);
+    }
+    for (; c + 7 < N; c += 8)
+    {
+        __m256 _o0 = _mm256_loadu_ps(o0 + c);
+        __m256 _o1 = _mm256_loadu_ps(o1 + c);
+        __m256 _o2 = _mm256_loadu_ps(o2 + c);
+        __m256 _o3 = _mm256_loadu_ps(o3 + c);
+
+        const float* p = pptr;
+        const float* v = vptr + c;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m256 _v = _mm256_loadu_ps(v);
+            _o0 = _mm256_comp_fmadd_ps(_mm256_broadcast_ss(p), _v, _o0);
+            _o1 = _mm256_comp_fmadd_ps(_mm256_broadcast_ss(p + 1), _v, _o1);
+            _o2 = _mm256_comp_fmadd_ps(_mm256_broadcast_ss(p + 2), _v, _o2);
+            _o3 = _mm256_comp_fmadd_ps(_mm256_broadcast_ss(p + 3), _v, _o3);
+            p += pstride;
+            v += vstride;
+        }
+
+        _mm256_storeu_ps(o0 + c, _o0);
+        _mm256_storeu_ps(o1 + c, _o1);
+        _mm256_storeu_ps(o2 + c, _o2);
+        _mm256_storeu_ps(o3 + c, _o3);
+    }
+#endif // __AVX__
+    for (; c + 7 < N; c += 8)
+    {
+        __m128 _o00 = _mm_loadu_ps(o0 + c);
+        __m128 _o01 = _mm_loadu_ps(o0 + c + 4);
+        __m128 _o10 = _mm_loadu_ps(o1 + c);
+        __m128 _o11 = _mm_loadu_ps(o1 + c + 4);
+        __m128 _o20 = _mm_loadu_ps(o2 + c);
+        __m128 _o21 = _mm_loadu_ps(o2 + c + 4);
+        __m128 _o30 = _mm_loadu_ps(o3 + c);
+        __m128 _o31 = _mm_loadu_ps(o3 + c + 4);
+
+        const float* p = pptr;
+        const float* v = vptr + c;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m128 _v0 = _mm_loadu_ps(v);
+            __m128 _v1 = _mm_loadu_ps(v + 4);
+            __m128 _p0 = _mm_set1_ps(p[0]);
+            __m128 _p1 = _mm_set1_ps(p[1]);
+            __m128 _p2 = _mm_set1_ps(p[2]);
+            __m128 _p3 = _mm_set1_ps(p[3]);
+            _o00 = _mm_comp_fmadd_ps(_p0, _v0, _o00);
+            _o01 = _mm_comp_fmadd_ps(_p0, _v1, _o01);
+            _o10 = _mm_comp_fmadd_ps(_p1, _v0, _o10);
+            _o11 = _mm_comp_fmadd_ps(_p1, _v1, _o11);
+            _o20 = _mm_comp_fmadd_ps(_p2, _v0, _o20);
+            _o21 = _mm_comp_fmadd_ps(_p2, _v1, _o21);
+            _o30 = _mm_comp_fmadd_ps(_p3, _v0, _o30);
+            _o31 = _mm_comp_fmadd_ps(_p3, _v1, _o31);
+            p += pstride;
+            v += vstride;
+        }
+
+        _mm_storeu_ps(o0 + c, _o00);
+        _mm_storeu_ps(o0 + c + 4, _o01);
+        _mm_storeu_ps(o1 + c, _o10);
+        _mm_storeu_ps(o1 + c + 4, _o11);
+        _mm_storeu_ps(o2 + c, _o20);
+        _mm_storeu_ps(o2 + c + 4, _o21);
+        _mm_storeu_ps(o3 + c, _o30);
+        _mm_storeu_ps(o3 + c + 4, _o31);
+    }
+    for (; c + 3 < N; c += 4)
+    {
+        __m128 _o0 = _mm_loadu_ps(o0 + c);
+        __m128 _o1 = _mm_loadu_ps(o1 + c);
+        __m128 _o2 = _mm_loadu_ps(o2 + c);
+        __m128 _o3 = _mm_loadu_ps(o3 + c);
+
+        const float* p = pptr;
+        const float* v = vptr + c;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m128 _v = _mm_loadu_ps(v);
+            _o0 = _mm_comp_fmadd_ps(_mm_set1_ps(p[0]), _v, _o0);
+            _o1 = _mm_comp_fmadd_ps(_mm_set1_ps(p[1]), _v, _o1);
+            _o2 = _mm_comp_fmadd_ps(_mm_set1_ps(p[2]), _v, _o2);
+            _o3 = _mm_comp_fmadd_ps(_mm_set1_ps(p[3]), _v, _o3);
+            p += pstride;
+            v += vstride;
+        }
+
+        _mm_storeu_ps(o0 + c, _o0);
+        _mm_storeu_ps(o1 + c, _o1);
+        _mm_storeu_ps(o2 + c, _o2);
+        _mm_storeu_ps(o3 + c, _o3);
+    }
+#endif // __SSE2__
+    for (; c < N; c++)
+    {
+        float sum0 = o0[c];
+        float sum1 = o1[c];
+        float sum2 = o2[c];
+        float sum3 = o3[c];
+
+        const float* p = pptr;
+        const float* v = vptr + c;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            sum0 += p[0] * v[0];
+            sum1 += p[1] * v[0];
+            sum2 += p[2] * v[0];
+            sum3 += p[3] * v[0];
+            p += pstride;
+            v += vstride;
+        }
+
+        o0[c] = sum0;
+        o1[c] = sum1;
+        o2[c] = sum2;
+        o3[c] = sum3;
+    }
+}
+
+// widen a contiguous key or value block into the fp32 tile, zero fill up to size_padded
+template<typename T>
+static void sdpa_load_tile(const T* ptr, int size, int size_padded, float* outptr)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr + i, sdpa_load_avx512(ptr + i));
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr + i, sdpa_load_avx(ptr + i));
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr + i, sdpa_load_sse(ptr + i));
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        outptr[i] = sdpa_load(ptr + i);
+    }
+
+    if (size_padded > size)
+    {
+        memset(outptr + size, 0, (size_padded - size) * sizeof(float));
+    }
+}
+
+// flash attention with online softmax over key/value tiles
+// the full src_seqlen x dst_seqlen attention matrix is never materialized
+// this variant reads key and value rows directly and suits few query rows, e.g. decoding
+// workspace holds fp32 query rows, scores, running max and running sum for one query tile
+template<typename T>
+static void sdpa_flash_attention(const Mat& query_head, const Mat& key_head, const Mat& value_head, const Mat& maskm, Mat& top_blob_head, int i0, int max_ii, int dst_seqlen, float scale, int TILE_N, float* workspace)
+{
+    const int embed_dim = query_head.w;
+    const int out_embed_dim = value_head.w;
+
+    float* qtile = workspace;
+    float* stile = qtile + max_ii * embed_dim;
+    float* maxptr = stile + max_ii * TILE_N;
+    float* sumptr = maxptr + max_ii;
+
+    // prescale query and zero output
+    for (int ii = 0; ii < max_ii; ii++)
+    {
+        const T* qptr = query_head.row<const T>(i0 + ii);
+        float* qtptr = qtile + ii * embed_dim;
+        for (int k = 0; k < embed_dim; k++)
+        {
+            qtptr[k] = sdpa_load(qptr + k) * scale;
+        }
+
+        memset(top_blob_head.row(i0 + ii), 0, out_embed_dim * sizeof(float));
+
+        maxptr[ii] = -FLT_MAX;
+        sumptr[ii] = 0.f;
+    }
+
+    for (int j0 = 0; j0 < dst_seqlen; j0 += TILE_N)
+    {
+        const int max_jj = std::min(dst_seqlen - j0, TILE_N);
+
+        for (int ii = 0; ii < max_ii; ii++)
+        {
+            const float* q0 = qtile + ii * embed_dim;
+            float* sptr = stile + ii * TILE_N;
+
+            // S = Q * K^T
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                const T* kptr = key_head.row<const T>(j0 + jj);
+                sptr[jj] = sdpa_dot(q0, kptr, embed_dim);
+            }
+
+            if (!maskm.empty())
+            {
+                sdpa_add_mask(sptr, maskm, i0 + ii, j0, max_jj);
+            }
+
+            // online softmax, rescale previous output when the running max grows
+            float* outptr = top_blob_head.row(i0 + ii);
+            sdpa_online_softmax(sptr, max_jj, maxptr[ii], sumptr[ii], outptr, out_embed_dim);
+
+            // O += P * V
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                const T* vptr = value_head.row<const T>(j0 + jj);
+                sdpa_axpy(outptr, sptr[jj], vptr, out_embed_dim);
+            }
+        }
+    }
+
+    for (int ii = 0; ii < max_ii; ii++)
+    {
+        sdpa_mul(top_blob_head.row(i0 + ii), 1.f / sumptr[ii], out_embed_dim);
+    }
+}
+
+// flash attention register tiled by 4 key rows x query columns
+// query is packed once per tile as fp32 Q^T so that scores come out as S^T and softmax runs down the columns
+// workspace holds Q^T, fp32 key and value blocks, scores, output accumulator, running max, sum and rescale factor
+template<typename T>
+static void sdpa_flash_attention_packed(const Mat& query_head, const Mat& key_head, const Mat& value_head, const Mat& maskm, Mat& top_blob_head, int i0, int max_ii, int dst_seqlen, float scale, int TILE_N, int TILE_K, float* workspace)
+{
+    const int embed_dim = query_head.w;
+    const int out_embed_dim = top_blob_head.w;
+
+    // pad query columns to a multiple of 4, the padded ones are computed and dropped
+    const int M = (max_ii + 3) / 4 * 4;
+
+    float* qttile = workspace;
+    float* ktile = qttile + embed_dim * M;
+    float* vtile = ktile + TILE_N * embed_dim;
+    float* sttile = vtile + TILE_N * out_embed_dim;
+    float* otile = sttile + TILE_N * M;
+    float* maxptr = otile + M * out_embed_dim;
+    float* sumptr = maxptr + M;
+    float* corrptr = sumptr + M;
+
+    // Q^T with scale folded in
+    memset(qttile, 0, embed_dim * M * sizeof(float));
+    for (int ii = 0; ii < max_ii; ii++)
+    {
+        const T* qptr = query_head.row<const T>(i0 + ii);
+        for (int k = 0; k < embed_dim; k++)
+        {
+            qttile[k * M + ii] = sdpa_load(qptr + k) * scale;
+        }
+    }
+
+    for (int ii = 0; ii < M; ii++)
+    {
+        maxptr[ii] = -FLT_MAX;
+        sumptr[ii] = 0.f;
+    }
+
+    memset(otile, 0, M * out_embed_dim * sizeof(float));
+
+    for (int j0 = 0; j0 < dst_seqlen; j0 += TILE_N)
+    {
+        const int max_jj = std::min(dst_seqlen - j0, TILE_N);
+        const int max_jj_padded = (max_jj + 3) / 4 * 4;
+
+        // key and value blocks are copied even for fp32, the compact tiles stay hot in cache
+        sdpa_load_tile(key_head.row<const T>(j0), max_jj * embed_dim, max_jj_padded * embed_dim, ktile);
+
+        // S^T = K * Q^T, split embed_dim so that Q^T stays in cache across key rows
+        for (int k0 = 0; k0 < embed_dim; k0 += TILE_K)
+        {
+            const int max_kk = std::min(embed_dim - k0, TILE_K);
+            for (int jj = 0; jj < max_jj_padded; jj += 4)
+            {
+                sdpa_qk_tile_4(ktile + jj * embed_dim + k0, embed_dim, max_kk, qttile + k0 * M, sttile + jj * M, M, k0 > 0);
+            }
+        }
+
+        if (!maskm.empty())
+        {
+            sdpa_add_mask_transposed(sttile, M, maskm, i0, max_ii, j0, max_jj);
+        }
+
+        // online softmax, rescale previous output when the running max grows
+        sdpa_online_softmax_transposed(sttile, M, max_jj, maxptr, sumptr, corrptr);
+
+        for (int ii = 0; ii < M; ii++)
+        {
+            if (corrptr[ii] != 1.f)
+            {
+                sdpa_mul(otile + ii * out_embed_dim, corrptr[ii], out_embed_dim);
+            }
+        }
+
+        sdpa_load_tile(value_head.row<const T>(j0), max_jj * out_embed_dim, max_jj * out_embed_dim, vtile);
+
+        // O += P * V, split out_embed_dim so that the value block stays in cache across query rows
+        for (int k0 = 0; k0 < out_embed_dim; k0 += TILE_K)
+        {
+            const int max_kk = std::min(out_embed_dim - k0, TILE_K);
+            for (int ii = 0; ii < M; ii += 4)
+            {
+                sdpa_pv_tile_4(sttile + ii, M, vtile + k0, out_embed_dim, max_jj, otile + ii * out_embed_dim + k0, out_embed_dim, max_kk);
+            }
+        }
+    }
+
+    for (int ii = 0; ii < max_ii; ii++)
+    {
+        float* outptr = top_blob_head.row(i0 + ii);
+        memcpy(outptr, otile + ii * out_embed_dim, out_embed_dim * sizeof(float));
+        sdpa_mul(outptr, 1.f / sumptr[ii], out_embed_dim);
+    }
+}
+
 SDPA_x86::SDPA_x86()
 {
 #if NCNN_BF16
@@ -20,12 +996,13 @@ SDPA_x86::SDPA_x86()
 
 int SDPA_x86::create_pipeline(const Option& _opt)
 {
+    // fp32 and bf16 go through the fused flash attention kernel
+    if (!int8_scale_term)
+        return 0;
+
     Option opt = _opt;
-    if (int8_scale_term)
-    {
-        opt.use_packing_layout = false; // TODO enable packing
-        support_bf16_storage = false;
-    }
+    opt.use_packing_layout = false; // TODO enable packing
+    support_bf16_storage = false;
 
     {
         qk_softmax = ncnn::create_layer_cpu(ncnn::LayerType::Softmax);
@@ -158,52 +1135,112 @@ int SDPA_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     const size_t elemsize = query.elemsize;
 
     Mat key;
-    if (past_seqlen > 0)
+    int retk = concat_kv_cache(past_key, cur_key, embed_dim, key, opt);
+    if (retk != 0)
+        return retk;
+
+    Mat value;
+    int retv = concat_kv_cache(past_value, cur_value, out_embed_dim, value, opt);
+    if (retv != 0)
+        return retv;
+
+    const int num_heads_per_group = num_heads / num_group;
+
+    if (!int8_scale_term)
     {
-        key.create(embed_dim, dst_seqlen, num_group, elemsize, opt.blob_allocator);
-        if (key.empty())
+        Mat& top_blob = top_blobs[0];
+        top_blob.create(out_embed_dim, src_seqlen, num_heads, 4u, opt.blob_allocator);
+        if (top_blob.empty())
             return -100;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
+        const float _scale = scale == 0.f ? 1.f / sqrt(embed_dim) : scale;
+
+        const int TILE_M = 64;
+        const int TILE_N = std::min(64, (dst_seqlen + 7) / 8 * 8);
+        const int TILE_K = 128;
+
+        const int nn_M = (src_seqlen + TILE_M - 1) / TILE_M;
+
+        if (src_seqlen < 4)
         {
-            const Mat past_key_head = past_key.channel(q);
-            const Mat cur_key_head = cur_key.channel(q);
-            Mat key_head = key.channel(q);
+            // few query rows, stream key and value rows as is
+            Mat workspace(TILE_M * embed_dim + TILE_M * TILE_N + TILE_M * 2, 1, opt.num_threads, 4u, opt.workspace_allocator);
+            if (workspace.empty())
+                return -100;
 
-            memcpy(key_head.row(0), past_key_head, embed_dim * past_seqlen * elemsize);
-            memcpy(key_head.row(past_seqlen), cur_key_head, embed_dim * cur_seqlen * elemsize);
-        }
-    }
-    else
-    {
-        key = cur_key;
-    }
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < num_heads; q++)
+            {
+                const Mat query_head = query.channel(q);
+                const Mat key_head = key.channel(q / num_heads_per_group);
+                const Mat value_head = value.channel(q / num_heads_per_group);
+                Mat top_blob_head = top_blob.channel(q);
 
-    Mat value;
-    if (past_seqlen > 0)
-    {
-        value.create(out_embed_dim, dst_seqlen, num_group, elemsize, opt.blob_allocator);
-        if (value.empty())
-            return -100;
+                Mat maskm;
+                if (attn_mask)
+                {
+                    maskm = attn_mask_blob.c > 1 ? attn_mask_blob.channel(q) : attn_mask_blob;
+                }
+
+                float* workspace_ptr = workspace.channel(get_omp_thread_num());
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = 0; q < num_group; q++)
+#if NCNN_BF16
+                if (opt.use_bf16_storage && elemsize == 2u)
+                {
+                    sdpa_flash_attention<unsigned short>(query_head, key_head, value_head, maskm, top_blob_head, 0, src_seqlen, dst_seqlen, _scale, TILE_N, workspace_ptr);
+                    continue;
+                }
+#endif
+
+                sdpa_flash_attention<float>(query_head, key_head, value_head, maskm, top_blob_head, 0, src_seqlen, dst_seqlen, _scale, TILE_N, workspace_ptr);
+            }
+        }
+        else
         {
-            const Mat past_value_head = past_value.channel(q);
-            const Mat cur_value_head = cur_value.channel(q);
-            Mat value_head = value.channel(q);
+            Mat workspace(embed_dim * TILE_M + TILE_N * embed_dim + TILE_N * out_embed_dim + TILE_N * TILE_M + TILE_M * out_embed_dim + TILE_M * 3, 1, opt.num_threads, 4u, opt.workspace_allocator);
+            if (workspace.empty())
+                return -100;
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int ppi = 0; ppi < num_heads * nn_M; ppi++)
+            {
+                const int q = ppi / nn_M;
+                const int i0 = ppi % nn_M * TILE_M;
+                const int max_ii = std::min(src_seqlen - i0, TILE_M);
+
+                const Mat query_head = query.channel(q);
+                const Mat key_head = key.channel(q / num_heads_per_group);
+                const Mat value_head = value.channel(q / num_heads_per_group);
+                Mat top_blob_head = top_blob.channel(q);
+
+                Mat maskm;
+                if (attn_mask)
+                {
+                    maskm = attn_mask_blob.c > 1 ? attn_mask_blob.channel(q) : attn_mask_blob;
+                }
+
+                float* workspace_ptr = workspace.channel(get_omp_thread_num());
+
+#if NCNN_BF16
+                if (opt.use_bf16_storage && elemsize == 2u)
+                {
+                    sdpa_flash_attention_packed<unsigned short>(query_head, key_head, value_head, maskm, top_blob_head, i0, max_ii, dst_seqlen, _scale, TILE_N, TILE_K, workspace_ptr);
+                    continue;
+                }
+#endif
 
-            memcpy(value_head.row(0), past_value_head, out_embed_dim * past_seqlen * elemsize);
-            memcpy(value_head.row(past_seqlen), cur_value_head, out_embed_dim * cur_seqlen * elemsize);
+                sdpa_flash_attention_packed<float>(query_head, key_head, value_head, maskm, top_blob_head, i0, max_ii, dst_seqlen, _scale, TILE_N, TILE_K, workspace_ptr);
+            }
         }
-    }
-    else
-    {
-        value = cur_value;
-    }
 
-    const int num_heads_per_group = num_heads / num_group;
+        if (kv_cache)
+        {
+            top_blobs[1] = key;
+            top_blobs[2] = value;
+        }
+
+        return 0;
+    }
 
     Mat qk_cross(dst_seqlen, src_seqlen, num_heads, 4u, opt.workspace_allocator);
     if (qk_cross.empty())
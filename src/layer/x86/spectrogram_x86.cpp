@@ -0,0 +1,151 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "spectrogram_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "cpu.h"
+
+namespace ncnn {
+
+namespace Spectrogram_x86_fft {
+
+#include "fft_functor.h"
+
+} // namespace Spectrogram_x86_fft
+
+#include "spectrogram_fft.h"
+
+int Spectrogram_x86::create_pipeline(const Option& /*opt*/)
+{
+    // the even n_fft takes the fft of n_fft / 2 complex values
+    const int fft_size = n_fft % 2 == 0 ? n_fft / 2 : n_fft;
+
+    fft_factorize(fft_size, fft_radices);
+
+    int ret = fft_create_twiddles(fft_radices, fft_twiddles);
+    if (ret != 0)
+        return ret;
+
+    if (n_fft % 2 == 0)
+    {
+        ret = fft_create_real_twiddles(n_fft, fft_real_twiddles);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+int Spectrogram_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    using namespace Spectrogram_x86_fft;
+
+    Mat bottom_blob_bordered = bottom_blob;
+    if (center == 1)
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        if (pad_type == 0)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_CONSTANT, 0.f, opt_b);
+        if (pad_type == 1)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REPLICATE, 0.f, opt_b);
+        if (pad_type == 2)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REFLECT, 0.f, opt_b);
+        if (bottom_blob_bordered.empty())
+            return -100;
+    }
+
+    const int size = bottom_blob_bordered.w;
+
+    const int frames = (size - n_fft) / hoplen + 1;
+    const int freqs_onesided = n_fft / 2 + 1;
+    const int freqs = onesided ? freqs_onesided : n_fft;
+
+    const size_t elemsize = bottom_blob_bordered.elemsize;
+
+    if (power == 0)
+    {
+        top_blob.create(2, frames, freqs, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(frames, freqs, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    float norm = 1.f;
+    if (normalized == 1)
+        norm = 1.f / sqrtf(n_fft);
+    if (normalized == 2)
+        norm = window_data[n_fft];
+
+    int max_lanes = 1;
+#if __SSE2__
+    max_lanes = 4;
+#if __AVX__
+    max_lanes = 8;
+#if __AVX512F__
+    max_lanes = 16;
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+    // one fft workspace per thread
+    Mat workspace(n_fft * 4 * max_lanes, opt.num_threads, (size_t)4u, opt.workspace_allocator);
+    if (workspace.empty())
+        return -100;
+
+    // transform a group of frames at once, one frame per lane
+    int j = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    j = spectrogram_fft_frames<fft_op_pack16>(bottom_blob_bordered, top_blob, j, frames, n_fft, hoplen, power, norm, window_data, fft_radices, fft_twiddles, fft_real_twiddles, workspace, opt);
+#endif // __AVX512F__
+    j = spectrogram_fft_frames<fft_op_pack8>(bottom_blob_bordered, top_blob, j, frames, n_fft, hoplen, power, norm, window_data, fft_radices, fft_twiddles, fft_real_twiddles, workspace, opt);
+#endif // __AVX__
+    j = spectrogram_fft_frames<fft_op_pack4>(bottom_blob_bordered, top_blob, j, frames, n_fft, hoplen, power, norm, window_data, fft_radices, fft_twiddles, fft_real_twiddles, workspace, opt);
+#endif // __SSE2__
+    spectrogram_fft_frames<fft_op_pack1>(bottom_blob_bordered, top_blob, j, frames, n_fft, hoplen, power, norm, window_data, fft_radices, fft_twiddles, fft_real_twiddles, workspace, opt);
+
+    if (!onesided)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = freqs_onesided; i < n_fft; i++)
+        {
+            if (power == 0)
+            {
+                const float* ptr = top_blob.channel(n_fft - i);
+                float* outptr = top_blob.channel(i);
+
+                for (int k = 0; k < frames; k++)
+                {
+                    // complex as real
+                    outptr[0] = ptr[0];
+                    outptr[1] = -ptr[1];
+                    ptr += 2;
+                    outptr += 2;
+                }
+            }
+            else // if (power == 1 || power == 2)
+            {
+                const float* ptr = top_blob.row(n_fft - i);
+                float* outptr = top_blob.row(i);
+
+                memcpy(outptr, ptr, frames * sizeof(float));
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,159 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "statisticspooling_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include <float.h>
+#include <math.h>
+
+namespace ncnn {
+
+#include "pooling_accumulate.h"
+
+StatisticsPooling_x86::StatisticsPooling_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+// outptr = sum((ptr - mean)^2) over size packed elements
+static void statisticspooling_sqsum(const float* ptr, int size, int elempack, const float* mean, float* outptr)
+{
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        __m512 _mean = _mm512_loadu_ps(mean);
+        __m512 _sum = _mm512_setzero_ps();
+        for (int i = 0; i < size; i++)
+        {
+            __m512 _v = _mm512_sub_ps(_mm512_loadu_ps(ptr), _mean);
+            _sum = _mm512_fmadd_ps(_v, _v, _sum);
+            ptr += 16;
+        }
+        _mm512_storeu_ps(outptr, _sum);
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        __m256 _mean = _mm256_loadu_ps(mean);
+        __m256 _sum = _mm256_setzero_ps();
+        for (int i = 0; i < size; i++)
+        {
+            __m256 _v = _mm256_sub_ps(_mm256_loadu_ps(ptr), _mean);
+            _sum = _mm256_comp_fmadd_ps(_v, _v, _sum);
+            ptr += 8;
+        }
+        _mm256_storeu_ps(outptr, _sum);
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        __m128 _mean = _mm_loadu_ps(mean);
+        __m128 _sum = _mm_setzero_ps();
+        for (int i = 0; i < size; i++)
+        {
+            __m128 _v = _mm_sub_ps(_mm_loadu_ps(ptr), _mean);
+            _sum = _mm_comp_fmadd_ps(_v, _v, _sum);
+            ptr += 4;
+        }
+        _mm_storeu_ps(outptr, _sum);
+    }
+#endif // __SSE2__
+    if (elempack == 1)
+    {
+        float sum = 0.f;
+
+        int i = 0;
+#if __SSE2__
+        __m128 _mean = _mm_set1_ps(mean[0]);
+        __m128 _sum = _mm_setzero_ps();
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _v = _mm_sub_ps(_mm_loadu_ps(ptr), _mean);
+            _sum = _mm_comp_fmadd_ps(_v, _v, _sum);
+            ptr += 4;
+        }
+        sum = _mm_reduce_add_ps(_sum);
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            const float v = *ptr++ - mean[0];
+            sum += v * v;
+        }
+
+        outptr[0] = sum;
+    }
+}
+
+int StatisticsPooling_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+
+    if (dims < 3)
+    {
+        // the whole blob is one channel, lanes belong to the same statistics
+        if (elempack == 1)
+            return StatisticsPooling::forward(bottom_blob, top_blob, opt);
+
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+
+        Mat bottom_blob_unpacked;
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_b);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+
+        return StatisticsPooling::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int size = bottom_blob.w * bottom_blob.h * bottom_blob.d;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    // means first, then the standard deviations
+    const int out_channels = include_stddev ? channels * 2 : channels;
+
+    top_blob.create(out_channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* ptr = bottom_blob.channel(q);
+        float* meanptr = (float*)top_blob + q * elempack;
+
+        pooling_accumulate_init(meanptr, elempack, 1);
+        pooling_accumulate(ptr, size, elempack, 1, meanptr);
+        pooling_accumulate_scale(meanptr, elempack, 1.f / size);
+
+        if (include_stddev)
+        {
+            float* stdptr = (float*)top_blob + (channels + q) * elempack;
+
+            statisticspooling_sqsum(ptr, size, elempack, meanptr, stdptr);
+
+            for (int i = 0; i < elempack; i++)
+            {
+                stdptr[i] = sqrtf(stdptr[i] / size);
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
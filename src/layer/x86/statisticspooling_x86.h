@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_STATISTICSPOOLING_X86_H
+#define LAYER_STATISTICSPOOLING_X86_H
+
+#include "statisticspooling.h"
+
+namespace ncnn {
+
+class StatisticsPooling_x86 : public StatisticsPooling
+{
+public:
+    StatisticsPooling_x86();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_STATISTICSPOOLING_X86_H
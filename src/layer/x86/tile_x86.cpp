@@ -0,0 +1,142 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "tile_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+#include "strided_copy.h"
+
+Tile_x86::Tile_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+    support_fp16_storage = cpu_support_x86_f16c();
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Tile_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    int repeat_w;
+    int repeat_h;
+    int repeat_d;
+    int repeat_c;
+    resolve_repeats(dims, repeat_w, repeat_h, repeat_d, repeat_c);
+
+    const int repeats_num = repeats.w;
+    const int outdims = std::max(dims, repeats_num);
+
+    if (repeat_w == 1 && repeat_h == 1 && repeat_d == 1 && repeat_c == 1)
+    {
+        // all ones
+        if (repeats_num == 0 || dims == repeats_num)
+        {
+            top_blob = bottom_blob;
+            return 0;
+        }
+    }
+
+    // logical axes c d h w, the packed axis is c for 3d and 4d, h for 2d and w for 1d
+    const int packed_axis = dims == 1 ? 3 : dims == 2 ? 2 : 0;
+    const int out_packed_axis = outdims == 1 ? 3 : outdims == 2 ? 2 : 0;
+
+    int in_sizes[4] = {bottom_blob.c, bottom_blob.d, bottom_blob.h, bottom_blob.w};
+    in_sizes[packed_axis] *= elempack;
+
+    const int axis_repeats[4] = {repeat_c, repeat_d, repeat_h, repeat_w};
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        // every repeated block starts at a multiple of the input size, pack by what divides it
+        const int packed_size = in_sizes[out_packed_axis];
+
+#if __AVX512F__
+        out_elempack = packed_size % 16 == 0 ? 16 : packed_size % 8 == 0 ? 8 : packed_size % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = packed_size % 8 == 0 ? 8 : packed_size % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = packed_size % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    const int outw = in_sizes[3] * repeat_w;
+    const int outh = in_sizes[2] * repeat_h;
+    const int outd = in_sizes[1] * repeat_d;
+    const int outc = in_sizes[0] * repeat_c;
+    if (outdims == 1)
+    {
+        top_blob.create(outw / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (outdims == 2)
+    {
+        top_blob.create(outw, outh / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (outdims == 3)
+    {
+        top_blob.create(outw, outh, outc / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (outdims == 4)
+    {
+        top_blob.create(outw, outh, outd, outc / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    size_t in_strides[4];
+    size_t out_axis_strides[4];
+    strided_copy_mat_strides(bottom_blob, in_strides);
+    strided_copy_mat_strides(top_blob, out_axis_strides);
+
+    int ndim = 0;
+    int sizes[STRIDED_COPY_MAX_AXES];
+    size_t strides[STRIDED_COPY_MAX_AXES];
+    size_t out_strides[STRIDED_COPY_MAX_AXES];
+    for (int i = 0; i < 4; i++)
+    {
+        const int axis_elempack = i == packed_axis ? elempack : 1;
+        const int axis_out_elempack = i == out_packed_axis ? out_elempack : 1;
+
+        strided_copy_append_axis(in_sizes[i], axis_elempack, in_strides[i], axis_out_elempack, out_axis_strides[i], ndim, sizes, strides, out_strides);
+
+        // the repeat axis reads the same input again
+        sizes[ndim] = axis_repeats[i];
+        strides[ndim] = 0;
+        out_strides[ndim] = in_sizes[i] / axis_out_elempack * out_axis_strides[i];
+        ndim++;
+    }
+
+    if (bottom_blob.elembits() == 16)
+    {
+        strided_copy<unsigned short>(bottom_blob, top_blob, ndim, sizes, strides, out_strides, opt);
+    }
+    else
+    {
+        strided_copy<float>(bottom_blob, top_blob, ndim, sizes, strides, out_strides, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -8,8 +8,12 @@
 
 #include <float.h>
 
+#include "topk_select.h"
+
 namespace ncnn {
 
+#include "detection_nms.h"
+
 Yolov3DetectionOutput_x86::Yolov3DetectionOutput_x86()
 {
 }
@@ -76,6 +80,18 @@ int Yolov3DetectionOutput_x86::forward(const std::vector<Mat>& bottom_blobs, std
             {
                 for (int j = 0; j < w; j++)
                 {
+                    // the class score sigmoid is at most one, so a low box score rejects the box without looking at any class
+                    if (sigmoid(box_score_ptr[0]) < confidence_threshold)
+                    {
+                        xptr++;
+                        yptr++;
+                        wptr++;
+                        hptr++;
+
+                        box_score_ptr++;
+                        continue;
+                    }
+
 #if 0
                     int class_index = 0;
                     float class_score = -FLT_MAX;
@@ -170,20 +186,40 @@ int Yolov3DetectionOutput_x86::forward(const std::vector<Mat>& bottom_blobs, std
         }
     }
 
-    // global sort inplace
-    qsort_descent_inplace(all_bbox_rects);
+    // global sort
+    const int num_bbox = (int)all_bbox_rects.size();
+
+    std::vector<float> all_bbox_scores(num_bbox);
+    for (int i = 0; i < num_bbox; i++)
+    {
+        all_bbox_scores[i] = all_bbox_rects[i].score;
+    }
+
+    std::vector<int> sorted(num_bbox);
+    topk_select(all_bbox_scores.data(), 0, num_bbox, num_bbox, sorted.data());
+
+    BBoxSoA sorted_bboxes;
+    sorted_bboxes.resize(num_bbox);
+    for (int i = 0; i < num_bbox; i++)
+    {
+        const BBoxRect& r = all_bbox_rects[sorted[i]];
+        sorted_bboxes.xmin[i] = r.xmin;
+        sorted_bboxes.ymin[i] = r.ymin;
+        sorted_bboxes.xmax[i] = r.xmax;
+        sorted_bboxes.ymax[i] = r.ymax;
+        sorted_bboxes.area[i] = r.area;
+    }
 
     // apply nms
-    std::vector<size_t> picked;
-    nms_sorted_bboxes(all_bbox_rects, picked, nms_threshold);
+    std::vector<int> picked;
+    nms_sorted_bboxes_soa(sorted_bboxes, num_bbox, nms_threshold, num_bbox, picked);
 
     // select
     std::vector<BBoxRect> bbox_rects;
 
     for (size_t i = 0; i < picked.size(); i++)
     {
-        size_t z = picked[i];
-        bbox_rects.push_back(all_bbox_rects[z]);
+        bbox_rects.push_back(all_bbox_rects[sorted[picked[i]]]);
     }
 
     // fill result
@@ -3,20 +3,19 @@
 
 #include "net.h"
 
+#include "benchmark.h"
 #include "cpu.h"
 #include "datareader.h"
+#include "kvcache.h"
 #include "layer_type.h"
 #include "modelbin.h"
 #include "paramdict.h"
+#include "profiler.h"
 
 #include <stdarg.h>
 #include <stdint.h>
 #include <string.h>
 
-#if NCNN_BENCHMARK
-#include "benchmark.h"
-#endif // NCNN_BENCHMARK
-
 #if NCNN_VULKAN
 #include "command.h"
 #include "pipelinecache.h"
@@ -24,6 +23,20 @@
 
 namespace ncnn {
 
+// arena planned by Net::plan_memory for one set of input shapes
+struct MemoryPlan
+{
+    std::vector<Mat> input_shapes;
+    // the first extracted blob
+    int blob_index;
+    ArenaAllocator* allocator;
+    bool in_use;
+};
+
+#if NCNN_THREADS
+class InterOpThreadPool;
+#endif // NCNN_THREADS
+
 class NetPrivate
 {
 public:
@@ -32,7 +45,21 @@ public:
     Option& opt;
 
     friend class Extractor;
-    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler = 0) const;
+
+    // forward one layer whose bottom blobs are all ready
+    int forward_one_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler) const;
+
+    // forward_layer, or forward_layer_parallel with use_inter_op_parallel
+    int forward_layer_cpu(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler);
+
+#if NCNN_THREADS
+    // forward the layers required by layer_index, independent branches run concurrently
+    int forward_layer_parallel(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler);
+
+    // max number of layers at the same depth, the branch parallelism of the graph
+    int graph_width() const;
+#endif // NCNN_THREADS
 
 #if NCNN_VULKAN
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
@@ -53,6 +80,12 @@ public:
     void update_input_output_names();
 #endif // NCNN_STRING
 
+    // find an idle memory plan for the inputs in blob_mats when extracting blob_index first
+    // return 0 if none
+    ArenaAllocator* acquire_memory_plan(const std::vector<Mat>& blob_mats, int blob_index);
+    void reclaim_memory_plan(ArenaAllocator* allocator);
+    void clear_memory_plans();
+
     std::vector<Blob> blobs;
     std::vector<Layer*> layers;
 
@@ -69,6 +102,14 @@ public:
     PoolAllocator* local_blob_allocator;
     PoolAllocator* local_workspace_allocator;
 
+    Mutex memory_plans_lock;
+    std::vector<MemoryPlan> memory_plans;
+
+#if NCNN_THREADS
+    Mutex inter_op_lock;
+    InterOpThreadPool* inter_op_pool;
+#endif // NCNN_THREADS
+
 #if defined _WIN32 || __ANDROID__ || defined __OHOS__ || defined __linux__ || __APPLE__
     MappedFile mapped_model_file;
 #endif
@@ -89,6 +130,10 @@ NetPrivate::NetPrivate(Option& _opt)
     local_blob_allocator = 0;
     local_workspace_allocator = 0;
 
+#if NCNN_THREADS
+    inter_op_pool = 0;
+#endif // NCNN_THREADS
+
 #if NCNN_VULKAN
     vkdev = 0;
     weight_vkallocator = 0;
@@ -120,7 +165,7 @@ static Option get_masked_option(const Option& opt, int featmask)
     return opt1;
 }
 
-int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler) const
 {
     const Layer* layer = layers[layer_index];
 
@@ -136,12 +181,45 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
 
         if (blob_mats[bottom_blob_index].dims == 0)
         {
-            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt);
+            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt, profiler);
             if (ret != 0)
                 return ret;
         }
     }
 
+    return forward_one_layer(layer_index, blob_mats, opt, profiler);
+}
+
+int NetPrivate::forward_one_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler) const
+{
+    const Layer* layer = layers[layer_index];
+
+    if (layer->typeindex == LayerType::Input)
+        return 0;
+
+    double profile_start = 0.0;
+    std::vector<Mat> profile_bottom_shapes;
+    if (profiler)
+    {
+        // shapes only, the bottom blobs may be released in light mode
+        profile_bottom_shapes.resize(layer->bottoms.size());
+        for (size_t i = 0; i < layer->bottoms.size(); i++)
+        {
+            const Mat& m = blob_mats[layer->bottoms[i]];
+            Mat& shape = profile_bottom_shapes[i];
+            shape.dims = m.dims;
+            shape.w = m.w;
+            shape.h = m.h;
+            shape.d = m.d;
+            shape.c = m.c;
+            shape.n = m.n;
+            shape.elempack = m.elempack;
+            shape.elemsize = m.elemsize;
+        }
+
+        profile_start = get_current_time();
+    }
+
 #if NCNN_BENCHMARK
     double start = get_current_time();
     Mat bottom_blob;
@@ -181,6 +259,19 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     if (ret != 0)
         return ret;
 
+    if (profiler)
+    {
+        const double profile_end = get_current_time();
+
+        std::vector<Mat> top_blobs(layer->tops.size());
+        for (size_t i = 0; i < layer->tops.size(); i++)
+        {
+            top_blobs[i] = blob_mats[layer->tops[i]];
+        }
+
+        profiler->record(layer, layer_index, profile_bottom_shapes, top_blobs, profile_start, profile_end, layer->featmask ? get_masked_option(opt, layer->featmask) : opt);
+    }
+
     //     NCNN_LOGE("forward_layer %d %s done", layer_index, layer->name.c_str());
     //     const Mat& blob = blob_mats[layer->tops[0]];
     //     NCNN_LOGE("[%-2d %-16s %-16s]  %d    blobs count = %-3d   size = %-3d x %-3d", layer_index, layer->type.c_str(), layer->name.c_str(), layer->tops[0], blob.c, blob.h, blob.w);
@@ -188,6 +279,307 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     return 0;
 }
 
+#if NCNN_THREADS
+// the layers of one forward_layer_parallel call
+class LayerGraphRun
+{
+public:
+    const NetPrivate* net;
+    std::vector<Mat>* blob_mats;
+    const Option* opt;
+    Profiler* profiler;
+
+    // unfinished producers per layer, -1 for the layers not required
+    std::vector<int> pending;
+    // the blobs the consumer layers wait for
+    std::vector<char> awaited;
+
+    // required layers not finished yet
+    int remaining;
+
+    int ret;
+    ConditionVariable finished;
+};
+
+struct LayerTask
+{
+    LayerGraphRun* run;
+    int layer_index;
+};
+
+// persistent workers shared by the extractors of a net
+// the calling thread of forward_layer_parallel works on its own layers as well
+class InterOpThreadPool
+{
+public:
+    InterOpThreadPool(int num_workers);
+    ~InterOpThreadPool();
+
+    // queue the ready layer, call with lock held
+    void push(LayerGraphRun* run, int layer_index);
+
+    // take a ready layer of run, or of any run if run is null, call with lock held
+    bool take(LayerGraphRun* run, LayerTask& task);
+
+    // forward the layer and release its consumers, call with lock held
+    void execute(const LayerTask& task);
+
+    void worker();
+
+    Mutex lock;
+    ConditionVariable condition;
+    std::list<LayerTask> ready;
+    bool stopping;
+    std::vector<Thread*> workers;
+};
+
+static void* inter_op_worker(void* args)
+{
+    InterOpThreadPool* pool = (InterOpThreadPool*)args;
+    pool->worker();
+    return 0;
+}
+
+InterOpThreadPool::InterOpThreadPool(int num_workers)
+{
+    stopping = false;
+
+    workers.resize(num_workers);
+    for (int i = 0; i < num_workers; i++)
+    {
+        workers[i] = new Thread(inter_op_worker, (void*)this);
+    }
+}
+
+InterOpThreadPool::~InterOpThreadPool()
+{
+    lock.lock();
+    stopping = true;
+    condition.broadcast();
+    lock.unlock();
+
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i]->join();
+        delete workers[i];
+    }
+}
+
+void InterOpThreadPool::push(LayerGraphRun* run, int layer_index)
+{
+    LayerTask task;
+    task.run = run;
+    task.layer_index = layer_index;
+    ready.push_back(task);
+
+    condition.signal();
+}
+
+bool InterOpThreadPool::take(LayerGraphRun* run, LayerTask& task)
+{
+    std::list<LayerTask>::iterator it = ready.begin();
+    for (; it != ready.end(); ++it)
+    {
+        if (!run || it->run == run)
+        {
+            task = *it;
+            ready.erase(it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void InterOpThreadPool::execute(const LayerTask& task)
+{
+    LayerGraphRun* run = task.run;
+
+    int ret = 0;
+    if (run->ret == 0)
+    {
+        const Option& opt = *run->opt;
+
+        lock.unlock();
+
+        set_kmp_blocktime(opt.openmp_blocktime);
+        set_flush_denormals(opt.flush_denormals);
+
+        ret = run->net->forward_one_layer(task.layer_index, *run->blob_mats, opt, run->profiler);
+
+        lock.lock();
+    }
+
+    if (ret != 0)
+        run->ret = ret;
+
+    const Layer* layer = run->net->layers[task.layer_index];
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        const int top_blob_index = layer->tops[i];
+        if (!run->awaited[top_blob_index])
+            continue;
+
+        const int consumer = run->net->blobs[top_blob_index].consumer;
+        run->pending[consumer]--;
+        if (run->pending[consumer] == 0)
+            push(run, consumer);
+    }
+
+    run->remaining--;
+    if (run->remaining == 0)
+        run->finished.signal();
+}
+
+void InterOpThreadPool::worker()
+{
+    lock.lock();
+
+    for (;;)
+    {
+        LayerTask task;
+        while (!take(0, task))
+        {
+            if (stopping)
+            {
+                lock.unlock();
+                return;
+            }
+
+            condition.wait(lock);
+        }
+
+        execute(task);
+    }
+}
+
+int NetPrivate::graph_width() const
+{
+    std::vector<int> depths(layers.size(), 0);
+    std::vector<int> widths(layers.size() + 1, 0);
+
+    // layers are stored in topological order
+    int width = 1;
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+
+        int depth = 0;
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            const int producer = blobs[layer->bottoms[j]].producer;
+            if (producer != -1)
+                depth = std::max(depth, depths[producer] + 1);
+        }
+
+        depths[i] = depth;
+        widths[depth]++;
+
+        if (layer->typeindex != LayerType::Input && layer->typeindex != LayerType::Split)
+            width = std::max(width, widths[depth]);
+    }
+
+    return width;
+}
+
+int NetPrivate::forward_layer_parallel(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler)
+{
+    InterOpThreadPool* pool = 0;
+    {
+        MutexLockGuard guard(inter_op_lock);
+
+        if (!inter_op_pool)
+        {
+            const int num_workers = std::min(opt.num_threads, graph_width()) - 1;
+            if (num_workers > 0)
+                inter_op_pool = new InterOpThreadPool(num_workers);
+        }
+
+        pool = inter_op_pool;
+    }
+
+    // a chain of layers
+    if (!pool)
+        return forward_layer(layer_index, blob_mats, opt, profiler);
+
+    LayerGraphRun run;
+    run.net = this;
+    run.blob_mats = &blob_mats;
+    run.opt = &opt;
+    run.profiler = profiler;
+    run.pending.resize(layers.size(), -1);
+    run.awaited.resize(blobs.size(), 0);
+    run.remaining = 0;
+    run.ret = 0;
+
+    // collect the required layers and their missing bottom blobs
+    std::vector<int> required;
+    required.push_back(layer_index);
+    run.pending[layer_index] = 0;
+    for (size_t i = 0; i < required.size(); i++)
+    {
+        const Layer* layer = layers[required[i]];
+        if (layer->typeindex == LayerType::Input)
+            continue;
+
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            const int bottom_blob_index = layer->bottoms[j];
+            if (blob_mats[bottom_blob_index].dims != 0)
+                continue;
+
+            run.awaited[bottom_blob_index] = 1;
+            run.pending[required[i]]++;
+
+            const int producer = blobs[bottom_blob_index].producer;
+            if (run.pending[producer] == -1)
+            {
+                run.pending[producer] = 0;
+                required.push_back(producer);
+            }
+        }
+    }
+
+    MutexLockGuard guard(pool->lock);
+
+    run.remaining = (int)required.size();
+    for (size_t i = 0; i < required.size(); i++)
+    {
+        if (run.pending[required[i]] == 0)
+            pool->push(&run, required[i]);
+    }
+
+    // work on our own layers until all are done
+    while (run.remaining > 0)
+    {
+        LayerTask task;
+        if (pool->take(&run, task))
+        {
+            pool->execute(task);
+            continue;
+        }
+
+        run.finished.wait(pool->lock);
+    }
+
+    // restore the thread states changed by execute
+    set_kmp_blocktime(opt.openmp_blocktime);
+    set_flush_denormals(opt.flush_denormals);
+
+    return run.ret;
+}
+#endif // NCNN_THREADS
+
+int NetPrivate::forward_layer_cpu(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, Profiler* profiler)
+{
+#if NCNN_THREADS
+    if (opt.use_inter_op_parallel && opt.num_threads > 1)
+        return forward_layer_parallel(layer_index, blob_mats, opt, profiler);
+#endif // NCNN_THREADS
+
+    return forward_layer(layer_index, blob_mats, opt, profiler);
+}
+
 #if NCNN_VULKAN
 int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
 {
@@ -1180,6 +1572,67 @@ void NetPrivate::update_input_output_names()
 }
 #endif // NCNN_STRING
 
+static bool same_shape(const Mat& a, const Mat& b)
+{
+    return a.dims == b.dims && a.w == b.w && a.h == b.h && a.d == b.d && a.c == b.c && a.n == b.n && a.elemsize == b.elemsize && a.elempack == b.elempack;
+}
+
+ArenaAllocator* NetPrivate::acquire_memory_plan(const std::vector<Mat>& blob_mats, int blob_index)
+{
+    MutexLockGuard lock(memory_plans_lock);
+
+    for (size_t i = 0; i < memory_plans.size(); i++)
+    {
+        MemoryPlan& plan = memory_plans[i];
+        if (plan.in_use || plan.blob_index != blob_index)
+            continue;
+
+        bool match = true;
+        for (size_t j = 0; j < input_blob_indexes.size(); j++)
+        {
+            if (!same_shape(blob_mats[input_blob_indexes[j]], plan.input_shapes[j]))
+            {
+                match = false;
+                break;
+            }
+        }
+
+        // the arena is still referenced by blobs of the previous inference
+        if (!match || plan.allocator->begin_replay() != 0)
+            continue;
+
+        plan.in_use = true;
+        return plan.allocator;
+    }
+
+    return 0;
+}
+
+void NetPrivate::reclaim_memory_plan(ArenaAllocator* allocator)
+{
+    MutexLockGuard lock(memory_plans_lock);
+
+    for (size_t i = 0; i < memory_plans.size(); i++)
+    {
+        if (memory_plans[i].allocator == allocator)
+        {
+            memory_plans[i].in_use = false;
+            return;
+        }
+    }
+}
+
+void NetPrivate::clear_memory_plans()
+{
+    MutexLockGuard lock(memory_plans_lock);
+
+    for (size_t i = 0; i < memory_plans.size(); i++)
+    {
+        delete memory_plans[i].allocator;
+    }
+    memory_plans.clear();
+}
+
 Net::Net()
     : d(new NetPrivate(opt))
 {
@@ -2476,6 +2929,13 @@ void Net::clear()
         d->local_workspace_allocator = 0;
     }
 
+    d->clear_memory_plans();
+
+#if NCNN_THREADS
+    delete d->inter_op_pool;
+    d->inter_op_pool = 0;
+#endif // NCNN_THREADS
+
 #if NCNN_VULKAN
     if (d->weight_vkallocator)
     {
@@ -2501,6 +2961,96 @@ Extractor Net::create_extractor() const
     return Extractor(this, d->blobs.size());
 }
 
+int Net::plan_memory(const std::vector<Mat>& input_shapes)
+{
+    if (input_shapes.size() != d->input_blob_indexes.size())
+    {
+        NCNN_LOGE("plan_memory expect %d input shapes but got %d", (int)d->input_blob_indexes.size(), (int)input_shapes.size());
+        return -1;
+    }
+
+    if (d->output_blob_indexes.empty())
+        return -1;
+
+    MemoryPlan plan;
+    plan.blob_index = d->output_blob_indexes[0];
+    plan.allocator = new ArenaAllocator;
+    plan.in_use = false;
+
+    // record the blob allocations of one inference on zero inputs
+    plan.allocator->begin_record();
+
+    int ret = 0;
+    std::vector<Mat> outputs(d->output_blob_indexes.size());
+    {
+        Extractor ex = create_extractor();
+        ex.set_blob_allocator(plan.allocator);
+
+        for (size_t i = 0; i < input_shapes.size(); i++)
+        {
+            const Mat& shape = input_shapes[i];
+
+            // unfed input
+            if (shape.dims == 0)
+            {
+                plan.input_shapes.push_back(Mat());
+                continue;
+            }
+
+            Mat in;
+            if (shape.n > 1)
+                in.create_like_batch(shape, shape.n);
+            else
+                in.create_like(shape);
+            if (in.empty())
+            {
+                ret = -100;
+                break;
+            }
+
+            memset(in.data, 0, (shape.n > 1 ? in.nstep * in.n : in.total()) * in.elemsize);
+
+            ex.input(d->input_blob_indexes[i], in);
+
+            // keep the shape only
+            Mat input_shape;
+            input_shape.dims = in.dims;
+            input_shape.w = in.w;
+            input_shape.h = in.h;
+            input_shape.d = in.d;
+            input_shape.c = in.c;
+            input_shape.n = in.n;
+            input_shape.elemsize = in.elemsize;
+            input_shape.elempack = in.elempack;
+            plan.input_shapes.push_back(input_shape);
+        }
+
+        for (size_t i = 0; i < outputs.size() && ret == 0; i++)
+        {
+            ret = ex.extract(d->output_blob_indexes[i], outputs[i]);
+        }
+    }
+
+    if (ret == 0)
+    {
+        // the extracted outputs are still alive and left out of the arena
+        ret = plan.allocator->end_record();
+    }
+
+    outputs.clear();
+
+    if (ret != 0)
+    {
+        delete plan.allocator;
+        return ret;
+    }
+
+    MutexLockGuard lock(d->memory_plans_lock);
+    d->memory_plans.push_back(plan);
+
+    return 0;
+}
+
 const std::vector<int>& Net::input_indexes() const
 {
     return d->input_blob_indexes;
@@ -2670,11 +3220,29 @@ public:
     ExtractorPrivate(const Net* _net)
         : net(_net)
     {
+        kv_cache = 0;
+        kv_cache_fed = false;
+        arena_allocator = 0;
+        profiler = 0;
     }
+
+    void feed_kv_cache();
+    int update_kv_cache();
+
     const Net* net;
     std::vector<Mat> blob_mats;
     Option opt;
 
+    KVCache* kv_cache;
+    // past key, past value, key output, value output per attention layer
+    std::vector<int> kv_cache_blob_indexes;
+    bool kv_cache_fed;
+
+    // blob allocator from the net memory plan
+    ArenaAllocator* arena_allocator;
+
+    Profiler* profiler;
+
 #if NCNN_VULKAN
     VkAllocator* local_blob_vkallocator;
     VkAllocator* local_staging_vkallocator;
@@ -2683,6 +3251,51 @@ public:
 #endif // NCNN_VULKAN
 };
 
+void ExtractorPrivate::feed_kv_cache()
+{
+    if (!kv_cache || kv_cache_fed)
+        return;
+
+    for (size_t i = 0; i < kv_cache_blob_indexes.size() / 4; i++)
+    {
+        const int past_key_index = kv_cache_blob_indexes[i * 4];
+        const int past_value_index = kv_cache_blob_indexes[i * 4 + 1];
+
+        const Mat& past_key = kv_cache->past_key((int)i);
+        const Mat& past_value = kv_cache->past_value((int)i);
+
+        // keep what the user fed explicitly
+        if (blob_mats[past_key_index].dims == 0 && !past_key.empty())
+            blob_mats[past_key_index] = past_key;
+        if (blob_mats[past_value_index].dims == 0 && !past_value.empty())
+            blob_mats[past_value_index] = past_value;
+    }
+
+    kv_cache_fed = true;
+}
+
+int ExtractorPrivate::update_kv_cache()
+{
+    if (!kv_cache)
+        return 0;
+
+    for (size_t i = 0; i < kv_cache_blob_indexes.size() / 4; i++)
+    {
+        const Mat& key = blob_mats[kv_cache_blob_indexes[i * 4 + 2]];
+        const Mat& value = blob_mats[kv_cache_blob_indexes[i * 4 + 3]];
+
+        // the attention layer has not been run yet
+        if (key.dims == 0 || value.dims == 0)
+            continue;
+
+        int ret = kv_cache->update((int)i, key, value);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 Extractor::Extractor(const Net* _net, size_t blob_count)
     : d(new ExtractorPrivate(_net))
 {
@@ -2714,6 +3327,16 @@ Extractor::Extractor(const Extractor& rhs)
     d->blob_mats = rhs.d->blob_mats;
     d->opt = rhs.d->opt;
 
+    d->kv_cache = rhs.d->kv_cache;
+    d->kv_cache_blob_indexes = rhs.d->kv_cache_blob_indexes;
+    d->kv_cache_fed = rhs.d->kv_cache_fed;
+
+    d->profiler = rhs.d->profiler;
+
+    // the memory plan stays with rhs
+    if (rhs.d->arena_allocator && d->opt.blob_allocator == rhs.d->arena_allocator)
+        d->opt.blob_allocator = 0;
+
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
     d->local_staging_vkallocator = 0;
@@ -2727,10 +3350,27 @@ Extractor& Extractor::operator=(const Extractor& rhs)
     if (this == &rhs)
         return *this;
 
+    if (d->arena_allocator)
+    {
+        d->blob_mats.clear();
+        d->net->d->reclaim_memory_plan(d->arena_allocator);
+        d->arena_allocator = 0;
+    }
+
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
     d->opt = rhs.d->opt;
 
+    d->kv_cache = rhs.d->kv_cache;
+    d->kv_cache_blob_indexes = rhs.d->kv_cache_blob_indexes;
+    d->kv_cache_fed = rhs.d->kv_cache_fed;
+
+    d->profiler = rhs.d->profiler;
+
+    // the memory plan stays with rhs
+    if (rhs.d->arena_allocator && d->opt.blob_allocator == rhs.d->arena_allocator)
+        d->opt.blob_allocator = 0;
+
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
     d->local_staging_vkallocator = 0;
@@ -2744,6 +3384,16 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 void Extractor::clear()
 {
     d->blob_mats.clear();
+    d->kv_cache_fed = false;
+
+    if (d->arena_allocator)
+    {
+        if (d->opt.blob_allocator == d->arena_allocator)
+            d->opt.blob_allocator = 0;
+
+        d->net->d->reclaim_memory_plan(d->arena_allocator);
+        d->arena_allocator = 0;
+    }
 
 #if NCNN_VULKAN
     if (d->opt.use_vulkan_compute)
@@ -2779,6 +3429,58 @@ void Extractor::set_workspace_allocator(Allocator* allocator)
     d->opt.workspace_allocator = allocator;
 }
 
+void Extractor::set_profiler(Profiler* profiler)
+{
+    d->profiler = profiler;
+}
+
+int Extractor::set_kv_cache(KVCache* kv_cache)
+{
+    d->kv_cache = kv_cache;
+    d->kv_cache_blob_indexes.clear();
+    d->kv_cache_fed = false;
+
+    if (!kv_cache)
+        return 0;
+
+    std::vector<int> token_axes;
+
+    const std::vector<Layer*>& layers = d->net->layers();
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+
+        if (layer->typeindex != LayerType::SDPA && layer->typeindex != LayerType::MultiHeadAttention)
+            continue;
+
+        // kv_cache enabled attention layers output key and value cache after the attention result
+        if (layer->tops.size() != 3 || layer->bottoms.size() < 3)
+            continue;
+
+        const size_t bottom_count = layer->bottoms.size();
+        d->kv_cache_blob_indexes.push_back(layer->bottoms[bottom_count - 2]);
+        d->kv_cache_blob_indexes.push_back(layer->bottoms[bottom_count - 1]);
+        d->kv_cache_blob_indexes.push_back(layer->tops[1]);
+        d->kv_cache_blob_indexes.push_back(layer->tops[2]);
+
+        if (layer->typeindex == LayerType::SDPA)
+        {
+            token_axes.push_back(1);
+        }
+        else
+        {
+            // multiheadattention with query as key is self attention whose cache grows along w
+            // any other form caches the projected memory which stays fixed while decoding
+            const bool self_attention = bottom_count == 3 || layer->bottoms[0] == layer->bottoms[1];
+            token_axes.push_back(self_attention ? 2 : 0);
+        }
+    }
+
+    kv_cache->bind(token_axes);
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 void Extractor::set_blob_vkallocator(VkAllocator* allocator)
 {
@@ -2861,6 +3563,15 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
     {
         int layer_index = d->net->blobs()[blob_index].producer;
 
+        d->feed_kv_cache();
+
+        // use the planned arena for these input shapes
+        if (!d->opt.blob_allocator && d->opt.lightmode)
+        {
+            d->arena_allocator = d->net->d->acquire_memory_plan(d->blob_mats, blob_index);
+            d->opt.blob_allocator = d->arena_allocator;
+        }
+
         // use local allocator
         if (d->opt.use_local_pool_allocator)
         {
@@ -2905,6 +3616,19 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
             {
                 cmd.record_download(feat_gpu, d->blob_mats[blob_index], d->opt);
 
+                // bring the key/value cache outputs back as well
+                for (size_t i = 0; i < d->kv_cache_blob_indexes.size() / 4; i++)
+                {
+                    for (int j = 2; j < 4; j++)
+                    {
+                        const int cache_blob_index = d->kv_cache_blob_indexes[i * 4 + j];
+                        if (d->blob_mats[cache_blob_index].dims == 0 && d->blob_mats_gpu[cache_blob_index].dims != 0)
+                        {
+                            cmd.record_download(d->blob_mats_gpu[cache_blob_index], d->blob_mats[cache_blob_index], d->opt);
+                        }
+                    }
+                }
+
                 ret = cmd.submit_and_wait();
 
 #if NCNN_BENCHMARK
@@ -2925,11 +3649,16 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
         }
         else
         {
-            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+            ret = d->net->d->forward_layer_cpu(layer_index, d->blob_mats, d->opt, d->profiler);
         }
 #else
-        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+        ret = d->net->d->forward_layer_cpu(layer_index, d->blob_mats, d->opt, d->profiler);
 #endif // NCNN_VULKAN
+
+        if (ret == 0)
+        {
+            ret = d->update_kv_cache();
+        }
     }
 
     feat = d->blob_mats[blob_index];
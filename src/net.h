@@ -23,7 +23,9 @@ class VkCompute;
 #endif // NCNN_VULKAN
 class DataReader;
 class Extractor;
+class KVCache;
 class NetPrivate;
+class Profiler;
 class NCNN_EXPORT Net
 {
 public:
@@ -130,6 +132,16 @@ public:
     // construct an Extractor from network
     Extractor create_extractor() const;
 
+    // plan the blob memory for one set of input shapes, call it after load_model
+    // one inference on zero inputs records the blob allocations and their lifetimes,
+    // which are packed into one preallocated arena where dead blobs share memory
+    // later extractors fed with the same input shapes that extract the outputs in order
+    // serve their intermediate blobs from the arena instead of the pool allocator,
+    // requires lightmode and no custom blob allocator on the extractor
+    // input_shapes follow input_indexes, an empty mat for an input that is not fed
+    // return 0 if success
+    int plan_memory(const std::vector<Mat>& input_shapes);
+
     // get input/output indexes/names
     const std::vector<int>& input_indexes() const;
     const std::vector<int>& output_indexes() const;
@@ -189,6 +201,15 @@ public:
     // set workspace memory allocator
     void set_workspace_allocator(Allocator* allocator);
 
+    // attach kv cache for the attention layers with kv_cache enabled
+    // the cached past key/value blobs are fed on the next extract and the updated ones are kept in kv_cache
+    // return 0 if success
+    int set_kv_cache(KVCache* kv_cache);
+
+    // record the per-layer timing of the cpu layers into profiler
+    // pass null to stop recording
+    void set_profiler(Profiler* profiler);
+
 #if NCNN_VULKAN
     void set_blob_vkallocator(VkAllocator* allocator);
 
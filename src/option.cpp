@@ -52,7 +52,7 @@ Option::Option()
     use_weights_in_host_memory = false;
 
     flush_denormals = 3;
-    use_reserved_2f = false;
+    use_inter_op_parallel = false;
     use_reserved_3f = false;
     use_mapped_model_loading = false;
 
@@ -120,7 +120,10 @@ public:
     // 3 = DAZ ON,  FTZ ON
     unsigned char flush_denormals;
 
-    bool use_reserved_2f;
+    // run independent branches of the graph concurrently
+    // up to num_threads layers run at the same time, each one with num_threads threads
+    // disabled by default
+    bool use_inter_op_parallel;
     bool use_reserved_3f;
     bool use_mapped_model_loading;
 
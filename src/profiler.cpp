@@ -0,0 +1,382 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "profiler.h"
+
+#include "benchmark.h"
+#include "layer.h"
+#include "layer_type.h"
+#include "option.h"
+
+#include "layer/convolution.h"
+#include "layer/convolutiondepthwise.h"
+#include "layer/embed.h"
+#include "layer/gemm.h"
+#include "layer/innerproduct.h"
+
+namespace ncnn {
+
+class ProfilerPrivate
+{
+public:
+    // assign the ordinal of the calling thread on its first record
+    int thread_id();
+
+    mutable Mutex lock;
+    std::vector<LayerProfile> records;
+    double origin;
+
+    ThreadLocalStorage tls_thread_id;
+    int thread_count;
+};
+
+int ProfilerPrivate::thread_id()
+{
+    // stored as id + 1, zero for unseen thread
+    size_t id = reinterpret_cast<size_t>(tls_thread_id.get());
+    if (id == 0)
+    {
+        id = (size_t)(++thread_count);
+        tls_thread_id.set(reinterpret_cast<void*>(id));
+    }
+
+    return (int)id - 1;
+}
+
+static Mat shape_of(const Mat& m)
+{
+    Mat shape;
+    shape.dims = m.dims;
+    shape.w = m.w;
+    shape.h = m.h;
+    shape.d = m.d;
+    shape.c = m.c;
+    shape.n = m.n;
+    shape.elempack = m.elempack;
+    shape.elemsize = m.elemsize;
+    return shape;
+}
+
+static const char* get_kernel_path(const Layer* layer, const std::vector<Mat>& bottom_shapes, const Option& opt)
+{
+    const Mat bottom_shape = bottom_shapes.empty() ? Mat() : bottom_shapes[0];
+    const bool int8_input = bottom_shape.elemsize != 0 && bottom_shape.elembits() == 8;
+
+    if (layer->typeindex == LayerType::Convolution)
+    {
+        const Convolution* conv = (const Convolution*)layer;
+        if (int8_input || (opt.use_int8_inference && conv->int8_scale_term))
+            return "int8";
+
+        const int maxk = conv->kernel_w * conv->kernel_h;
+        const int num_input = conv->weight_data_size / maxk / conv->num_output;
+
+        const bool use_winograd = opt.use_winograd23_convolution || opt.use_winograd43_convolution || opt.use_winograd63_convolution;
+        if (opt.use_winograd_convolution && use_winograd && (num_input > 8 || conv->num_output > 8)
+                && conv->kernel_w == 3 && conv->kernel_h == 3 && conv->dilation_w == 1 && conv->dilation_h == 1 && conv->stride_w == 1 && conv->stride_h == 1)
+            return "winograd";
+
+        if (opt.use_sgemm_convolution || maxk == 1)
+            return "sgemm";
+
+        return "direct";
+    }
+
+    if (layer->typeindex == LayerType::ConvolutionDepthWise)
+    {
+        const ConvolutionDepthWise* convdw = (const ConvolutionDepthWise*)layer;
+        if (int8_input || (opt.use_int8_inference && convdw->int8_scale_term))
+            return "int8";
+    }
+
+    if (layer->typeindex == LayerType::InnerProduct)
+    {
+        const InnerProduct* innerproduct = (const InnerProduct*)layer;
+        if (innerproduct->weight_quant_bits)
+            return innerproduct->weight_quant_bits == 4 ? "weight_int4" : "weight_int8";
+        if (int8_input || (opt.use_int8_inference && innerproduct->int8_scale_term))
+            return "int8";
+    }
+
+    if (layer->typeindex == LayerType::Embed)
+    {
+        const Embed* embed = (const Embed*)layer;
+        if (embed->weight_quant_bits)
+            return embed->weight_quant_bits == 4 ? "weight_int4" : "weight_int8";
+        if (embed->int8_scale_term)
+            return "int8";
+    }
+
+    if (layer->typeindex == LayerType::Gemm)
+    {
+        const Gemm* gemm = (const Gemm*)layer;
+        if (gemm->weight_quant_bits)
+            return gemm->weight_quant_bits == 4 ? "weight_int4" : "weight_int8";
+        if (opt.use_int8_inference && gemm->int8_scale_term)
+            return "int8";
+    }
+
+    if (bottom_shape.elempack > 1)
+        return "packed";
+
+    return "";
+}
+
+Profiler::Profiler()
+    : d(new ProfilerPrivate)
+{
+    d->origin = get_current_time();
+    d->thread_count = 0;
+}
+
+Profiler::~Profiler()
+{
+    delete d;
+}
+
+Profiler::Profiler(const Profiler&)
+    : d(0)
+{
+}
+
+Profiler& Profiler::operator=(const Profiler&)
+{
+    return *this;
+}
+
+void Profiler::clear()
+{
+    MutexLockGuard guard(d->lock);
+
+    d->records.clear();
+    d->origin = get_current_time();
+}
+
+std::vector<LayerProfile> Profiler::records() const
+{
+    MutexLockGuard guard(d->lock);
+
+    return d->records;
+}
+
+std::vector<LayerTypeProfile> Profiler::summary() const
+{
+    std::vector<LayerTypeProfile> types;
+
+    {
+        MutexLockGuard guard(d->lock);
+
+        for (size_t i = 0; i < d->records.size(); i++)
+        {
+            const LayerProfile& r = d->records[i];
+            const double duration = r.end - r.start;
+
+            size_t j = 0;
+            for (; j < types.size(); j++)
+            {
+                if (types[j].typeindex == r.typeindex)
+                    break;
+            }
+
+            if (j == types.size())
+            {
+                LayerTypeProfile t;
+                t.typeindex = r.typeindex;
+#if NCNN_STRING
+                t.type = r.type;
+#endif
+                t.count = 0;
+                t.total = 0.0;
+                t.min = duration;
+                t.max = duration;
+                types.push_back(t);
+            }
+
+            LayerTypeProfile& t = types[j];
+            t.count++;
+            t.total += duration;
+            t.min = std::min(t.min, duration);
+            t.max = std::max(t.max, duration);
+        }
+    }
+
+    // most expensive first
+    for (size_t i = 1; i < types.size(); i++)
+    {
+        LayerTypeProfile t = types[i];
+
+        size_t j = i;
+        for (; j > 0 && types[j - 1].total < t.total; j--)
+        {
+            types[j] = types[j - 1];
+        }
+        types[j] = t;
+    }
+
+    return types;
+}
+
+#if NCNN_STDIO
+static void print_json_string(FILE* fp, const char* s)
+{
+    fputc('"', fp);
+    for (; *s; s++)
+    {
+        const char c = *s;
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', fp);
+            fputc(c, fp);
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            fprintf(fp, "\\u%04x", (unsigned char)c);
+        }
+        else
+        {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+static void print_shape_list(FILE* fp, const std::vector<Mat>& shapes)
+{
+    fputc('"', fp);
+    for (size_t i = 0; i < shapes.size(); i++)
+    {
+        const Mat& m = shapes[i];
+
+        if (i != 0)
+            fputc(' ', fp);
+
+        if (m.dims == 1)
+            fprintf(fp, "[%d *%d]", m.w, m.elempack);
+        if (m.dims == 2)
+            fprintf(fp, "[%d,%d *%d]", m.w, m.h, m.elempack);
+        if (m.dims == 3)
+            fprintf(fp, "[%d,%d,%d *%d]", m.w, m.h, m.c, m.elempack);
+        if (m.dims == 4)
+            fprintf(fp, "[%d,%d,%d,%d *%d]", m.w, m.h, m.d, m.c, m.elempack);
+        if (m.dims != 0 && m.n > 1)
+            fprintf(fp, "x%d", m.n);
+    }
+    fputc('"', fp);
+}
+
+int Profiler::write_chrome_trace(FILE* fp) const
+{
+    std::vector<LayerProfile> records = this->records();
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const LayerProfile& r = records[i];
+
+        fprintf(fp, "{\"name\":");
+#if NCNN_STRING
+        print_json_string(fp, r.name);
+        fprintf(fp, ",\"cat\":");
+        print_json_string(fp, r.type);
+#else
+        fprintf(fp, "\"layer%d\",\"cat\":\"%d\"", r.layer_index, r.typeindex);
+#endif
+        // microseconds
+        fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d", r.start * 1000, (r.end - r.start) * 1000, r.thread_id);
+
+        fprintf(fp, ",\"args\":{\"layer_index\":%d,\"in\":", r.layer_index);
+        print_shape_list(fp, r.bottom_shapes);
+        fprintf(fp, ",\"out\":");
+        print_shape_list(fp, r.top_shapes);
+        fprintf(fp, ",\"elempack\":%d", r.top_shapes.empty() ? 0 : r.top_shapes[0].elempack);
+        fprintf(fp, ",\"allocated\":%zu,\"kernel\":", r.allocated);
+        print_json_string(fp, r.kernel);
+        fprintf(fp, ",\"num_threads\":%d}}", r.num_threads);
+
+        fprintf(fp, i + 1 == records.size() ? "\n" : ",\n");
+    }
+
+    fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    return ferror(fp) ? -1 : 0;
+}
+
+int Profiler::write_chrome_trace(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    int ret = write_chrome_trace(fp);
+
+    fclose(fp);
+
+    return ret;
+}
+
+void Profiler::print_summary(FILE* fp) const
+{
+    std::vector<LayerTypeProfile> types = summary();
+
+    double total = 0.0;
+    for (size_t i = 0; i < types.size(); i++)
+    {
+        total += types[i].total;
+    }
+
+    fprintf(fp, "%-24s %8s %12s %10s %10s %10s %8s\n", "type", "count", "total(ms)", "avg(ms)", "min(ms)", "max(ms)", "%");
+
+    for (size_t i = 0; i < types.size(); i++)
+    {
+        const LayerTypeProfile& t = types[i];
+
+#if NCNN_STRING
+        fprintf(fp, "%-24s", t.type);
+#else
+        fprintf(fp, "%-24d", t.typeindex);
+#endif
+        fprintf(fp, " %8d %12.3f %10.3f %10.3f %10.3f %7.2f%%\n", t.count, t.total, t.total / t.count, t.min, t.max, total > 0.0 ? t.total / total * 100 : 0.0);
+    }
+}
+#endif // NCNN_STDIO
+
+void Profiler::record(const Layer* layer, int layer_index, const std::vector<Mat>& bottom_shapes, const std::vector<Mat>& top_blobs, double start, double end, const Option& opt)
+{
+    LayerProfile r;
+    r.layer_index = layer_index;
+    r.typeindex = layer->typeindex;
+#if NCNN_STRING
+    r.type = layer->type.c_str();
+    r.name = layer->name.c_str();
+#endif
+    r.num_threads = opt.num_threads;
+    r.bottom_shapes = bottom_shapes;
+    r.kernel = get_kernel_path(layer, bottom_shapes, opt);
+
+    const bool inplace = opt.lightmode && layer->support_inplace;
+
+    r.allocated = 0;
+    r.top_shapes.resize(top_blobs.size());
+    for (size_t i = 0; i < top_blobs.size(); i++)
+    {
+        const Mat& m = top_blobs[i];
+        r.top_shapes[i] = shape_of(m);
+
+        if (!inplace)
+            r.allocated += m.total() * m.elemsize;
+    }
+
+    MutexLockGuard guard(d->lock);
+
+    r.start = start - d->origin;
+    r.end = end - d->origin;
+    r.thread_id = d->thread_id();
+
+    d->records.push_back(r);
+}
+
+} // namespace ncnn
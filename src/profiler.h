@@ -0,0 +1,116 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_PROFILER_H
+#define NCNN_PROFILER_H
+
+#include "mat.h"
+#include "platform.h"
+
+#if NCNN_STDIO
+#include <stdio.h>
+#endif // NCNN_STDIO
+
+namespace ncnn {
+
+class Layer;
+class Option;
+
+// one layer forward captured by the profiler
+struct LayerProfile
+{
+    int layer_index;
+    int typeindex;
+#if NCNN_STRING
+    // points to the layer type and name, valid while the net is loaded
+    const char* type;
+    const char* name;
+#endif // NCNN_STRING
+
+    // wall time in ms since the profiler was created or cleared
+    double start;
+    double end;
+
+    // ordinal of the thread that ran the layer, from 0
+    int thread_id;
+    // openmp threads of the layer
+    int num_threads;
+
+    // blob shapes without data, with elempack and elemsize
+    std::vector<Mat> bottom_shapes;
+    std::vector<Mat> top_shapes;
+
+    // bytes of the top blobs created by the layer, zero for inplace forward
+    size_t allocated;
+
+    // the algorithm the cpu backends select for the layer,
+    // winograd / sgemm / direct for convolution, int8 for quantized layers,
+    // weight_int8 / weight_int4 for weight-only quantized gemm,
+    // packed for other layers on packed blobs, empty otherwise
+    const char* kernel;
+};
+
+// the layers of the same type aggregated
+struct LayerTypeProfile
+{
+    int typeindex;
+#if NCNN_STRING
+    const char* type;
+#endif // NCNN_STRING
+
+    int count;
+    // in ms
+    double total;
+    double min;
+    double max;
+};
+
+// per-layer timing collected at runtime, attach it to extractors with Extractor::set_profiler()
+// one profiler can be shared by extractors running on different threads
+// layers forwarded on gpu are not recorded
+class ProfilerPrivate;
+class NCNN_EXPORT Profiler
+{
+public:
+    // empty
+    Profiler();
+    // destroy records
+    virtual ~Profiler();
+
+    // discard the records and restart the clock
+    void clear();
+
+    // records in completion order
+    std::vector<LayerProfile> records() const;
+
+    // the records aggregated by layer type, the most expensive type first
+    std::vector<LayerTypeProfile> summary() const;
+
+#if NCNN_STDIO
+    // write the records as chrome trace event json
+    // load it in chrome://tracing or https://ui.perfetto.dev
+    // return 0 if success
+    int write_chrome_trace(FILE* fp) const;
+    int write_chrome_trace(const char* path) const;
+
+    // print the per layer type summary table
+    void print_summary(FILE* fp = stderr) const;
+#endif // NCNN_STDIO
+
+protected:
+    friend class NetPrivate;
+
+    // called by the net after each layer forward on cpu
+    void record(const Layer* layer, int layer_index, const std::vector<Mat>& bottom_shapes, const std::vector<Mat>& top_blobs, double start, double end, const Option& opt);
+
+private:
+    Profiler(const Profiler&);
+    Profiler& operator=(const Profiler&);
+
+private:
+    ProfilerPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_PROFILER_H
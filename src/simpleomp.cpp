@@ -6,13 +6,21 @@
 #if NCNN_SIMPLEOMP
 
 #include "simpleomp.h"
-#include "cpu.h" // ncnn::get_cpu_count()
+#include "allocator.h" // NCNN_XADD
+#include "benchmark.h" // ncnn::get_current_time()
+#include "cpu.h"       // ncnn::get_cpu_count()
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdarg.h>
+#include <sched.h>
+
+#if defined __ANDROID__ || defined __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #if __clang__
 extern "C" typedef void (*kmpc_micro)(int32_t* gtid, int32_t* tid, ...);
@@ -61,6 +69,31 @@ static void* kmp_threadfunc(void* args);
 } // extern "C"
 #endif
 
+// spin time in ms of the idle threads
+static volatile int g_kmp_blocktime = 0;
+
+// omp_sched_t and chunks per thread
+static volatile int g_kmp_schedule = omp_sched_static;
+static volatile int g_kmp_chunks = 4;
+
+// busy wait within the blocktime while (*value != 0) != until_nonzero
+// the caller takes the lock and checks again afterwards
+static void kmp_spin(const volatile int* value, bool until_nonzero)
+{
+    const int blocktime = g_kmp_blocktime;
+    if (blocktime <= 0)
+        return;
+
+    const double end = ncnn::get_current_time() + blocktime;
+    for (int i = 1; (*value != 0) != until_nonzero; i++)
+    {
+        sched_yield();
+
+        if (i % 16 == 0 && ncnn::get_current_time() > end)
+            break;
+    }
+}
+
 namespace ncnn {
 
 class KMPTask
@@ -79,6 +112,11 @@ public:
 #endif
     int num_threads;
 
+    // dynamic schedule, the team threads take chunks from next_chunk until num_chunks
+    // num_chunks is zero for the static schedule
+    int* next_chunk;
+    int num_chunks;
+
     // per-task
     int thread_num;
 
@@ -154,6 +192,9 @@ public:
 
     void get(KMPTask*& v)
     {
+        // the next parallel region is likely to come soon, avoid the sleep and wake up
+        kmp_spin(&size, true);
+
         lock.lock();
         while (size == 0)
         {
@@ -176,7 +217,7 @@ private:
     // ring buffer queue
     int max_size;
     KMPTask** tasks;
-    int size;
+    volatile int size;
     int front;
     int back;
 };
@@ -189,6 +230,8 @@ public:
         kmp_max_threads = 0;
         kmp_threads = 0;
         kmp_threads_tid = 0;
+        kmp_threads_pid = 0;
+        kmp_threads_started = 0;
         kmp_task_queue = 0;
     }
 
@@ -212,16 +255,46 @@ public:
 
         kmp_task_queue = new ncnn::KMPTaskQueue(std::max(kmp_max_threads * 4, 16));
 
+        const char* omp_schedule = getenv("OMP_SCHEDULE");
+        if (omp_schedule && strncmp(omp_schedule, "dynamic", 7) == 0)
+        {
+            g_kmp_schedule = omp_sched_dynamic;
+        }
+
         if (kmp_max_threads > 1)
         {
             kmp_threads = new ncnn::Thread*[kmp_max_threads - 1];
             kmp_threads_tid = new int[kmp_max_threads - 1];
+            kmp_threads_pid = new int[kmp_max_threads - 1];
             for (int i = 0; i < kmp_max_threads - 1; i++)
             {
                 kmp_threads_tid[i] = i + 1;
+                kmp_threads_pid[i] = 0;
                 kmp_threads[i] = new ncnn::Thread(kmp_threadfunc, (void*)&kmp_threads_tid[i]);
             }
+
+            // wait for the worker system thread ids
+            kmp_threads_lock.lock();
+            while (kmp_threads_started < kmp_max_threads - 1)
+            {
+                kmp_threads_condition.wait(kmp_threads_lock);
+            }
+            kmp_threads_lock.unlock();
+        }
+    }
+
+    void started(int tid)
+    {
+        kmp_threads_lock.lock();
+#if defined __ANDROID__ || defined __linux__
+        kmp_threads_pid[tid - 1] = (int)syscall(SYS_gettid);
+#endif
+        kmp_threads_started++;
+        if (kmp_threads_started == kmp_max_threads - 1)
+        {
+            kmp_threads_condition.signal();
         }
+        kmp_threads_lock.unlock();
     }
 
     void deinit()
@@ -242,6 +315,8 @@ public:
                 tasks[i].data = 0;
 #endif
                 tasks[i].num_threads = kmp_max_threads;
+                tasks[i].next_chunk = 0;
+                tasks[i].num_chunks = 0;
                 tasks[i].thread_num = i + 1;
                 tasks[i].num_threads_to_wait = 0;
                 tasks[i].finish_lock = 0;
@@ -263,6 +338,7 @@ public:
             }
             delete[] kmp_threads;
             delete[] kmp_threads_tid;
+            delete[] kmp_threads_pid;
         }
 
         delete kmp_task_queue;
@@ -272,6 +348,11 @@ public:
     int kmp_max_threads;
     ncnn::Thread** kmp_threads;
     int* kmp_threads_tid;
+    // system thread id for pinning
+    int* kmp_threads_pid;
+    int kmp_threads_started;
+    ncnn::Mutex kmp_threads_lock;
+    ncnn::ConditionVariable kmp_threads_condition;
     ncnn::KMPTaskQueue* kmp_task_queue;
 };
 
@@ -283,6 +364,7 @@ static ncnn::KMPGlobal g_kmp_global;
 
 static ncnn::ThreadLocalStorage tls_num_threads;
 static ncnn::ThreadLocalStorage tls_thread_num;
+static ncnn::ThreadLocalStorage tls_team_thread_num;
 
 static void init_g_kmp_global()
 {
@@ -323,17 +405,36 @@ int omp_get_thread_num()
     return (int)reinterpret_cast<size_t>(tls_thread_num.get());
 }
 
-#if __clang__
+int kmp_get_team_thread_num()
+{
+    return (int)reinterpret_cast<size_t>(tls_team_thread_num.get());
+}
+
+void omp_set_schedule(omp_sched_t kind, int chunk_size)
+{
+    // static and dynamic only
+    g_kmp_schedule = kind == omp_sched_dynamic ? omp_sched_dynamic : omp_sched_static;
+    g_kmp_chunks = chunk_size > 0 ? chunk_size : 4;
+}
+
+void omp_get_schedule(omp_sched_t* kind, int* chunk_size)
+{
+    *kind = (omp_sched_t)g_kmp_schedule;
+    *chunk_size = g_kmp_chunks;
+}
+
 int kmp_get_blocktime()
 {
-    return 0;
+    return g_kmp_blocktime;
 }
 
-void kmp_set_blocktime(int /*blocktime*/)
+void kmp_set_blocktime(int blocktime)
 {
-    // always passive, ignore
+    g_kmp_blocktime = std::max(blocktime, 0);
 }
 
+#if __clang__
+
 static int kmp_invoke_microtask(kmpc_micro fn, int gtid, int tid, int argc, void** argv)
 {
     // fprintf(stderr, "__kmp_invoke_microtask %d %d %d\n", gtid, tid, argc);
@@ -445,13 +546,65 @@ static int kmp_invoke_microtask(kmpc_micro fn, int gtid, int tid, int argc, void
 }
 #endif // __clang__
 
-static void* kmp_threadfunc(void* args)
+static void kmp_run_task(const ncnn::KMPTask* task, int tid)
 {
+    tls_team_thread_num.set(reinterpret_cast<void*>((size_t)task->thread_num));
+
+    if (task->num_chunks == 0)
+    {
+        tls_num_threads.set(reinterpret_cast<void*>((size_t)task->num_threads));
+        tls_thread_num.set(reinterpret_cast<void*>((size_t)task->thread_num));
+
 #if __clang__
-    int tid = *(int*)args;
+        kmp_invoke_microtask(task->fn, task->thread_num, tid, task->argc, task->argv);
+#else
+        (void)tid;
+        task->fn(task->data);
+#endif
+        return;
+    }
+
+    // the loop is partitioned into num_chunks parts, take the next part until none is left
+    tls_num_threads.set(reinterpret_cast<void*>((size_t)task->num_chunks));
+
+    for (;;)
+    {
+        const int chunk = NCNN_XADD(task->next_chunk, 1);
+        if (chunk >= task->num_chunks)
+            break;
+
+        tls_thread_num.set(reinterpret_cast<void*>((size_t)chunk));
+
+#if __clang__
+        kmp_invoke_microtask(task->fn, chunk, tid, task->argc, task->argv);
 #else
-    (void)args;
+        task->fn(task->data);
 #endif
+    }
+}
+
+static int kmp_team_chunks(int num_threads)
+{
+    return g_kmp_schedule == omp_sched_dynamic ? num_threads * g_kmp_chunks : 0;
+}
+
+static void kmp_wait_team(int* num_threads_to_wait, ncnn::Mutex* finish_lock, ncnn::ConditionVariable* finish_condition)
+{
+    kmp_spin(num_threads_to_wait, false);
+
+    finish_lock->lock();
+    while (*num_threads_to_wait != 0)
+    {
+        finish_condition->wait(*finish_lock);
+    }
+    finish_lock->unlock();
+}
+
+static void* kmp_threadfunc(void* args)
+{
+    int tid = *(int*)args;
+
+    g_kmp_global.started(tid);
 
     for (;;)
     {
@@ -463,14 +616,7 @@ static void* kmp_threadfunc(void* args)
         if (!task->fn)
             break;
 
-        tls_num_threads.set(reinterpret_cast<void*>((size_t)task->num_threads));
-        tls_thread_num.set(reinterpret_cast<void*>((size_t)task->thread_num));
-
-#if __clang__
-        kmp_invoke_microtask(task->fn, task->thread_num, tid, task->argc, task->argv);
-#else
-        task->fn(task->data);
-#endif
+        kmp_run_task(task, tid);
 
         // update finished
         {
@@ -523,6 +669,7 @@ void __kmpc_fork_call(void* /*loc*/, int32_t argc, kmpc_micro fn, ...)
         for (int i = 0; i < num_threads; i++)
         {
             tls_thread_num.set(reinterpret_cast<void*>((size_t)i));
+            tls_team_thread_num.set(reinterpret_cast<void*>((size_t)i));
 
             kmp_invoke_microtask(fn, 0, 0, argc, argv);
         }
@@ -534,40 +681,37 @@ void __kmpc_fork_call(void* /*loc*/, int32_t argc, kmpc_micro fn, ...)
     ncnn::Mutex finish_lock;
     ncnn::ConditionVariable finish_condition;
 
+    int next_chunk = 0;
+    const int num_chunks = kmp_team_chunks(num_threads);
+
     // TODO portable stack allocation
-    ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca((num_threads - 1) * sizeof(ncnn::KMPTask));
-    for (int i = 0; i < num_threads - 1; i++)
+    ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca(num_threads * sizeof(ncnn::KMPTask));
+    for (int i = 0; i < num_threads; i++)
     {
         tasks[i].fn = fn;
         tasks[i].argc = argc;
         tasks[i].argv = (void**)argv;
         tasks[i].num_threads = num_threads;
-        tasks[i].thread_num = i + 1;
+        tasks[i].next_chunk = &next_chunk;
+        tasks[i].num_chunks = num_chunks;
+        tasks[i].thread_num = i;
         tasks[i].num_threads_to_wait = &num_threads_to_wait;
         tasks[i].finish_lock = &finish_lock;
         tasks[i].finish_condition = &finish_condition;
     }
 
     // dispatch 1 ~ num_threads
-    g_kmp_global.kmp_task_queue->dispatch(tasks, num_threads - 1);
+    g_kmp_global.kmp_task_queue->dispatch(tasks + 1, num_threads - 1);
 
     // dispatch 0
-    {
-        tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
-        tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
-
-        kmp_invoke_microtask(fn, 0, 0, argc, argv);
-    }
+    kmp_run_task(&tasks[0], 0);
 
     // wait for finished
-    {
-        finish_lock.lock();
-        if (num_threads_to_wait != 0)
-        {
-            finish_condition.wait(finish_lock);
-        }
-        finish_lock.unlock();
-    }
+    kmp_wait_team(&num_threads_to_wait, &finish_lock, &finish_condition);
+
+    // restore the requested team size
+    tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
+    tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
 }
 
 void __kmpc_for_static_init_4(void* /*loc*/, int32_t gtid, int32_t /*sched*/, int32_t* last, int32_t* lower, int32_t* upper, int32_t* /*stride*/, int32_t /*incr*/, int32_t /*chunk*/)
@@ -667,6 +811,7 @@ void GOMP_parallel_start(void (*fn)(void*), void* data, unsigned num_threads)
         {
             tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
             tls_thread_num.set(reinterpret_cast<void*>((size_t)i));
+            tls_team_thread_num.set(reinterpret_cast<void*>((size_t)i));
 
             fn(data);
         }
@@ -686,6 +831,8 @@ void GOMP_parallel_start(void (*fn)(void*), void* data, unsigned num_threads)
         pc->tasks[i].fn = fn;
         pc->tasks[i].data = data;
         pc->tasks[i].num_threads = num_threads;
+        pc->tasks[i].next_chunk = 0;
+        pc->tasks[i].num_chunks = 0;
         pc->tasks[i].thread_num = i + 1;
         pc->tasks[i].num_threads_to_wait = &pc->num_threads_to_wait;
         pc->tasks[i].finish_lock = &pc->finish_lock;
@@ -699,6 +846,7 @@ void GOMP_parallel_start(void (*fn)(void*), void* data, unsigned num_threads)
     {
         tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
         tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
+        tls_team_thread_num.set(reinterpret_cast<void*>((size_t)0));
     }
 }
 
@@ -709,14 +857,7 @@ void GOMP_parallel_end()
     tls_parallel_context.set(0);
 
     // wait for finished
-    {
-        pc->finish_lock.lock();
-        if (pc->num_threads_to_wait != 0)
-        {
-            pc->finish_condition.wait(pc->finish_lock);
-        }
-        pc->finish_lock.unlock();
-    }
+    kmp_wait_team(&pc->num_threads_to_wait, &pc->finish_lock, &pc->finish_condition);
 
     delete[] pc->tasks;
     delete pc;
@@ -738,6 +879,7 @@ void GOMP_parallel(void (*fn)(void*), void* data, unsigned num_threads, unsigned
         {
             tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
             tls_thread_num.set(reinterpret_cast<void*>((size_t)i));
+            tls_team_thread_num.set(reinterpret_cast<void*>((size_t)i));
 
             fn(data);
         }
@@ -749,39 +891,36 @@ void GOMP_parallel(void (*fn)(void*), void* data, unsigned num_threads, unsigned
     ncnn::Mutex finish_lock;
     ncnn::ConditionVariable finish_condition;
 
+    int next_chunk = 0;
+    const int num_chunks = kmp_team_chunks(num_threads);
+
     // TODO portable stack allocation
-    ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca((num_threads - 1) * sizeof(ncnn::KMPTask));
-    for (unsigned i = 0; i < num_threads - 1; i++)
+    ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca(num_threads * sizeof(ncnn::KMPTask));
+    for (unsigned i = 0; i < num_threads; i++)
     {
         tasks[i].fn = fn;
         tasks[i].data = data;
         tasks[i].num_threads = num_threads;
-        tasks[i].thread_num = i + 1;
+        tasks[i].next_chunk = &next_chunk;
+        tasks[i].num_chunks = num_chunks;
+        tasks[i].thread_num = i;
         tasks[i].num_threads_to_wait = &num_threads_to_wait;
         tasks[i].finish_lock = &finish_lock;
         tasks[i].finish_condition = &finish_condition;
     }
 
     // dispatch 1 ~ num_threads
-    g_kmp_global.kmp_task_queue->dispatch(tasks, num_threads - 1);
+    g_kmp_global.kmp_task_queue->dispatch(tasks + 1, num_threads - 1);
 
     // dispatch 0
-    {
-        tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
-        tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
-
-        fn(data);
-    }
+    kmp_run_task(&tasks[0], 0);
 
     // wait for finished
-    {
-        finish_lock.lock();
-        if (num_threads_to_wait != 0)
-        {
-            finish_condition.wait(finish_lock);
-        }
-        finish_lock.unlock();
-    }
+    kmp_wait_team(&num_threads_to_wait, &finish_lock, &finish_condition);
+
+    // restore the requested team size
+    tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
+    tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
 }
 #endif // __clang__
 
@@ -789,4 +928,30 @@ void GOMP_parallel(void (*fn)(void*), void* data, unsigned num_threads, unsigned
 } // extern "C"
 #endif
 
+namespace ncnn {
+
+int set_simpleomp_worker_affinity(const CpuSet& thread_affinity_mask)
+{
+    g_kmp_global.try_init();
+
+#if defined __ANDROID__ || defined __linux__
+    for (int i = 0; i < g_kmp_global.kmp_max_threads - 1; i++)
+    {
+        int syscallret = syscall(__NR_sched_setaffinity, g_kmp_global.kmp_threads_pid[i], sizeof(cpu_set_t), &thread_affinity_mask.cpu_set);
+        if (syscallret)
+        {
+            NCNN_LOGE("syscall error %d", syscallret);
+            return -1;
+        }
+    }
+
+    return 0;
+#else
+    (void)thread_affinity_mask;
+    return -1;
+#endif
+}
+
+} // namespace ncnn
+
 #endif // NCNN_SIMPLEOMP
@@ -31,12 +31,45 @@ NCNN_EXPORT int omp_get_thread_num();
 
 NCNN_EXPORT int kmp_get_blocktime();
 
+// idle workers spin for blocktime ms before going to sleep
 NCNN_EXPORT void kmp_set_blocktime(int blocktime);
 
+typedef enum omp_sched_t
+{
+    omp_sched_static = 1,
+    omp_sched_dynamic = 2,
+    omp_sched_guided = 3,
+    omp_sched_auto = 4
+} omp_sched_t;
+
+// process wide loop schedule of the parallel for loops, omp_sched_static by default
+// omp_sched_dynamic splits the loop into chunk_size chunks per thread, the team threads
+// take the next chunk as soon as they are done so that the fast cores do more of the work
+// chunk_size <= 0 selects 4 chunks per thread
+NCNN_EXPORT void omp_set_schedule(omp_sched_t kind, int chunk_size);
+
+NCNN_EXPORT void omp_get_schedule(omp_sched_t* kind, int* chunk_size);
+
+// the thread index in the team, omp_get_thread_num() returns the chunk index under omp_sched_dynamic
+// use it to index the per-thread buffers
+NCNN_EXPORT int kmp_get_team_thread_num();
+
 #ifdef __cplusplus
 }
 #endif
 
+#ifdef __cplusplus
+namespace ncnn {
+
+class CpuSet;
+
+// bind all the worker threads to the cpus in thread_affinity_mask
+// return 0 if success
+NCNN_EXPORT int set_simpleomp_worker_affinity(const CpuSet& thread_affinity_mask);
+
+} // namespace ncnn
+#endif
+
 #endif // NCNN_SIMPLEOMP
 
 #endif // NCNN_SIMPLEOMP_H
@@ -0,0 +1,272 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "speculative.h"
+
+namespace ncnn {
+
+TokenDecoder::~TokenDecoder()
+{
+}
+
+class SpeculativeDecoderPrivate
+{
+public:
+    // forward the tokens the decoder has not seen yet plus the extra ones
+    int forward_pending(TokenDecoder* decoder, const std::vector<int>& extra, Mat& logits, int& pending_row);
+
+    TokenDecoder* target;
+    TokenDecoder* draft;
+    int draft_count;
+
+    // the last token is pending, not yet in the context of the target
+    std::vector<int> tokens;
+
+    int target_forward_count;
+    int draft_forward_count;
+    int proposed_count;
+    int accepted_count;
+};
+
+static int argmax(const Mat& logits, int row)
+{
+    const int vocab_size = logits.w;
+    const float* ptr = (const float*)logits + (size_t)vocab_size * row;
+
+    int index = 0;
+    float max = ptr[0];
+    for (int i = 1; i < vocab_size; i++)
+    {
+        if (ptr[i] > max)
+        {
+            index = i;
+            max = ptr[i];
+        }
+    }
+
+    return index;
+}
+
+int SpeculativeDecoderPrivate::forward_pending(TokenDecoder* decoder, const std::vector<int>& extra, Mat& logits, int& pending_row)
+{
+    const int seqlen = decoder->seqlen();
+
+    std::vector<int> input;
+    for (int i = seqlen; i < (int)tokens.size(); i++)
+    {
+        input.push_back(tokens[i]);
+    }
+
+    // the row scoring the token after the pending ones
+    pending_row = (int)input.size() - 1;
+
+    for (size_t i = 0; i < extra.size(); i++)
+    {
+        input.push_back(extra[i]);
+    }
+
+    int ret = decoder->forward(input, logits);
+    if (ret != 0)
+        return ret;
+
+    if (logits.empty() || logits.elemsize != 4u || logits.elempack != 1 || (logits.dims == 1 ? 1 : logits.h) != (int)input.size())
+    {
+        NCNN_LOGE("decoder logits must be fp32 with one row per token");
+        return -1;
+    }
+
+    return 0;
+}
+
+SpeculativeDecoder::SpeculativeDecoder(TokenDecoder* target, TokenDecoder* draft)
+    : d(new SpeculativeDecoderPrivate)
+{
+    d->target = target;
+    d->draft = draft;
+    d->draft_count = 4;
+    d->target_forward_count = 0;
+    d->draft_forward_count = 0;
+    d->proposed_count = 0;
+    d->accepted_count = 0;
+}
+
+SpeculativeDecoder::~SpeculativeDecoder()
+{
+    delete d;
+}
+
+SpeculativeDecoder::SpeculativeDecoder(const SpeculativeDecoder&)
+    : d(0)
+{
+}
+
+SpeculativeDecoder& SpeculativeDecoder::operator=(const SpeculativeDecoder&)
+{
+    return *this;
+}
+
+void SpeculativeDecoder::set_draft_count(int draft_count)
+{
+    d->draft_count = draft_count;
+}
+
+int SpeculativeDecoder::prefill(const std::vector<int>& prompt)
+{
+    if (prompt.empty())
+    {
+        NCNN_LOGE("prefill with empty prompt");
+        return -1;
+    }
+
+    d->tokens = prompt;
+    d->target_forward_count = 0;
+    d->draft_forward_count = 0;
+    d->proposed_count = 0;
+    d->accepted_count = 0;
+
+    d->target->truncate(0);
+    if (d->draft)
+        d->draft->truncate(0);
+
+    if (prompt.size() == 1)
+        return 0;
+
+    // keep the last token pending, the first step feeds it with the draft tokens
+    std::vector<int> context;
+    for (size_t i = 0; i + 1 < prompt.size(); i++)
+    {
+        context.push_back(prompt[i]);
+    }
+
+    Mat logits;
+    int ret = d->target->forward(context, logits);
+    if (ret != 0)
+        return ret;
+
+    d->target_forward_count++;
+
+    if (d->draft)
+    {
+        ret = d->draft->forward(context, logits);
+        if (ret != 0)
+            return ret;
+
+        d->draft_forward_count++;
+    }
+
+    return 0;
+}
+
+int SpeculativeDecoder::step(std::vector<int>& tokens)
+{
+    if (d->tokens.empty())
+    {
+        NCNN_LOGE("step without prefill");
+        return -1;
+    }
+
+    const int n = (int)d->tokens.size();
+    const int draft_count = d->draft ? d->draft_count : 0;
+
+    // propose
+    std::vector<int> drafts;
+    for (int i = 0; i < draft_count; i++)
+    {
+        // the pending tokens first, then the previous draft token
+        std::vector<int> extra;
+        if (i > 0)
+            extra.push_back(drafts[i - 1]);
+
+        Mat logits;
+        int pending_row = 0;
+        int ret = d->forward_pending(d->draft, extra, logits, pending_row);
+        if (ret != 0)
+            return ret;
+
+        d->draft_forward_count++;
+
+        drafts.push_back(argmax(logits, logits.dims == 1 ? 0 : logits.h - 1));
+    }
+
+    // verify all draft tokens in one target forward
+    Mat logits;
+    int pending_row = 0;
+    int ret = d->forward_pending(d->target, drafts, logits, pending_row);
+    if (ret != 0)
+        return ret;
+
+    d->target_forward_count++;
+
+    int accepted = 0;
+    while (accepted < draft_count && argmax(logits, pending_row + accepted) == drafts[accepted])
+    {
+        accepted++;
+    }
+
+    const int next_token = argmax(logits, pending_row + accepted);
+
+    for (int i = 0; i < accepted; i++)
+    {
+        d->tokens.push_back(drafts[i]);
+        tokens.push_back(drafts[i]);
+    }
+    d->tokens.push_back(next_token);
+    tokens.push_back(next_token);
+
+    d->proposed_count += draft_count;
+    d->accepted_count += accepted;
+
+    // roll back the rejected tokens, the new token stays pending
+    d->target->truncate(n + accepted);
+    if (d->draft && d->draft->seqlen() > n + accepted)
+        d->draft->truncate(n + accepted);
+
+    return 0;
+}
+
+int SpeculativeDecoder::generate(int max_new_tokens, std::vector<int>& tokens)
+{
+    int generated = 0;
+    while (generated < max_new_tokens)
+    {
+        std::vector<int> new_tokens;
+        int ret = step(new_tokens);
+        if (ret != 0)
+            return ret;
+
+        for (size_t i = 0; i < new_tokens.size() && generated < max_new_tokens; i++)
+        {
+            tokens.push_back(new_tokens[i]);
+            generated++;
+        }
+    }
+
+    return 0;
+}
+
+const std::vector<int>& SpeculativeDecoder::tokens() const
+{
+    return d->tokens;
+}
+
+int SpeculativeDecoder::target_forward_count() const
+{
+    return d->target_forward_count;
+}
+
+int SpeculativeDecoder::draft_forward_count() const
+{
+    return d->draft_forward_count;
+}
+
+int SpeculativeDecoder::proposed_count() const
+{
+    return d->proposed_count;
+}
+
+int SpeculativeDecoder::accepted_count() const
+{
+    return d->accepted_count;
+}
+
+} // namespace ncnn
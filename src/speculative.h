@@ -0,0 +1,80 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_SPECULATIVE_H
+#define NCNN_SPECULATIVE_H
+
+#include "platform.h"
+#include "mat.h"
+
+namespace ncnn {
+
+// a causal language model that keeps the context of the tokens it has seen
+// usually a decoder net with a KVCache, the cache seqlen is the context length
+class NCNN_EXPORT TokenDecoder
+{
+public:
+    virtual ~TokenDecoder();
+
+    // run tokens following the context in one forward and append them to the context
+    // logits gets one row per token, row i scores the token following tokens[i]
+    // return 0 if success
+    virtual int forward(const std::vector<int>& tokens, Mat& logits) = 0;
+
+    // number of tokens in the context
+    virtual int seqlen() const = 0;
+
+    // drop the context beyond seqlen
+    virtual void truncate(int seqlen) = 0;
+};
+
+// greedy speculative decoding
+// the draft decoder proposes draft_count tokens one by one,
+// the target decoder scores all of them in one forward with a causal mask over the proposed positions,
+// the longest prefix matching the target argmax is accepted plus one token from the target,
+// the context of the rejected tokens is rolled back with truncate()
+// the generated tokens are exactly those of greedy decoding with the target alone
+class SpeculativeDecoderPrivate;
+class NCNN_EXPORT SpeculativeDecoder
+{
+public:
+    // draft can be null for plain greedy decoding with target
+    SpeculativeDecoder(TokenDecoder* target, TokenDecoder* draft);
+    virtual ~SpeculativeDecoder();
+
+    // tokens proposed by the draft per target forward
+    // default is 4
+    void set_draft_count(int draft_count);
+
+    // restart from prompt, all but the last prompt token are run through both decoders
+    // return 0 if success
+    int prefill(const std::vector<int>& prompt);
+
+    // one draft and verify round, append 1 to draft_count + 1 new tokens
+    // return 0 if success
+    int step(std::vector<int>& tokens);
+
+    // repeat step() until max_new_tokens new tokens are appended
+    // return 0 if success
+    int generate(int max_new_tokens, std::vector<int>& tokens);
+
+    // prompt and generated tokens since the last prefill
+    const std::vector<int>& tokens() const;
+
+    // counters since the last prefill
+    int target_forward_count() const;
+    int draft_forward_count() const;
+    int proposed_count() const;
+    int accepted_count() const;
+
+private:
+    SpeculativeDecoder(const SpeculativeDecoder&);
+    SpeculativeDecoder& operator=(const SpeculativeDecoder&);
+
+private:
+    SpeculativeDecoderPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_SPECULATIVE_H
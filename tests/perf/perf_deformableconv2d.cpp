@@ -0,0 +1,44 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "perfutil.h"
+
+static void perf_deformableconv2d(int w, int h, int c, int outch, int kernel, int stride, int has_mask)
+{
+    const int pad = kernel / 2;
+    const int outw = (w + pad * 2 - kernel) / stride + 1;
+    const int outh = (h + pad * 2 - kernel) / stride + 1;
+    const int maxk = kernel * kernel;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);
+    pd.set(1, kernel);
+    pd.set(2, 1);
+    pd.set(3, stride);
+    pd.set(4, pad);
+    pd.set(5, 1);
+    pd.set(6, outch * c * maxk);
+
+    std::vector<ncnn::Mat> weights(2);
+    weights[0] = PerfMat(outch * c * maxk);
+    weights[1] = PerfMat(outch);
+
+    std::vector<ncnn::Mat> inputs(has_mask ? 3 : 2);
+    inputs[0] = PerfMat(w, h, c);
+    inputs[1] = PerfMat(outw, outh, maxk * 2, 0.3f);
+    if (has_mask)
+        inputs[2] = PerfMat(outw, outh, maxk, 0.5f);
+
+    perf_layer("DeformableConv2D", pd, weights, inputs, 1, "outch=%d k=%d s=%d mask=%d", outch, kernel, stride, has_mask);
+}
+
+int main()
+{
+    perf_deformableconv2d(56, 56, 64, 64, 3, 1, 1);
+    perf_deformableconv2d(56, 56, 64, 64, 3, 1, 0);
+    perf_deformableconv2d(28, 28, 128, 128, 3, 1, 1);
+    perf_deformableconv2d(28, 28, 128, 256, 3, 2, 1);
+    perf_deformableconv2d(14, 14, 256, 256, 3, 1, 1);
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "perfutil.h"
+
+static void perf_gridsample(int w, int h, int c, int outw, int outh, int sample_type, int padding_mode)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, sample_type);
+    pd.set(1, padding_mode);
+    pd.set(2, 0);
+    pd.set(3, 0);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    std::vector<ncnn::Mat> inputs(2);
+    inputs[0] = PerfMat(w, h, c);
+    inputs[1] = PerfMat(2, outw, outh, 0.3f);
+
+    perf_layer("GridSample", pd, weights, inputs, 1, "out=%dx%d sample=%d padding=%d", outw, outh, sample_type, padding_mode);
+}
+
+static void perf_gridsample_3d(int w, int h, int d, int c, int outw, int outh, int outd, int sample_type)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, sample_type);
+    pd.set(1, 1);
+    pd.set(2, 0);
+    pd.set(3, 0);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    std::vector<ncnn::Mat> inputs(2);
+    inputs[0] = PerfMat(w, h, d, c);
+    inputs[1] = PerfMat(3, outw, outh, outd, 0.3f);
+
+    perf_layer("GridSample", pd, weights, inputs, 1, "out=%dx%dx%d sample=%d", outw, outh, outd, sample_type);
+}
+
+int main()
+{
+    perf_gridsample(64, 64, 32, 64, 64, 1, 1);
+    perf_gridsample(64, 64, 32, 64, 64, 1, 2);
+    perf_gridsample(64, 64, 32, 64, 64, 2, 1);
+    perf_gridsample(64, 64, 32, 64, 64, 3, 1);
+    perf_gridsample(128, 96, 16, 128, 96, 1, 3);
+
+    perf_gridsample_3d(24, 24, 16, 16, 24, 24, 16, 1);
+    perf_gridsample_3d(24, 24, 16, 16, 24, 24, 16, 2);
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "perfutil.h"
+
+static void perf_roialign(int w, int h, int c, int pooled, float spatial_scale, int sampling_ratio, int version)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, pooled);
+    pd.set(1, pooled);
+    pd.set(2, spatial_scale);
+    pd.set(3, sampling_ratio);
+    pd.set(4, 1);
+    pd.set(5, version);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    // one roi covering the central part of the image
+    ncnn::Mat roi(4);
+    roi[0] = w / spatial_scale * 0.2f;
+    roi[1] = h / spatial_scale * 0.25f;
+    roi[2] = w / spatial_scale * 0.7f;
+    roi[3] = h / spatial_scale * 0.8f;
+
+    std::vector<ncnn::Mat> inputs(2);
+    inputs[0] = PerfMat(w, h, c);
+    inputs[1] = roi;
+
+    perf_layer("ROIAlign", pd, weights, inputs, 1, "pooled=%d scale=%.4f sr=%d v=%d", pooled, spatial_scale, sampling_ratio, version);
+}
+
+int main()
+{
+    perf_roialign(50, 38, 256, 7, 0.0625f, 2, 0);
+    perf_roialign(50, 38, 256, 7, 0.0625f, 2, 1);
+    perf_roialign(100, 76, 256, 14, 0.125f, 2, 1);
+    perf_roialign(100, 76, 256, 7, 0.125f, 0, 1);
+    perf_roialign(200, 152, 256, 7, 0.25f, 0, 0);
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "perfutil.h"
+
+static void perf_statisticspooling(int w, int h, int c, int include_stddev)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, include_stddev);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    perf_layer("StatisticsPooling", pd, weights, PerfMat(w, h, c), "stddev=%d", include_stddev);
+}
+
+int main()
+{
+    perf_statisticspooling(300, 1, 1500, 0);
+    perf_statisticspooling(300, 1, 1500, 1);
+    perf_statisticspooling(1000, 1, 1500, 1);
+    perf_statisticspooling(200, 4, 512, 1);
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_argmax(const ncnn::Mat& a, int out_max_val, int topk, int axis)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, out_max_val);
+    pd.set(1, topk);
+    pd.set(2, axis);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("ArgMax", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_argmax failed a.dims=%d a=(%d %d %d %d) out_max_val=%d topk=%d axis=%d\n", a.dims, a.w, a.h, a.d, a.c, out_max_val, topk, axis);
+    }
+
+    return ret;
+}
+
+static int test_argmax_0()
+{
+    // the whole blob as one row
+    return 0
+           || test_argmax(RandomMat(1), 0, 1, -233)
+           || test_argmax(RandomMat(37), 0, 1, -233)
+           || test_argmax(RandomMat(37), 1, 5, -233)
+           || test_argmax(RandomMat(37), 1, 37, -233)
+           || test_argmax(RandomMat(33, 13), 0, 3, -233)
+           || test_argmax(RandomMat(8, 8, 12), 1, 7, -233)
+           || test_argmax(RandomMat(4, 5, 2, 8), 1, 16, -233)
+           || test_argmax(RandomMat(3000), 1, 200, -233)
+           || test_argmax(RandomMat(70000), 1, 40, -233);
+}
+
+static int test_argmax_1()
+{
+    // rows along the innermost axis
+    return 0
+           || test_argmax(RandomMat(45), 0, 3, 0)
+           || test_argmax(RandomMat(45, 7), 1, 4, 1)
+           || test_argmax(RandomMat(45, 7), 0, 50, -1)
+           || test_argmax(RandomMat(19, 5, 6), 1, 2, 2)
+           || test_argmax(RandomMat(600, 3, 2), 1, 140, -1)
+           || test_argmax(RandomMat(17, 3, 4, 5), 0, 6, 3);
+}
+
+static int test_argmax_2()
+{
+    // outer axes
+    return 0
+           || test_argmax(RandomMat(45, 7), 1, 4, 0)
+           || test_argmax(RandomMat(19, 5, 6), 0, 2, 0)
+           || test_argmax(RandomMat(19, 5, 6), 1, 3, 1)
+           || test_argmax(RandomMat(17, 3, 4, 5), 1, 2, 1)
+           || test_argmax(RandomMat(17, 3, 4, 5), 0, 3, -2);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_argmax_0()
+           || test_argmax_1()
+           || test_argmax_2();
+}
@@ -0,0 +1,239 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "batchingexecutor.h"
+#include "net.h"
+#include "testutil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* param_str = "7767517\n"
+                               "4 4\n"
+                               "Input       input   0 1 data\n"
+                               "Convolution conv    1 1 data conv 0=8 1=3 4=1 5=1 6=216\n"
+                               "ReLU        relu    1 1 conv relu\n"
+                               "Pooling     pool    1 1 relu output 0=1 4=1\n";
+
+static std::vector<float> weights;
+
+static int load_net(ncnn::Net& net)
+{
+    weights.clear();
+
+    // a zero flag tags raw fp32 weight
+    weights.push_back(0.f);
+    ncnn::Mat weight = RandomMat(216);
+    weights.insert(weights.end(), (const float*)weight, (const float*)weight + 216);
+    ncnn::Mat bias = RandomMat(8);
+    weights.insert(weights.end(), (const float*)bias, (const float*)bias + 8);
+
+    if (net.load_param_mem(param_str) != 0)
+        return -1;
+
+    net.load_model((const unsigned char*)weights.data());
+    return 0;
+}
+
+static int forward_ref(const ncnn::Net& net, const ncnn::Mat& in, ncnn::Mat& out)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+    return ex.extract("output", out);
+}
+
+struct callback_result
+{
+    int ret;
+    ncnn::Mat out;
+    bool done;
+};
+
+static void on_done(int ret, const std::vector<ncnn::Mat>& outputs, void* userdata)
+{
+    callback_result* r = (callback_result*)userdata;
+    r->ret = ret;
+    r->out = outputs[0];
+    r->done = true;
+}
+
+static int test_batchingexecutor_submit()
+{
+    ncnn::Net net;
+    if (load_net(net) != 0)
+        return -1;
+
+    ncnn::BatchingExecutor executor(&net);
+    executor.set_max_batch_size(4);
+    // long enough for all requests to be queued before the first batch runs
+    executor.set_batch_timeout(1000.f);
+    executor.start();
+
+    std::vector<ncnn::Mat> inputs(4);
+    callback_result results[4];
+    for (int i = 0; i < 4; i++)
+    {
+        inputs[i] = RandomMat(9, 7, 3);
+        results[i].done = false;
+
+        int ret = executor.submit(std::vector<ncnn::Mat>(1, inputs[i]), on_done, &results[i]);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_batchingexecutor_submit submit failed %d\n", ret);
+            return -1;
+        }
+    }
+
+    // drain
+    executor.stop();
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (!results[i].done || results[i].ret != 0)
+        {
+            fprintf(stderr, "test_batchingexecutor_submit request %d failed\n", i);
+            return -1;
+        }
+
+        ncnn::Mat out_ref;
+        forward_ref(net, inputs[i], out_ref);
+
+        if (CompareMat(results[i].out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_batchingexecutor_submit request %d mismatch\n", i);
+            return -1;
+        }
+    }
+
+    ncnn::BatchingStats stats = executor.stats();
+    if (stats.request_count != 4)
+    {
+        fprintf(stderr, "test_batchingexecutor_submit request_count expect 4 got %d\n", stats.request_count);
+        return -1;
+    }
+
+#if NCNN_THREADS
+    if (stats.batch_count != 1 || stats.max_batch_size != 4)
+    {
+        fprintf(stderr, "test_batchingexecutor_submit expect one batch of 4 got %d batches max %d\n", stats.batch_count, stats.max_batch_size);
+        return -1;
+    }
+#endif
+
+    if (stats.latency_p50 > stats.latency_p99)
+    {
+        fprintf(stderr, "test_batchingexecutor_submit latency p50 %f > p99 %f\n", stats.latency_p50, stats.latency_p99);
+        return -1;
+    }
+
+    return 0;
+}
+
+struct client_args
+{
+    ncnn::BatchingExecutor* executor;
+    const ncnn::Net* net;
+    std::vector<ncnn::Mat> inputs;
+    int ret;
+};
+
+static void* client(void* args)
+{
+    client_args* a = (client_args*)args;
+    a->ret = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        const ncnn::Mat& in = a->inputs[i];
+
+        std::vector<ncnn::Mat> outputs;
+        int ret = a->executor->run(std::vector<ncnn::Mat>(1, in), outputs);
+        if (ret != 0 || outputs.size() != 1)
+        {
+            a->ret = -1;
+            return 0;
+        }
+
+        ncnn::Mat out_ref;
+        forward_ref(*a->net, in, out_ref);
+
+        if (CompareMat(outputs[0], out_ref, 0.001) != 0)
+        {
+            a->ret = -1;
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+static int test_batchingexecutor_run()
+{
+    ncnn::Net net;
+    if (load_net(net) != 0)
+        return -1;
+
+    ncnn::BatchingExecutor executor(&net);
+    executor.set_max_batch_size(3);
+    executor.set_batch_timeout(5.f);
+    executor.start();
+
+    client_args args[4];
+    for (int i = 0; i < 4; i++)
+    {
+        args[i].executor = &executor;
+        args[i].net = &net;
+        args[i].ret = 0;
+
+        // two input shapes, only the same shapes are batched together
+        for (int j = 0; j < 4; j++)
+        {
+            args[i].inputs.push_back((i + j) % 2 == 0 ? RandomMat(9, 7, 3) : RandomMat(5, 6, 3));
+        }
+    }
+
+#if NCNN_THREADS
+    std::vector<ncnn::Thread*> threads(4);
+    for (int i = 0; i < 4; i++)
+    {
+        threads[i] = new ncnn::Thread(client, &args[i]);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+#else
+    for (int i = 0; i < 4; i++)
+    {
+        client(&args[i]);
+    }
+#endif
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (args[i].ret != 0)
+        {
+            fprintf(stderr, "test_batchingexecutor_run client %d failed\n", i);
+            return -1;
+        }
+    }
+
+    ncnn::BatchingStats stats = executor.stats();
+    if (stats.request_count != 16 || stats.max_batch_size > 3)
+    {
+        fprintf(stderr, "test_batchingexecutor_run stats request_count %d max_batch_size %d\n", stats.request_count, stats.max_batch_size);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_batchingexecutor_submit()
+           || test_batchingexecutor_run();
+}
@@ -75,9 +75,53 @@ static int test_convolution3d_0()
     return 0;
 }
 
+static int test_convolution3d_aniso(int w, int h, int d, int c, int outch, int kernel_w, int kernel_h, int kernel_d, int dilation_d, int stride_d, int pad_front, int pad_behind, float pad_value)
+{
+    ncnn::Mat a = RandomMat(w, h, d, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);
+    pd.set(1, kernel_w);
+    pd.set(11, kernel_h);
+    pd.set(21, kernel_d);
+    pd.set(22, dilation_d);
+    pd.set(23, stride_d);
+    pd.set(4, 1);
+    pd.set(24, pad_front);
+    pd.set(17, pad_behind);
+    pd.set(18, pad_value);
+    pd.set(5, 1);
+    pd.set(6, outch * c * kernel_w * kernel_h * kernel_d);
+
+    std::vector<ncnn::Mat> weights(2);
+    weights[0] = RandomMat(outch * c * kernel_w * kernel_h * kernel_d);
+    weights[1] = RandomMat(outch);
+
+    int ret = test_layer("Convolution3D", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_convolution3d_aniso failed w=%d h=%d d=%d c=%d outch=%d kernel=%d,%d,%d dilation_d=%d stride_d=%d pad_front=%d pad_behind=%d pad_value=%f\n", w, h, d, c, outch, kernel_w, kernel_h, kernel_d, dilation_d, stride_d, pad_front, pad_behind, pad_value);
+    }
+
+    return ret;
+}
+
+static int test_convolution3d_1()
+{
+    return 0
+           || test_convolution3d_aniso(9, 8, 7, 3, 8, 3, 1, 2, 1, 1, 0, 1, 0.f)
+           || test_convolution3d_aniso(9, 8, 7, 8, 4, 1, 3, 3, 2, 1, 2, 1, -0.5f)
+           || test_convolution3d_aniso(9, 8, 7, 4, 16, 3, 3, 3, 1, 2, 1, 2, 1.f)
+           || test_convolution3d_aniso(9, 8, 7, 16, 12, 2, 3, 4, 1, 2, 3, 0, 0.f)
+           || test_convolution3d_aniso(9, 8, 7, 32, 24, 3, 3, 3, 1, 1, 1, 1, 0.f)
+           || test_convolution3d_aniso(9, 8, 7, 24, 32, 1, 1, 3, 2, 1, 0, 0, 0.f);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_convolution3d_0();
+    return 0
+           || test_convolution3d_0()
+           || test_convolution3d_1();
 }
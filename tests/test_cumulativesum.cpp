@@ -39,7 +39,8 @@ static int test_cumulativesum_1d()
            || test_cumulativesum(RandomMat(10), 0)
            || test_cumulativesum(RandomMat(10), -1)
            || test_cumulativesum(RandomMat(10), -2)
-           || test_cumulativesum(RandomMat(101), 0);
+           || test_cumulativesum(RandomMat(101), 0)
+           || test_cumulativesum(RandomMat(70000), 0);
 }
 
 static int test_cumulativesum_2d()
@@ -48,7 +49,8 @@ static int test_cumulativesum_2d()
            || test_cumulativesum(RandomMat(6, 8), 0)
            || test_cumulativesum(RandomMat(20, 103), 1)
            || test_cumulativesum(RandomMat(106, 50), -1)
-           || test_cumulativesum(RandomMat(106, 50), -2);
+           || test_cumulativesum(RandomMat(106, 50), -2)
+           || test_cumulativesum(RandomMat(40000, 1), 1);
 }
 
 static int test_cumulativesum_3d()
@@ -84,9 +84,51 @@ static int test_deconvolution3d_0()
     return 0;
 }
 
+static int test_deconvolution3d_aniso(int w, int h, int d, int c, int outch, int kernel_w, int kernel_h, int kernel_d, int dilation_d, int stride_d, int pad_front, int pad_behind, int output_pad_behind)
+{
+    ncnn::Mat a = RandomMat(w, h, d, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);
+    pd.set(1, kernel_w);
+    pd.set(11, kernel_h);
+    pd.set(21, kernel_d);
+    pd.set(22, dilation_d);
+    pd.set(23, stride_d);
+    pd.set(24, pad_front);
+    pd.set(17, pad_behind);
+    pd.set(20, output_pad_behind);
+    pd.set(5, 1);
+    pd.set(6, outch * c * kernel_w * kernel_h * kernel_d);
+
+    std::vector<ncnn::Mat> weights(2);
+    weights[0] = RandomMat(outch * c * kernel_w * kernel_h * kernel_d);
+    weights[1] = RandomMat(outch);
+
+    int ret = test_layer("Deconvolution3D", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_deconvolution3d_aniso failed w=%d h=%d d=%d c=%d outch=%d kernel=%d,%d,%d dilation_d=%d stride_d=%d pad_front=%d pad_behind=%d output_pad_behind=%d\n", w, h, d, c, outch, kernel_w, kernel_h, kernel_d, dilation_d, stride_d, pad_front, pad_behind, output_pad_behind);
+    }
+
+    return ret;
+}
+
+static int test_deconvolution3d_1()
+{
+    return 0
+           || test_deconvolution3d_aniso(7, 6, 5, 3, 8, 3, 1, 2, 1, 1, 0, 1, 0)
+           || test_deconvolution3d_aniso(7, 6, 5, 8, 4, 1, 3, 3, 2, 1, 1, 1, 1)
+           || test_deconvolution3d_aniso(7, 6, 5, 4, 16, 3, 3, 3, 1, 2, 1, 0, 1)
+           || test_deconvolution3d_aniso(7, 6, 5, 16, 12, 2, 3, 4, 1, 2, 0, 2, 0)
+           || test_deconvolution3d_aniso(7, 6, 5, 32, 24, 3, 3, 3, 1, 1, 1, 1, 0);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_deconvolution3d_0();
+    return 0
+           || test_deconvolution3d_0()
+           || test_deconvolution3d_1();
 }
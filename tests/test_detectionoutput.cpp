@@ -0,0 +1,128 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_detectionoutput(const std::vector<ncnn::Mat>& a, int num_class, float nms_threshold, int nms_top_k, int keep_top_k, float confidence_threshold)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, num_class);
+    pd.set(1, nms_threshold);
+    pd.set(2, nms_top_k);
+    pd.set(3, keep_top_k);
+    pd.set(4, confidence_threshold);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("DetectionOutput", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_detectionoutput failed a.dims=%d a=(%d %d %d) num_class=%d nms_threshold=%f nms_top_k=%d keep_top_k=%d confidence_threshold=%f\n", a[1].dims, a[1].w, a[1].h, a[1].c, num_class, nms_threshold, nms_top_k, keep_top_k, confidence_threshold);
+    }
+
+    return ret;
+}
+
+// normalize the num_class scores of each prior, which sit class_stride apart and start prior_stride apart
+static void softmax_scores(ncnn::Mat& conf, int num_prior, int num_class, int prior_stride, int class_stride)
+{
+    float* ptr = conf;
+    for (int i = 0; i < num_prior; i++)
+    {
+        float* p = ptr + i * prior_stride;
+
+        float sum = 0.f;
+        for (int j = 0; j < num_class; j++)
+        {
+            p[j * class_stride] = expf(p[j * class_stride]);
+            sum += p[j * class_stride];
+        }
+        for (int j = 0; j < num_class; j++)
+        {
+            p[j * class_stride] /= sum;
+        }
+    }
+}
+
+// priors are random boxes in the unit square
+static void random_priors(float* ptr, int num_prior)
+{
+    for (int i = 0; i < num_prior; i++)
+    {
+        float* p = ptr + i * 4;
+
+        float cx = RandomFloat(0.1f, 0.9f);
+        float cy = RandomFloat(0.1f, 0.9f);
+        float w = RandomFloat(0.05f, 0.3f);
+        float h = RandomFloat(0.05f, 0.3f);
+
+        p[0] = cx - w * 0.5f;
+        p[1] = cy - h * 0.5f;
+        p[2] = cx + w * 0.5f;
+        p[3] = cy + h * 0.5f;
+    }
+}
+
+static int test_detectionoutput_caffe(int num_prior, int num_class, float nms_threshold, int nms_top_k, int keep_top_k, float confidence_threshold)
+{
+    std::vector<ncnn::Mat> a(3);
+    a[0] = RandomMat(num_prior * 4, -1.f, 1.f);
+    a[1] = RandomMat(num_class * num_prior, -4.f, 4.f);
+    a[2] = ncnn::Mat(num_prior * 4, 2);
+
+    softmax_scores(a[1], num_prior, num_class, num_class, 1);
+
+    random_priors(a[2].row(0), num_prior);
+
+    float* var = a[2].row(1);
+    for (int i = 0; i < num_prior; i++)
+    {
+        var[i * 4] = 0.1f;
+        var[i * 4 + 1] = 0.1f;
+        var[i * 4 + 2] = 0.2f;
+        var[i * 4 + 3] = 0.2f;
+    }
+
+    return test_detectionoutput(a, num_class, nms_threshold, nms_top_k, keep_top_k, confidence_threshold);
+}
+
+static int test_detectionoutput_mxnet(int num_prior, int num_class, float nms_threshold, int nms_top_k, int keep_top_k, float confidence_threshold)
+{
+    std::vector<ncnn::Mat> a(3);
+    a[0] = RandomMat(num_prior * 4, -1.f, 1.f);
+    a[1] = RandomMat(num_prior, num_class, -4.f, 4.f);
+    a[2] = ncnn::Mat(4, num_prior);
+
+    softmax_scores(a[1], num_prior, num_class, 1, num_prior);
+
+    random_priors(a[2], num_prior);
+
+    return test_detectionoutput(a, -233, nms_threshold, nms_top_k, keep_top_k, confidence_threshold);
+}
+
+static int test_detectionoutput_0()
+{
+    return 0
+           || test_detectionoutput_caffe(7, 3, 0.45f, 100, 100, 0.2f)
+           || test_detectionoutput_caffe(100, 5, 0.45f, 300, 100, 0.3f)
+           || test_detectionoutput_caffe(1917, 21, 0.45f, 100, 100, 0.1f)
+           || test_detectionoutput_caffe(1917, 21, 0.3f, 400, 200, 0.05f)
+           || test_detectionoutput_caffe(503, 91, 0.5f, 30, 10, 0.02f);
+}
+
+static int test_detectionoutput_1()
+{
+    return 0
+           || test_detectionoutput_mxnet(9, 4, 0.45f, 100, 100, 0.2f)
+           || test_detectionoutput_mxnet(1000, 21, 0.45f, 400, 100, 0.05f)
+           || test_detectionoutput_mxnet(333, 7, 0.5f, 50, 20, 0.1f);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_detectionoutput_0()
+           || test_detectionoutput_1();
+}
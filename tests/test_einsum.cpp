@@ -149,6 +149,84 @@ static int test_einsum_11()
     return test_einsum(a, "imnj,kmln->ijkl");
 }
 
+static int test_einsum_12()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(32, 24, 4, 2);
+    a[1] = RandomMat(32, 20, 4, 2);
+
+    std::vector<ncnn::Mat> b(2);
+    b[0] = RandomMat(20, 24, 4, 2);
+    b[1] = RandomMat(32, 20, 4, 2);
+
+    return 0
+           || test_einsum(a, "bhqd,bhkd->bhqk")
+           || test_einsum(a, "bhqd,bhkd->bhkq")
+           || test_einsum(b, "bhqk,bhkd->bhqd")
+           || test_einsum(b, "bhqk,bhkd->bqhd");
+}
+
+static int test_einsum_13()
+{
+    std::vector<ncnn::Mat> a(1);
+    a[0] = RandomMat(13, 17, 5);
+
+    return 0
+           || test_einsum(a, "abc->cab")
+           || test_einsum(a, "abc->ba")
+           || test_einsum(a, "XyZ->Zy")
+           || test_einsum(a, "abc->");
+}
+
+static int test_einsum_14()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(24, 19);
+    a[1] = RandomMat(17, 24);
+
+    std::vector<ncnn::Mat> b(1);
+    b[0] = RandomMat(11, 11);
+
+    std::vector<ncnn::Mat> c(1);
+    c[0] = RandomMat(7, 9, 9);
+
+    return 0
+           || test_einsum(a, "ij,jk")
+           || test_einsum(a, "ba,ca")
+           || test_einsum(b, "ii->i")
+           || test_einsum(b, "ij->ji")
+           || test_einsum(c, "iij->j")
+           || test_einsum(c, "iij");
+}
+
+static int test_einsum_15()
+{
+    std::vector<ncnn::Mat> a(3);
+    a[0] = RandomMat(25, 18);
+    a[1] = RandomMat(30, 25);
+    a[2] = RandomMat(16, 30);
+
+    return test_einsum(a, "Ab,bC,CD->AD") || test_einsum(a, "Ab,bC,CD->DA") || test_einsum(a, "Ab,bC,CD->b");
+}
+
+static int test_einsum_16()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(13, 17, 5);
+    a[1] = RandomMat(19, 13, 5);
+
+    std::vector<ncnn::Mat> b(2);
+    b[0] = RandomMat(13, 17, 5);
+    b[1] = RandomMat(13, 17, 5);
+
+    return 0
+           || test_einsum(a, "bij,bjk->bik")
+           || test_einsum(a, "bij,bjk->kib")
+           || test_einsum(b, "bij,bij->bij")
+           || test_einsum(b, "bij,bkj->bik")
+           || test_einsum(b, "bij,bij->b");
+}
+
 int main()
 {
     SRAND(7767517);
@@ -165,5 +243,10 @@ int main()
            || test_einsum_8()
            || test_einsum_9()
            || test_einsum_10()
-           || test_einsum_11();
+           || test_einsum_11()
+           || test_einsum_12()
+           || test_einsum_13()
+           || test_einsum_14()
+           || test_einsum_15()
+           || test_einsum_16();
 }
@@ -36,7 +36,9 @@ static int test_embed_0()
            || test_embed(127, 127, 127, 0)
            || test_embed(127, 127, 127, 1)
            || test_embed(124, 124, 124, 0)
-           || test_embed(124, 124, 124, 1);
+           || test_embed(124, 124, 124, 1)
+           || test_embed(16, 300, 50, 1)
+           || test_embed(20, 520, 64, 0);
 }
 
 #if NCNN_INT8
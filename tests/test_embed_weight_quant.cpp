@@ -0,0 +1,147 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "layer.h"
+#include "testutil.h"
+
+#if NCNN_INT8
+static float RelativeError(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    double diff = 0.0;
+    double norm = 0.0;
+    for (int i = 0; i < a.h; i++)
+    {
+        const float* pa = a.row(i);
+        const float* pb = b.row(i);
+
+        for (int j = 0; j < a.w; j++)
+        {
+            diff += (pa[j] - pb[j]) * (pa[j] - pb[j]);
+            norm += pa[j] * pa[j];
+        }
+    }
+
+    return (float)sqrt(diff / std::max(norm, 1e-12));
+}
+
+static int test_embed_weight_quant(int words, int num_output, int input_dim, int bias, int bits, int group_size)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, num_output);
+    pd.set(1, input_dim);
+    pd.set(2, bias);
+    pd.set(3, num_output * input_dim);
+    pd.set(19, bits);
+    pd.set(20, group_size);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomMat(num_output * input_dim);
+    if (bias)
+        weights[1] = RandomMat(num_output);
+
+    ncnn::Mat a(words);
+    RandomizeInt(a, 0, input_dim);
+
+    int ret = test_layer("Embed", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_embed_weight_quant failed words=%d num_output=%d input_dim=%d bias=%d bits=%d group_size=%d\n", words, num_output, input_dim, bias, bits, group_size);
+        return ret;
+    }
+
+    // close to the fp32 table
+    ncnn::Mat b;
+    test_layer_naive(ncnn::layer_to_index("Embed"), pd, weights, a, b, 0);
+
+    pd.set(19, 0);
+
+    ncnn::Mat b_fp32;
+    test_layer_naive(ncnn::layer_to_index("Embed"), pd, weights, a, b_fp32, 0);
+
+    const float error = RelativeError(b_fp32, b);
+    if (error > (bits == 8 ? 0.01f : 0.1f))
+    {
+        fprintf(stderr, "test_embed_weight_quant accuracy failed words=%d num_output=%d input_dim=%d bits=%d group_size=%d error=%f\n", words, num_output, input_dim, bits, group_size, error);
+        return -1;
+    }
+
+    return 0;
+}
+
+// the model stores the quantized table as int8 followed by the scales and zeros
+static int test_embed_weight_quant_model(int words, int num_output, int input_dim, int bits, int group_size)
+{
+    const int num_groups = bits == 4 ? (num_output + group_size - 1) / group_size : 1;
+
+    ncnn::ParamDict pd;
+    pd.set(0, num_output);
+    pd.set(1, input_dim);
+    pd.set(2, 1);
+    pd.set(3, num_output * input_dim);
+    pd.set(19, bits);
+    pd.set(20, group_size);
+
+    std::vector<ncnn::Mat> weights(bits == 4 ? 4 : 3);
+    weights[0].create(num_output * input_dim, (size_t)1u);
+    for (int i = 0; i < num_output * input_dim; i++)
+    {
+        ((signed char*)weights[0])[i] = bits == 4 ? RandomInt(0, 15) : RandomInt(-127, 127);
+    }
+    weights[1] = RandomMat(num_output);
+    weights[2] = RandomMat(num_groups * input_dim, 0.001f, 0.02f);
+    if (bits == 4)
+    {
+        weights[3].create(num_groups * input_dim);
+        for (int i = 0; i < num_groups * input_dim; i++)
+        {
+            weights[3][i] = (float)RandomInt(0, 15);
+        }
+    }
+
+    ncnn::Mat a(words);
+    RandomizeInt(a, 0, input_dim);
+
+    int ret = test_layer("Embed", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_embed_weight_quant_model failed words=%d num_output=%d input_dim=%d bits=%d group_size=%d\n", words, num_output, input_dim, bits, group_size);
+    }
+
+    return ret;
+}
+
+static int test_embed_weight_quant_0()
+{
+    return 0
+           || test_embed_weight_quant(16, 64, 100, 1, 8, 32)
+           || test_embed_weight_quant(13, 67, 50, 0, 8, 32)
+           || test_embed_weight_quant(32, 300, 40, 1, 8, 32)
+           || test_embed_weight_quant(16, 128, 100, 1, 4, 32)
+           || test_embed_weight_quant(5, 100, 30, 1, 4, 64)
+           || test_embed_weight_quant(24, 35, 20, 0, 4, 8)
+           || test_embed_weight_quant(8, 300, 40, 1, 4, 40);
+}
+
+static int test_embed_weight_quant_1()
+{
+    return 0
+           || test_embed_weight_quant_model(16, 40, 30, 8, 32)
+           || test_embed_weight_quant_model(12, 40, 30, 4, 16)
+           || test_embed_weight_quant_model(7, 33, 20, 4, 8)
+           || test_embed_weight_quant_model(32, 260, 20, 4, 24);
+}
+#endif // NCNN_INT8
+
+int main()
+{
+    SRAND(7767517);
+
+#if NCNN_INT8
+    return 0
+           || test_embed_weight_quant_0()
+           || test_embed_weight_quant_1();
+#else
+    // test nothing
+    return 0;
+#endif
+}
@@ -0,0 +1,166 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "layer.h"
+#include "testutil.h"
+
+#if NCNN_INT8
+static float RelativeError(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    double diff = 0.0;
+    double norm = 0.0;
+    for (int q = 0; q < a.c; q++)
+    {
+        const float* pa = a.channel(q);
+        const float* pb = b.channel(q);
+
+        for (int i = 0; i < a.w * a.h * a.d; i++)
+        {
+            diff += (pa[i] - pb[i]) * (pa[i] - pb[i]);
+            norm += pa[i] * pa[i];
+        }
+    }
+
+    return (float)sqrt(diff / std::max(norm, 1e-12));
+}
+
+static int test_gemm_weight_quant(int M, int N, int K, int transA, int transB, int output_transpose, int constantC, int bits, int group_size)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, RandomFloat(0.5f, 1.5f)); // alpha
+    pd.set(1, RandomFloat(0.5f, 1.5f)); // beta
+    pd.set(2, transA);
+    pd.set(3, transB);
+    pd.set(4, 0);
+    pd.set(5, 1);
+    pd.set(6, constantC);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, constantC ? 4 : -1);
+    pd.set(14, output_transpose);
+    pd.set(23, bits);
+    pd.set(24, group_size);
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(transB ? RandomMat(K, N) : RandomMat(N, K));
+    if (constantC)
+        weights.push_back(RandomMat(N));
+
+    std::vector<ncnn::Mat> a;
+    a.push_back(transA ? RandomMat(M, K) : RandomMat(K, M));
+    if (!constantC)
+        a.push_back(RandomMat(N, M));
+
+    int ret = test_layer("Gemm", pd, weights, a, 1, 0.001, TEST_LAYER_ENABLE_THREADING);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_weight_quant failed M=%d N=%d K=%d transA=%d transB=%d output_transpose=%d constantC=%d bits=%d group_size=%d\n", M, N, K, transA, transB, output_transpose, constantC, bits, group_size);
+        return ret;
+    }
+
+    // close to the fp32 result
+    std::vector<ncnn::Mat> b(1);
+    test_layer_naive(ncnn::layer_to_index("Gemm"), pd, weights, a, 1, b, 0);
+
+    pd.set(23, 0);
+
+    std::vector<ncnn::Mat> b_fp32(1);
+    test_layer_naive(ncnn::layer_to_index("Gemm"), pd, weights, a, 1, b_fp32, 0);
+
+    const float error = RelativeError(b_fp32[0], b[0]);
+    if (error > (bits == 8 ? 0.01f : 0.1f))
+    {
+        fprintf(stderr, "test_gemm_weight_quant accuracy failed M=%d N=%d K=%d transB=%d bits=%d group_size=%d error=%f\n", M, N, K, transB, bits, group_size, error);
+        return -1;
+    }
+
+    return 0;
+}
+
+// the model stores the quantized B as int8 followed by the scales and zeros
+static int test_gemm_weight_quant_model(int M, int N, int K, int transB, int bits, int group_size)
+{
+    const int num_groups = bits == 4 ? (K + group_size - 1) / group_size : 1;
+
+    ncnn::ParamDict pd;
+    pd.set(3, transB);
+    pd.set(4, 0);
+    pd.set(5, 1);
+    pd.set(6, 1);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, -1);
+    pd.set(23, bits);
+    pd.set(24, group_size);
+
+    std::vector<ncnn::Mat> weights(bits == 4 ? 3 : 2);
+    weights[0].create(N * K, (size_t)1u);
+    for (int i = 0; i < N * K; i++)
+    {
+        ((signed char*)weights[0])[i] = bits == 4 ? RandomInt(0, 15) : RandomInt(-127, 127);
+    }
+    weights[1] = RandomMat(num_groups * N, 0.001f, 0.02f);
+    if (bits == 4)
+    {
+        weights[2].create(num_groups * N);
+        for (int i = 0; i < num_groups * N; i++)
+        {
+            weights[2][i] = (float)RandomInt(0, 15);
+        }
+    }
+
+    int ret = test_layer("Gemm", pd, weights, RandomMat(K, M));
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_weight_quant_model failed M=%d N=%d K=%d transB=%d bits=%d group_size=%d\n", M, N, K, transB, bits, group_size);
+    }
+
+    return ret;
+}
+
+static int test_gemm_weight_quant_0()
+{
+    return 0
+           || test_gemm_weight_quant(1, 32, 64, 0, 1, 0, 1, 8, 32)
+           || test_gemm_weight_quant(1, 32, 64, 0, 1, 0, 1, 4, 32)
+           || test_gemm_weight_quant(1, 19, 71, 0, 0, 0, 0, 8, 32)
+           || test_gemm_weight_quant(1, 19, 72, 0, 0, 0, 0, 4, 16)
+           || test_gemm_weight_quant(1, 40, 128, 0, 1, 1, 1, 4, 64);
+}
+
+static int test_gemm_weight_quant_1()
+{
+    return 0
+           || test_gemm_weight_quant(4, 32, 64, 0, 1, 0, 1, 8, 32)
+           || test_gemm_weight_quant(8, 24, 96, 0, 1, 0, 0, 4, 32)
+           || test_gemm_weight_quant(5, 17, 48, 1, 0, 1, 1, 4, 8)
+           || test_gemm_weight_quant(7, 16, 40, 1, 1, 0, 0, 8, 32)
+           || test_gemm_weight_quant(16, 48, 64, 0, 0, 1, 1, 4, 32);
+}
+
+static int test_gemm_weight_quant_2()
+{
+    return 0
+           || test_gemm_weight_quant_model(1, 16, 40, 1, 8, 32)
+           || test_gemm_weight_quant_model(1, 16, 40, 1, 4, 16)
+           || test_gemm_weight_quant_model(3, 9, 33, 0, 4, 8)
+           || test_gemm_weight_quant_model(3, 9, 33, 0, 8, 32);
+}
+#endif // NCNN_INT8
+
+int main()
+{
+    SRAND(7767517);
+
+#if NCNN_INT8
+    return 0
+           || test_gemm_weight_quant_0()
+           || test_gemm_weight_quant_1()
+           || test_gemm_weight_quant_2();
+#else
+    // test nothing
+    return 0;
+#endif
+}
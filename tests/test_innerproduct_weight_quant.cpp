@@ -0,0 +1,162 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "layer.h"
+#include "testutil.h"
+
+#if NCNN_INT8
+static float RelativeError(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    double diff = 0.0;
+    double norm = 0.0;
+    for (int q = 0; q < a.c; q++)
+    {
+        const float* pa = a.channel(q);
+        const float* pb = b.channel(q);
+
+        for (int i = 0; i < a.w * a.h * a.d; i++)
+        {
+            diff += (pa[i] - pb[i]) * (pa[i] - pb[i]);
+            norm += pa[i] * pa[i];
+        }
+    }
+
+    return (float)sqrt(diff / std::max(norm, 1e-12));
+}
+
+static int test_innerproduct_weight_quant(const ncnn::Mat& a, int outch, int bias, int bits, int group_size)
+{
+    const int num_input = a.w * a.h * a.d * a.c;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, bias);  // bias_term
+    pd.set(2, outch * num_input);
+    pd.set(11, bits);
+    pd.set(12, group_size);
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomMat(outch * num_input);
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    int ret = test_layer("InnerProduct", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_innerproduct_weight_quant failed a.dims=%d a=(%d %d %d %d) outch=%d bias=%d bits=%d group_size=%d act=%d actparams=[%f,%f]\n", a.dims, a.w, a.h, a.d, a.c, outch, bias, bits, group_size, activation_type, activation_params[0], activation_params[1]);
+        return ret;
+    }
+
+    // close to the fp32 result without activation
+    pd.set(9, 0);
+
+    ncnn::Mat b;
+    test_layer_naive(ncnn::layer_to_index("InnerProduct"), pd, weights, a, b, 0);
+
+    pd.set(11, 0);
+
+    ncnn::Mat b_fp32;
+    test_layer_naive(ncnn::layer_to_index("InnerProduct"), pd, weights, a, b_fp32, 0);
+
+    const float error = RelativeError(b_fp32, b);
+    if (error > (bits == 8 ? 0.01f : 0.1f))
+    {
+        fprintf(stderr, "test_innerproduct_weight_quant accuracy failed a.dims=%d a=(%d %d %d %d) outch=%d bits=%d group_size=%d error=%f\n", a.dims, a.w, a.h, a.d, a.c, outch, bits, group_size, error);
+        return -1;
+    }
+
+    return 0;
+}
+
+// the model stores the quantized weight as int8 followed by the scales and zeros
+static int test_innerproduct_weight_quant_model(const ncnn::Mat& a, int outch, int bits, int group_size)
+{
+    const int num_input = a.w * a.h * a.d * a.c;
+    const int num_groups = bits == 4 ? (num_input + group_size - 1) / group_size : 1;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, 1);     // bias_term
+    pd.set(2, outch * num_input);
+    pd.set(11, bits);
+    pd.set(12, group_size);
+
+    std::vector<ncnn::Mat> weights(bits == 4 ? 4 : 3);
+    weights[0].create(outch * num_input, (size_t)1u);
+    for (int i = 0; i < outch * num_input; i++)
+    {
+        ((signed char*)weights[0])[i] = bits == 4 ? RandomInt(0, 15) : RandomInt(-127, 127);
+    }
+    weights[1] = RandomMat(outch);
+    weights[2] = RandomMat(num_groups * outch, 0.001f, 0.02f);
+    if (bits == 4)
+    {
+        weights[3].create(num_groups * outch);
+        for (int i = 0; i < num_groups * outch; i++)
+        {
+            weights[3][i] = (float)RandomInt(0, 15);
+        }
+    }
+
+    int ret = test_layer("InnerProduct", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_innerproduct_weight_quant_model failed a.dims=%d a=(%d %d %d %d) outch=%d bits=%d group_size=%d\n", a.dims, a.w, a.h, a.d, a.c, outch, bits, group_size);
+    }
+
+    return ret;
+}
+
+static int test_innerproduct_weight_quant_0()
+{
+    return 0
+           || test_innerproduct_weight_quant(RandomMat(64), 16, 1, 8, 32)
+           || test_innerproduct_weight_quant(RandomMat(67), 9, 0, 8, 32)
+           || test_innerproduct_weight_quant(RandomMat(128), 24, 1, 4, 32)
+           || test_innerproduct_weight_quant(RandomMat(100), 7, 1, 4, 64)
+           || test_innerproduct_weight_quant(RandomMat(35), 8, 0, 4, 8)
+           || test_innerproduct_weight_quant(RandomMat(3, 5, 8), 13, 1, 8, 32)
+           || test_innerproduct_weight_quant(RandomMat(3, 5, 8), 16, 1, 4, 16);
+}
+
+static int test_innerproduct_weight_quant_1()
+{
+    return 0
+           || test_innerproduct_weight_quant(RandomMat(64, 1), 16, 1, 8, 32)
+           || test_innerproduct_weight_quant(RandomMat(64, 4), 16, 0, 8, 32)
+           || test_innerproduct_weight_quant(RandomMat(64, 5), 12, 1, 4, 32)
+           || test_innerproduct_weight_quant(RandomMat(49, 8), 17, 1, 4, 16)
+           || test_innerproduct_weight_quant(RandomMat(96, 16), 32, 0, 4, 32);
+}
+
+static int test_innerproduct_weight_quant_2()
+{
+    return 0
+           || test_innerproduct_weight_quant_model(RandomMat(40), 8, 8, 32)
+           || test_innerproduct_weight_quant_model(RandomMat(40), 8, 4, 16)
+           || test_innerproduct_weight_quant_model(RandomMat(33, 3), 5, 4, 8)
+           || test_innerproduct_weight_quant_model(RandomMat(33, 3), 5, 8, 32);
+}
+#endif // NCNN_INT8
+
+int main()
+{
+    SRAND(7767517);
+
+#if NCNN_INT8
+    return 0
+           || test_innerproduct_weight_quant_0()
+           || test_innerproduct_weight_quant_1()
+           || test_innerproduct_weight_quant_2();
+#else
+    // test nothing
+    return 0;
+#endif
+}
@@ -0,0 +1,140 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "testutil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// an inception block, four branches of different depth joined by concat
+// plus a side output taken from one branch
+static const char* param_str = "7767517\n"
+                               "11 14\n"
+                               "Input       input   0 1 data\n"
+                               "Split       split   1 4 data b0 b1 b2 b3\n"
+                               "Convolution conv0   1 1 b0 conv0 0=8 1=1 5=1 6=24\n"
+                               "Convolution conv1a  1 1 b1 conv1a 0=8 1=1 5=1 6=24 9=1\n"
+                               "Convolution conv1b  1 1 conv1a conv1b 0=8 1=3 4=1 5=1 6=576\n"
+                               "Convolution conv2a  1 1 b2 conv2a 0=4 1=1 5=1 6=12 9=1\n"
+                               "Convolution conv2b  1 1 conv2a conv2b 0=4 1=3 4=1 5=1 6=144 9=1\n"
+                               "Convolution conv2c  1 1 conv2b conv2c 0=8 1=3 4=1 5=1 6=288\n"
+                               "Pooling     pool3   1 1 b3 pool3 0=0 1=3 3=1\n"
+                               "Convolution conv3   1 1 pool3 conv3 0=8 1=1 5=1 6=24\n"
+                               "Concat      concat  4 1 conv0 conv1b conv2c conv3 output\n";
+
+static std::vector<float> weights;
+
+static void append_weights(int size, bool with_flag)
+{
+    // a zero flag tags raw fp32 data
+    if (with_flag)
+        weights.push_back(0.f);
+
+    ncnn::Mat m = RandomMat(size);
+    weights.insert(weights.end(), (const float*)m, (const float*)m + size);
+}
+
+static int load_net(ncnn::Net& net, bool use_inter_op_parallel, int num_threads)
+{
+    net.opt.use_inter_op_parallel = use_inter_op_parallel;
+    net.opt.num_threads = num_threads;
+
+    if (net.load_param_mem(param_str) != 0)
+        return -1;
+
+    net.load_model((const unsigned char*)weights.data());
+    return 0;
+}
+
+static int forward(const ncnn::Net& net, const ncnn::Mat& in, ncnn::Mat& out, ncnn::Mat& side)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+
+    // the side blob is already computed when output is extracted
+    int ret = ex.extract("conv2b", side);
+    if (ret != 0)
+        return ret;
+
+    return ex.extract("output", out);
+}
+
+static int test_interop_parallel(int num_threads)
+{
+    ncnn::Net net_ref;
+    ncnn::Net net;
+    if (load_net(net_ref, false, 1) != 0 || load_net(net, true, num_threads) != 0)
+        return -1;
+
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat in = i == 2 ? RandomMat(7, 5, 3) : RandomMat(13, 11, 3);
+
+        ncnn::Mat out_ref;
+        ncnn::Mat side_ref;
+        forward(net_ref, in, out_ref, side_ref);
+
+        ncnn::Mat out;
+        ncnn::Mat side;
+        int ret = forward(net, in, out, side);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_interop_parallel num_threads=%d forward failed %d\n", num_threads, ret);
+            return -1;
+        }
+
+        if (CompareMat(out, out_ref, 0.001) != 0 || CompareMat(side, side_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_interop_parallel num_threads=%d output mismatch\n", num_threads);
+            return -1;
+        }
+    }
+
+    // extract output only, all branches scheduled in one go
+    {
+        ncnn::Mat in = RandomMat(13, 11, 3);
+
+        ncnn::Extractor ex_ref = net_ref.create_extractor();
+        ex_ref.input("data", in);
+        ncnn::Mat out_ref;
+        ex_ref.extract("output", out_ref);
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        ncnn::Mat out;
+        ex.extract("output", out);
+
+        if (CompareMat(out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_interop_parallel num_threads=%d single extract mismatch\n", num_threads);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    append_weights(24, true);
+    append_weights(8, false);
+    append_weights(24, true);
+    append_weights(8, false);
+    append_weights(576, true);
+    append_weights(8, false);
+    append_weights(12, true);
+    append_weights(4, false);
+    append_weights(144, true);
+    append_weights(4, false);
+    append_weights(288, true);
+    append_weights(8, false);
+    append_weights(24, true);
+    append_weights(8, false);
+
+    return 0
+           || test_interop_parallel(2)
+           || test_interop_parallel(4);
+}
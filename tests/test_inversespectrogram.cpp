@@ -37,9 +37,21 @@ static int test_inversespectrogram_0()
            || test_inversespectrogram(124, 28, 55, 2, 12, 55, 1, 1, 2);
 }
 
+static int test_inversespectrogram_1()
+{
+    return 0
+           || test_inversespectrogram(40, 201, 400, 1, 100, 400, 1, 1, 0)
+           || test_inversespectrogram(37, 257, 512, 0, 128, 512, 1, 1, 1)
+           || test_inversespectrogram(29, 64, 64, 2, 16, 48, 2, 0, 2)
+           || test_inversespectrogram(25, 16, 30, 0, 9, 30, 1, 1, 0)
+           || test_inversespectrogram(21, 49, 49, 1, 12, 49, 0, 0, 1);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_inversespectrogram_0();
+    return 0
+           || test_inversespectrogram_0()
+           || test_inversespectrogram_1();
 }
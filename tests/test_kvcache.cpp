@@ -0,0 +1,138 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "kvcache.h"
+#include "net.h"
+#include "testutil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* sdpa_cache_param = "7767517\n"
+                                      "5 8\n"
+                                      "Input q 0 1 q\n"
+                                      "Input k 0 1 k\n"
+                                      "Input v 0 1 v\n"
+                                      "Input kv_cache 0 2 past_k past_v\n"
+                                      "SDPA sdpa 5 3 q k v past_k past_v out out_k out_v 7=1\n";
+
+static const char* sdpa_param = "7767517\n"
+                                "4 4\n"
+                                "Input q 0 1 q\n"
+                                "Input k 0 1 k\n"
+                                "Input v 0 1 v\n"
+                                "SDPA sdpa 3 1 q k v out\n";
+
+// keep the first seqlen rows of a and append b
+static ncnn::Mat append_rows(const ncnn::Mat& a, int seqlen, const ncnn::Mat& b)
+{
+    ncnn::Mat m(b.w, seqlen + b.h, b.c);
+    for (int q = 0; q < b.c; q++)
+    {
+        if (seqlen > 0)
+            memcpy(m.channel(q), a.channel(q), b.w * seqlen * sizeof(float));
+        memcpy(m.channel(q).row(seqlen), b.channel(q), b.w * b.h * sizeof(float));
+    }
+    return m;
+}
+
+static int test_kvcache(bool use_packing_layout)
+{
+    ncnn::Net net;
+    net.opt.use_packing_layout = use_packing_layout;
+    net.load_param_mem(sdpa_cache_param);
+    net.load_model((const unsigned char*)"");
+
+    ncnn::Net net_ref;
+    net_ref.opt.use_packing_layout = use_packing_layout;
+    net_ref.load_param_mem(sdpa_param);
+    net_ref.load_model((const unsigned char*)"");
+
+    ncnn::KVCache kv_cache;
+    kv_cache.reserve(8);
+    kv_cache.set_block_size(4);
+
+    // prefill 3, decode, grow past the reserved capacity, roll back 2, prefill 5 more, decode
+    const int cur_seqlens[14] = {3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 1, 1, 1};
+
+    ncnn::Mat key_all;
+    ncnn::Mat value_all;
+    int seqlen = 0;
+    for (int i = 0; i < 14; i++)
+    {
+        if (i == 7)
+        {
+            kv_cache.truncate(seqlen - 2);
+            seqlen -= 2;
+        }
+
+        const int cur_seqlen = cur_seqlens[i];
+        ncnn::Mat q = RandomMat(16, cur_seqlen, 2);
+        ncnn::Mat k = RandomMat(16, cur_seqlen, 2);
+        ncnn::Mat v = RandomMat(16, cur_seqlen, 2);
+
+        key_all = append_rows(key_all, seqlen, k);
+        value_all = append_rows(value_all, seqlen, v);
+        seqlen += cur_seqlen;
+
+        ncnn::Mat out;
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.set_kv_cache(&kv_cache);
+            ex.input("q", q);
+            ex.input("k", k);
+            ex.input("v", v);
+            int ret = ex.extract("out", out);
+            if (ret != 0)
+            {
+                fprintf(stderr, "test_kvcache extract failed at step %d\n", i);
+                return -1;
+            }
+        }
+
+        ncnn::Mat out_ref;
+        {
+            ncnn::Extractor ex = net_ref.create_extractor();
+            ex.input("q", q);
+            ex.input("k", key_all);
+            ex.input("v", value_all);
+            ex.extract("out", out_ref);
+        }
+
+        if (kv_cache.seqlen() != seqlen)
+        {
+            fprintf(stderr, "test_kvcache seqlen failed at step %d %d != %d\n", i, kv_cache.seqlen(), seqlen);
+            return -1;
+        }
+
+        if (kv_cache.capacity() < seqlen)
+        {
+            fprintf(stderr, "test_kvcache capacity failed at step %d %d < %d\n", i, kv_cache.capacity(), seqlen);
+            return -1;
+        }
+
+        if (CompareMat(out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_kvcache output failed at step %d use_packing_layout=%d\n", i, use_packing_layout);
+            return -1;
+        }
+    }
+
+    kv_cache.clear();
+    if (kv_cache.seqlen() != 0)
+    {
+        fprintf(stderr, "test_kvcache clear failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_kvcache(false)
+           || test_kvcache(true);
+}
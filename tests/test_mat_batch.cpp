@@ -1308,6 +1308,167 @@ static int test_batch_forward_pooling()
     return 0;
 }
 
+// run the batched input through the net and compare each batch item against a single-item forward
+static int test_batch_forward_compare(const char* name, const char* param_str, const std::vector<float>& weights, const ncnn::Mat& item, int B, bool use_packing_layout)
+{
+    ncnn::Net net;
+    net.opt.use_packing_layout = use_packing_layout;
+    net.load_param_mem(param_str);
+    net.load_model((const unsigned char*)weights.data());
+
+    ncnn::Mat input_batch;
+    if (item.dims == 1)
+        input_batch.create_batch(item.w, B, 4u, 1);
+    if (item.dims == 2)
+        input_batch.create_batch(item.w, item.h, B, 4u, 1);
+    if (item.dims == 3)
+        input_batch.create_batch(item.w, item.h, item.c, B, 4u, 1);
+
+    std::vector<ncnn::Mat> items(B);
+    for (int b = 0; b < B; b++)
+    {
+        if (item.dims == 1)
+            items[b] = RandomMat(item.w);
+        if (item.dims == 2)
+            items[b] = RandomMat(item.w, item.h);
+        if (item.dims == 3)
+            items[b] = RandomMat(item.w, item.h, item.c);
+
+        ncnn::Mat sub = input_batch.batch(b);
+        for (int q = 0; q < sub.c; q++)
+        {
+            memcpy(sub.channel(q), items[b].channel(q), sub.w * sub.h * sizeof(float));
+        }
+    }
+
+    ncnn::Mat output_batch;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", input_batch);
+        int ret = ex.extract("output", output_batch);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_batch_forward_%s extract failed ret=%d\n", name, ret);
+            return -1;
+        }
+    }
+
+    if (output_batch.n != B)
+    {
+        fprintf(stderr, "test_batch_forward_%s output n expect %d got %d\n", name, B, output_batch.n);
+        return -1;
+    }
+
+    for (int b = 0; b < B; b++)
+    {
+        ncnn::Mat out_ref;
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", items[b]);
+        ex.extract("output", out_ref);
+
+        if (CompareMat(output_batch.batch(b), out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_batch_forward_%s b%d mismatch use_packing_layout=%d\n", name, b, use_packing_layout);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static void append_weights(std::vector<float>& weights, int size, bool with_flag)
+{
+    // a zero flag tags raw fp32 data
+    if (with_flag)
+        weights.push_back(0.f);
+
+    ncnn::Mat m = RandomMat(size);
+    weights.insert(weights.end(), (const float*)m, (const float*)m + size);
+}
+
+static int test_batch_forward_convolution()
+{
+    // 3x3 stride 1 and 3x3 stride 2 with padding, the batch items are stacked into one convolution
+    const char param_str[] = "7767517\n"
+                             "3 3\n"
+                             "Input       input   0 1 data\n"
+                             "Convolution conv0   1 1 data conv0 0=8 1=3 4=1 5=1 6=288\n"
+                             "Convolution conv1   1 1 conv0 output 0=16 1=3 3=2 4=1 5=1 6=1152\n";
+
+    std::vector<float> weights;
+    append_weights(weights, 288, true);
+    append_weights(weights, 8, false);
+    append_weights(weights, 1152, true);
+    append_weights(weights, 16, false);
+
+    return 0
+           || test_batch_forward_compare("convolution", param_str, weights, ncnn::Mat(7, 9, 4), 3, false)
+           || test_batch_forward_compare("convolution", param_str, weights, ncnn::Mat(7, 9, 4), 3, true);
+}
+
+static int test_batch_forward_convolutiondepthwise()
+{
+    const char param_str[] = "7767517\n"
+                             "2 2\n"
+                             "Input                input   0 1 data\n"
+                             "ConvolutionDepthWise dw0     1 1 data output 0=8 1=3 3=2 4=1 5=1 6=72 7=8\n";
+
+    std::vector<float> weights;
+    append_weights(weights, 72, true);
+    append_weights(weights, 8, false);
+
+    return 0
+           || test_batch_forward_compare("convolutiondepthwise", param_str, weights, ncnn::Mat(10, 6, 8), 2, false)
+           || test_batch_forward_compare("convolutiondepthwise", param_str, weights, ncnn::Mat(10, 6, 8), 2, true);
+}
+
+static int test_batch_forward_innerproduct()
+{
+    // flattened 3d items, 1d items and 2d items through the gemm path
+    const char param_str[] = "7767517\n"
+                             "2 2\n"
+                             "Input        input   0 1 data\n"
+                             "InnerProduct fc      1 1 data output 0=12 1=1 2=1152\n";
+
+    const char param_str_2d[] = "7767517\n"
+                                "2 2\n"
+                                "Input        input   0 1 data\n"
+                                "InnerProduct fc      1 1 data output 0=12 1=1 2=192\n";
+
+    std::vector<float> weights;
+    append_weights(weights, 1152, true);
+    append_weights(weights, 12, false);
+
+    std::vector<float> weights_2d;
+    append_weights(weights_2d, 192, true);
+    append_weights(weights_2d, 12, false);
+
+    return 0
+           || test_batch_forward_compare("innerproduct", param_str, weights, ncnn::Mat(6, 4, 4), 5, false)
+           || test_batch_forward_compare("innerproduct", param_str, weights, ncnn::Mat(6, 4, 4), 5, true)
+           || test_batch_forward_compare("innerproduct", param_str_2d, weights_2d, ncnn::Mat(16), 4, true)
+           || test_batch_forward_compare("innerproduct", param_str_2d, weights_2d, ncnn::Mat(16, 3), 4, false)
+           || test_batch_forward_compare("innerproduct", param_str_2d, weights_2d, ncnn::Mat(16, 3), 4, true);
+}
+
+static int test_batch_forward_gemm()
+{
+    // A(K=16, M=6) x constant B(N=24) + constant C per N
+    const char param_str[] = "7767517\n"
+                             "2 2\n"
+                             "Input input   0 1 data\n"
+                             "Gemm  gemm    1 1 data output 4=0 5=1 6=1 7=0 8=24 9=16 10=4\n";
+
+    std::vector<float> weights;
+    append_weights(weights, 24 * 16, true);
+    append_weights(weights, 24, true);
+
+    return 0
+           || test_batch_forward_compare("gemm", param_str, weights, ncnn::Mat(16, 6), 4, false)
+           || test_batch_forward_compare("gemm", param_str, weights, ncnn::Mat(16, 6), 4, true)
+           || test_batch_forward_compare("gemm", param_str, weights, ncnn::Mat(16, 5), 3, true);
+}
+
 #if NCNN_VULKAN
 static int test_vkmat_create_batch_basic()
 {
@@ -2360,6 +2521,10 @@ int main()
     ret |= test_batch_forward_shape_ops();
     ret |= test_batch_forward_relu();
     ret |= test_batch_forward_pooling();
+    ret |= test_batch_forward_convolution();
+    ret |= test_batch_forward_convolutiondepthwise();
+    ret |= test_batch_forward_innerproduct();
+    ret |= test_batch_forward_gemm();
 
 #if NCNN_VULKAN
     ncnn::create_gpu_instance();
@@ -0,0 +1,189 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "testutil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// two branches joined by an add, so that blobs with different lifetimes share the arena
+static const char* param_str = "7767517\n"
+                               "8 9\n"
+                               "Input       input   0 1 data\n"
+                               "Convolution conv0   1 1 data conv0 0=8 1=3 4=1 5=1 6=216\n"
+                               "Split       split   1 2 conv0 a b\n"
+                               "Convolution conv1   1 1 a conv1 0=8 1=3 4=1 5=1 6=576\n"
+                               "Convolution conv2   1 1 b conv2 0=8 1=1 5=1 6=64\n"
+                               "BinaryOp    add     2 1 conv1 conv2 sum 0=0\n"
+                               "ReLU        relu    1 1 sum relu\n"
+                               "Convolution conv3   1 1 relu output 0=4 1=3 3=2 4=1 5=1 6=288\n";
+
+static std::vector<float> weights;
+
+static void append_weights(int size, bool with_flag)
+{
+    // a zero flag tags raw fp32 data
+    if (with_flag)
+        weights.push_back(0.f);
+
+    ncnn::Mat m = RandomMat(size);
+    weights.insert(weights.end(), (const float*)m, (const float*)m + size);
+}
+
+static int load_net(ncnn::Net& net, bool use_packing_layout)
+{
+    net.opt.use_packing_layout = use_packing_layout;
+
+    if (net.load_param_mem(param_str) != 0)
+        return -1;
+
+    net.load_model((const unsigned char*)weights.data());
+    return 0;
+}
+
+static int forward(const ncnn::Net& net, const ncnn::Mat& in, ncnn::Mat& out, ncnn::Allocator* blob_allocator = 0)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    if (blob_allocator)
+        ex.set_blob_allocator(blob_allocator);
+    ex.input("data", in);
+    return ex.extract("output", out);
+}
+
+static int test_arena_allocator(bool use_packing_layout)
+{
+    ncnn::Net net;
+    if (load_net(net, use_packing_layout) != 0)
+        return -1;
+
+    ncnn::ArenaAllocator allocator;
+
+    ncnn::Mat in0 = RandomMat(13, 11, 3);
+    ncnn::Mat in1 = RandomMat(13, 11, 3);
+
+    {
+        allocator.begin_record();
+
+        ncnn::Mat out;
+        forward(net, in0, out, &allocator);
+
+        allocator.end_record();
+    }
+
+    if (allocator.arena_size() == 0 || allocator.arena_size() >= allocator.planned_size())
+    {
+        fprintf(stderr, "test_arena_allocator no memory shared, arena %zu planned %zu\n", allocator.arena_size(), allocator.planned_size());
+        return -1;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        const ncnn::Mat& in = i == 0 ? in0 : in1;
+
+        if (allocator.begin_replay() != 0)
+        {
+            fprintf(stderr, "test_arena_allocator begin_replay failed\n");
+            return -1;
+        }
+
+        ncnn::Mat out;
+        forward(net, in, out, &allocator);
+
+        // only the output escapes the arena
+        if (allocator.unplanned_count() > 2)
+        {
+            fprintf(stderr, "test_arena_allocator %d allocations not served from arena\n", allocator.unplanned_count());
+            return -1;
+        }
+
+        ncnn::Mat out_ref;
+        forward(net, in, out_ref);
+
+        if (CompareMat(out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_arena_allocator output mismatch use_packing_layout=%d\n", use_packing_layout);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_plan_memory(bool use_packing_layout)
+{
+    ncnn::Net net;
+    if (load_net(net, use_packing_layout) != 0)
+        return -1;
+
+    ncnn::Mat in0 = RandomMat(13, 11, 3);
+    ncnn::Mat in1 = RandomMat(13, 11, 3);
+    ncnn::Mat in2 = RandomMat(7, 9, 3);
+
+    ncnn::Mat out0_ref;
+    ncnn::Mat out1_ref;
+    ncnn::Mat out2_ref;
+    forward(net, in0, out0_ref);
+    forward(net, in1, out1_ref);
+    forward(net, in2, out2_ref);
+
+    int ret = net.plan_memory(std::vector<ncnn::Mat>(1, ncnn::Mat(13, 11, 3)));
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_plan_memory plan_memory failed %d\n", ret);
+        return -1;
+    }
+
+    // the outputs are kept across inferences and must not be overwritten by the arena
+    ncnn::Mat out0;
+    ncnn::Mat out1;
+    ncnn::Mat out2;
+    forward(net, in0, out0);
+    forward(net, in1, out1);
+    forward(net, in2, out2);
+
+    if (CompareMat(out0, out0_ref, 0.001) != 0 || CompareMat(out1, out1_ref, 0.001) != 0 || CompareMat(out2, out2_ref, 0.001) != 0)
+    {
+        fprintf(stderr, "test_plan_memory output mismatch use_packing_layout=%d\n", use_packing_layout);
+        return -1;
+    }
+
+    // concurrent extractors, the second one falls back to the pool allocator
+    {
+        ncnn::Extractor ex0 = net.create_extractor();
+        ncnn::Extractor ex1 = net.create_extractor();
+        ex0.input("data", in0);
+        ex1.input("data", in1);
+
+        ex0.extract("output", out0);
+        ex1.extract("output", out1);
+    }
+
+    if (CompareMat(out0, out0_ref, 0.001) != 0 || CompareMat(out1, out1_ref, 0.001) != 0)
+    {
+        fprintf(stderr, "test_plan_memory concurrent output mismatch use_packing_layout=%d\n", use_packing_layout);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    append_weights(216, true);
+    append_weights(8, false);
+    append_weights(576, true);
+    append_weights(8, false);
+    append_weights(64, true);
+    append_weights(8, false);
+    append_weights(288, true);
+    append_weights(4, false);
+
+    return 0
+           || test_arena_allocator(false)
+           || test_arena_allocator(true)
+           || test_plan_memory(false)
+           || test_plan_memory(true);
+}
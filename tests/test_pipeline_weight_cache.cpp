@@ -0,0 +1,172 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "testutil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// winograd, sgemm and packed convolutions plus innerproduct, all with transformed weights
+static const char* param_str = "7767517\n"
+                               "6 6\n"
+                               "Input        input   0 1 data\n"
+                               "Convolution  conv0   1 1 data conv0 0=16 1=3 4=1 5=1 6=432 9=1\n"
+                               "Convolution  conv1   1 1 conv0 conv1 0=16 1=3 4=1 5=1 6=2304\n"
+                               "Convolution  conv2   1 1 conv1 conv2 0=32 1=1 5=1 6=512\n"
+                               "Convolution  conv3   1 1 conv2 conv3 0=16 1=3 3=2 5=1 6=4608\n"
+                               "InnerProduct fc      1 1 conv3 output 0=10 1=1 2=7840\n";
+
+static const char* modelpath = "test_pipeline_weight_cache.model";
+static const char* cachepath = "test_pipeline_weight_cache.cache";
+
+static std::vector<float> generate_weights()
+{
+    const int sizes[10] = {432, 16, 2304, 16, 512, 32, 4608, 16, 7840, 10};
+
+    std::vector<float> weights;
+    for (int i = 0; i < 10; i++)
+    {
+        // a zero flag tags raw fp32 weight data, bias comes without flag
+        if (i % 2 == 0)
+            weights.push_back(0.f);
+
+        ncnn::Mat m = RandomMat(sizes[i]);
+        weights.insert(weights.end(), (const float*)m, (const float*)m + sizes[i]);
+    }
+
+    return weights;
+}
+
+static int write_file(const char* path, const std::vector<float>& data)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+        return -1;
+
+    size_t nwrite = fwrite(data.data(), sizeof(float), data.size(), fp);
+    fclose(fp);
+    return nwrite == data.size() ? 0 : -1;
+}
+
+static std::vector<unsigned char> read_file(const char* path)
+{
+    std::vector<unsigned char> data;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return data;
+
+    unsigned char buf[4096];
+    size_t nread;
+    while ((nread = fread(buf, 1, sizeof(buf), fp)) > 0)
+    {
+        data.insert(data.end(), buf, buf + nread);
+    }
+
+    fclose(fp);
+    return data;
+}
+
+static int forward(const ncnn::Option& opt, const char* weight_cache, const ncnn::Mat& in, ncnn::Mat& out)
+{
+    ncnn::Net net;
+    net.opt = opt;
+
+    if (weight_cache)
+        net.set_pipeline_weight_cache(weight_cache);
+
+    if (net.load_param_mem(param_str) != 0)
+        return -1;
+
+    if (net.load_model(modelpath) != 0)
+        return -1;
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+    return ex.extract("output", out);
+}
+
+static int test_pipeline_weight_cache(bool use_packing_layout, bool use_mapped_model_loading, bool lightmode)
+{
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = use_packing_layout;
+    opt.use_mapped_model_loading = use_mapped_model_loading;
+    opt.lightmode = lightmode;
+
+    remove(cachepath);
+
+    ncnn::Mat in = RandomMat(15, 15, 3);
+
+    for (int k = 0; k < 2; k++)
+    {
+        // the second round leaves a cache of other weights behind
+        if (write_file(modelpath, generate_weights()) != 0)
+        {
+            fprintf(stderr, "test_pipeline_weight_cache write model failed\n");
+            return -1;
+        }
+
+        ncnn::Mat out_ref;
+        if (forward(opt, 0, in, out_ref) != 0)
+        {
+            fprintf(stderr, "test_pipeline_weight_cache forward failed\n");
+            return -1;
+        }
+
+        const std::vector<unsigned char> stale_cache_data = read_file(cachepath);
+
+        // the first load prepares and saves the weights, the second restores them
+        std::vector<unsigned char> cache_data;
+        for (int i = 0; i < 2; i++)
+        {
+            ncnn::Mat out;
+            if (forward(opt, cachepath, in, out) != 0)
+            {
+                fprintf(stderr, "test_pipeline_weight_cache forward with cache failed\n");
+                return -1;
+            }
+
+            if (CompareMat(out, out_ref, 0.001) != 0)
+            {
+                fprintf(stderr, "test_pipeline_weight_cache output mismatch round %d load %d use_packing_layout=%d use_mapped_model_loading=%d lightmode=%d\n", k, i, use_packing_layout, use_mapped_model_loading, lightmode);
+                return -1;
+            }
+
+            if (i == 0)
+            {
+                cache_data = read_file(cachepath);
+                if (cache_data.empty() || cache_data == stale_cache_data)
+                {
+                    fprintf(stderr, "test_pipeline_weight_cache cache not written round %d\n", k);
+                    return -1;
+                }
+            }
+            else
+            {
+                if (read_file(cachepath) != cache_data)
+                {
+                    fprintf(stderr, "test_pipeline_weight_cache cache rewritten on hit round %d\n", k);
+                    return -1;
+                }
+            }
+        }
+    }
+
+    remove(cachepath);
+    remove(modelpath);
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_pipeline_weight_cache(false, false, true)
+           || test_pipeline_weight_cache(true, false, true)
+           || test_pipeline_weight_cache(true, true, true)
+           || test_pipeline_weight_cache(true, true, false);
+}
@@ -0,0 +1,191 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "profiler.h"
+#include "testutil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* param_str = "7767517\n"
+                               "5 5\n"
+                               "Input       input   0 1 data\n"
+                               "Convolution conv0   1 1 data conv0 0=16 1=3 4=1 5=1 6=432\n"
+                               "ReLU        relu    1 1 conv0 relu\n"
+                               "Convolution conv1   1 1 relu conv1 0=8 1=1 5=1 6=128\n"
+                               "Pooling     pool    1 1 conv1 output 0=1 4=1\n";
+
+static std::vector<float> weights;
+
+static void append_weights(int size, bool with_flag)
+{
+    // a zero flag tags raw fp32 data
+    if (with_flag)
+        weights.push_back(0.f);
+
+    ncnn::Mat m = RandomMat(size);
+    weights.insert(weights.end(), (const float*)m, (const float*)m + size);
+}
+
+static int test_profiler_records()
+{
+    ncnn::Net net;
+    net.opt.use_winograd_convolution = true;
+    net.opt.use_sgemm_convolution = true;
+
+    if (net.load_param_mem(param_str) != 0)
+        return -1;
+
+    net.load_model((const unsigned char*)weights.data());
+
+    ncnn::Profiler profiler;
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_profiler(&profiler);
+        ex.input("data", RandomMat(13, 11, 3));
+
+        ncnn::Mat out;
+        int ret = ex.extract("output", out);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_profiler_records extract failed %d\n", ret);
+            return -1;
+        }
+    }
+
+    // four layers twice, input layer excluded
+    std::vector<ncnn::LayerProfile> records = profiler.records();
+    if (records.size() != 8)
+    {
+        fprintf(stderr, "test_profiler_records expect 8 records got %d\n", (int)records.size());
+        return -1;
+    }
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const ncnn::LayerProfile& r = records[i];
+
+        if (r.end < r.start || r.start < 0.0 || r.thread_id != 0 || r.num_threads != net.opt.num_threads)
+        {
+            fprintf(stderr, "test_profiler_records record %d bad timing %f %f thread %d\n", (int)i, r.start, r.end, r.thread_id);
+            return -1;
+        }
+
+        if (r.bottom_shapes.size() != 1 || r.top_shapes.size() != 1 || r.top_shapes[0].dims == 0)
+        {
+            fprintf(stderr, "test_profiler_records record %d bad shapes\n", (int)i);
+            return -1;
+        }
+    }
+
+    const ncnn::LayerProfile& conv0 = records[0];
+    if (strcmp(conv0.name, "conv0") != 0 || strcmp(conv0.kernel, "winograd") != 0 || conv0.bottom_shapes[0].w != 13 || conv0.allocated == 0)
+    {
+        fprintf(stderr, "test_profiler_records conv0 %s kernel %s w %d allocated %d\n", conv0.name, conv0.kernel, conv0.bottom_shapes[0].w, (int)conv0.allocated);
+        return -1;
+    }
+
+    // relu runs inplace
+    const ncnn::LayerProfile& relu = records[1];
+    if (strcmp(relu.type, "ReLU") != 0 || relu.allocated != 0)
+    {
+        fprintf(stderr, "test_profiler_records relu %s allocated %d\n", relu.type, (int)relu.allocated);
+        return -1;
+    }
+
+    if (strcmp(records[2].kernel, "sgemm") != 0)
+    {
+        fprintf(stderr, "test_profiler_records conv1 kernel %s\n", records[2].kernel);
+        return -1;
+    }
+
+    std::vector<ncnn::LayerTypeProfile> summary = profiler.summary();
+    if (summary.size() != 3)
+    {
+        fprintf(stderr, "test_profiler_records expect 3 layer types got %d\n", (int)summary.size());
+        return -1;
+    }
+
+    for (size_t i = 0; i < summary.size(); i++)
+    {
+        const ncnn::LayerTypeProfile& t = summary[i];
+        const int expect_count = strcmp(t.type, "Convolution") == 0 ? 4 : 2;
+        if (t.count != expect_count || t.min > t.max || (i > 0 && summary[i - 1].total < t.total))
+        {
+            fprintf(stderr, "test_profiler_records summary %s count %d\n", t.type, t.count);
+            return -1;
+        }
+    }
+
+    profiler.clear();
+    if (!profiler.records().empty())
+    {
+        fprintf(stderr, "test_profiler_records clear failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_profiler_chrome_trace()
+{
+    ncnn::Net net;
+    if (net.load_param_mem(param_str) != 0)
+        return -1;
+
+    net.load_model((const unsigned char*)weights.data());
+
+    ncnn::Profiler profiler;
+
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_profiler(&profiler);
+        ex.input("data", RandomMat(13, 11, 3));
+
+        ncnn::Mat out;
+        ex.extract("output", out);
+    }
+
+    FILE* fp = tmpfile();
+    if (!fp)
+        return 0;
+
+    int ret = profiler.write_chrome_trace(fp);
+    if (ret != 0)
+    {
+        fclose(fp);
+        fprintf(stderr, "test_profiler_chrome_trace write failed\n");
+        return -1;
+    }
+
+    std::vector<char> json(4096, 0);
+    rewind(fp);
+    size_t nread = fread(json.data(), 1, json.size() - 1, fp);
+    fclose(fp);
+
+    const char* s = json.data();
+    if (nread == 0 || strncmp(s, "{\"traceEvents\":[", 16) != 0 || !strstr(s, "\"name\":\"conv1\"") || !strstr(s, "\"ph\":\"X\"") || !strstr(s, "\"displayTimeUnit\""))
+    {
+        fprintf(stderr, "test_profiler_chrome_trace unexpected json\n%s\n", s);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    append_weights(432, true);
+    append_weights(16, false);
+    append_weights(128, true);
+    append_weights(8, false);
+
+    return 0
+           || test_profiler_records()
+           || test_profiler_chrome_trace();
+}
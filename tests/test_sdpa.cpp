@@ -47,7 +47,11 @@ static int test_sdpa_0()
            || test_sdpa(RandomMat(44, 128, 4), RandomMat(44, 123, 4), RandomMat(55, 123, 4), 0, 1.f)
            || test_sdpa(RandomMat(12, 127, 4), RandomMat(12, 127, 4), RandomMat(55, 127, 4), 1, 1.f)
            || test_sdpa(RandomMat(28, 17, 15), RandomMat(28, 127, 5), RandomMat(32, 127, 5), 0, 0.1f)
-           || test_sdpa(RandomMat(28, 17, 15), RandomMat(28, 32, 5), RandomMat(11, 32, 5), 1, -0.4f);
+           || test_sdpa(RandomMat(28, 17, 15), RandomMat(28, 32, 5), RandomMat(11, 32, 5), 1, -0.4f)
+           || test_sdpa(RandomMat(64, 1, 8), RandomMat(64, 389, 2), RandomMat(64, 389, 2), 0)
+           || test_sdpa(RandomMat(33, 259, 3), RandomMat(33, 517, 3), RandomMat(47, 517, 3), 1)
+           || test_sdpa(RandomMat(128, 200, 4), RandomMat(128, 300, 1), RandomMat(128, 300, 1), 1, 0.05f)
+           || test_sdpa(RandomMat(300, 70, 2), RandomMat(300, 90, 2), RandomMat(260, 90, 2), 1, 0.02f);
 }
 
 #if NCNN_INT8
@@ -39,9 +39,21 @@ static int test_spectrogram_0()
            || test_spectrogram(124, 55, 2, 12, 55, 1, 1, 2, 2, 0);
 }
 
+static int test_spectrogram_1()
+{
+    return 0
+           || test_spectrogram(4000, 400, 2, 160, 400, 1, 1, 2, 0, 1)
+           || test_spectrogram(2048, 512, 0, 128, 512, 1, 1, 2, 1, 1)
+           || test_spectrogram(700, 64, 1, 16, 48, 2, 0, 1, 2, 0)
+           || test_spectrogram(900, 30, 0, 9, 30, 1, 1, 0, 0, 1)
+           || test_spectrogram(1000, 49, 2, 20, 49, 0, 1, 2, 1, 0);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_spectrogram_0();
+    return 0
+           || test_spectrogram_0()
+           || test_spectrogram_1();
 }
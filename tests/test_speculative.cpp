@@ -0,0 +1,185 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "speculative.h"
+
+#include <stdio.h>
+
+static const int vocab_size = 37;
+
+// a deterministic causal model, the next token is a hash of the whole context
+// the draft variant disagrees with the target after every period-th context length
+class MockDecoder : public ncnn::TokenDecoder
+{
+public:
+    MockDecoder(int _period)
+        : period(_period)
+    {
+    }
+
+    virtual int forward(const std::vector<int>& tokens, ncnn::Mat& logits)
+    {
+        logits.create(vocab_size, (int)tokens.size());
+        logits.fill(0.f);
+
+        for (size_t i = 0; i < tokens.size(); i++)
+        {
+            context.push_back(tokens[i]);
+            logits.row((int)i)[next_token(context, period)] = 1.f;
+        }
+
+        return 0;
+    }
+
+    virtual int seqlen() const
+    {
+        return (int)context.size();
+    }
+
+    virtual void truncate(int seqlen)
+    {
+        context.resize(seqlen);
+    }
+
+    static int next_token(const std::vector<int>& context, int period)
+    {
+        unsigned int h = 17;
+        for (size_t i = 0; i < context.size(); i++)
+        {
+            h = h * 31 + context[i];
+        }
+
+        int token = h % vocab_size;
+        if (period > 0 && context.size() % period == 0)
+            token = (token + 1) % vocab_size;
+
+        return token;
+    }
+
+public:
+    int period;
+    std::vector<int> context;
+};
+
+static std::vector<int> greedy_reference(const std::vector<int>& prompt, int max_new_tokens)
+{
+    std::vector<int> context = prompt;
+    std::vector<int> tokens;
+    for (int i = 0; i < max_new_tokens; i++)
+    {
+        int token = MockDecoder::next_token(context, 0);
+        context.push_back(token);
+        tokens.push_back(token);
+    }
+
+    return tokens;
+}
+
+static int test_speculative(int prompt_size, int max_new_tokens, int draft_count, int draft_period, bool use_draft)
+{
+    MockDecoder target(0);
+    MockDecoder draft(draft_period);
+
+    std::vector<int> prompt;
+    for (int i = 0; i < prompt_size; i++)
+    {
+        prompt.push_back((i * 7 + 3) % vocab_size);
+    }
+
+    ncnn::SpeculativeDecoder speculative(&target, use_draft ? &draft : 0);
+    speculative.set_draft_count(draft_count);
+
+    int ret = speculative.prefill(prompt);
+    if (ret != 0)
+    {
+        fprintf(stderr, "prefill failed\n");
+        return -1;
+    }
+
+    std::vector<int> tokens;
+    ret = speculative.generate(max_new_tokens, tokens);
+    if (ret != 0)
+    {
+        fprintf(stderr, "generate failed\n");
+        return -1;
+    }
+
+    // exactly the tokens of greedy decoding with the target alone
+    const std::vector<int> reference = greedy_reference(prompt, max_new_tokens);
+    for (int i = 0; i < max_new_tokens; i++)
+    {
+        if (tokens.size() != reference.size() || tokens[i] != reference[i])
+        {
+            fprintf(stderr, "test_speculative tokens mismatch prompt_size=%d max_new_tokens=%d draft_count=%d draft_period=%d use_draft=%d\n", prompt_size, max_new_tokens, draft_count, draft_period, use_draft);
+            return -1;
+        }
+    }
+
+    // the rejected tokens are rolled back, the last token is pending
+    const int n = (int)speculative.tokens().size();
+    if (target.seqlen() != n - 1 || (use_draft && draft.seqlen() > n - 1))
+    {
+        fprintf(stderr, "test_speculative seqlen mismatch target=%d draft=%d tokens=%d\n", target.seqlen(), draft.seqlen(), n);
+        return -1;
+    }
+
+    for (int i = 0; i < n - 1; i++)
+    {
+        if (target.context[i] != speculative.tokens()[i])
+        {
+            fprintf(stderr, "test_speculative target context mismatch at %d\n", i);
+            return -1;
+        }
+    }
+
+    if (speculative.accepted_count() > speculative.proposed_count())
+    {
+        fprintf(stderr, "test_speculative accepted %d > proposed %d\n", speculative.accepted_count(), speculative.proposed_count());
+        return -1;
+    }
+
+    if (!use_draft && speculative.proposed_count() != 0)
+    {
+        fprintf(stderr, "test_speculative proposed %d without draft\n", speculative.proposed_count());
+        return -1;
+    }
+
+    // a draft that always agrees gets draft_count + 1 tokens per target forward
+    if (use_draft && draft_period == 0)
+    {
+        const int steps = (max_new_tokens + draft_count) / (draft_count + 1);
+        if (speculative.target_forward_count() != steps + (prompt_size > 1 ? 1 : 0) || speculative.accepted_count() != speculative.proposed_count())
+        {
+            fprintf(stderr, "test_speculative target_forward_count %d accepted %d/%d expect %d steps\n", speculative.target_forward_count(), speculative.accepted_count(), speculative.proposed_count(), steps);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_speculative_0()
+{
+    return 0
+           || test_speculative(8, 32, 4, 0, true)
+           || test_speculative(8, 31, 3, 0, true)
+           || test_speculative(1, 20, 4, 0, true)
+           || test_speculative(5, 24, 1, 0, true);
+}
+
+static int test_speculative_1()
+{
+    return 0
+           || test_speculative(8, 32, 4, 3, true)
+           || test_speculative(7, 40, 5, 2, true)
+           || test_speculative(1, 17, 4, 5, true)
+           || test_speculative(9, 33, 2, 1, true)
+           || test_speculative(9, 16, 4, 0, false);
+}
+
+int main()
+{
+    return 0
+           || test_speculative_0()
+           || test_speculative_1();
+}
@@ -0,0 +1,46 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_spp(const ncnn::Mat& a, int pooling_type, int pyramid_height)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, pooling_type);   // pooling_type
+    pd.set(1, pyramid_height); // pyramid_height
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("SPP", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_spp failed a.dims=%d a=(%d %d %d) pooling_type=%d pyramid_height=%d\n", a.dims, a.w, a.h, a.c, pooling_type, pyramid_height);
+    }
+
+    return ret;
+}
+
+static int test_spp_0()
+{
+    ncnn::Mat a = RandomMat(9, 7, 1);
+    ncnn::Mat b = RandomMat(8, 8, 4);
+    ncnn::Mat c = RandomMat(13, 11, 12);
+    ncnn::Mat d = RandomMat(16, 15, 32);
+
+    return 0
+           || test_spp(a, 0, 1)
+           || test_spp(a, 1, 2)
+           || test_spp(b, 0, 2)
+           || test_spp(b, 1, 3)
+           || test_spp(c, 0, 3)
+           || test_spp(c, 1, 2)
+           || test_spp(d, 0, 2)
+           || test_spp(d, 1, 3);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return test_spp_0();
+}
@@ -31,10 +31,29 @@ static int test_statisticspooling_0()
            || test_statisticspooling(b, 1);
 }
 
+static int test_statisticspooling_1()
+{
+    ncnn::Mat a = RandomMat(7, 5, 16);
+    ncnn::Mat b = RandomMat(13, 1, 24);
+    ncnn::Mat c = RandomMat(4, 3, 2, 32);
+    ncnn::Mat d = RandomMat(11, 12);
+
+    return 0
+           || test_statisticspooling(a, 0)
+           || test_statisticspooling(a, 1)
+           || test_statisticspooling(b, 0)
+           || test_statisticspooling(b, 1)
+           || test_statisticspooling(c, 0)
+           || test_statisticspooling(c, 1)
+           || test_statisticspooling(d, 0)
+           || test_statisticspooling(d, 1);
+}
+
 int main()
 {
     SRAND(7767517);
 
     return 0
-           || test_statisticspooling_0();
+           || test_statisticspooling_0()
+           || test_statisticspooling_1();
 }